@@ -326,6 +326,8 @@ ss::future<ntp_archiver::batch_result> ntp_archiver::upload_next_candidates(
           _ntp);
         co_await upload_manifest();
         _last_upload_time = ss::lowres_clock::now();
+        // segments that are not archived yet must survive disk pressure
+        lm.set_uploaded_offset(_ntp, _remote.get_last_offset());
     }
     co_return total;
 }
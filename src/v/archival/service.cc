@@ -249,6 +249,15 @@ ss::future<> scheduler_service_impl::upload_topic_manifest(
     }
 }
 
+/// Keeps the segments that are not archived yet from being evicted under disk
+/// pressure, until the archiver uploads them.
+static void
+protect_unarchived(storage::log_manager& lm, const ntp_archiver& svc) {
+    const auto& m = svc.get_remote_manifest();
+    lm.set_uploaded_offset(
+      svc.get_ntp(), m.size() ? m.get_last_offset() : model::offset{});
+}
+
 ss::future<>
 scheduler_service_impl::create_archivers(std::vector<model::ntp> to_create) {
     return ss::do_with(
@@ -263,13 +272,14 @@ scheduler_service_impl::create_archivers(std::vector<model::ntp> to_create) {
                 }
                 auto svc = ss::make_lw_shared<ntp_archiver>(
                   log->config(), _conf);
-                return ss::repeat([this, svc, ntp] {
+                return ss::repeat([this, svc, ntp, &lm] {
                     return svc->download_manifest()
                       .then(
-                        [this, svc](download_manifest_result result)
+                        [this, svc, &lm](download_manifest_result result)
                           -> ss::future<ss::stop_iteration> {
                             switch (result) {
                             case download_manifest_result::success:
+                                protect_unarchived(lm, *svc);
                                 _queue.insert(svc);
                                 vlog(
                                   archival_log.info,
@@ -278,6 +288,7 @@ scheduler_service_impl::create_archivers(std::vector<model::ntp> to_create) {
                                 return ss::make_ready_future<
                                   ss::stop_iteration>(ss::stop_iteration::yes);
                             case download_manifest_result::notfound:
+                                protect_unarchived(lm, *svc);
                                 _queue.insert(svc);
                                 vlog(
                                   archival_log.info,
@@ -0,0 +1,73 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/foreign_iobuf.h"
+
+#include "vassert.h"
+
+#include <seastar/core/future-util.hh>
+#include <seastar/core/smp.hh>
+
+namespace details {
+
+foreign_release_queue& foreign_release_queue::local() {
+    static thread_local foreign_release_queue queue;
+    return queue;
+}
+
+void foreign_release_queue::push(
+  ss::shard_id owner, void* ptr, release_fn release) {
+    vassert(
+      owner != ss::this_shard_id(),
+      "Releasing an object of shard {} to itself",
+      owner);
+    if (_pending.size() <= owner) {
+        _pending.resize(ss::smp::count);
+        _scheduled.resize(ss::smp::count, false);
+    }
+    auto& pending = _pending[owner];
+    pending.push_back({.ptr = ptr, .release = release});
+    if (pending.size() >= max_batch) {
+        flush(owner);
+        return;
+    }
+    if (!_scheduled[owner]) {
+        // everything released to the owner by the current task goes in one
+        // message
+        _scheduled[owner] = true;
+        (void)ss::later().then([this, owner] { flush(owner); });
+    }
+}
+
+void foreign_release_queue::flush(ss::shard_id owner) {
+    _scheduled[owner] = false;
+    auto batch = std::exchange(_pending[owner], {});
+    if (batch.empty()) {
+        return;
+    }
+    _released += batch.size();
+    ++_messages;
+    (void)ss::smp::submit_to(owner, [batch = std::move(batch)] {
+        for (const auto& p : batch) {
+            p.release(p.ptr);
+        }
+    });
+}
+
+} // namespace details
+
+iobuf iobuf_share_foreign(const iobuf& src, ss::deleter keepalive) {
+    iobuf ret;
+    for (const auto& f : src) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        ret.append(ss::temporary_buffer<char>(
+          const_cast<char*>(f.get()), f.size(), keepalive.share()));
+    }
+    return ret;
+}
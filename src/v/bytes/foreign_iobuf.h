@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "seastarx.h"
+
+#include <seastar/core/deleter.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace details {
+
+/**
+ * Objects owned by other shards waiting to be destroyed on their owner.
+ *
+ * Destroying a `foreign_ptr` sends one message to its owner. Objects pushed
+ * here are instead sent back to their owner in bulk: one message per owner
+ * with everything released during the current task, or as soon as
+ * `max_batch` objects are pending.
+ */
+class foreign_release_queue {
+public:
+    using release_fn = void (*)(void*);
+
+    static constexpr size_t max_batch = 128;
+
+    static foreign_release_queue& local();
+
+    /// destroys `ptr` with `release` on shard `owner`
+    void push(ss::shard_id owner, void* ptr, release_fn release);
+
+    /// objects sent back to their owner
+    uint64_t released() const { return _released; }
+    /// messages sent to other shards
+    uint64_t messages() const { return _messages; }
+
+private:
+    struct pending {
+        void* ptr;
+        release_fn release;
+    };
+
+    void flush(ss::shard_id owner);
+
+    // indexed by owner shard
+    std::vector<std::vector<pending>> _pending;
+    std::vector<bool> _scheduled;
+    uint64_t _released{0};
+    uint64_t _messages{0};
+};
+
+} // namespace details
+
+/// \brief deleter destroying `p` on its owner shard, in bulk with the other
+/// objects released to that shard by the calling shard
+template<typename T>
+ss::deleter make_foreign_deleter(ss::foreign_ptr<std::unique_ptr<T>> p) {
+    const auto owner = p.get_owner_shard();
+    if (owner == ss::this_shard_id()) {
+        return ss::make_object_deleter(std::move(p));
+    }
+    T* ptr = p.release().release();
+    return ss::make_deleter([owner, ptr] {
+        details::foreign_release_queue::local().push(
+          owner, ptr, [](void* v) { delete static_cast<T*>(v); });
+    });
+}
+
+/// \brief shares the memory of `src`, owned by another shard, with the calling
+/// shard without copying it. The result and its fragments are allocated on the
+/// calling shard; `keepalive` must own the memory of `src` and is destroyed
+/// once all the fragments of the result are gone, see make_foreign_deleter().
+/// `src` must not be modified while the result is alive.
+iobuf iobuf_share_foreign(const iobuf& src, ss::deleter keepalive);
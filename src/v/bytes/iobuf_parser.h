@@ -46,11 +46,42 @@ public:
     size_t bytes_consumed() const { return _in.bytes_consumed(); }
 
     std::pair<int64_t, uint8_t> read_varlong() {
+        if (likely(_in.segment_bytes_left() >= vint::details::word_length)) {
+            auto [val, length_size] = vint::details::decode_word(
+              segment_data());
+            if (likely(length_size > 0)) {
+                _in.skip(length_size);
+                return {vint::decode_zigzag(val), length_size};
+            }
+        }
         auto [val, length_size] = vint::deserialize(_in);
         _in.skip(length_size);
         return {val, length_size};
     }
 
+    /// reads `n` consecutive varlongs. values are decoded in bulk straight
+    /// from the current fragment; only a varint straddling two fragments goes
+    /// through the byte-at-a-time path
+    void read_varlongs(int64_t* out, size_t n) {
+        while (n > 0) {
+            auto [decoded, consumed] = vint::deserialize_array(
+              segment_data(), _in.segment_bytes_left(), out, n);
+            _in.skip(consumed);
+            out += decoded;
+            n -= decoded;
+            if (n > 0) {
+                *out++ = read_varlong().first;
+                --n;
+            }
+        }
+    }
+
+    std::pair<uint64_t, uint8_t> read_unsigned_varlong() {
+        auto [val, length_size] = vint::deserialize_unsigned(_in);
+        _in.skip(length_size);
+        return {val, length_size};
+    }
+
     ss::sstring read_string(size_t len) {
         ss::sstring str = ss::uninitialized_string(len);
         _in.consume_to(str.size(), str.begin());
@@ -103,6 +134,11 @@ private:
     size_t _original_size;
 
     const iobuf& cref() const { return *std::get<const_ref>(_buf); }
+
+    const uint8_t* segment_data() const {
+        // NOLINTNEXTLINE
+        return reinterpret_cast<const uint8_t*>(_in.segment_data());
+    }
 };
 
 class iobuf_const_parser final : public iobuf_parser_base {
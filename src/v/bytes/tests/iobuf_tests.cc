@@ -9,11 +9,15 @@
 
 #include "bytes/bytes.h"
 #include "bytes/details/io_allocation_size.h"
+#include "bytes/foreign_iobuf.h"
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_istreambuf.h"
 #include "bytes/iobuf_ostreambuf.h"
 #include "bytes/tests/utils.h"
 
+#include <seastar/core/sharded.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/smp.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/testing/thread_test_case.hh>
 
@@ -22,6 +26,9 @@
 #include <boost/test/unit_test.hpp>
 #include <fmt/format.h>
 
+#include <atomic>
+#include <chrono>
+
 SEASTAR_THREAD_TEST_CASE(test_appended_data_is_retained) {
     iobuf buf;
     append_sequence(buf, 5);
@@ -632,3 +639,45 @@ SEASTAR_THREAD_TEST_CASE(iobuf_string_view_cmp) {
         BOOST_REQUIRE_EQUAL(buf, std::string_view(str));
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(share_foreign_iobuf_releases_on_owner) {
+    if (ss::smp::count < 2) {
+        return;
+    }
+    struct owned {
+        iobuf buf;
+        std::atomic<int>* released_on;
+        ~owned() { released_on->store(ss::this_shard_id()); }
+    };
+    std::atomic<int> released_on{-1};
+
+    auto src = ss::smp::submit_to(1, [&released_on] {
+                   auto o = std::make_unique<owned>();
+                   o->released_on = &released_on;
+                   append_sequence(o->buf, 5);
+                   return ss::make_foreign(std::move(o));
+               }).get0();
+
+    iobuf expected;
+    append_sequence(expected, 5);
+    const auto messages
+      = details::foreign_release_queue::local().messages();
+    {
+        const auto& buf = src->buf;
+        auto keepalive = make_foreign_deleter(std::move(src));
+        auto a = iobuf_share_foreign(buf, keepalive.share());
+        auto b = iobuf_share_foreign(buf, std::move(keepalive));
+        BOOST_REQUIRE(a == expected);
+        BOOST_REQUIRE(b == expected);
+        a.clear();
+        // still referenced by b
+        ss::later().get();
+        BOOST_REQUIRE_EQUAL(released_on.load(), -1);
+    }
+    for (int i = 0; i < 1000 && released_on.load() == -1; ++i) {
+        ss::sleep(std::chrono::milliseconds(1)).get();
+    }
+    BOOST_REQUIRE_EQUAL(released_on.load(), 1);
+    BOOST_REQUIRE_EQUAL(
+      details::foreign_release_queue::local().messages(), messages + 1);
+}
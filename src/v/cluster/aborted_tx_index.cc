@@ -0,0 +1,92 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/aborted_tx_index.h"
+
+#include "vassert.h"
+
+#include <algorithm>
+
+namespace cluster {
+
+void aborted_tx_index::add(
+  tx_range range, model::offset marker, model::offset stable_offset) {
+    stable_offset = std::min(stable_offset, range.first);
+    if (!_entries.empty()) {
+        vassert(
+          _entries.back().marker < marker,
+          "aborted transactions must be added in the order of their markers, "
+          "last marker: {}, added: {}",
+          _entries.back().marker,
+          marker);
+    }
+    // keep the stable offsets monotonic even if the caller's view of the
+    // ongoing transactions was incomplete
+    for (auto it = _entries.rbegin();
+         it != _entries.rend() && it->stable_offset > stable_offset;
+         ++it) {
+        it->stable_offset = stable_offset;
+    }
+    _entries.push_back(entry{
+      .range = range,
+      .marker = marker,
+      .stable_offset = stable_offset,
+    });
+}
+
+void aborted_tx_index::reset(
+  std::vector<tx_range> ranges, std::optional<model::offset> ongoing_start) {
+    std::sort(
+      ranges.begin(), ranges.end(), [](const tx_range& l, const tx_range& r) {
+          return l.last < r.last;
+      });
+    _entries.clear();
+    _entries.resize(ranges.size());
+    // the stable offset of every entry is the lowest first offset of the
+    // ranges that follow it, and of the transactions that are still ongoing
+    // which may be aborted later
+    auto stable = ongoing_start.value_or(model::offset::max());
+    for (size_t i = ranges.size(); i > 0; --i) {
+        auto& r = ranges[i - 1];
+        stable = std::min(stable, r.first);
+        _entries[i - 1] = entry{
+          .range = r,
+          .marker = r.last,
+          .stable_offset = stable,
+        };
+    }
+}
+
+std::vector<tx_range>
+aborted_tx_index::find(model::offset from, model::offset to) const {
+    std::vector<tx_range> ret;
+    // the marker always follows the last offset of the range
+    auto it = std::lower_bound(
+      _entries.begin(),
+      _entries.end(),
+      from,
+      [](const entry& e, model::offset o) { return e.marker < o; });
+    for (; it != _entries.end() && it->stable_offset <= to; ++it) {
+        if (it->range.last >= from && it->range.first <= to) {
+            ret.push_back(it->range);
+        }
+    }
+    return ret;
+}
+
+std::vector<tx_range> aborted_tx_index::evict_before(model::offset offset) {
+    std::vector<tx_range> ret;
+    while (!_entries.empty() && _entries.front().marker < offset) {
+        ret.push_back(_entries.front().range);
+        _entries.pop_front();
+    }
+    return ret;
+}
+
+} // namespace cluster
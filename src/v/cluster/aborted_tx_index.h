@@ -0,0 +1,82 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record.h"
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace cluster {
+
+struct tx_range {
+    model::producer_identity pid;
+    model::offset first;
+    model::offset last;
+};
+
+/**
+ * Offset ordered index of the aborted transactions of a partition.
+ *
+ * Ranges are appended in the order of their abort markers and every entry
+ * keeps, next to the range, the offset of the abort marker and the last
+ * stable offset at the moment of the abort, i.e. the first offset of the
+ * oldest ongoing transaction. Both are monotonic in the order of the
+ * aborts, and all the ranges aborted later start at or after the stable
+ * offset of an entry.
+ *
+ * A lookup of the ranges overlapping [from, to] starts at the first entry
+ * whose marker is at or after `from` (ranges aborted earlier end before
+ * `from`) and stops at the first entry whose stable offset is past `to`
+ * (ranges aborted later start after `to`), which makes it O(log n + k).
+ */
+class aborted_tx_index {
+public:
+    struct entry {
+        tx_range range;
+        // offset of the abort marker
+        model::offset marker;
+        // first offset of the oldest transaction ongoing at the abort
+        model::offset stable_offset;
+    };
+
+    /// appends a range aborted by the marker at `marker`, `stable_offset` is
+    /// the first offset of the oldest transaction that was ongoing when the
+    /// marker was applied, including the aborted one
+    void add(tx_range, model::offset marker, model::offset stable_offset);
+
+    /// rebuilds the index from a snapshot of the ranges, the abort markers
+    /// are unknown so the ranges are ordered by their last offset.
+    /// `ongoing_start` is the first offset of the oldest transaction that
+    /// was ongoing when the snapshot was taken.
+    void
+    reset(std::vector<tx_range>, std::optional<model::offset> ongoing_start);
+
+    /// returns the aborted ranges overlapping [from, to]
+    std::vector<tx_range> find(model::offset from, model::offset to) const;
+
+    /// drops the ranges that end before `offset`, returns the dropped ones
+    std::vector<tx_range> evict_before(model::offset offset);
+
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+
+    auto begin() const { return _entries.cbegin(); }
+    auto end() const { return _entries.cend(); }
+
+private:
+    std::deque<entry> _entries;
+};
+
+} // namespace cluster
@@ -24,6 +24,9 @@
 #include <seastar/core/do_with.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+
+#include <vector>
 
 namespace cluster {
 
@@ -159,23 +162,15 @@ template<typename... Commands>
 CONCEPT(requires(ControllerCommand<Commands>, ...))
 using make_commands_list = commands_type_list<Commands...>;
 
-/// Commands are serialized as a batch with single record. Command key is
-/// serialized as a record key. Key is independent from command type so it can
-/// leverage the log compactions (i.e only last command for given key is enough
-/// to determine its state). Command value contains command type information.
-/// Record data contains first the command type and then value.
-///
-///                  +--------------+-------+
-///                  | command_type | value |
-///                  +--------------+-------+
-///
+namespace internal {
 template<typename Cmd>
 CONCEPT(requires ControllerCommand<Cmd>)
-ss::future<model::record_batch> serialize_cmd(Cmd cmd) {
+ss::future<> add_cmd(simple_batch_builder& builder, Cmd cmd) {
     return ss::do_with(
       iobuf{},
       iobuf{},
-      [cmd = std::move(cmd)](iobuf& key_buf, iobuf& value_buf) mutable {
+      [&builder, cmd = std::move(cmd)](
+        iobuf& key_buf, iobuf& value_buf) mutable {
           auto value_f
             = reflection::async_adl<command_type>{}
                 .to(value_buf, Cmd::type)
@@ -187,13 +182,68 @@ ss::future<model::record_batch> serialize_cmd(Cmd cmd) {
             key_buf, std::move(cmd.key));
           return ss::when_all_succeed(std::move(key_f), std::move(value_f))
             .discard_result()
-            .then([&key_buf, &value_buf]() mutable {
-                simple_batch_builder builder(Cmd::batch_type, model::offset(0));
+            .then([&builder, &key_buf, &value_buf]() mutable {
                 builder.add_raw_kv(std::move(key_buf), std::move(value_buf));
-                return std::move(builder).build();
             });
       });
 }
+} // namespace internal
+
+/// Commands are serialized as a batch with single record. Command key is
+/// serialized as a record key. Key is independent from command type so it can
+/// leverage the log compactions (i.e only last command for given key is enough
+/// to determine its state). Command value contains command type information.
+/// Record data contains first the command type and then value.
+///
+///                  +--------------+-------+
+///                  | command_type | value |
+///                  +--------------+-------+
+///
+template<typename Cmd>
+CONCEPT(requires ControllerCommand<Cmd>)
+ss::future<model::record_batch> serialize_cmd(Cmd cmd) {
+    return ss::do_with(
+      simple_batch_builder(Cmd::batch_type, model::offset(0)),
+      [cmd = std::move(cmd)](simple_batch_builder& builder) mutable {
+          return internal::add_cmd(builder, std::move(cmd))
+            .then([&builder] { return std::move(builder).build(); });
+      });
+}
+
+/// Serializes many commands of the same type as a single batch, each command
+/// is a separate record with the same layout as in `serialize_cmd`. The batch
+/// is replicated and applied as a whole, every record gets its own offset.
+/// Use `split_cmds` to turn it back into single command batches.
+template<typename Cmd>
+CONCEPT(requires ControllerCommand<Cmd>)
+ss::future<model::record_batch> serialize_cmds(std::vector<Cmd> cmds) {
+    return ss::do_with(
+      simple_batch_builder(Cmd::batch_type, model::offset(0)),
+      std::move(cmds),
+      [](simple_batch_builder& builder, std::vector<Cmd>& cmds) {
+          return ss::do_for_each(
+                   cmds,
+                   [&builder](Cmd& cmd) {
+                       return internal::add_cmd(builder, std::move(cmd));
+                   })
+            .then([&builder] { return std::move(builder).build(); });
+      });
+}
+
+/// Splits a batch containing many commands into single command batches, the
+/// base offset of each batch is the offset of its record
+inline std::vector<model::record_batch>
+split_cmds(const model::record_batch& b) {
+    std::vector<model::record_batch> ret;
+    ret.reserve(b.record_count());
+    for (auto& r : b.copy_records()) {
+        simple_batch_builder builder(
+          b.header().type, b.base_offset() + model::offset(r.offset_delta()));
+        builder.add_raw_kv(r.release_key(), r.release_value());
+        ret.push_back(std::move(builder).build());
+    }
+    return ret;
+}
 
 namespace internal {
 template<typename Cmd>
@@ -12,14 +12,17 @@
 #include "cluster/cluster_utils.h"
 #include "cluster/controller_backend.h"
 #include "cluster/controller_service.h"
+#include "cluster/leader_balancer.h"
 #include "cluster/logger.h"
 #include "cluster/members_manager.h"
 #include "cluster/members_table.h"
 #include "cluster/metadata_dissemination_service.h"
+#include "cluster/node_load_monitor.h"
 #include "cluster/partition_leaders_table.h"
 #include "cluster/partition_manager.h"
 #include "cluster/raft0_utils.h"
 #include "cluster/security_frontend.h"
+#include "cluster/shard_balancer.h"
 #include "cluster/shard_table.h"
 #include "cluster/topic_table.h"
 #include "cluster/topics_frontend.h"
@@ -88,6 +91,8 @@ ss::future<> controller::start() {
             std::ref(clusterlog),
             _raft0.get(),
             raft::persistent_last_applied::yes,
+            raft::snapshot_interval(
+              config::shard_local_cfg().controller_snapshot_interval_entries()),
             std::ref(_tp_updates_dispatcher),
             std::ref(_security_manager));
       })
@@ -107,6 +112,7 @@ ss::future<> controller::start() {
             std::ref(_connections),
             std::ref(_partition_allocator),
             std::ref(_partition_leaders),
+            std::ref(_tp_state),
             std::ref(_as));
       })
       .then([this] {
@@ -142,7 +148,46 @@ ss::future<> controller::start() {
           });
       })
       .then(
-        [this] { return _backend.invoke_on_all(&controller_backend::start); });
+        [this] { return _backend.invoke_on_all(&controller_backend::start); })
+      .then([this] {
+          return _leader_balancer.start_single(
+            _raft0,
+            std::ref(_tp_state),
+            std::ref(_partition_leaders),
+            std::ref(_connections),
+            std::ref(_shard_table),
+            std::ref(_partition_manager),
+            std::ref(_as));
+      })
+      .then([this] {
+          return _leader_balancer.invoke_on(
+            leader_balancer::shard, &leader_balancer::start);
+      })
+      .then([this] {
+          return _load_monitor.start_single(
+            _raft0,
+            std::ref(_members_table),
+            std::ref(_connections),
+            std::ref(_partition_manager),
+            std::ref(_partition_allocator),
+            std::ref(_as));
+      })
+      .then([this] {
+          return _load_monitor.invoke_on(
+            node_load_monitor::shard, &node_load_monitor::start);
+      })
+      .then([this] {
+          return _shard_balancer.start_single(
+            _raft0->self().id(),
+            std::ref(_tp_state),
+            std::ref(_tp_frontend),
+            std::ref(_partition_manager),
+            std::ref(_as));
+      })
+      .then([this] {
+          return _shard_balancer.invoke_on(
+            shard_balancer::shard, &shard_balancer::start);
+      });
 }
 
 ss::future<> controller::shutdown_input() {
@@ -161,7 +206,10 @@ ss::future<> controller::stop() {
     }
 
     return f.then([this] {
-        return _backend.stop()
+        return _shard_balancer.stop()
+          .then([this] { return _load_monitor.stop(); })
+          .then([this] { return _leader_balancer.stop(); })
+          .then([this] { return _backend.stop(); })
           .then([this] { return _tp_frontend.stop(); })
           .then([this] { return _security_frontend.stop(); })
           .then([this] { return _stm.stop(); })
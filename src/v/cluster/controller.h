@@ -55,6 +55,10 @@ public:
 
     ss::sharded<security::authorizer>& get_authorizer() { return _authorizer; }
 
+    ss::sharded<leader_balancer>& get_leader_balancer() {
+        return _leader_balancer;
+    }
+
     ss::future<> wire_up();
 
     ss::future<> start();
@@ -74,6 +78,9 @@ private:
     ss::sharded<controller_backend> _backend;      // instance per core
     ss::sharded<controller_stm> _stm;              // single instance
     ss::sharded<controller_service> _service;      // instance per core
+    ss::sharded<leader_balancer> _leader_balancer; // single instance
+    ss::sharded<node_load_monitor> _load_monitor;  // single instance
+    ss::sharded<shard_balancer> _shard_balancer;   // single instance
     ss::sharded<rpc::connection_cache>& _connections;
     ss::sharded<partition_manager>& _partition_manager;
     ss::sharded<shard_table>& _shard_table;
@@ -173,11 +173,34 @@ ss::future<> controller_backend::bootstrap_controller_backend() {
     });
 }
 
+/**
+ * Runs `f` for every NTP with pending deltas, partitions are independent so
+ * they are reconciled in parallel. Creating thousands of partitions at once
+ * would open as many logs and raft groups concurrently, the number of NTPs
+ * processed at the same time is bounded by
+ * `controller_backend_reconciliation_concurrency`.
+ */
+template<typename Container, typename Func>
+static ss::future<> for_each_ntp_bounded(Container& deltas, Func f) {
+    const auto concurrency = std::max<size_t>(
+      config::shard_local_cfg().controller_backend_reconciliation_concurrency(),
+      1);
+    return ss::do_with(
+      ss::semaphore(concurrency),
+      [&deltas, f = std::move(f)](ss::semaphore& sem) mutable {
+          return ss::parallel_for_each(
+            deltas.begin(),
+            deltas.end(),
+            [&sem, &f](typename Container::value_type& ntp_deltas) {
+                return ss::with_semaphore(
+                  sem, 1, [&f, &ntp_deltas] { return f(ntp_deltas); });
+            });
+      });
+}
+
 ss::future<> controller_backend::do_bootstrap() {
-    return ss::parallel_for_each(
-      _topic_deltas.begin(),
-      _topic_deltas.end(),
-      [this](underlying_t::value_type& ntp_deltas) {
+    return for_each_ntp_bounded(
+      _topic_deltas, [this](underlying_t::value_type& ntp_deltas) {
           return bootstrap_ntp(ntp_deltas.first, ntp_deltas.second);
       });
 }
@@ -324,9 +347,8 @@ ss::future<> controller_backend::reconcile_topics() {
             return ss::now();
         }
         // reconcile NTPs in parallel
-        return ss::parallel_for_each(
-                 _topic_deltas.begin(),
-                 _topic_deltas.end(),
+        return for_each_ntp_bounded(
+                 _topic_deltas,
                  [this](underlying_t::value_type& ntp_deltas) {
                      return reconcile_ntp(ntp_deltas.second);
                  })
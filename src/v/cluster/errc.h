@@ -38,6 +38,7 @@ enum class errc {
     update_in_progress,
     user_exists,
     user_does_not_exist,
+    leadership_transfer_failed,
 };
 struct errc_category final : public std::error_category {
     const char* name() const noexcept final { return "cluster::errc"; }
@@ -96,6 +97,8 @@ struct errc_category final : public std::error_category {
             return "User already exists";
         case errc::user_does_not_exist:
             return "User does not exist";
+        case errc::leadership_transfer_failed:
+            return "Partition leadership transfer failed";
         default:
             return "cluster::errc::unknown";
         }
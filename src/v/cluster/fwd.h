@@ -17,6 +17,9 @@ class controller;
 class controller_backend;
 class controller_service;
 class id_allocator_frontend;
+class leader_balancer;
+class node_load_monitor;
+class shard_balancer;
 class partition_leaders_table;
 class partition_allocator;
 class partition_manager;
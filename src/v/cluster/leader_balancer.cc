@@ -0,0 +1,371 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/leader_balancer.h"
+
+#include "cluster/controller_service.h"
+#include "cluster/logger.h"
+#include "cluster/partition_leaders_table.h"
+#include "cluster/partition_manager.h"
+#include "cluster/shard_table.h"
+#include "cluster/topic_table.h"
+#include "config/configuration.h"
+#include "model/timeout_clock.h"
+#include "raft/peer_liveness.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+
+#include <algorithm>
+
+namespace cluster {
+
+namespace {
+using shard_key = std::pair<model::node_id, uint32_t>;
+
+shard_key to_key(const model::broker_shard& bs) {
+    return {bs.node_id, bs.shard};
+}
+
+// leadership transfers include recovery of the target replica
+constexpr auto transfer_timeout = std::chrono::seconds(30);
+} // namespace
+
+leader_balancer::leader_balancer(
+  consensus_ptr raft0,
+  ss::sharded<topic_table>& topics,
+  ss::sharded<partition_leaders_table>& leaders,
+  ss::sharded<rpc::connection_cache>& connections,
+  ss::sharded<shard_table>& st,
+  ss::sharded<partition_manager>& pm,
+  ss::sharded<ss::abort_source>& as)
+  : _raft0(std::move(raft0))
+  , _topics(topics)
+  , _leaders(leaders)
+  , _connections(connections)
+  , _shard_table(st)
+  , _partition_manager(pm)
+  , _as(as)
+  , _self(_raft0->self().id()) {}
+
+ss::future<> leader_balancer::start() {
+    _status.enabled = config::shard_local_cfg().enable_leader_balancer();
+    _status.dry_run = config::shard_local_cfg().leader_balancer_dry_run();
+    _timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] { return tick(); })
+          .handle_exception([](std::exception_ptr e) {
+              vlog(clusterlog.warn, "Leader balancer tick failed: {}", e);
+          })
+          .finally([this] { arm_timer(); });
+    });
+    arm_timer();
+    return ss::now();
+}
+
+ss::future<> leader_balancer::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void leader_balancer::arm_timer() {
+    if (!_gate.is_closed() && !_as.local().abort_requested()) {
+        _timer.arm(config::shard_local_cfg().leader_balancer_interval_ms());
+    }
+}
+
+ss::future<> leader_balancer::tick() {
+    const auto& cfg = config::shard_local_cfg();
+    _status.active = _raft0->is_leader();
+    if (!_status.enabled || !_status.active) {
+        co_return;
+    }
+
+    _status.last_tick = ss::lowres_system_clock::now();
+    auto plan = make_plan(
+      collect_partitions(),
+      live_nodes(),
+      muted_partitions(),
+      cfg.leader_balancer_max_transfers());
+    _status.last_plan = plan;
+
+    if (plan.moves.empty()) {
+        co_return;
+    }
+
+    vlog(
+      clusterlog.info,
+      "Leader balancer planned {} moves, shard leader spread {} -> {}{}",
+      plan.moves.size(),
+      plan.spread_before,
+      plan.spread_after,
+      _status.dry_run ? " (dry run)" : "");
+
+    if (_status.dry_run) {
+        co_return;
+    }
+
+    // transfers are executed one at a time to limit the number of concurrent
+    // elections in the cluster
+    for (const auto& m : plan.moves) {
+        if (_as.local().abort_requested() || !_raft0->is_leader()) {
+            break;
+        }
+        _muted[m.ntp] = ss::lowres_clock::now()
+                        + cfg.leader_balancer_mute_timeout_ms();
+
+        std::error_code ec;
+        try {
+            ec = co_await transfer(m);
+        } catch (...) {
+            vlog(
+              clusterlog.info,
+              "Leadership transfer of {} to {} failed: {}",
+              m.ntp,
+              m.to,
+              std::current_exception());
+            ec = errc::leadership_transfer_failed;
+        }
+
+        if (ec) {
+            ++_status.failed_transfers;
+            vlog(
+              clusterlog.info,
+              "Leadership transfer of {} from {} to {} failed: {}",
+              m.ntp,
+              m.from,
+              m.to,
+              ec.message());
+        } else {
+            ++_status.transfers;
+            vlog(
+              clusterlog.debug,
+              "Transferred leadership of {} from {} to {}",
+              m.ntp,
+              m.from,
+              m.to);
+        }
+    }
+}
+
+std::vector<leader_balancer::partition>
+leader_balancer::collect_partitions() const {
+    std::vector<partition> ret;
+    for (auto& md : _topics.local().all_topics_metadata()) {
+        for (auto& p : md.partitions) {
+            model::ntp ntp(md.tp_ns.ns, md.tp_ns.tp, p.id);
+            if (_topics.local().is_update_in_progress(ntp)) {
+                continue;
+            }
+            auto leader = _leaders.local().get_leader(ntp);
+            if (!leader) {
+                continue;
+            }
+            auto it = std::find_if(
+              p.replicas.cbegin(),
+              p.replicas.cend(),
+              [&leader](const model::broker_shard& bs) {
+                  return bs.node_id == *leader;
+              });
+            if (it == p.replicas.cend()) {
+                continue;
+            }
+            ret.push_back(partition{
+              .ntp = std::move(ntp),
+              .leader = *it,
+              .replicas = std::move(p.replicas),
+            });
+        }
+    }
+    return ret;
+}
+
+absl::flat_hash_set<model::node_id> leader_balancer::live_nodes() const {
+    absl::flat_hash_set<model::node_id> ret{_self};
+    auto now = raft::clock_type::now();
+    auto timeout = config::shard_local_cfg().raft_election_timeout_ms();
+    const auto& liveness = raft::shard_local_peer_liveness();
+    for (auto& f : _raft0->get_follower_metrics()) {
+        if (f.is_live || liveness.last_seen(f.id) + timeout > now) {
+            ret.insert(f.id);
+        }
+    }
+    return ret;
+}
+
+absl::flat_hash_set<model::ntp> leader_balancer::muted_partitions() {
+    auto now = ss::lowres_clock::now();
+    absl::erase_if(_muted, [now](const auto& e) { return e.second <= now; });
+
+    absl::flat_hash_set<model::ntp> ret;
+    ret.reserve(_muted.size());
+    for (auto& e : _muted) {
+        ret.insert(e.first);
+    }
+    return ret;
+}
+
+leader_balancer::plan leader_balancer::make_plan(
+  const std::vector<partition>& partitions,
+  const absl::flat_hash_set<model::node_id>& live_nodes,
+  const absl::flat_hash_set<model::ntp>& muted,
+  size_t max_moves) {
+    // leaders per shard, including live shards that lead nothing
+    absl::flat_hash_map<shard_key, size_t> load;
+    absl::flat_hash_map<shard_key, std::vector<size_t>> leaders;
+    for (size_t i = 0; i < partitions.size(); ++i) {
+        const auto& p = partitions[i];
+        for (const auto& r : p.replicas) {
+            if (live_nodes.contains(r.node_id)) {
+                load.try_emplace(to_key(r), 0);
+            }
+        }
+        ++load[to_key(p.leader)];
+        leaders[to_key(p.leader)].push_back(i);
+    }
+
+    auto spread = [&load]() -> size_t {
+        if (load.empty()) {
+            return 0;
+        }
+        auto [min, max] = std::minmax_element(
+          load.begin(), load.end(), [](const auto& a, const auto& b) {
+              return a.second < b.second;
+          });
+        return max->second - min->second;
+    };
+
+    plan ret;
+    ret.spread_before = spread();
+
+    absl::flat_hash_set<shard_key> exhausted;
+    std::vector<bool> moved(partitions.size(), false);
+
+    while (ret.moves.size() < max_moves) {
+        // most loaded shard which may still shed a leader
+        std::optional<shard_key> hot;
+        size_t hot_load = 0;
+        for (const auto& [k, l] : load) {
+            if (!exhausted.contains(k) && (!hot || l > hot_load)) {
+                hot = k;
+                hot_load = l;
+            }
+        }
+        if (!hot) {
+            break;
+        }
+
+        // pick the partition whose least loaded live replica improves the
+        // balance the most
+        std::optional<size_t> best;
+        size_t best_pos = 0;
+        model::broker_shard best_target{};
+        size_t best_load = 0;
+        const auto& led = leaders[*hot];
+        for (size_t pos = 0; pos < led.size(); ++pos) {
+            auto idx = led[pos];
+            const auto& p = partitions[idx];
+            if (moved[idx] || muted.contains(p.ntp)) {
+                continue;
+            }
+            for (const auto& r : p.replicas) {
+                auto k = to_key(r);
+                if (k == *hot || !live_nodes.contains(r.node_id)) {
+                    continue;
+                }
+                auto l = load.find(k)->second;
+                if (l + 1 < hot_load && (!best || l < best_load)) {
+                    best = idx;
+                    best_pos = pos;
+                    best_target = r;
+                    best_load = l;
+                }
+            }
+        }
+
+        if (!best) {
+            exhausted.insert(*hot);
+            continue;
+        }
+
+        const auto& p = partitions[*best];
+        auto& from = leaders[*hot];
+        from.erase(from.begin() + best_pos);
+        leaders[to_key(best_target)].push_back(*best);
+        --load[*hot];
+        ++load[to_key(best_target)];
+        moved[*best] = true;
+
+        ret.moves.push_back(move{
+          .ntp = p.ntp,
+          .from = p.leader,
+          .to = best_target,
+        });
+    }
+
+    ret.spread_after = spread();
+    return ret;
+}
+
+ss::future<std::error_code> leader_balancer::transfer(const move& m) {
+    auto leader = _leaders.local().get_leader(m.ntp);
+    if (leader != m.from.node_id) {
+        // leadership changed since the plan was made
+        return ss::make_ready_future<std::error_code>(errc::not_leader);
+    }
+
+    if (*leader == _self) {
+        return transfer_local(m.ntp, m.to.node_id);
+    }
+
+    auto timeout = model::timeout_clock::now() + transfer_timeout;
+    return _connections.local()
+      .with_node_client<controller_client_protocol>(
+        _self,
+        ss::this_shard_id(),
+        *leader,
+        timeout,
+        [ntp = m.ntp, target = m.to.node_id, timeout](
+          controller_client_protocol client) mutable {
+            return client
+              .transfer_leadership(
+                transfer_leadership_request{
+                  .ntp = std::move(ntp),
+                  .target = target,
+                },
+                rpc::client_opts(timeout))
+              .then(&rpc::get_ctx_data<transfer_leadership_reply>);
+        })
+      .then([](result<transfer_leadership_reply> r) {
+          if (r.has_error()) {
+              return r.error();
+          }
+          return make_error_code(r.value().result);
+      });
+}
+
+ss::future<std::error_code> leader_balancer::transfer_local(
+  model::ntp ntp, std::optional<model::node_id> target) {
+    auto shard = _shard_table.local().shard_for(ntp);
+    if (!shard) {
+        return ss::make_ready_future<std::error_code>(
+          errc::partition_not_exists);
+    }
+    return _partition_manager.invoke_on(
+      *shard,
+      [ntp = std::move(ntp), target](partition_manager& pm) mutable {
+          auto partition = pm.get(ntp);
+          if (!partition) {
+              return ss::make_ready_future<std::error_code>(
+                errc::partition_not_exists);
+          }
+          return partition->transfer_leadership(target);
+      });
+}
+
+} // namespace cluster
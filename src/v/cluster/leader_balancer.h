@@ -0,0 +1,143 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "cluster/fwd.h"
+#include "cluster/types.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "raft/consensus.h"
+#include "rpc/connection_cache.h"
+#include "seastarx.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Leader balancer.
+ *
+ * Partition leadership is not moved back once it has been acquired by a
+ * replica. After node restarts leaders pile up on the surviving nodes and
+ * stay there, saturating some shards while leaving others idle.
+ *
+ * The balancer periodically runs on the controller leader. It builds the
+ * number of leaders per shard from the partition leaders table and the
+ * replica assignments in the topic table, and greedily plans leadership
+ * moves from the most loaded shard to the least loaded replica shard until
+ * the spread between shards is at most one leader. Every tick executes at
+ * most `leader_balancer_max_transfers` moves by asking the current leader
+ * to transfer leadership, which in turn uses raft's timeout_now request.
+ * Partitions that were recently moved are muted for a while so that the
+ * balancer does not fight elections that are still settling.
+ *
+ * In dry-run mode the plan is computed and published but not executed. The
+ * last plan is exposed through the admin API.
+ *
+ * Single instance running on shard `leader_balancer::shard`.
+ */
+class leader_balancer {
+public:
+    static constexpr ss::shard_id shard = 0;
+
+    struct move {
+        model::ntp ntp;
+        model::broker_shard from;
+        model::broker_shard to;
+    };
+
+    // replica placement and current leader of a single partition
+    struct partition {
+        model::ntp ntp;
+        model::broker_shard leader;
+        std::vector<model::broker_shard> replicas;
+    };
+
+    struct plan {
+        std::vector<move> moves;
+        // difference between the most and least loaded shard
+        size_t spread_before{0};
+        size_t spread_after{0};
+    };
+
+    struct status {
+        bool enabled{false};
+        bool dry_run{false};
+        // true when this node is the controller leader
+        bool active{false};
+        std::optional<ss::lowres_system_clock::time_point> last_tick;
+        plan last_plan;
+        size_t transfers{0};
+        size_t failed_transfers{0};
+    };
+
+    leader_balancer(
+      consensus_ptr,
+      ss::sharded<topic_table>&,
+      ss::sharded<partition_leaders_table>&,
+      ss::sharded<rpc::connection_cache>&,
+      ss::sharded<shard_table>&,
+      ss::sharded<partition_manager>&,
+      ss::sharded<ss::abort_source>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    const status& get_status() const { return _status; }
+
+    /**
+     * Plan up to `max_moves` leadership moves that reduce the leader count
+     * spread between shards. Replicas on nodes that are not in `live_nodes`
+     * are never chosen as targets and muted partitions are never moved.
+     */
+    static plan make_plan(
+      const std::vector<partition>&,
+      const absl::flat_hash_set<model::node_id>& live_nodes,
+      const absl::flat_hash_set<model::ntp>& muted,
+      size_t max_moves);
+
+private:
+    void arm_timer();
+    ss::future<> tick();
+    std::vector<partition> collect_partitions() const;
+    absl::flat_hash_set<model::node_id> live_nodes() const;
+    absl::flat_hash_set<model::ntp> muted_partitions();
+    ss::future<std::error_code> transfer(const move&);
+    ss::future<std::error_code>
+      transfer_local(model::ntp, std::optional<model::node_id>);
+
+    consensus_ptr _raft0;
+    ss::sharded<topic_table>& _topics;
+    ss::sharded<partition_leaders_table>& _leaders;
+    ss::sharded<rpc::connection_cache>& _connections;
+    ss::sharded<shard_table>& _shard_table;
+    ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<ss::abort_source>& _as;
+    model::node_id _self;
+
+    absl::flat_hash_map<model::ntp, ss::lowres_clock::time_point> _muted;
+    status _status;
+    ss::timer<ss::lowres_clock> _timer;
+    ss::gate _gate;
+};
+
+} // namespace cluster
@@ -68,6 +68,11 @@ metadata_cache::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return _topics_state.local().get_topic_timestamp_type(tp);
 }
 
+std::optional<model::compression>
+metadata_cache::get_topic_compression(model::topic_namespace_view tp) const {
+    return _topics_state.local().get_topic_compression(tp);
+}
+
 std::vector<model::topic_metadata> metadata_cache::all_topics_metadata() const {
     auto all_md = _topics_state.local().all_topics_metadata();
     for (auto& md : all_md) {
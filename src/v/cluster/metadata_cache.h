@@ -77,6 +77,13 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
+    ///\brief Returns topics compression type
+    ///
+    /// If topic does not exists or does not set a compression type it returns
+    /// an empty optional
+    std::optional<model::compression>
+      get_topic_compression(model::topic_namespace_view) const;
+
     /// Returns metadata of all topics.
     std::vector<model::topic_metadata> all_topics_metadata() const;
 
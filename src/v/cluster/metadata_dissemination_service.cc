@@ -315,6 +315,7 @@ ss::future<> metadata_dissemination_service::dispatch_one_update(
         ss::this_shard_id(),
         target_id,
         _dissemination_interval,
+        metadata_dissemination_rpc_client_protocol::update_leadership_lane,
         [this, &meta, target_id](
           metadata_dissemination_rpc_client_protocol proto) mutable {
             vlog(
@@ -0,0 +1,178 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/node_load_monitor.h"
+
+#include "cluster/controller_service.h"
+#include "cluster/logger.h"
+#include "cluster/members_table.h"
+#include "cluster/partition_manager.h"
+#include "config/configuration.h"
+#include "model/timeout_clock.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+
+namespace cluster {
+
+namespace {
+constexpr auto report_timeout = std::chrono::seconds(5);
+} // namespace
+
+node_load_monitor::node_load_monitor(
+  consensus_ptr raft0,
+  ss::sharded<members_table>& members,
+  ss::sharded<rpc::connection_cache>& connections,
+  ss::sharded<partition_manager>& pm,
+  ss::sharded<partition_allocator>& allocator,
+  ss::sharded<ss::abort_source>& as)
+  : _raft0(std::move(raft0))
+  , _members(members)
+  , _connections(connections)
+  , _partition_manager(pm)
+  , _allocator(allocator)
+  , _as(as)
+  , _self(_raft0->self().id()) {}
+
+ss::future<> node_load_monitor::start() {
+    _timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] { return tick(); })
+          .handle_exception([](std::exception_ptr e) {
+              vlog(clusterlog.warn, "Collecting node load failed: {}", e);
+          })
+          .finally([this] { arm_timer(); });
+    });
+    arm_timer();
+    return ss::now();
+}
+
+ss::future<> node_load_monitor::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void node_load_monitor::arm_timer() {
+    auto interval
+      = config::shard_local_cfg().partition_allocation_load_interval_ms();
+    if (
+      interval.count() > 0 && !_gate.is_closed()
+      && !_as.local().abort_requested()) {
+        _timer.arm(interval);
+    }
+}
+
+ss::future<> node_load_monitor::tick() {
+    if (!_raft0->is_leader()) {
+        // reports must be consecutive to compute rates
+        for (auto& [id, _] : std::exchange(_samples, {})) {
+            _allocator.local().clear_node_load(id);
+        }
+        co_return;
+    }
+
+    co_await ss::parallel_for_each(
+      _members.local().all_broker_ids(), [this](model::node_id id) {
+          return fetch(id).then(
+            [this, id](result<std::vector<shard_load>> r) {
+                if (!r) {
+                    vlog(
+                      clusterlog.debug,
+                      "Unable to collect load of node {}: {}",
+                      id,
+                      r.error().message());
+                    forget(id);
+                    return;
+                }
+                update(id, std::move(r.value()));
+            });
+      });
+}
+
+ss::future<result<std::vector<shard_load>>>
+node_load_monitor::fetch(model::node_id id) {
+    using ret_t = result<std::vector<shard_load>>;
+    if (id == _self) {
+        return _partition_manager
+          .map([](partition_manager& pm) { return pm.get_shard_load(); })
+          .then([](std::vector<shard_load> shards) {
+              return ret_t(std::move(shards));
+          });
+    }
+
+    auto timeout = model::timeout_clock::now() + report_timeout;
+    return _connections.local()
+      .with_node_client<controller_client_protocol>(
+        _self,
+        ss::this_shard_id(),
+        id,
+        timeout,
+        [timeout](controller_client_protocol client) mutable {
+            return client
+              .get_node_load(node_load_request{}, rpc::client_opts(timeout))
+              .then(&rpc::get_ctx_data<node_load_reply>);
+        })
+      .then([](result<node_load_reply> r) {
+          if (r.has_error()) {
+              return ret_t(r.error());
+          }
+          return ret_t(std::move(r.value().shards));
+      });
+}
+
+void node_load_monitor::update(
+  model::node_id id, std::vector<shard_load> shards) {
+    sample current{
+      .timestamp = ss::lowres_clock::now(),
+      .shards = std::move(shards),
+    };
+    auto it = _samples.find(id);
+    if (it == _samples.end()) {
+        _samples.emplace(id, std::move(current));
+        return;
+    }
+
+    auto& previous = it->second;
+    std::chrono::duration<double> elapsed = current.timestamp
+                                            - previous.timestamp;
+    if (
+      previous.shards.size() == current.shards.size()
+      && elapsed.count() > 0) {
+        _allocator.local().update_node_load(
+          id, to_observed_load(previous.shards, current.shards, elapsed));
+    }
+    previous = std::move(current);
+}
+
+void node_load_monitor::forget(model::node_id id) {
+    _samples.erase(id);
+    _allocator.local().clear_node_load(id);
+}
+
+std::vector<allocation_node::observed_load>
+node_load_monitor::to_observed_load(
+  const std::vector<shard_load>& previous,
+  const std::vector<shard_load>& current,
+  std::chrono::duration<double> elapsed) {
+    std::vector<allocation_node::observed_load> ret;
+    ret.reserve(current.size());
+    for (size_t i = 0; i < current.size(); ++i) {
+        // counters go backwards when partitions leave the core
+        auto records = current[i].records >= previous[i].records
+                         ? current[i].records - previous[i].records
+                         : 0;
+        ret.push_back(allocation_node::observed_load{
+          .throughput = records / elapsed.count(),
+          .disk_bytes = current[i].disk_bytes,
+        });
+    }
+    return ret;
+}
+
+} // namespace cluster
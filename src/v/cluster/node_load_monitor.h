@@ -0,0 +1,97 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "cluster/fwd.h"
+#include "cluster/partition_allocator.h"
+#include "cluster/types.h"
+#include "model/metadata.h"
+#include "outcome.h"
+#include "raft/consensus.h"
+#include "rpc/connection_cache.h"
+#include "seastarx.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Node load monitor.
+ *
+ * Runs next to the partition allocator and, while the node is the controller
+ * leader, periodically collects the per core load of every node in the
+ * cluster. Nodes report cumulative counters, the monitor turns two
+ * consecutive reports into per core throughput and feeds it together with
+ * the disk usage to the allocator so that new partitions are placed on the
+ * least loaded cores.
+ *
+ * Nodes that fail to report are dropped from the allocator's observed load
+ * and are placed by partition weight alone.
+ *
+ * Single instance running on shard `node_load_monitor::shard`.
+ */
+class node_load_monitor {
+public:
+    static constexpr ss::shard_id shard = partition_allocator::shard;
+
+    node_load_monitor(
+      consensus_ptr,
+      ss::sharded<members_table>&,
+      ss::sharded<rpc::connection_cache>&,
+      ss::sharded<partition_manager>&,
+      ss::sharded<partition_allocator>&,
+      ss::sharded<ss::abort_source>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    /// per core load observed between two cumulative reports of a node
+    static std::vector<allocation_node::observed_load> to_observed_load(
+      const std::vector<shard_load>& previous,
+      const std::vector<shard_load>& current,
+      std::chrono::duration<double> elapsed);
+
+private:
+    struct sample {
+        ss::lowres_clock::time_point timestamp;
+        std::vector<shard_load> shards;
+    };
+
+    void arm_timer();
+    ss::future<> tick();
+    ss::future<result<std::vector<shard_load>>> fetch(model::node_id);
+    void update(model::node_id, std::vector<shard_load>);
+    void forget(model::node_id);
+
+    consensus_ptr _raft0;
+    ss::sharded<members_table>& _members;
+    ss::sharded<rpc::connection_cache>& _connections;
+    ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<partition_allocator>& _allocator;
+    ss::sharded<ss::abort_source>& _as;
+    model::node_id _self;
+
+    // last report of every node
+    absl::flat_hash_map<model::node_id, sample> _samples;
+    ss::timer<ss::lowres_clock> _timer;
+    ss::gate _gate;
+};
+
+} // namespace cluster
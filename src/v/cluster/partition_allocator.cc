@@ -10,6 +10,7 @@
 #include "cluster/partition_allocator.h"
 
 #include "cluster/logger.h"
+#include "config/configuration.h"
 #include "vlog.h"
 
 #include <boost/container_hash/hash.hpp>
@@ -17,22 +18,25 @@
 #include <roaring/roaring.hh>
 
 #include <algorithm>
+#include <cstdlib>
 #include <numeric>
 #include <random>
 
 namespace cluster {
 
-void partition_allocator::rollback(const std::vector<partition_assignment>& v) {
+void partition_allocator::rollback(
+  const std::vector<partition_assignment>& v, double weight) {
     for (auto& as : v) {
-        rollback(as.replicas);
+        rollback(as.replicas, weight);
         // rollback for each assignment as the groups are distinct
         _highest_group = raft::group_id(_highest_group() - 1);
     }
 }
 
-void partition_allocator::rollback(const std::vector<model::broker_shard>& v) {
+void partition_allocator::rollback(
+  const std::vector<model::broker_shard>& v, double weight) {
     for (auto& bs : v) {
-        deallocate(bs);
+        deallocate(bs, weight);
     }
 }
 
@@ -64,23 +68,47 @@ static bool is_machine_in_replicas(
 }
 
 std::optional<std::vector<model::broker_shard>>
-partition_allocator::allocate_replicas(int16_t replication_factor) {
+partition_allocator::allocate_replicas(
+  int16_t replication_factor, double weight) {
     std::vector<model::broker_shard> replicas;
     replicas.reserve(replication_factor);
 
     while (replicas.size() < (size_t)replication_factor) {
         const uint16_t replicas_left = replication_factor - replicas.size();
         if (_available_machines.size() < replicas_left) {
-            rollback(replicas);
+            rollback(replicas, weight);
             return std::nullopt;
         }
+        // starting at the round robin position pick the machine with the
+        // coldest core, so that ties keep the round robin order
         auto& rr = round_robin_ptr();
-        auto& machine = *rr;
-        rr++;
-        if (is_machine_in_replicas(machine, replicas)) {
-            continue;
+        auto it = rr;
+        auto best = _available_machines.end();
+        double best_load = 0;
+        for (size_t i = 0; i < _available_machines.size(); ++i, ++it) {
+            if (it == _available_machines.end()) {
+                it = _available_machines.begin();
+            }
+            if (is_machine_in_replicas(*it, replicas)) {
+                continue;
+            }
+            auto core = it->coldest_core();
+            if (!core) {
+                continue;
+            }
+            auto load = it->load(*core);
+            if (best == _available_machines.end() || load < best_load) {
+                best = it;
+                best_load = load;
+            }
         }
-        const uint32_t cpu = machine.allocate();
+        if (best == _available_machines.end()) {
+            rollback(replicas, weight);
+            return std::nullopt;
+        }
+        auto& machine = *best;
+        rr = std::next(best);
+        const uint32_t cpu = machine.allocate(weight);
         model::broker_shard bs{.node_id = machine.id(), .shard = cpu};
         replicas.push_back(bs);
         if (machine.is_full()) {
@@ -88,7 +116,7 @@ partition_allocator::allocate_replicas(int16_t replication_factor) {
         }
     }
     if (!valid_machine_fault_domain_diversity(replicas)) {
-        rollback(replicas);
+        rollback(replicas, weight);
         return std::nullopt;
     }
     return replicas;
@@ -115,14 +143,16 @@ partition_allocator::allocate(const topic_configuration& cfg) {
           cap);
         return std::nullopt;
     }
+    const auto weight = partition_weight(cfg.tp_ns.tp);
     std::vector<partition_assignment> ret;
     ret.reserve(cfg.partition_count);
     for (int32_t i = 0; i < cfg.partition_count; ++i) {
         // all replicas must belong to the same raft group
         raft::group_id partition_group = raft::group_id(_highest_group() + 1);
-        auto replicas_assignment = allocate_replicas(cfg.replication_factor);
+        auto replicas_assignment = allocate_replicas(
+          cfg.replication_factor, weight);
         if (replicas_assignment == std::nullopt) {
-            rollback(ret);
+            rollback(ret, weight);
             return std::nullopt;
         }
 
@@ -133,16 +163,27 @@ partition_allocator::allocate(const topic_configuration& cfg) {
         ret.push_back(std::move(p_as));
         _highest_group = partition_group;
     }
-    return allocation_units(ret, this);
+    return allocation_units(ret, this, weight);
 }
 
-void partition_allocator::deallocate(const model::broker_shard& bs) {
+std::vector<std::optional<partition_allocator::allocation_units>>
+partition_allocator::allocate(const std::vector<topic_configuration>& cfgs) {
+    std::vector<std::optional<allocation_units>> ret;
+    ret.reserve(cfgs.size());
+    for (const auto& cfg : cfgs) {
+        ret.push_back(allocate(cfg));
+    }
+    return ret;
+}
+
+void partition_allocator::deallocate(
+  const model::broker_shard& bs, double weight) {
     // find in brokers
     auto it = find_node(bs.node_id);
     if (it != _machines.end()) {
         auto& [id, machine] = *it;
         if (bs.shard < machine->cpus()) {
-            machine->deallocate(bs.shard);
+            machine->deallocate(bs.shard, weight);
             if (!machine->_hook.is_linked()) {
                 _available_machines.push_back(*machine);
             }
@@ -156,20 +197,24 @@ void partition_allocator::update_allocation_state(
         return;
     }
 
-    std::vector<model::broker_shard> shards;
+    // partitions of different topics may have different weights
     for (auto const& t_md : metadata) {
+        std::vector<model::broker_shard> shards;
         for (auto& p_md : t_md.partitions) {
             std::move(
               p_md.replicas.begin(),
               p_md.replicas.end(),
               std::back_inserter(shards));
         }
+        update_allocation_state(
+          std::move(shards), gid, partition_weight(t_md.tp_ns.tp));
     }
-    update_allocation_state(shards, gid);
 }
 
 void partition_allocator::update_allocation_state(
-  std::vector<model::broker_shard> shards, raft::group_id group_id) {
+  std::vector<model::broker_shard> shards,
+  raft::group_id group_id,
+  double weight) {
     if (shards.empty()) {
         return;
     }
@@ -195,7 +240,7 @@ void partition_allocator::update_allocation_state(
             it = find_node(bs.node_id);
         }
         if (it != _machines.end()) {
-            it->second->allocate(bs.shard);
+            it->second->allocate(bs.shard, weight);
         }
     }
 }
@@ -205,12 +250,105 @@ partition_allocator::find_node(model::node_id id) {
     return _machines.find(id);
 }
 
+double partition_allocator::partition_weight(const model::topic& topic) {
+    // entries are in the `<topic>:<weight>` format
+    const auto& weights
+      = config::shard_local_cfg().partition_allocation_weights();
+    for (const auto& e : weights) {
+        auto pos = e.rfind(':');
+        if (pos == ss::sstring::npos || e.substr(0, pos) != topic()) {
+            continue;
+        }
+        auto value = e.substr(pos + 1);
+        char* end = nullptr;
+        auto weight = std::strtod(value.c_str(), &end);
+        if (end == value.c_str() || *end != '\0' || !(weight > 0)) {
+            vlog(clusterlog.warn, "Invalid partition allocation weight: {}", e);
+            continue;
+        }
+        return weight;
+    }
+    return 1;
+}
+
+void partition_allocator::update_node_load(
+  model::node_id id, std::vector<allocation_node::observed_load> load) {
+    auto it = find_node(id);
+    if (it == _machines.end()) {
+        return;
+    }
+    auto& machine = *it->second;
+    if (load.size() != machine.cpus()) {
+        vlog(
+          clusterlog.warn,
+          "Ignoring load of node {} reported for {} cores, expected {}",
+          id,
+          load.size(),
+          machine.cpus());
+        return;
+    }
+    machine._reported_load = std::move(load);
+    update_observed_load();
+}
+
+void partition_allocator::clear_node_load(model::node_id id) {
+    auto it = find_node(id);
+    if (it == _machines.end() || it->second->_reported_load.empty()) {
+        return;
+    }
+    it->second->_reported_load.clear();
+    it->second->_observed_load.clear();
+    it->second->update_coldest_core();
+    update_observed_load();
+}
+
+void partition_allocator::update_observed_load() {
+    // observed loads are expressed in units of partition weight, the unit is
+    // the average load per weight across all the nodes that reported
+    double weight = 0;
+    double throughput = 0;
+    double disk = 0;
+    for (auto& [id, m] : _machines) {
+        if (m->_reported_load.empty()) {
+            continue;
+        }
+        for (uint32_t c = 0; c < m->cpus(); ++c) {
+            weight += m->_hinted_load[c];
+            throughput += m->_reported_load[c].throughput;
+            disk += m->_reported_load[c].disk_bytes;
+        }
+    }
+    const auto throughput_unit = weight > 0 ? throughput / weight : 0;
+    const auto disk_unit = weight > 0 ? disk / weight : 0;
+
+    for (auto& [id, m] : _machines) {
+        if (m->_reported_load.empty()) {
+            continue;
+        }
+        m->_observed_load.resize(m->cpus());
+        for (uint32_t c = 0; c < m->cpus(); ++c) {
+            // a core is as hot as its hottest resource
+            const auto& r = m->_reported_load[c];
+            double l = 0;
+            if (throughput_unit > 0) {
+                l = std::max(l, r.throughput / throughput_unit);
+            }
+            if (disk_unit > 0) {
+                l = std::max(l, r.disk_bytes / disk_unit);
+            }
+            m->_observed_load[c] = l;
+        }
+        m->update_coldest_core();
+    }
+}
+
 void partition_allocator::test_only_saturate_all_machines() {
     for (auto& [id, m] : _machines) {
         m->_partition_capacity = 0;
         for (auto& w : m->_weights) {
             w = allocation_node::max_allocations_per_core;
         }
+        m->update_coldest_core();
     }
     _available_machines.clear();
 }
@@ -231,8 +369,8 @@ std::ostream& operator<<(std::ostream& o, const allocation_node& n) {
     o << "{ node:" << n._id << ", max_partitions_per_core: "
       << allocation_node::max_allocations_per_core
       << ", partition_capacity:" << n._partition_capacity << ", weights: [";
-    for (auto w : n._weights) {
-        o << "(" << w << ")";
+    for (uint32_t c = 0; c < n.cpus(); ++c) {
+        o << "(" << n._weights[c] << ", load: " << n.load(c) << ")";
     }
     return o << "]}";
 }
@@ -18,6 +18,8 @@
 
 #include <boost/container/flat_map.hpp>
 
+#include <algorithm>
+#include <optional>
 #include <vector>
 
 namespace cluster {
@@ -29,22 +31,36 @@ public:
     // TODO make configurable
     static constexpr const uint32_t max_allocations_per_core = 7000;
 
+    /// load of a single core as reported by the node
+    struct observed_load {
+        // records produced and fetched per second
+        double throughput{0};
+        uint64_t disk_bytes{0};
+    };
+
     allocation_node(
       model::node_id id,
       uint32_t cpus,
       std::unordered_map<ss::sstring, ss::sstring> labels)
       : _id(id)
       , _weights(cpus)
+      , _hinted_load(cpus)
       , _machine_labels(std::move(labels)) {
         // add extra weights to core 0
         _weights[0] = core0_extra_weight;
+        _hinted_load[0] = core0_extra_weight;
         _partition_capacity = (cpus * max_allocations_per_core)
                               - core0_extra_weight;
+        update_coldest_core();
     }
 
     allocation_node(allocation_node&& o) noexcept
       : _id(o._id)
       , _weights(std::move(o._weights))
+      , _hinted_load(std::move(o._hinted_load))
+      , _reported_load(std::move(o._reported_load))
+      , _observed_load(std::move(o._observed_load))
+      , _coldest(o._coldest)
       , _partition_capacity(o._partition_capacity)
       , _machine_labels(std::move(o._machine_labels)) {
         _hook.swap_nodes(o._hook);
@@ -58,6 +74,17 @@ public:
     model::node_id id() const { return _id; }
     uint32_t partition_capacity() const { return _partition_capacity; }
 
+    /// estimated load of a core in units of partition weight, the larger of
+    /// the sum of weight hints of the partitions allocated to the core and
+    /// of its observed load
+    double load(uint32_t core) const {
+        auto l = _hinted_load[core];
+        if (!_observed_load.empty()) {
+            l = std::max(l, _observed_load[core]);
+        }
+        return l;
+    }
+
 private:
     friend partition_allocator;
 
@@ -69,13 +96,29 @@ private:
         }
         return true;
     }
-    uint32_t allocate() {
-        auto it = std::min_element(_weights.begin(), _weights.end());
-        (*it)++; // increment the weights
-        _partition_capacity--;
-        return std::distance(_weights.begin(), it);
+    /// least loaded core that still has room for a partition
+    std::optional<uint32_t> coldest_core() const { return _coldest; }
+    void update_coldest_core() {
+        std::optional<uint32_t> ret;
+        for (uint32_t c = 0; c < _weights.size(); ++c) {
+            if (_weights[c] >= max_allocations_per_core) {
+                continue;
+            }
+            if (
+              !ret || load(c) < load(*ret)
+              || (load(c) == load(*ret) && _weights[c] < _weights[*ret])) {
+                ret = c;
+            }
+        }
+        _coldest = ret;
+    }
+    uint32_t allocate(double weight) {
+        auto core = coldest_core();
+        vassert(core, "Tried to allocate on a full node - {}", *this);
+        allocate(*core, weight);
+        return *core;
     }
-    void deallocate(uint32_t core) {
+    void deallocate(uint32_t core, double weight) {
         vassert(
           core < _weights.size(),
           "Tried to deallocate a non-existing core:{} - {}",
@@ -83,15 +126,20 @@ private:
           *this);
         _partition_capacity++;
         _weights[core]--;
+        // weight hints may have changed since the partition was allocated
+        _hinted_load[core] = std::max(0.0, _hinted_load[core] - weight);
+        update_coldest_core();
     }
-    void allocate(uint32_t core) {
+    void allocate(uint32_t core, double weight) {
         vassert(
           core < _weights.size(),
           "Tried to allocate a non-existing core:{} - {}",
           core,
           *this);
         _weights[core]++;
+        _hinted_load[core] += weight;
         _partition_capacity--;
+        update_coldest_core();
     }
     const std::unordered_map<ss::sstring, ss::sstring>& machine_labels() const {
         return _machine_labels;
@@ -100,6 +148,13 @@ private:
     model::node_id _id;
     /// each index is a CPU. A weight is roughly the number of assigments
     std::vector<uint32_t> _weights;
+    /// sum of the weight hints of the partitions allocated to each CPU
+    std::vector<double> _hinted_load;
+    /// last load reported by the node, empty if it never reported
+    std::vector<observed_load> _reported_load;
+    /// reported load converted to units of partition weight
+    std::vector<double> _observed_load;
+    std::optional<uint32_t> _coldest;
     uint32_t _partition_capacity{0};
     /// generated by `rpk` usually in /etc/redpanda/machine_labels.json
     std::unordered_map<ss::sstring, ss::sstring> _machine_labels;
@@ -116,9 +171,11 @@ public:
     struct allocation_units {
         allocation_units(
           std::vector<partition_assignment> assignments,
-          partition_allocator* pal)
+          partition_allocator* pal,
+          double weight = 1)
           : _assignments(std::move(assignments))
-          , _allocator(pal) {}
+          , _allocator(pal)
+          , _weight(weight) {}
 
         allocation_units& operator=(allocation_units&&) = default;
         allocation_units& operator=(const allocation_units&) = delete;
@@ -128,7 +185,7 @@ public:
         ~allocation_units() {
             for (auto& pas : _assignments) {
                 for (auto& replica : pas.replicas) {
-                    _allocator->deallocate(replica);
+                    _allocator->deallocate(replica, _weight);
                 }
             }
         }
@@ -141,6 +198,7 @@ public:
         std::vector<partition_assignment> _assignments;
         // keep the pointer to make this type movable
         partition_allocator* _allocator;
+        double _weight;
     };
 
     static constexpr ss::shard_id shard = 0;
@@ -170,18 +228,44 @@ public:
     /// how to use a nullopt value
     std::optional<allocation_units> allocate(const topic_configuration&);
 
+    /// allocates partitions of many topics in a single pass, returns an
+    /// allocation for every topic in the order of the request. Topics that
+    /// can not be placed do not prevent the following ones from being
+    /// allocated.
+    std::vector<std::optional<allocation_units>>
+    allocate(const std::vector<topic_configuration>&);
+
     /// best effort. Does not throw if we cannot find the old partition
-    void deallocate(const model::broker_shard&);
+    void deallocate(const model::broker_shard&, double weight = 1);
 
     /// updates the state of allocation, it is used during recovery and
     /// when processing raft0 committed notifications
     void update_allocation_state(
       std::vector<model::topic_metadata>, raft::group_id);
-    void
-      update_allocation_state(std::vector<model::broker_shard>, raft::group_id);
+    void update_allocation_state(
+      std::vector<model::broker_shard>, raft::group_id, double weight = 1);
+
+    /// load weight of a single partition of the topic, configured with
+    /// `partition_allocation_weights`. Defaults to 1
+    static double partition_weight(const model::topic&);
+
+    /// updates the per core load observed on the node. Observed loads are
+    /// converted to units of partition weight using the average load per
+    /// unit of weight across all the nodes that reported
+    void update_node_load(
+      model::node_id, std::vector<allocation_node::observed_load>);
+    /// drops the observed load of the node, i.e. when it stopped reporting
+    void clear_node_load(model::node_id);
 
     const underlying_t& allocation_nodes() { return _machines; }
 
+    /// highest raft group id ever assigned, group ids of deleted partitions
+    /// are never reused
+    raft::group_id highest_group() const { return _highest_group; }
+    void update_highest_group(raft::group_id id) {
+        _highest_group = std::max(_highest_group, id);
+    }
+
     ~partition_allocator() {
         _available_machines.clear();
         _rr = _available_machines.end();
@@ -192,12 +276,13 @@ private:
     /// rolls back partition assignment, only decrementing
     /// raft-group by distinct raft-group counts
     /// assumes sorted in raft-group order
-    void rollback(const std::vector<partition_assignment>& pa);
-    void rollback(const std::vector<model::broker_shard>& v);
+    void rollback(const std::vector<partition_assignment>& pa, double weight);
+    void rollback(const std::vector<model::broker_shard>& v, double weight);
 
     std::optional<std::vector<model::broker_shard>>
-    allocate_replicas(int16_t replication_factor);
+    allocate_replicas(int16_t replication_factor, double weight);
     iterator find_node(model::node_id id);
+    void update_observed_load();
 
     [[gnu::always_inline]] inline cil_t::iterator& round_robin_ptr() {
         if (_rr == _available_machines.end()) {
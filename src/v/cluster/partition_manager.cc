@@ -111,6 +111,16 @@ ss::future<> partition_manager::shutdown(const model::ntp& ntp) {
       .finally([partition] {}); // in the end remove partition
 }
 
+shard_load partition_manager::get_shard_load() const {
+    shard_load ret;
+    for (const auto& [_, p] : _ntp_table) {
+        ret.records += p->probe().records_produced()
+                       + p->probe().records_fetched();
+        ret.disk_bytes += p->size_bytes();
+    }
+    return ret;
+}
+
 std::ostream& operator<<(std::ostream& o, const partition_manager& pm) {
     return o << "{shard:" << ss::this_shard_id() << ", mngr:{}"
              << pm._storage.log_mgr()
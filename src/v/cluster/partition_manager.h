@@ -13,6 +13,7 @@
 
 #include "cluster/ntp_callbacks.h"
 #include "cluster/partition.h"
+#include "cluster/types.h"
 #include "model/metadata.h"
 #include "raft/consensus_client_protocol.h"
 #include "raft/group_manager.h"
@@ -110,6 +111,9 @@ public:
      */
     const ntp_table_container& partitions() const { return _ntp_table; }
 
+    /// cumulative load of all the partitions hosted on this core
+    shard_load get_shard_load() const;
+
 private:
     storage::api& _storage;
     /// used to wait for concurrent recoveries
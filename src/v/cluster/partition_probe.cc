@@ -97,6 +97,22 @@ void partition_probe::setup_metrics(const model::ntp& ntp) {
           [this] { return _records_fetched; },
           sm::description("Total number of records fetched"),
           labels),
+        sm::make_gauge(
+          "idempotent_producers",
+          [this] {
+              return _partition._rm_stm ? _partition._rm_stm->producers() : 0;
+          },
+          sm::description("Number of idempotent producers tracked"),
+          labels),
+        sm::make_gauge(
+          "idempotent_producers_memory_bytes",
+          [this] {
+              return _partition._rm_stm
+                       ? _partition._rm_stm->producers_memory_usage()
+                       : 0;
+          },
+          sm::description("Memory used to track idempotent producers"),
+          labels),
       });
 }
 } // namespace cluster
@@ -35,6 +35,9 @@ public:
         _records_fetched += num_records;
     }
 
+    uint64_t records_produced() const { return _records_produced; }
+    uint64_t records_fetched() const { return _records_fetched; }
+
 private:
     partition& _partition;
     uint64_t _records_produced = 0;
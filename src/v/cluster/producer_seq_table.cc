@@ -0,0 +1,104 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/producer_seq_table.h"
+
+#include "utils/vint.h"
+
+#include <algorithm>
+#include <array>
+
+namespace cluster {
+
+const seq_entry*
+producer_seq_table::find(model::producer_identity pid) const {
+    auto it = _entries.find(pid);
+    if (it == _entries.end()) {
+        return nullptr;
+    }
+    return &it->second.entry;
+}
+
+void producer_seq_table::write(
+  model::producer_identity pid, int32_t seq, model::timestamp::type ts) {
+    auto [it, inserted] = _entries.try_emplace(pid);
+    auto& n = it->second;
+    if (!inserted) {
+        n.hook.unlink();
+    }
+    n.entry = seq_entry{
+      .pid = pid,
+      .seq = seq,
+      .last_write_timestamp = std::min(ts, model::timestamp::now().value()),
+    };
+    _lru.push_back(n);
+}
+
+size_t producer_seq_table::evict_before(model::timestamp::type cutoff) {
+    size_t evicted = 0;
+    while (!_lru.empty()
+           && _lru.front().entry.last_write_timestamp < cutoff) {
+        // erasing the node unlinks it
+        _entries.erase(_lru.front().entry.pid);
+        ++evicted;
+    }
+    return evicted;
+}
+
+void producer_seq_table::clear() {
+    _lru.clear();
+    _entries.clear();
+}
+
+size_t producer_seq_table::memory_usage() const {
+    // a pointer and a control byte per slot, a heap allocated node per entry
+    return _entries.capacity() * (sizeof(void*) + 1)
+           + _entries.size()
+               * sizeof(decltype(_entries)::value_type);
+}
+
+void producer_seq_table::encode(iobuf& out) const {
+    std::array<uint8_t, vint::max_length> buf;
+    auto put = [&out, &buf](int64_t v) {
+        auto n = vint::serialize(v, buf.data());
+        out.append(buf.data(), n);
+    };
+
+    put(static_cast<int64_t>(_entries.size()));
+    model::timestamp::type prev = 0;
+    for (const auto& n : _lru) {
+        const auto& e = n.entry;
+        put(e.pid.id);
+        put(e.pid.epoch);
+        put(e.seq);
+        put(e.last_write_timestamp - prev);
+        prev = e.last_write_timestamp;
+    }
+}
+
+void producer_seq_table::decode(iobuf_parser& in) {
+    auto count = in.read_varlong().first;
+    model::timestamp::type prev = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        model::producer_identity pid{
+          .id = in.read_varlong().first,
+          .epoch = static_cast<int16_t>(in.read_varlong().first),
+        };
+        auto seq = static_cast<int32_t>(in.read_varlong().first);
+        auto ts = prev + in.read_varlong().first;
+        prev = ts;
+
+        auto current = find(pid);
+        if (!current || current->seq < seq) {
+            write(pid, seq, ts);
+        }
+    }
+}
+
+} // namespace cluster
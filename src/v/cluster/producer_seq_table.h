@@ -0,0 +1,102 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "model/record.h"
+#include "model/timestamp.h"
+#include "utils/intrusive_list_helpers.h"
+
+#include <absl/container/node_hash_map.h>
+
+#include <cstdint>
+
+namespace cluster {
+
+struct seq_entry {
+    model::producer_identity pid;
+    int32_t seq;
+    model::timestamp::type last_write_timestamp;
+};
+
+/**
+ * Last sequence number of every idempotent producer of a partition.
+ *
+ * Next to the hash map used for lookups the producers are linked in the
+ * order of their last write, so expiring the producers which have not
+ * written for a while pops them from the front of the list: O(1) per expired
+ * producer instead of a scan of the whole table. The list follows the order
+ * of the writes rather than of their timestamps, which come from the
+ * producers and are not monotonic; expiry stops at the first producer whose
+ * last write is recent enough. Timestamps ahead of the local clock are
+ * clamped to it, otherwise a producer with a clock in the future would hold
+ * back the expiry of every producer written after it.
+ *
+ * The table is encoded in the same order with variable length integers and
+ * delta encoded timestamps. Large tables are mostly made of idle producers
+ * with small ids, epochs and sequence numbers, which takes about half the
+ * space of fixed width entries.
+ */
+class producer_seq_table {
+public:
+    producer_seq_table() = default;
+    producer_seq_table(const producer_seq_table&) = delete;
+    producer_seq_table& operator=(const producer_seq_table&) = delete;
+    producer_seq_table(producer_seq_table&&) = delete;
+    producer_seq_table& operator=(producer_seq_table&&) = delete;
+    ~producer_seq_table() = default;
+
+    /// entry of the producer or nullptr if the producer is not in the table
+    const seq_entry* find(model::producer_identity) const;
+
+    /// records a write of the producer up to `seq`, inserting the producer
+    /// if needed, and makes it the most recently written one. the timestamp
+    /// is clamped to the local clock
+    void write(model::producer_identity, int32_t seq, model::timestamp::type);
+
+    /// removes the producers, least recently written first, until one whose
+    /// last write is at or after `cutoff`. returns the number removed
+    size_t evict_before(model::timestamp::type cutoff);
+
+    /// appends the entries in the order of their last write
+    void encode(iobuf&) const;
+
+    /// writes the encoded entries, keeping the higher sequence number of the
+    /// producers already in the table
+    void decode(iobuf_parser&);
+
+    void clear();
+
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+    size_t memory_usage() const;
+
+    template<typename Func>
+    void for_each(Func&& f) const {
+        for (const auto& n : _lru) {
+            f(n.entry);
+        }
+    }
+
+private:
+    struct node {
+        seq_entry entry;
+        intrusive_list_hook hook;
+    };
+
+    absl::node_hash_map<model::producer_identity, node> _entries;
+    // least recently written first, nodes unlink themselves when erased
+    intrusive_list<node, &node::hook> _lru;
+};
+
+} // namespace cluster
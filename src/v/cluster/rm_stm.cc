@@ -22,6 +22,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
 
+#include <algorithm>
 #include <filesystem>
 #include <optional>
 
@@ -147,7 +148,6 @@ static inline rm_stm::producer_epoch epoch(model::producer_identity pid) {
 
 rm_stm::rm_stm(ss::logger& logger, raft::consensus* c)
   : persisted_stm("rm", logger, c)
-  , _oldest_session(model::timestamp::now())
   , _sync_timeout(config::shard_local_cfg().rm_sync_timeout_ms.value())
   , _recovery_policy(
       config::shard_local_cfg().rm_violation_recovery_policy.value())
@@ -492,28 +492,15 @@ rm_stm::replicate(
 
 bool rm_stm::check_seq(model::batch_identity bid) {
     auto pid_seq = _log_state.seq_table.find(bid.pid);
-    auto last_write_timestamp = model::timestamp::now().value();
-    if (pid_seq == _log_state.seq_table.end()) {
+    if (pid_seq == nullptr) {
         if (bid.first_seq != 0) {
             return false;
         }
-        seq_entry entry{
-          .pid = bid.pid,
-          .seq = bid.last_seq,
-          .last_write_timestamp = last_write_timestamp};
-        _oldest_session = std::min(
-          _oldest_session, model::timestamp(entry.last_write_timestamp));
-        _log_state.seq_table.emplace(entry.pid, entry);
-    } else {
-        if (!is_sequence(pid_seq->second.seq, bid.first_seq)) {
-            return false;
-        }
-        pid_seq->second.seq = bid.last_seq;
-        pid_seq->second.last_write_timestamp = last_write_timestamp;
-        _oldest_session = std::min(
-          _oldest_session,
-          model::timestamp(pid_seq->second.last_write_timestamp));
+    } else if (!is_sequence(pid_seq->seq, bid.first_seq)) {
+        return false;
     }
+    _log_state.seq_table.write(
+      bid.pid, bid.last_seq, model::timestamp::now().value());
     return true;
 }
 
@@ -654,38 +641,19 @@ model::offset rm_stm::last_stable_offset() {
 
 ss::future<std::vector<rm_stm::tx_range>>
 rm_stm::aborted_transactions(model::offset from, model::offset to) {
-    std::vector<rm_stm::tx_range> result;
-    for (auto& range : _log_state.aborted) {
-        if (range.second.last < from) {
-            continue;
-        }
-        if (range.second.first > to) {
-            continue;
-        }
-        result.push_back(range.second);
-    }
-    co_return result;
+    co_return _log_state.aborted_index.find(from, to);
+}
+
+void rm_stm::evict_aborted_transactions() {
+    // only the index is evicted, _log_state.aborted fences off the late
+    // writes, prepares and commits of the aborted sessions
+    _log_state.aborted_index.evict_before(_c->start_offset());
 }
 
 void rm_stm::compact_snapshot() {
     auto cutoff_timestamp = model::timestamp::now().value()
                             - _transactional_id_expiration.count();
-    if (cutoff_timestamp <= _oldest_session.value()) {
-        return;
-    }
-    auto next_oldest_session = model::timestamp::now();
-    for (auto it = _log_state.seq_table.cbegin();
-         it != _log_state.seq_table.cend();) {
-        if (it->second.last_write_timestamp < cutoff_timestamp) {
-            _log_state.seq_table.erase(it++);
-        } else {
-            next_oldest_session = std::min(
-              next_oldest_session,
-              model::timestamp(it->second.last_write_timestamp));
-            ++it;
-        }
-    }
-    _oldest_session = next_oldest_session;
+    _log_state.seq_table.evict_before(cutoff_timestamp);
 }
 
 ss::future<> rm_stm::apply(model::record_batch b) {
@@ -704,13 +672,14 @@ ss::future<> rm_stm::apply(model::record_batch b) {
         apply_prepare(parse_prepare_batch(b));
     } else if (hdr.type == raft::data_batch_type) {
         if (hdr.attrs.is_control()) {
-            apply_control(bid.pid, parse_control_batch(b));
+            apply_control(bid.pid, parse_control_batch(b), last_offset);
         } else {
             apply_data(bid, last_offset);
         }
     }
 
     compact_snapshot();
+    evict_aborted_transactions();
     _insync_offset = last_offset;
     return ss::now();
 }
@@ -790,7 +759,9 @@ void rm_stm::apply_prepare(rm_stm::prepare_marker prepare) {
 }
 
 void rm_stm::apply_control(
-  model::producer_identity pid, model::control_record_type crt) {
+  model::producer_identity pid,
+  model::control_record_type crt,
+  model::offset marker) {
     auto fence_it = _log_state.fence_pid_epoch.find(id(pid));
     if (fence_it == _log_state.fence_pid_epoch.end()) {
         _log_state.fence_pid_epoch.emplace(id(pid), epoch(pid));
@@ -814,6 +785,8 @@ void rm_stm::apply_control(
         auto offset_it = _log_state.ongoing_map.find(pid);
         if (offset_it != _log_state.ongoing_map.end()) {
             _log_state.aborted.emplace(pid, offset_it->second);
+            _log_state.aborted_index.add(
+              offset_it->second, marker, *_log_state.ongoing_set.begin());
             _log_state.ongoing_set.erase(offset_it->second.first);
             _log_state.ongoing_map.erase(pid);
         }
@@ -874,18 +847,9 @@ void rm_stm::apply_control(
 void rm_stm::apply_data(model::batch_identity bid, model::offset last_offset) {
     if (bid.has_idempotent()) {
         auto pid_seq = _log_state.seq_table.find(bid.pid);
-        if (pid_seq == _log_state.seq_table.end()) {
-            seq_entry entry{
-              .pid = bid.pid,
-              .seq = bid.last_seq,
-              .last_write_timestamp = bid.max_timestamp.value()};
-            _log_state.seq_table.emplace(bid.pid, entry);
-            _oldest_session = std::min(
-              _oldest_session, model::timestamp(entry.last_write_timestamp));
-        } else if (pid_seq->second.seq < bid.last_seq) {
-            pid_seq->second.seq = bid.last_seq;
-            pid_seq->second.last_write_timestamp = bid.max_timestamp.value();
-            _oldest_session = std::min(_oldest_session, bid.max_timestamp);
+        if (pid_seq == nullptr || pid_seq->seq < bid.last_seq) {
+            _log_state.seq_table.write(
+              bid.pid, bid.last_seq, bid.max_timestamp.value());
         }
     }
 
@@ -938,13 +902,42 @@ void rm_stm::apply_data(model::batch_identity bid, model::offset last_offset) {
     }
 }
 
+// producers of v0 snapshots are in no particular order, they are encoded in
+// the order of their last write
+static rm_stm::tx_snapshot upgrade_snapshot(rm_stm::tx_snapshot_v0 v0) {
+    std::sort(
+      v0.seqs.begin(),
+      v0.seqs.end(),
+      [](const rm_stm::seq_entry& a, const rm_stm::seq_entry& b) {
+          return a.last_write_timestamp < b.last_write_timestamp;
+      });
+    producer_seq_table seqs;
+    for (const auto& e : v0.seqs) {
+        seqs.write(e.pid, e.seq, e.last_write_timestamp);
+    }
+
+    rm_stm::tx_snapshot ret{
+      .fenced = std::move(v0.fenced),
+      .ongoing = std::move(v0.ongoing),
+      .prepared = std::move(v0.prepared),
+      .aborted = std::move(v0.aborted),
+      .offset = v0.offset,
+    };
+    seqs.encode(ret.seqs);
+    return ret;
+}
+
 void rm_stm::load_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
     vassert(
-      hdr.version == tx_snapshot_version,
+      hdr.version == tx_snapshot_version
+        || hdr.version == tx_snapshot_v0_version,
       "unsupported seq_snapshot_header version {}",
       hdr.version);
     iobuf_parser data_parser(std::move(tx_ss_buf));
-    auto data = reflection::adl<tx_snapshot>{}.from(data_parser);
+    auto data = hdr.version == tx_snapshot_v0_version
+                  ? upgrade_snapshot(
+                    reflection::adl<tx_snapshot_v0>{}.from(data_parser))
+                  : reflection::adl<tx_snapshot>{}.from(data_parser);
 
     for (auto& entry : data.fenced) {
         _log_state.fence_pid_epoch.emplace(id(entry), epoch(entry));
@@ -959,12 +952,14 @@ void rm_stm::load_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
     for (auto& entry : data.aborted) {
         _log_state.aborted.emplace(entry.pid, entry);
     }
-    for (auto& entry : data.seqs) {
-        auto [seq_it, _] = _log_state.seq_table.try_emplace(entry.pid, entry);
-        if (seq_it->second.seq < entry.seq) {
-            seq_it->second = entry;
-        }
+    std::optional<model::offset> ongoing_start;
+    if (!_log_state.ongoing_set.empty()) {
+        ongoing_start = *_log_state.ongoing_set.begin();
     }
+    _log_state.aborted_index.reset(std::move(data.aborted), ongoing_start);
+    evict_aborted_transactions();
+    iobuf_parser seqs(std::move(data.seqs));
+    _log_state.seq_table.decode(seqs);
 
     _last_snapshot_offset = data.offset;
     _insync_offset = data.offset;
@@ -986,9 +981,7 @@ stm_snapshot rm_stm::take_snapshot() {
     for (auto& entry : _log_state.aborted) {
         tx_ss.aborted.push_back(entry.second);
     }
-    for (auto& entry : _log_state.seq_table) {
-        tx_ss.seqs.push_back(entry.second);
-    }
+    _log_state.seq_table.encode(tx_ss.seqs);
     tx_ss.offset = _insync_offset;
 
     iobuf tx_ss_buf;
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include "cluster/aborted_tx_index.h"
 #include "cluster/persisted_stm.h"
+#include "cluster/producer_seq_table.h"
 #include "cluster/types.h"
 #include "config/configuration.h"
 #include "kafka/protocol/errors.h"
@@ -44,15 +46,13 @@ namespace cluster {
  */
 class rm_stm final : public persisted_stm {
 public:
-    static constexpr const int8_t tx_snapshot_version = 0;
+    static constexpr const int8_t tx_snapshot_version = 1;
+    static constexpr const int8_t tx_snapshot_v0_version = 0;
     using producer_id = named_type<int64_t, struct producer_identity_id>;
     using producer_epoch = named_type<int16_t, struct producer_identity_epoch>;
 
-    struct tx_range {
-        model::producer_identity pid;
-        model::offset first;
-        model::offset last;
-    };
+    using tx_range = cluster::tx_range;
+    using seq_entry = cluster::seq_entry;
 
     struct prepare_marker {
         // partition of the transaction manager
@@ -63,10 +63,14 @@ public:
         model::producer_identity pid;
     };
 
-    struct seq_entry {
-        model::producer_identity pid;
-        int32_t seq;
-        model::timestamp::type last_write_timestamp;
+    // fixed width producer entries
+    struct tx_snapshot_v0 {
+        std::vector<model::producer_identity> fenced;
+        std::vector<tx_range> ongoing;
+        std::vector<prepare_marker> prepared;
+        std::vector<tx_range> aborted;
+        model::offset offset;
+        std::vector<seq_entry> seqs;
     };
 
     struct tx_snapshot {
@@ -75,7 +79,8 @@ public:
         std::vector<prepare_marker> prepared;
         std::vector<tx_range> aborted;
         model::offset offset;
-        std::vector<seq_entry> seqs;
+        // producer_seq_table::encode
+        iobuf seqs;
     };
 
     static constexpr model::control_record_version
@@ -107,6 +112,13 @@ public:
       model::record_batch_reader,
       raft::replicate_options);
 
+    /// idempotent producers tracked by the partition and an estimate of the
+    /// memory used to track them
+    size_t producers() const { return _log_state.seq_table.size(); }
+    size_t producers_memory_usage() const {
+        return _log_state.seq_table.memory_usage();
+    }
+
 private:
     void load_snapshot(stm_snapshot_header, iobuf&&) override;
     stm_snapshot take_snapshot() override;
@@ -126,7 +138,9 @@ private:
 
     ss::future<> apply(model::record_batch) override;
     void apply_prepare(rm_stm::prepare_marker);
-    void apply_control(model::producer_identity, model::control_record_type);
+    void apply_control(
+      model::producer_identity, model::control_record_type, model::offset);
+    void evict_aborted_transactions();
     void apply_data(model::batch_identity, model::offset);
 
     // The state of this state machine maybe change via two paths
@@ -155,12 +169,17 @@ private:
         absl::btree_set<model::offset> ongoing_set;
         absl::flat_hash_map<model::producer_identity, prepare_marker> prepared;
         absl::flat_hash_map<model::producer_identity, tx_range> aborted;
+        // the same aborted transactions ordered by offset, used to serve
+        // read_committed fetches. Transactions that ended before the start
+        // of the log are evicted from the index but stay in `aborted`,
+        // which fences off the sessions, and in the snapshots.
+        aborted_tx_index aborted_index;
         // the only piece of data which we update on replay and before
         // replicating the command. we use the highest seq number to resolve
         // conflicts. if the replication fails we reject a command but clients
         // by spec should be ready for thier commands being rejected so it's
         // ok by design to have false rejects
-        absl::flat_hash_map<model::producer_identity, seq_entry> seq_table;
+        producer_seq_table seq_table;
     };
 
     struct mem_state {
@@ -201,7 +220,6 @@ private:
 
     log_state _log_state;
     mem_state _mem_state;
-    model::timestamp _oldest_session;
     std::chrono::milliseconds _sync_timeout;
     model::violation_recovery_policy _recovery_policy;
     std::chrono::milliseconds _transactional_id_expiration;
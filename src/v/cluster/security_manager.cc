@@ -13,6 +13,7 @@
 #include "cluster/commands.h"
 #include "model/metadata.h"
 #include "raft/types.h"
+#include "reflection/adl.h"
 
 #include <seastar/core/coroutine.hh>
 
@@ -142,4 +143,59 @@ ss::future<std::error_code> security_manager::dispatch_updates_to_cores(
       });
 }
 
+ss::future<iobuf> security_manager::take_snapshot(model::offset) {
+    // credentials and ACLs are replicated to all cores, the local copy is
+    // enough to build the snapshot
+    std::vector<security::credential_user> users;
+    std::vector<security::scram_credential> credentials;
+    for (const auto& [user, credential] : _credentials.local()) {
+        users.push_back(user);
+        credentials.push_back(std::get<security::scram_credential>(credential));
+    }
+    create_acls_cmd_data acls{
+      .bindings = _authorizer.local().acls(
+        security::acl_binding_filter::any())};
+
+    iobuf buf;
+    reflection::serialize(
+      buf,
+      snapshot_version,
+      std::move(users),
+      std::move(credentials),
+      std::move(acls));
+    return ss::make_ready_future<iobuf>(std::move(buf));
+}
+
+ss::future<> security_manager::apply_snapshot(
+  model::offset, model::offset, iobuf&& data) {
+    iobuf_parser parser(std::move(data));
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    vassert(
+      version == snapshot_version,
+      "Unsupported security snapshot version {}",
+      version);
+    auto users = reflection::adl<std::vector<security::credential_user>>{}.from(
+      parser);
+    auto credentials
+      = reflection::adl<std::vector<security::scram_credential>>{}.from(parser);
+    auto acls = reflection::adl<create_acls_cmd_data>{}.from(parser);
+
+    // the snapshot replaces the whole state
+    return _credentials
+      .invoke_on_all([users, credentials](security::credential_store& store) {
+          store.clear();
+          for (size_t i = 0; i < users.size(); ++i) {
+              store.put(users[i], credentials[i]);
+          }
+      })
+      .then([this, bindings = std::move(acls.bindings)] {
+          return _authorizer.invoke_on_all(
+            [bindings](security::authorizer& authorizer) {
+                authorizer.remove_bindings(
+                  {security::acl_binding_filter::any()});
+                authorizer.add_bindings(bindings);
+            });
+      });
+}
+
 } // namespace cluster
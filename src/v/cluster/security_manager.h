@@ -39,7 +39,14 @@ public:
                || batch.header().type == acl_batch_type;
     }
 
+    /// Controller snapshot support, the snapshot contains all the user
+    /// credentials and ACL bindings
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, model::offset, iobuf&&);
+
 private:
+    static constexpr int8_t snapshot_version = 0;
+
     template<typename Cmd, typename T>
     ss::future<std::error_code> dispatch_updates_to_cores(Cmd, ss::sharded<T>&);
 
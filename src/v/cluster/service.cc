@@ -11,7 +11,9 @@
 
 #include "cluster/members_manager.h"
 #include "cluster/metadata_cache.h"
+#include "cluster/partition_manager.h"
 #include "cluster/security_frontend.h"
+#include "cluster/shard_table.h"
 #include "cluster/topics_frontend.h"
 #include "cluster/types.h"
 #include "config/configuration.h"
@@ -28,12 +30,16 @@ service::service(
   ss::sharded<topics_frontend>& tf,
   ss::sharded<members_manager>& mm,
   ss::sharded<metadata_cache>& cache,
-  ss::sharded<security_frontend>& sf)
+  ss::sharded<security_frontend>& sf,
+  ss::sharded<partition_manager>& pm,
+  ss::sharded<shard_table>& st)
   : controller_service(sg, ssg)
   , _topics_frontend(tf)
   , _members_manager(mm)
   , _md_cache(cache)
-  , _security_frontend(sf) {}
+  , _security_frontend(sf)
+  , _partition_manager(pm)
+  , _shard_table(st) {}
 
 ss::future<join_reply>
 service::join(join_request&& req, rpc::streaming_context&) {
@@ -110,6 +116,27 @@ ss::future<configuration_update_reply> service::update_node_configuration(
       });
 }
 
+ss::future<move_partition_replicas_reply> service::move_partition_replicas(
+  move_partition_replicas_request&& req, rpc::streaming_context&) {
+    return ss::with_scheduling_group(
+      get_scheduling_group(), [this, req = std::move(req)]() mutable {
+          return do_move_partition_replicas(std::move(req));
+      });
+}
+
+ss::future<move_partition_replicas_reply>
+service::do_move_partition_replicas(move_partition_replicas_request&& req) {
+    auto ec = co_await _topics_frontend.local().move_partition_replicas(
+      std::move(req.ntp),
+      std::move(req.new_replica_set),
+      config::shard_local_cfg().replicate_append_timeout_ms()
+        + model::timeout_clock::now());
+
+    errc e = ec ? errc::not_leader : errc::success;
+
+    co_return move_partition_replicas_reply{.result = e};
+}
+
 ss::future<finish_partition_update_reply> service::finish_partition_update(
   finish_partition_update_request&& req, rpc::streaming_context&) {
     return ss::with_scheduling_group(
@@ -178,4 +205,50 @@ service::delete_acls(delete_acls_request&& request, rpc::streaming_context&) {
       });
 }
 
+ss::future<transfer_leadership_reply> service::transfer_leadership(
+  transfer_leadership_request&& req, rpc::streaming_context&) {
+    return ss::with_scheduling_group(
+      get_scheduling_group(), [this, req = std::move(req)]() mutable {
+          return do_transfer_leadership(std::move(req));
+      });
+}
+
+ss::future<transfer_leadership_reply>
+service::do_transfer_leadership(transfer_leadership_request&& req) {
+    auto shard = _shard_table.local().shard_for(req.ntp);
+    if (!shard) {
+        co_return transfer_leadership_reply{
+          .result = errc::partition_not_exists};
+    }
+
+    co_return co_await _partition_manager.invoke_on(
+      *shard,
+      get_smp_service_group(),
+      [req = std::move(req)](partition_manager& pm) mutable {
+          auto partition = pm.get(req.ntp);
+          if (!partition) {
+              return ss::make_ready_future<transfer_leadership_reply>(
+                transfer_leadership_reply{
+                  .result = errc::partition_not_exists});
+          }
+          return partition->transfer_leadership(req.target)
+            .then([](std::error_code ec) {
+                return transfer_leadership_reply{
+                  .result = ec ? errc::leadership_transfer_failed
+                               : errc::success};
+            });
+      });
+}
+
+ss::future<node_load_reply>
+service::get_node_load(node_load_request&&, rpc::streaming_context&) {
+    return ss::with_scheduling_group(get_scheduling_group(), [this] {
+        return _partition_manager
+          .map([](partition_manager& pm) { return pm.get_shard_load(); })
+          .then([](std::vector<shard_load> shards) {
+              return node_load_reply{.shards = std::move(shards)};
+          });
+    });
+}
+
 } // namespace cluster
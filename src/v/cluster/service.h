@@ -21,6 +21,8 @@ namespace cluster {
 class members_manager;
 class topics_frontend;
 class metadata_cache;
+class partition_manager;
+class shard_table;
 
 class service : public controller_service {
 public:
@@ -30,7 +32,9 @@ public:
       ss::sharded<topics_frontend>&,
       ss::sharded<members_manager>&,
       ss::sharded<metadata_cache>&,
-      ss::sharded<security_frontend>&);
+      ss::sharded<security_frontend>&,
+      ss::sharded<partition_manager>&,
+      ss::sharded<shard_table>&);
 
     virtual ss::future<join_reply>
     join(join_request&&, rpc::streaming_context&) override;
@@ -41,6 +45,9 @@ public:
     ss::future<configuration_update_reply> update_node_configuration(
       configuration_update_request&&, rpc::streaming_context&) final;
 
+    ss::future<move_partition_replicas_reply> move_partition_replicas(
+      move_partition_replicas_request&&, rpc::streaming_context&) final;
+
     ss::future<finish_partition_update_reply> finish_partition_update(
       finish_partition_update_request&&, rpc::streaming_context&) final;
 
@@ -53,20 +60,34 @@ public:
     ss::future<delete_acls_reply>
     delete_acls(delete_acls_request&&, rpc::streaming_context&) final;
 
+    ss::future<transfer_leadership_reply> transfer_leadership(
+      transfer_leadership_request&&, rpc::streaming_context&) final;
+
+    ss::future<node_load_reply>
+    get_node_load(node_load_request&&, rpc::streaming_context&) final;
+
 private:
     std::
       pair<std::vector<model::topic_metadata>, std::vector<topic_configuration>>
       fetch_metadata_and_cfg(const std::vector<topic_result>&);
 
+    ss::future<move_partition_replicas_reply>
+    do_move_partition_replicas(move_partition_replicas_request&&);
+
     ss::future<finish_partition_update_reply>
     do_finish_partition_update(finish_partition_update_request&&);
 
     ss::future<update_topic_properties_reply>
     do_update_topic_properties(update_topic_properties_request&&);
 
+    ss::future<transfer_leadership_reply>
+    do_transfer_leadership(transfer_leadership_request&&);
+
     ss::sharded<topics_frontend>& _topics_frontend;
     ss::sharded<members_manager>& _members_manager;
     ss::sharded<metadata_cache>& _md_cache;
     ss::sharded<security_frontend>& _security_frontend;
+    ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<shard_table>& _shard_table;
 };
 } // namespace cluster
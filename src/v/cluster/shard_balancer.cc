@@ -0,0 +1,340 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/shard_balancer.h"
+
+#include "cluster/logger.h"
+#include "cluster/partition_manager.h"
+#include "cluster/topic_table.h"
+#include "cluster/topics_frontend.h"
+#include "config/configuration.h"
+#include "model/timeout_clock.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cluster {
+
+shard_balancer::shard_balancer(
+  model::node_id self,
+  ss::sharded<topic_table>& topics,
+  ss::sharded<topics_frontend>& frontend,
+  ss::sharded<partition_manager>& pm,
+  ss::sharded<ss::abort_source>& as)
+  : _self(self)
+  , _topics(topics)
+  , _topics_frontend(frontend)
+  , _partition_manager(pm)
+  , _as(as)
+  , _moves_out(ss::smp::count, 0)
+  , _moves_in(ss::smp::count, 0) {}
+
+ss::future<> shard_balancer::start() {
+    setup_metrics();
+    _timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] { return tick(); })
+          .handle_exception([](std::exception_ptr e) {
+              vlog(clusterlog.warn, "Shard balancer tick failed: {}", e);
+          })
+          .finally([this] { arm_timer(); });
+    });
+    arm_timer();
+    return ss::now();
+}
+
+ss::future<> shard_balancer::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void shard_balancer::arm_timer() {
+    if (!_gate.is_closed() && !_as.local().abort_requested()) {
+        _timer.arm(config::shard_local_cfg().core_balancer_interval_ms());
+    }
+}
+
+ss::future<> shard_balancer::tick() {
+    const auto& cfg = config::shard_local_cfg();
+    if (!cfg.enable_core_balancer() || ss::smp::count < 2) {
+        _records.clear();
+        _skewed_intervals = 0;
+        _active = false;
+        co_return;
+    }
+
+    absl::erase_if(_in_progress, [this](const model::ntp& ntp) {
+        return !_topics.local().is_update_in_progress(ntp);
+    });
+
+    auto loads = co_await collect();
+    std::vector<double> shard_loads(ss::smp::count, 0);
+    for (const auto& l : loads) {
+        shard_loads[l.shard] += l.load;
+    }
+    _skew = skew(shard_loads);
+
+    // hysteresis, start moving partitions only when the skew is persistent
+    // and keep going until it drops well below the threshold
+    const auto threshold = static_cast<double>(
+      cfg.core_balancer_skew_threshold_percent());
+    _skewed_intervals = _skew > threshold ? _skewed_intervals + 1 : 0;
+    if (
+      !_active
+      && _skewed_intervals >= cfg.core_balancer_sustained_intervals()) {
+        vlog(clusterlog.info, "Core load skew {:.1f}%, rebalancing", _skew);
+        _active = true;
+    } else if (_active && _skew <= threshold / 2) {
+        vlog(clusterlog.info, "Core load skew {:.1f}%, balanced", _skew);
+        _active = false;
+    }
+
+    if (!_active || !_in_progress.empty()) {
+        co_return;
+    }
+
+    auto plan = make_plan(
+      loads,
+      ss::smp::count,
+      unmovable_partitions(loads),
+      threshold / 2,
+      cfg.core_balancer_max_moves());
+
+    for (const auto& m : plan) {
+        if (_as.local().abort_requested()) {
+            break;
+        }
+        co_await execute(m);
+    }
+}
+
+ss::future<std::vector<shard_balancer::partition_load>>
+shard_balancer::collect() {
+    auto samples = co_await _partition_manager.map([](partition_manager& pm) {
+        std::vector<std::pair<model::ntp, uint64_t>> ret;
+        ret.reserve(pm.partitions().size());
+        for (const auto& [ntp, p] : pm.partitions()) {
+            ret.emplace_back(
+              ntp,
+              p->probe().records_produced() + p->probe().records_fetched());
+        }
+        return ret;
+    });
+
+    auto now = ss::lowres_clock::now();
+    std::chrono::duration<double> elapsed = now - _last_sample;
+    _last_sample = now;
+
+    std::vector<partition_load> ret;
+    absl::flat_hash_map<model::ntp, uint64_t> records;
+    for (ss::shard_id shard = 0; shard < samples.size(); ++shard) {
+        for (auto& [ntp, count] : samples[shard]) {
+            double load = 0;
+            // partitions without a previous sample are new to the node
+            if (auto it = _records.find(ntp);
+                it != _records.end() && count >= it->second) {
+                load = (count - it->second) / elapsed.count();
+            }
+            records.emplace(ntp, count);
+            ret.push_back(partition_load{
+              .ntp = std::move(ntp),
+              .shard = shard,
+              .load = load,
+            });
+        }
+    }
+    _records = std::move(records);
+    co_return ret;
+}
+
+absl::flat_hash_set<model::ntp>
+shard_balancer::unmovable_partitions(const std::vector<partition_load>& loads) {
+    auto now = ss::lowres_clock::now();
+    absl::erase_if(_muted, [now](const auto& e) { return e.second <= now; });
+
+    absl::flat_hash_set<model::ntp> ret;
+    for (const auto& l : loads) {
+        // i.e. controller partition or an ongoing reassignment
+        if (
+          _muted.contains(l.ntp)
+          || !_topics.local().contains(
+            model::topic_namespace_view(l.ntp), l.ntp.tp.partition)
+          || _topics.local().is_update_in_progress(l.ntp)) {
+            ret.insert(l.ntp);
+        }
+    }
+    return ret;
+}
+
+ss::future<> shard_balancer::execute(const move& m) {
+    auto assignment = _topics.local().get_partition_assignment(m.ntp);
+    if (!assignment) {
+        co_return;
+    }
+    auto replicas = std::move(assignment->replicas);
+    auto it = std::find_if(
+      replicas.begin(), replicas.end(), [this](const model::broker_shard& bs) {
+          return bs.node_id == _self;
+      });
+    if (it == replicas.end() || it->shard != m.from) {
+        // assignment changed since the partition was sampled
+        co_return;
+    }
+    it->shard = m.to;
+
+    const auto& cfg = config::shard_local_cfg();
+    _muted[m.ntp] = ss::lowres_clock::now()
+                    + cfg.core_balancer_mute_timeout_ms();
+    vlog(
+      clusterlog.info,
+      "Moving partition {} from core {} to core {}",
+      m.ntp,
+      m.from,
+      m.to);
+
+    auto ec = co_await _topics_frontend.local().move_partition_replicas(
+      m.ntp,
+      std::move(replicas),
+      model::timeout_clock::now() + cfg.replicate_append_timeout_ms());
+    if (ec) {
+        ++_failed_moves;
+        vlog(
+          clusterlog.info,
+          "Moving partition {} from core {} to core {} failed: {}",
+          m.ntp,
+          m.from,
+          m.to,
+          ec.message());
+        co_return;
+    }
+    ++_moves_out[m.from];
+    ++_moves_in[m.to];
+    _in_progress.insert(m.ntp);
+}
+
+double shard_balancer::skew(const std::vector<double>& shard_loads) {
+    if (shard_loads.empty()) {
+        return 0;
+    }
+    double total = 0;
+    for (auto l : shard_loads) {
+        total += l;
+    }
+    const auto avg = total / shard_loads.size();
+    if (avg < min_average_load) {
+        return 0;
+    }
+    auto [min, max] = std::minmax_element(
+      shard_loads.begin(), shard_loads.end());
+    return (*max - *min) / avg * 100;
+}
+
+std::vector<shard_balancer::move> shard_balancer::make_plan(
+  const std::vector<partition_load>& loads,
+  size_t shards,
+  const absl::flat_hash_set<model::ntp>& muted,
+  double threshold,
+  size_t max_moves) {
+    std::vector<double> shard_loads(shards, 0);
+    std::vector<std::vector<size_t>> hosted(shards);
+    for (size_t i = 0; i < loads.size(); ++i) {
+        shard_loads[loads[i].shard] += loads[i].load;
+        hosted[loads[i].shard].push_back(i);
+    }
+
+    std::vector<move> ret;
+    std::vector<bool> moved(loads.size(), false);
+    while (ret.size() < max_moves && skew(shard_loads) > threshold) {
+        auto [min, max] = std::minmax_element(
+          shard_loads.begin(), shard_loads.end());
+        const auto cold = std::distance(shard_loads.begin(), min);
+        const auto hot = std::distance(shard_loads.begin(), max);
+        const auto diff = *max - *min;
+
+        // moving a partition lighter than the difference lowers the busiest
+        // core, the best candidate leaves both cores at the same load
+        std::optional<size_t> best;
+        size_t best_pos = 0;
+        double best_distance = 0;
+        auto& from = hosted[hot];
+        for (size_t pos = 0; pos < from.size(); ++pos) {
+            const auto& p = loads[from[pos]];
+            if (
+              moved[from[pos]] || muted.contains(p.ntp) || p.load <= 0
+              || p.load >= diff) {
+                continue;
+            }
+            auto distance = std::abs(p.load - diff / 2);
+            if (!best || distance < best_distance) {
+                best = from[pos];
+                best_pos = pos;
+                best_distance = distance;
+            }
+        }
+        if (!best) {
+            break;
+        }
+
+        const auto& p = loads[*best];
+        shard_loads[hot] -= p.load;
+        shard_loads[cold] += p.load;
+        from.erase(from.begin() + best_pos);
+        hosted[cold].push_back(*best);
+        moved[*best] = true;
+        ret.push_back(move{
+          .ntp = p.ntp,
+          .from = static_cast<ss::shard_id>(hot),
+          .to = static_cast<ss::shard_id>(cold),
+        });
+    }
+    return ret;
+}
+
+void shard_balancer::setup_metrics() {
+    namespace sm = ss::metrics;
+
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    std::vector<sm::metric_definition> defs{
+      sm::make_gauge(
+        "skew",
+        [this] { return _skew; },
+        sm::description(
+          "Difference between the busiest and idlest core relative to the "
+          "average core load, in percent")),
+      sm::make_derive(
+        "failed_moves",
+        [this] { return _failed_moves; },
+        sm::description("Number of partition moves that failed to start")),
+    };
+    auto shard_label = sm::label("core");
+    for (ss::shard_id s = 0; s < ss::smp::count; ++s) {
+        defs.push_back(sm::make_derive(
+          "moves_out",
+          [this, s] { return _moves_out[s]; },
+          sm::description("Number of partitions moved away from the core"),
+          {shard_label(s)}));
+        defs.push_back(sm::make_derive(
+          "moves_in",
+          [this, s] { return _moves_in[s]; },
+          sm::description("Number of partitions moved to the core"),
+          {shard_label(s)}));
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:core_balancer"), defs);
+}
+
+} // namespace cluster
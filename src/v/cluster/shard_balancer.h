@@ -0,0 +1,137 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "cluster/fwd.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "seastarx.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Shard balancer.
+ *
+ * Partitions are assigned to cores when they are created and stay there,
+ * so a few busy partitions landing on the same core saturate it while the
+ * other cores of the node are idle.
+ *
+ * The balancer runs on every node and periodically samples the throughput
+ * (records produced and fetched per second) of the local partitions. When
+ * the spread between the busiest and the idlest core, relative to the
+ * average core, stays above `core_balancer_skew_threshold_percent` for
+ * `core_balancer_sustained_intervals` consecutive samples, it moves
+ * partitions from the busiest to the idlest core. Moves are regular
+ * partition reassignments that only change the core of the local replica,
+ * so they are replicated through the controller and executed by the
+ * controller_backend cross core move path.
+ *
+ * Once triggered the balancer keeps moving partitions until the skew drops
+ * below half of the threshold. At most `core_balancer_max_moves` moves are
+ * started per interval, no new moves are started while previous ones are
+ * still in progress, and moved partitions are not moved again for
+ * `core_balancer_mute_timeout_ms`.
+ *
+ * Single instance running on shard `shard_balancer::shard`.
+ */
+class shard_balancer {
+public:
+    static constexpr ss::shard_id shard = 0;
+    // cores doing less work than this, in records per second on average,
+    // are never considered skewed
+    static constexpr double min_average_load = 100;
+
+    // throughput of a single local partition
+    struct partition_load {
+        model::ntp ntp;
+        ss::shard_id shard;
+        double load;
+    };
+
+    struct move {
+        model::ntp ntp;
+        ss::shard_id from;
+        ss::shard_id to;
+    };
+
+    shard_balancer(
+      model::node_id,
+      ss::sharded<topic_table>&,
+      ss::sharded<topics_frontend>&,
+      ss::sharded<partition_manager>&,
+      ss::sharded<ss::abort_source>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    /// difference between the most and least loaded core relative to the
+    /// average core load, in percent. Zero when the average load is below
+    /// `min_average_load`
+    static double skew(const std::vector<double>& shard_loads);
+
+    /**
+     * Plan up to `max_moves` partition moves that reduce the load difference
+     * between the busiest and idlest core, as long as the skew is above
+     * `threshold` percent. Muted partitions are never moved.
+     */
+    static std::vector<move> make_plan(
+      const std::vector<partition_load>&,
+      size_t shards,
+      const absl::flat_hash_set<model::ntp>& muted,
+      double threshold,
+      size_t max_moves);
+
+private:
+    void arm_timer();
+    ss::future<> tick();
+    ss::future<std::vector<partition_load>> collect();
+    absl::flat_hash_set<model::ntp>
+    unmovable_partitions(const std::vector<partition_load>&);
+    ss::future<> execute(const move&);
+    void setup_metrics();
+
+    model::node_id _self;
+    ss::sharded<topic_table>& _topics;
+    ss::sharded<topics_frontend>& _topics_frontend;
+    ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<ss::abort_source>& _as;
+
+    // cumulative record counts of the previous sample
+    absl::flat_hash_map<model::ntp, uint64_t> _records;
+    ss::lowres_clock::time_point _last_sample;
+    size_t _skewed_intervals{0};
+    bool _active{false};
+    absl::flat_hash_map<model::ntp, ss::lowres_clock::time_point> _muted;
+    // partitions moved by the balancer that are still being moved
+    absl::flat_hash_set<model::ntp> _in_progress;
+
+    double _skew{0};
+    uint64_t _failed_moves{0};
+    std::vector<uint64_t> _moves_out;
+    std::vector<uint64_t> _moves_in;
+    ss::metrics::metric_groups _metrics;
+    ss::timer<ss::lowres_clock> _timer;
+    ss::gate _gate;
+};
+
+} // namespace cluster
@@ -0,0 +1,95 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/aborted_tx_index.h"
+#include "model/fundamental.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <random>
+#include <vector>
+
+// read_committed fetches of a partition with 1M aborted transactions, the
+// offset ordered index compared to scanning all the aborted transactions
+struct aborted_txs {
+    static constexpr int64_t aborted_count = 1'000'000;
+    // a transaction starts every `stride` offsets and ends `span` offsets
+    // later, so that `span / stride` transactions are open at any time
+    static constexpr int64_t stride = 4;
+    static constexpr int64_t span = 64;
+    static constexpr size_t queries = 100;
+    static constexpr int64_t fetch_size = 1'000;
+
+    aborted_txs() {
+        // every other transaction is aborted
+        for (int64_t i = 0; i < 2 * aborted_count; ++i) {
+            cluster::tx_range r{
+              .pid = model::producer_identity{.id = i, .epoch = 0},
+              .first = model::offset(i * stride),
+              .last = model::offset(i * stride + span - 1),
+            };
+            if (i % 2 == 0) {
+                by_pid.emplace(r.pid, r);
+                // the aborted transaction is the oldest open one
+                index.add(r, r.last + model::offset(1), r.first);
+            }
+        }
+        end = 2 * aborted_count * stride + span;
+    }
+
+    std::vector<model::offset> fetch_offsets(bool tail) {
+        std::vector<model::offset> ret;
+        std::uniform_int_distribution<int64_t> dist(
+          tail ? end - 10 * fetch_size : 0, end - fetch_size);
+        for (size_t i = 0; i < queries; ++i) {
+            ret.push_back(model::offset(dist(rng)));
+        }
+        return ret;
+    }
+
+    size_t scan(bool tail) {
+        auto offsets = fetch_offsets(tail);
+        perf_tests::start_measuring_time();
+        for (auto from : offsets) {
+            auto to = from + model::offset(fetch_size);
+            std::vector<cluster::tx_range> result;
+            for (auto& [_, r] : by_pid) {
+                if (r.last >= from && r.first <= to) {
+                    result.push_back(r);
+                }
+            }
+            perf_tests::do_not_optimize(result);
+        }
+        perf_tests::stop_measuring_time();
+        return queries;
+    }
+
+    size_t lookup(bool tail) {
+        auto offsets = fetch_offsets(tail);
+        perf_tests::start_measuring_time();
+        for (auto from : offsets) {
+            perf_tests::do_not_optimize(
+              index.find(from, from + model::offset(fetch_size)));
+        }
+        perf_tests::stop_measuring_time();
+        return queries;
+    }
+
+    std::mt19937 rng{7};
+    int64_t end{0};
+    absl::flat_hash_map<model::producer_identity, cluster::tx_range> by_pid;
+    cluster::aborted_tx_index index;
+};
+
+PERF_TEST_F(aborted_txs, scan_tail) { return scan(true); }
+PERF_TEST_F(aborted_txs, index_tail) { return lookup(true); }
+PERF_TEST_F(aborted_txs, scan_random) { return scan(false); }
+PERF_TEST_F(aborted_txs, index_random) { return lookup(false); }
@@ -0,0 +1,162 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE cluster
+#include "cluster/aborted_tx_index.h"
+#include "model/fundamental.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using cluster::aborted_tx_index;
+using cluster::tx_range;
+
+namespace {
+
+/*
+ * interleaved transactions of many producers, every offset holds either a
+ * data batch of an ongoing transaction or a commit/abort marker
+ */
+struct workload {
+    std::mt19937 rng{42};
+    int64_t offset{0};
+    std::map<int64_t, tx_range> ongoing;
+    std::vector<tx_range> aborted;
+    aborted_tx_index index;
+
+    std::optional<model::offset> ongoing_start() const {
+        std::optional<model::offset> ret;
+        for (const auto& [_, r] : ongoing) {
+            if (!ret || r.first < *ret) {
+                ret = r.first;
+            }
+        }
+        return ret;
+    }
+
+    void step(int producers) {
+        auto id = std::uniform_int_distribution<int64_t>(0, producers)(rng);
+        auto o = model::offset(offset++);
+        auto it = ongoing.find(id);
+        if (it == ongoing.end()) {
+            ongoing.emplace(
+              id,
+              tx_range{
+                .pid = model::producer_identity{.id = id, .epoch = 0},
+                .first = o,
+                .last = o});
+            return;
+        }
+        switch (std::uniform_int_distribution<int>(0, 3)(rng)) {
+        case 0:
+            index.add(it->second, o, *ongoing_start());
+            aborted.push_back(it->second);
+            ongoing.erase(it);
+            break;
+        case 1:
+            ongoing.erase(it);
+            break;
+        default:
+            it->second.last = o;
+        }
+    }
+
+    std::vector<tx_range> scan(model::offset from, model::offset to) const {
+        std::vector<tx_range> ret;
+        for (const auto& r : aborted) {
+            if (r.last >= from && r.first <= to) {
+                ret.push_back(r);
+            }
+        }
+        return ret;
+    }
+};
+
+bool same_ranges(std::vector<tx_range> l, std::vector<tx_range> r) {
+    auto by_first = [](const tx_range& a, const tx_range& b) {
+        return a.first < b.first;
+    };
+    std::sort(l.begin(), l.end(), by_first);
+    std::sort(r.begin(), r.end(), by_first);
+    return std::equal(
+      l.begin(),
+      l.end(),
+      r.begin(),
+      r.end(),
+      [](const tx_range& a, const tx_range& b) {
+          return a.pid == b.pid && a.first == b.first && a.last == b.last;
+      });
+}
+
+void check_queries(workload& w, const aborted_tx_index& index) {
+    for (int i = 0; i < 1000; ++i) {
+        auto a = std::uniform_int_distribution<int64_t>(0, w.offset)(w.rng);
+        auto len = std::uniform_int_distribution<int64_t>(0, 100)(w.rng);
+        auto from = model::offset(a);
+        auto to = model::offset(a + len);
+        BOOST_REQUIRE(same_ranges(index.find(from, to), w.scan(from, to)));
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(find_matches_linear_scan) {
+    for (int producers : {1, 4, 32}) {
+        workload w;
+        for (int i = 0; i < 10000; ++i) {
+            w.step(producers);
+        }
+        BOOST_REQUIRE_EQUAL(w.index.size(), w.aborted.size());
+        check_queries(w, w.index);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(index_rebuilt_from_snapshot) {
+    workload w;
+    for (int i = 0; i < 5000; ++i) {
+        w.step(16);
+    }
+    // node restarting from a snapshot keeps applying the log
+    aborted_tx_index restored;
+    restored.reset(w.aborted, w.ongoing_start());
+    check_queries(w, restored);
+
+    std::swap(w.index, restored);
+    for (int i = 0; i < 5000; ++i) {
+        w.step(16);
+    }
+    check_queries(w, w.index);
+}
+
+BOOST_AUTO_TEST_CASE(ranges_before_log_start_are_evicted) {
+    aborted_tx_index index;
+    auto pid = [](int64_t id) {
+        return model::producer_identity{.id = id, .epoch = 0};
+    };
+    auto range = [&pid](int64_t id, int64_t first, int64_t last) {
+        return tx_range{
+          .pid = pid(id),
+          .first = model::offset(first),
+          .last = model::offset(last)};
+    };
+    index.add(range(1, 0, 2), model::offset(3), model::offset(0));
+    index.add(range(2, 1, 5), model::offset(6), model::offset(1));
+
+    BOOST_REQUIRE(index.evict_before(model::offset(3)).empty());
+    auto evicted = index.evict_before(model::offset(4));
+    BOOST_REQUIRE_EQUAL(evicted.size(), 1);
+    BOOST_REQUIRE_EQUAL(evicted[0].pid, pid(1));
+    BOOST_REQUIRE_EQUAL(index.size(), 1);
+    BOOST_REQUIRE_EQUAL(
+      index.find(model::offset(0), model::offset(10)).size(), 1);
+}
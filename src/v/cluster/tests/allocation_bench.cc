@@ -9,6 +9,7 @@
 
 #include "cluster/tests/partition_allocator_tester.h"
 #include "raft/types.h"
+#include "units.h"
 
 #include <seastar/core/reactor.hh>
 #include <seastar/core/sharded.hh>
@@ -47,3 +48,46 @@ PERF_TEST_F(partition_allocator_tester, recovery) {
     pa.update_allocation_state(md, raft::group_id(partitions_per_topic));
     perf_tests::stop_measuring_time();
 }
+
+struct large_cluster_tester : partition_allocator_tester {
+    static constexpr uint32_t nodes = 15;
+    static constexpr uint32_t cpus = 32;
+    static constexpr int32_t partitions = 100'000;
+
+    large_cluster_tester()
+      : partition_allocator_tester(nodes, cpus) {}
+
+    // skewed per core load as reported by the nodes
+    void report_load() {
+        for (uint32_t n = 0; n < nodes; ++n) {
+            std::vector<allocation_node::observed_load> load;
+            load.reserve(cpus);
+            for (uint32_t c = 0; c < cpus; ++c) {
+                load.push_back(allocation_node::observed_load{
+                  .throughput = static_cast<double>(_prng() % 100'000),
+                  .disk_bytes = _prng() % 100_GiB,
+                });
+            }
+            pa.update_node_load(model::node_id(n), std::move(load));
+        }
+    }
+};
+
+PERF_TEST_F(large_cluster_tester, allocation_100k) {
+    auto cfg = gen_topic_configuration(partitions, 3);
+
+    perf_tests::start_measuring_time();
+    auto vals = pa.allocate(cfg);
+    perf_tests::do_not_optimize(vals);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST_F(large_cluster_tester, allocation_100k_observed_load) {
+    report_load();
+    auto cfg = gen_topic_configuration(partitions, 3);
+
+    perf_tests::start_measuring_time();
+    auto vals = pa.allocate(cfg);
+    perf_tests::do_not_optimize(vals);
+    perf_tests::stop_measuring_time();
+}
@@ -0,0 +1,113 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/commands.h"
+#include "cluster/partition_allocator.h"
+#include "cluster/topic_table.h"
+#include "cluster/topic_updates_dispatcher.h"
+#include "model/metadata.h"
+
+#include <seastar/core/sharded.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <unordered_map>
+#include <vector>
+
+// Startup of a node replaying a long controller log with years of topic churn
+// compared to a node recovering the same state from a controller snapshot.
+struct controller_state {
+    static constexpr int churned_topics = 2'000;
+    static constexpr int live_topics = 200;
+
+    controller_state() {
+        table.start().get();
+        allocator.start_single(raft::group_id(0)).get();
+        for (int id = 0; id < 3; ++id) {
+            allocator.local().register_node(
+              std::make_unique<cluster::allocation_node>(
+                model::node_id(id),
+                16,
+                std::unordered_map<ss::sstring, ss::sstring>{}));
+        }
+    }
+
+    ~controller_state() {
+        table.stop().get();
+        allocator.stop().get();
+    }
+
+    /// Builds controller log where most of the created topics are deleted
+    /// later on, the log is applied to this state while being built.
+    std::vector<model::record_batch> make_log() {
+        std::vector<model::record_batch> log;
+        model::offset offset(0);
+        auto append = [this, &log, &offset](model::record_batch b) {
+            b.header().base_offset = offset++;
+            log.push_back(b.copy());
+            dispatcher.apply_update(std::move(b)).get();
+        };
+        for (int i = 0; i < churned_topics + live_topics; ++i) {
+            model::topic_namespace tp_ns(
+              model::ns("kafka"), model::topic(fmt::format("topic-{}", i)));
+            cluster::topic_configuration cfg(tp_ns.ns, tp_ns.tp, 3, 3);
+            auto units = allocator.local().allocate(cfg);
+            cluster::topic_configuration_assignment ca(
+              cfg, units.value().get_assignments());
+            append(cluster::serialize_cmd(
+                     cluster::create_topic_cmd(tp_ns, std::move(ca)))
+                     .get0());
+            if (i < churned_topics) {
+                append(cluster::serialize_cmd(
+                         cluster::delete_topic_cmd(tp_ns, tp_ns))
+                         .get0());
+            }
+        }
+        return log;
+    }
+
+    ss::sharded<cluster::partition_allocator> allocator;
+    ss::sharded<cluster::topic_table> table;
+    cluster::topic_updates_dispatcher dispatcher{allocator, table};
+};
+
+PERF_TEST(controller_startup, replay_log) {
+    return ss::async([] {
+        std::vector<model::record_batch> log;
+        {
+            controller_state leader;
+            log = leader.make_log();
+        }
+        controller_state node;
+        perf_tests::start_measuring_time();
+        for (auto& b : log) {
+            node.dispatcher.apply_update(std::move(b)).get();
+        }
+        perf_tests::stop_measuring_time();
+    });
+}
+
+PERF_TEST(controller_startup, apply_snapshot) {
+    return ss::async([] {
+        iobuf snapshot;
+        model::offset last_included;
+        {
+            controller_state leader;
+            auto log = leader.make_log();
+            last_included = log.back().last_offset();
+            snapshot = leader.dispatcher.take_snapshot(last_included).get0();
+        }
+        controller_state node;
+        perf_tests::start_measuring_time();
+        node.dispatcher
+          .apply_snapshot(model::offset{}, last_included, std::move(snapshot))
+          .get();
+        perf_tests::stop_measuring_time();
+    });
+}
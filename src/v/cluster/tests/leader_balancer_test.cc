@@ -0,0 +1,150 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE cluster
+#include "cluster/leader_balancer.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <vector>
+
+using lb = cluster::leader_balancer;
+
+static model::broker_shard bs(int node, uint32_t shard = 0) {
+    return model::broker_shard{.node_id = model::node_id(node), .shard = shard};
+}
+
+/*
+ * every partition is replicated on all the nodes and led by `leader`
+ */
+static std::vector<lb::partition>
+make_partitions(int count, int nodes, model::broker_shard leader) {
+    std::vector<lb::partition> ret;
+    for (int p = 0; p < count; ++p) {
+        lb::partition part{
+          .ntp = model::ntp(
+            model::kafka_namespace, model::topic("t"), model::partition_id(p)),
+          .leader = leader,
+        };
+        for (int n = 0; n < nodes; ++n) {
+            part.replicas.push_back(bs(n, leader.shard));
+        }
+        ret.push_back(std::move(part));
+    }
+    return ret;
+}
+
+static absl::flat_hash_set<model::node_id> nodes(std::vector<int> ids) {
+    absl::flat_hash_set<model::node_id> ret;
+    for (auto id : ids) {
+        ret.insert(model::node_id(id));
+    }
+    return ret;
+}
+
+static std::map<int, int> leaders_after(
+  const std::vector<lb::partition>& partitions, const lb::plan& plan) {
+    // all the test partitions belong to the same topic
+    std::map<model::partition_id, int> leader;
+    for (const auto& p : partitions) {
+        leader[p.ntp.tp.partition] = p.leader.node_id();
+    }
+    for (const auto& m : plan.moves) {
+        BOOST_REQUIRE_EQUAL(leader[m.ntp.tp.partition], m.from.node_id());
+        leader[m.ntp.tp.partition] = m.to.node_id();
+    }
+    std::map<int, int> ret;
+    for (const auto& [_, node] : leader) {
+        ++ret[node];
+    }
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE(leaders_piled_on_a_single_node_are_spread) {
+    auto partitions = make_partitions(9, 3, bs(0));
+    auto plan = lb::make_plan(partitions, nodes({0, 1, 2}), {}, 100);
+
+    BOOST_REQUIRE_EQUAL(plan.moves.size(), 6);
+    BOOST_REQUIRE_EQUAL(plan.spread_before, 9);
+    BOOST_REQUIRE_EQUAL(plan.spread_after, 0);
+    auto leaders = leaders_after(partitions, plan);
+    BOOST_REQUIRE_EQUAL(leaders[0], 3);
+    BOOST_REQUIRE_EQUAL(leaders[1], 3);
+    BOOST_REQUIRE_EQUAL(leaders[2], 3);
+}
+
+BOOST_AUTO_TEST_CASE(balanced_cluster_needs_no_moves) {
+    std::vector<lb::partition> partitions;
+    for (int n = 0; n < 3; ++n) {
+        auto led = make_partitions(2, 3, bs(n));
+        for (auto& p : led) {
+            p.ntp.tp.partition = model::partition_id(
+              p.ntp.tp.partition() + n * 2);
+            partitions.push_back(std::move(p));
+        }
+    }
+    auto plan = lb::make_plan(partitions, nodes({0, 1, 2}), {}, 100);
+    BOOST_REQUIRE(plan.moves.empty());
+    BOOST_REQUIRE_EQUAL(plan.spread_before, 0);
+}
+
+BOOST_AUTO_TEST_CASE(moves_are_throttled) {
+    auto partitions = make_partitions(9, 3, bs(0));
+    auto plan = lb::make_plan(partitions, nodes({0, 1, 2}), {}, 2);
+    BOOST_REQUIRE_EQUAL(plan.moves.size(), 2);
+    BOOST_REQUIRE_EQUAL(plan.spread_after, 6);
+}
+
+BOOST_AUTO_TEST_CASE(dead_nodes_are_not_targets) {
+    auto partitions = make_partitions(8, 3, bs(0));
+    auto plan = lb::make_plan(partitions, nodes({0, 1}), {}, 100);
+    auto leaders = leaders_after(partitions, plan);
+    BOOST_REQUIRE_EQUAL(leaders[0], 4);
+    BOOST_REQUIRE_EQUAL(leaders[1], 4);
+    BOOST_REQUIRE_EQUAL(leaders.count(2), 0);
+}
+
+BOOST_AUTO_TEST_CASE(muted_partitions_are_not_moved) {
+    auto partitions = make_partitions(4, 2, bs(0));
+    absl::flat_hash_set<model::ntp> muted;
+    for (const auto& p : partitions) {
+        muted.insert(p.ntp);
+    }
+    auto plan = lb::make_plan(partitions, nodes({0, 1}), muted, 100);
+    BOOST_REQUIRE(plan.moves.empty());
+
+    muted.erase(partitions[0].ntp);
+    plan = lb::make_plan(partitions, nodes({0, 1}), muted, 100);
+    BOOST_REQUIRE_EQUAL(plan.moves.size(), 1);
+    BOOST_REQUIRE_EQUAL(plan.moves[0].ntp, partitions[0].ntp);
+}
+
+BOOST_AUTO_TEST_CASE(leaders_are_spread_across_shards_of_a_node) {
+    // two nodes with two shards each, all leaders on node 0 shard 0
+    std::vector<lb::partition> partitions;
+    for (int p = 0; p < 8; ++p) {
+        uint32_t shard = p % 2;
+        partitions.push_back(lb::partition{
+          .ntp = model::ntp(
+            model::kafka_namespace, model::topic("t"), model::partition_id(p)),
+          .leader = bs(0, 0),
+          .replicas = {bs(0, 0), bs(1, shard)},
+        });
+    }
+    // node 0 shard 1 hosts no replica so it is not part of the plan, the
+    // leaders end up split 3/3/2 between the three shards that are
+    auto plan = lb::make_plan(partitions, nodes({0, 1}), {}, 100);
+    auto leaders = leaders_after(partitions, plan);
+    BOOST_REQUIRE_EQUAL(leaders[0], 3);
+    BOOST_REQUIRE_EQUAL(leaders[1], 5);
+    BOOST_REQUIRE_EQUAL(plan.spread_after, 1);
+}
@@ -9,9 +9,12 @@
 
 #include "cluster/partition_allocator.h"
 #include "cluster/tests/partition_allocator_tester.h"
+#include "config/configuration.h"
 #include "raft/types.h"
 #include "test_utils/fixture.h"
 
+#include <set>
+
 using namespace cluster; // NOLINT
 
 uint allocated_nodes_count(const std::vector<partition_assignment>& allocs) {
@@ -197,4 +200,63 @@ FIXTURE_TEST(allocation_units_test, partition_allocator_tester) {
       machines().at(model::node_id(2))->partition_capacity(), max);
     // we do not decrement the highest raft group
     BOOST_REQUIRE_EQUAL(highest_group()(), partitions);
-}
\ No newline at end of file
+}
+static topic_configuration
+topic_cfg(ss::sstring topic, int32_t partitions, int16_t replication_factor) {
+    return topic_configuration(
+      model::ns("test_ns"),
+      model::topic(std::move(topic)),
+      partitions,
+      replication_factor);
+}
+
+BOOST_AUTO_TEST_CASE(weight_hints_spread_heavy_partitions) {
+    partition_allocator_tester test(1, 4);
+    config::shard_local_cfg()
+      .get("partition_allocation_weights")
+      .set_value(std::vector<ss::sstring>{"heavy:10"});
+
+    // heavy partitions avoid core 0 and each other
+    auto heavy = test.pa.allocate(topic_cfg("heavy", 3, 1)).value();
+    std::set<uint32_t> heavy_cores;
+    for (auto& a : heavy.get_assignments()) {
+        heavy_cores.insert(a.replicas[0].shard);
+    }
+    BOOST_REQUIRE(heavy_cores == std::set<uint32_t>({1, 2, 3}));
+
+    // light partitions fill up the remaining core until it is as loaded as
+    // the cores with a single heavy partition
+    auto light = test.pa.allocate(topic_cfg("light", 8, 1)).value();
+    for (auto& a : light.get_assignments()) {
+        BOOST_REQUIRE_EQUAL(a.replicas[0].shard, 0);
+    }
+
+    config::shard_local_cfg()
+      .get("partition_allocation_weights")
+      .set_value(std::vector<ss::sstring>{});
+}
+
+BOOST_AUTO_TEST_CASE(observed_load_steers_placement) {
+    partition_allocator_tester test(2, 2);
+    using load_t = allocation_node::observed_load;
+    test.pa.update_node_load(
+      model::node_id(0), {load_t{.throughput = 0}, load_t{.throughput = 0}});
+    test.pa.update_node_load(
+      model::node_id(1),
+      {load_t{.throughput = 1000}, load_t{.throughput = 1000}});
+
+    // both partitions land on the idle core even though round robin would
+    // place the second one on node 1
+    auto allocs = test.pa.allocate(topic_cfg("t", 2, 1)).value();
+    for (auto& a : allocs.get_assignments()) {
+        BOOST_REQUIRE_EQUAL(a.replicas[0].node_id, model::node_id(0));
+        BOOST_REQUIRE_EQUAL(a.replicas[0].shard, 1);
+    }
+
+    // without observed load node 1 is the least loaded one
+    test.pa.clear_node_load(model::node_id(0));
+    test.pa.clear_node_load(model::node_id(1));
+    auto next = test.pa.allocate(topic_cfg("t", 1, 1)).value();
+    BOOST_REQUIRE_EQUAL(
+      next.get_assignments()[0].replicas[0].node_id, model::node_id(1));
+}
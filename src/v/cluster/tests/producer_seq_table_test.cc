@@ -0,0 +1,127 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE cluster
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "cluster/producer_seq_table.h"
+#include "model/record.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using cluster::producer_seq_table;
+using cluster::seq_entry;
+
+static model::producer_identity pid(int64_t id) {
+    return model::producer_identity{.id = id, .epoch = 0};
+}
+
+static std::vector<int64_t> ids(const producer_seq_table& t) {
+    std::vector<int64_t> ret;
+    t.for_each([&ret](const seq_entry& e) { ret.push_back(e.pid.id); });
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE(writes_move_producers_to_the_back) {
+    producer_seq_table t;
+    t.write(pid(1), 0, 10);
+    t.write(pid(2), 0, 20);
+    t.write(pid(3), 0, 30);
+    t.write(pid(1), 5, 40);
+
+    BOOST_REQUIRE_EQUAL(t.size(), 3);
+    BOOST_REQUIRE(ids(t) == std::vector<int64_t>({2, 3, 1}));
+    auto e = t.find(pid(1));
+    BOOST_REQUIRE(e);
+    BOOST_REQUIRE_EQUAL(e->seq, 5);
+    BOOST_REQUIRE_EQUAL(e->last_write_timestamp, 40);
+    BOOST_REQUIRE(!t.find(pid(4)));
+}
+
+BOOST_AUTO_TEST_CASE(eviction_stops_at_a_recent_write) {
+    producer_seq_table t;
+    t.write(pid(1), 0, 10);
+    t.write(pid(2), 0, 30);
+    // timestamps of the writes are not monotonic, the producer stays until
+    // the ones written before it expire
+    t.write(pid(3), 0, 20);
+    t.write(pid(4), 0, 40);
+
+    BOOST_REQUIRE_EQUAL(t.evict_before(25), 1);
+    BOOST_REQUIRE(ids(t) == std::vector<int64_t>({2, 3, 4}));
+    BOOST_REQUIRE_EQUAL(t.evict_before(35), 2);
+    BOOST_REQUIRE(ids(t) == std::vector<int64_t>({4}));
+    BOOST_REQUIRE_EQUAL(t.evict_before(35), 0);
+    BOOST_REQUIRE_EQUAL(t.evict_before(100), 1);
+    BOOST_REQUIRE(t.empty());
+}
+
+BOOST_AUTO_TEST_CASE(future_timestamp_does_not_block_eviction) {
+    producer_seq_table t;
+    auto now = model::timestamp::now().value();
+    // a producer with its clock an hour ahead is written first
+    t.write(pid(1), 0, now + 3'600'000);
+    t.write(pid(2), 0, now - 60'000);
+
+    BOOST_REQUIRE_LE(t.find(pid(1))->last_write_timestamp, now + 60'000);
+    BOOST_REQUIRE_EQUAL(t.evict_before(now + 60'000), 2);
+    BOOST_REQUIRE(t.empty());
+}
+
+BOOST_AUTO_TEST_CASE(encoding_round_trip) {
+    producer_seq_table t;
+    for (int64_t i = 0; i < 1000; ++i) {
+        t.write(
+          model::producer_identity{.id = i * 7, .epoch = int16_t(i % 3)},
+          int32_t(i),
+          1'600'000'000'000 + (i % 2 ? i : -i));
+    }
+
+    iobuf buf;
+    t.encode(buf);
+    // the fixed width entries took 22 bytes each
+    BOOST_REQUIRE_LT(buf.size_bytes(), t.size() * 11);
+
+    producer_seq_table decoded;
+    iobuf_parser parser(std::move(buf));
+    decoded.decode(parser);
+    BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+
+    std::vector<seq_entry> expected;
+    t.for_each([&expected](const seq_entry& e) { expected.push_back(e); });
+    std::vector<seq_entry> actual;
+    decoded.for_each([&actual](const seq_entry& e) { actual.push_back(e); });
+    BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        BOOST_REQUIRE(expected[i].pid == actual[i].pid);
+        BOOST_REQUIRE_EQUAL(expected[i].seq, actual[i].seq);
+        BOOST_REQUIRE_EQUAL(
+          expected[i].last_write_timestamp, actual[i].last_write_timestamp);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decoding_keeps_the_higher_sequence) {
+    producer_seq_table snapshot;
+    snapshot.write(pid(1), 5, 10);
+    snapshot.write(pid(2), 5, 10);
+    iobuf buf;
+    snapshot.encode(buf);
+
+    producer_seq_table t;
+    t.write(pid(1), 10, 20);
+    t.write(pid(2), 1, 20);
+    iobuf_parser parser(std::move(buf));
+    t.decode(parser);
+
+    BOOST_REQUIRE_EQUAL(t.find(pid(1))->seq, 10);
+    BOOST_REQUIRE_EQUAL(t.find(pid(2))->seq, 5);
+    BOOST_REQUIRE(ids(t) == std::vector<int64_t>({1, 2}));
+}
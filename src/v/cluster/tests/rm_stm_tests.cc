@@ -381,3 +381,68 @@ FIXTURE_TEST(test_tx_post_aborted_produce, mux_state_machine_fixture) {
                  .get0();
     BOOST_REQUIRE(offset_r == invalid_producer_epoch);
 }
+
+// an aborted tx which ends before the start of the log is evicted from
+// aborted_transactions but its session stays fenced off
+FIXTURE_TEST(test_tx_evicted_aborted_tx_fenced, mux_state_machine_fixture) {
+    start_raft();
+
+    cluster::rm_stm stm(logger, _raft.get());
+
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+
+    wait_for_leader();
+    wait_for_meta_initialized();
+
+    auto min_offset = model::offset(0);
+    auto max_offset = model::offset(std::numeric_limits<int64_t>::max());
+
+    auto pid1 = model::producer_identity{.id = 1, .epoch = 0};
+    auto pid20 = model::producer_identity{.id = 2, .epoch = 0};
+    auto term_op = stm.begin_tx(pid20).get0();
+    BOOST_REQUIRE((bool)term_op);
+
+    auto rreader = make_rreader(pid20, 0, 5, true);
+    auto offset_r = stm
+                      .replicate(
+                        rreader.id,
+                        std::move(rreader.reader),
+                        raft::replicate_options(
+                          raft::consistency_level::quorum_ack))
+                      .get0();
+    BOOST_REQUIRE((bool)offset_r);
+
+    auto op = stm.abort_tx(pid20, 2'000ms).get0();
+    BOOST_REQUIRE_EQUAL(op, cluster::tx_errc::none);
+    auto aborted_txs = stm.aborted_transactions(min_offset, max_offset).get0();
+    BOOST_REQUIRE_EQUAL(aborted_txs.size(), 1);
+
+    _raft
+      ->write_snapshot(
+        raft::write_snapshot_cfg(_raft->committed_offset(), iobuf()))
+      .get0();
+
+    // the aborted tx is evicted once the next batch is applied
+    rreader = make_rreader(pid1, 0, 5, false);
+    offset_r = stm
+                 .replicate(
+                   rreader.id,
+                   std::move(rreader.reader),
+                   raft::replicate_options(raft::consistency_level::quorum_ack))
+                 .get0();
+    BOOST_REQUIRE((bool)offset_r);
+
+    // replicate_tx syncs the stm before rejecting the write
+    rreader = make_rreader(pid20, 0, 5, true);
+    offset_r = stm
+                 .replicate(
+                   rreader.id,
+                   std::move(rreader.reader),
+                   raft::replicate_options(raft::consistency_level::quorum_ack))
+                 .get0();
+    BOOST_REQUIRE(offset_r == invalid_producer_epoch);
+
+    aborted_txs = stm.aborted_transactions(min_offset, max_offset).get0();
+    BOOST_REQUIRE_EQUAL(aborted_txs.size(), 0);
+}
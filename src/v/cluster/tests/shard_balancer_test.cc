@@ -0,0 +1,107 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE cluster
+#include "cluster/shard_balancer.h"
+#include "model/fundamental.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using sb = cluster::shard_balancer;
+
+static sb::partition_load pl(int p, ss::shard_id shard, double load) {
+    return sb::partition_load{
+      .ntp = model::ntp(
+        model::kafka_namespace, model::topic("t"), model::partition_id(p)),
+      .shard = shard,
+      .load = load,
+    };
+}
+
+static std::vector<double> shard_loads_after(
+  const std::vector<sb::partition_load>& loads,
+  size_t shards,
+  const std::vector<sb::move>& plan) {
+    std::vector<double> ret(shards, 0);
+    for (const auto& l : loads) {
+        ret[l.shard] += l.load;
+    }
+    for (const auto& m : plan) {
+        auto it = std::find_if(
+          loads.begin(), loads.end(), [&m](const sb::partition_load& l) {
+              return l.ntp == m.ntp;
+          });
+        BOOST_REQUIRE(it != loads.end());
+        BOOST_REQUIRE_EQUAL(it->shard, m.from);
+        ret[m.from] -= it->load;
+        ret[m.to] += it->load;
+    }
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE(balanced_cores_need_no_moves) {
+    std::vector<sb::partition_load> loads;
+    for (ss::shard_id s = 0; s < 4; ++s) {
+        loads.push_back(pl(s, s, 1000));
+    }
+    BOOST_REQUIRE_EQUAL(sb::skew({1000, 1000, 1000, 1000}), 0);
+    BOOST_REQUIRE(sb::make_plan(loads, 4, {}, 25, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(hot_core_is_relieved) {
+    std::vector<sb::partition_load> loads;
+    for (int p = 0; p < 4; ++p) {
+        loads.push_back(pl(p, 0, 1000));
+    }
+    BOOST_REQUIRE_EQUAL(sb::skew({4000, 0, 0, 0}), 400);
+
+    auto plan = sb::make_plan(loads, 4, {}, 25, 10);
+    BOOST_REQUIRE_EQUAL(plan.size(), 3);
+    auto after = shard_loads_after(loads, 4, plan);
+    for (auto l : after) {
+        BOOST_REQUIRE_EQUAL(l, 1000);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(moves_are_throttled) {
+    std::vector<sb::partition_load> loads;
+    for (int p = 0; p < 4; ++p) {
+        loads.push_back(pl(p, 0, 1000));
+    }
+    auto plan = sb::make_plan(loads, 4, {}, 25, 1);
+    BOOST_REQUIRE_EQUAL(plan.size(), 1);
+    BOOST_REQUIRE_EQUAL(plan[0].from, 0);
+}
+
+BOOST_AUTO_TEST_CASE(muted_partitions_are_not_moved) {
+    std::vector<sb::partition_load> loads{pl(0, 0, 1000), pl(1, 0, 1000)};
+    absl::flat_hash_set<model::ntp> muted{loads[0].ntp, loads[1].ntp};
+    BOOST_REQUIRE(sb::make_plan(loads, 2, muted, 25, 10).empty());
+
+    muted.erase(loads[1].ntp);
+    auto plan = sb::make_plan(loads, 2, muted, 25, 10);
+    BOOST_REQUIRE_EQUAL(plan.size(), 1);
+    BOOST_REQUIRE_EQUAL(plan[0].ntp, loads[1].ntp);
+    BOOST_REQUIRE_EQUAL(plan[0].to, 1);
+}
+
+BOOST_AUTO_TEST_CASE(moves_that_do_not_help_are_skipped) {
+    // moving the only partition would just make the other core the hot one
+    std::vector<sb::partition_load> loads{pl(0, 0, 3000), pl(1, 1, 1000)};
+    BOOST_REQUIRE(sb::make_plan(loads, 2, {}, 25, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(idle_cores_are_never_skewed) {
+    BOOST_REQUIRE_EQUAL(sb::skew({50, 0}), 0);
+    std::vector<sb::partition_load> loads{pl(0, 0, 50), pl(1, 0, 50)};
+    BOOST_REQUIRE(sb::make_plan(loads, 2, {}, 25, 10).empty());
+}
@@ -11,11 +11,15 @@
 #include "cluster/tests/topic_table_fixture.h"
 #include "cluster/topic_updates_dispatcher.h"
 #include "model/metadata.h"
+#include "raft/types.h"
+#include "reflection/adl.h"
 
 #include <seastar/testing/thread_test_case.hh>
 
 #include <bits/stdint-uintn.h>
+#include <fmt/ostream.h>
 
+#include <algorithm>
 #include <cstdint>
 using namespace std::chrono_literals;
 
@@ -201,3 +205,311 @@ FIXTURE_TEST(
         ->partition_capacity(),
       node_initial_capacity(4) - (1 + 12 + 2));
 }
+
+static std::vector<ss::sstring> topics_state(cluster::topic_table& table) {
+    std::vector<ss::sstring> ret;
+    for (auto& md : table.all_topics_metadata()) {
+        ret.push_back(fmt::format("{}", md));
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+static std::vector<size_t>
+capacities(cluster::partition_allocator& allocator) {
+    std::vector<size_t> ret;
+    for (auto id : {1, 2, 3}) {
+        ret.push_back(allocator.allocation_nodes()
+                        .at(model::node_id(id))
+                        ->partition_capacity());
+    }
+    return ret;
+}
+
+template<typename Cmd>
+std::error_code
+apply_at(cluster::topic_updates_dispatcher& d, Cmd cmd, int64_t offset) {
+    auto b = cluster::serialize_cmd(std::move(cmd)).get0();
+    b.header().base_offset = model::offset(offset);
+    return d.apply_update(std::move(b)).get0();
+}
+
+FIXTURE_TEST(test_dispatcher_snapshot, topic_table_updates_dispatcher_fixture) {
+    auto tp_1 = make_create_topic_cmd("test_tp_1", 1, 3);
+    auto tp_2 = make_create_topic_cmd("test_tp_2", 12, 3);
+    auto tp_3 = make_create_topic_cmd("test_tp_3", 8, 1);
+    auto delete_tp_2 = cluster::delete_topic_cmd(
+      make_tp_ns("test_tp_2"), make_tp_ns("test_tp_2"));
+
+    BOOST_REQUIRE_EQUAL(apply_at(dispatcher, tp_1, 1), cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(apply_at(dispatcher, tp_2, 2), cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(apply_at(dispatcher, tp_3, 3), cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(
+      apply_at(dispatcher, delete_tp_2, 4), cluster::errc::success);
+    // topic created again with different partitions
+    BOOST_REQUIRE_EQUAL(
+      apply_at(dispatcher, make_create_topic_cmd("test_tp_2", 3, 1), 5),
+      cluster::errc::success);
+    table.local().wait_for_changes(as).get0();
+
+    // node starting from the snapshot only
+    {
+        topic_table_updates_dispatcher_fixture fresh;
+        fresh.dispatcher
+          .apply_snapshot(
+            model::offset{},
+            model::offset(5),
+            dispatcher.take_snapshot(model::offset(5)).get0())
+          .get0();
+
+        BOOST_REQUIRE(
+          topics_state(fresh.table.local()) == topics_state(table.local()));
+        BOOST_REQUIRE(
+          capacities(fresh.allocator.local())
+          == capacities(allocator.local()));
+        // partitions keep revisions of the commands that created them
+        auto deltas = fresh.table.local().wait_for_changes(fresh.as).get0();
+        validate_delta(deltas, 1 + 8 + 3, 0);
+        for (auto& d : deltas) {
+            auto expected = d.ntp.tp.topic == model::topic("test_tp_1") ? 1
+                            : d.ntp.tp.topic == model::topic("test_tp_3")
+                              ? 3
+                              : 5;
+            BOOST_REQUIRE_EQUAL(d.offset, model::offset(expected));
+        }
+    }
+
+    // lagging node that applied the log up to offset 2
+    {
+        topic_table_updates_dispatcher_fixture lagging;
+        BOOST_REQUIRE_EQUAL(
+          apply_at(lagging.dispatcher, tp_1, 1), cluster::errc::success);
+        BOOST_REQUIRE_EQUAL(
+          apply_at(lagging.dispatcher, tp_2, 2), cluster::errc::success);
+        lagging.table.local().wait_for_changes(lagging.as).get0();
+
+        lagging.dispatcher
+          .apply_snapshot(
+            model::offset(2),
+            model::offset(5),
+            dispatcher.take_snapshot(model::offset(5)).get0())
+          .get0();
+
+        BOOST_REQUIRE(
+          topics_state(lagging.table.local()) == topics_state(table.local()));
+        BOOST_REQUIRE(
+          capacities(lagging.allocator.local())
+          == capacities(allocator.local()));
+        // old test_tp_2 partitions removed, test_tp_3 and new test_tp_2
+        // partitions added
+        auto deltas
+          = lagging.table.local().wait_for_changes(lagging.as).get0();
+        validate_delta(deltas, 8 + 3, 12);
+    }
+}
+
+FIXTURE_TEST(
+  test_dispatching_batched_commands, topic_table_updates_dispatcher_fixture) {
+    std::vector<cluster::create_topic_cmd> creates;
+    creates.push_back(make_create_topic_cmd("test_tp_1", 1, 3));
+    creates.push_back(make_create_topic_cmd("test_tp_2", 12, 3));
+    creates.push_back(make_create_topic_cmd("test_tp_3", 8, 1));
+    auto b = cluster::serialize_cmds(std::move(creates)).get0();
+    BOOST_REQUIRE_EQUAL(b.record_count(), 3);
+    b.header().base_offset = model::offset(10);
+    BOOST_REQUIRE_EQUAL(
+      dispatcher.apply_update(std::move(b)).get0(), cluster::errc::success);
+
+    // every topic is created with the offset of its own record
+    auto deltas = table.local().wait_for_changes(as).get0();
+    validate_delta(deltas, 1 + 12 + 8, 0);
+    for (auto& d : deltas) {
+        auto expected = d.ntp.tp.topic == model::topic("test_tp_1") ? 10
+                        : d.ntp.tp.topic == model::topic("test_tp_2")
+                          ? 11
+                          : 12;
+        BOOST_REQUIRE_EQUAL(d.offset, model::offset(expected));
+    }
+
+    // failed commands do not prevent the rest of the batch from being
+    // applied, the result is the error of the first one that failed
+    std::vector<cluster::delete_topic_cmd> deletes;
+    for (auto tp : {"not_exists", "test_tp_2", "test_tp_3"}) {
+        deletes.emplace_back(make_tp_ns(tp), make_tp_ns(tp));
+    }
+    b = cluster::serialize_cmds(std::move(deletes)).get0();
+    b.header().base_offset = model::offset(13);
+    BOOST_REQUIRE_EQUAL(
+      dispatcher.apply_update(std::move(b)).get0(),
+      cluster::errc::topic_not_exists);
+
+    auto md = table.local().all_topics_metadata();
+    BOOST_REQUIRE_EQUAL(md.size(), 1);
+    BOOST_REQUIRE_EQUAL(md[0].tp_ns, make_tp_ns("test_tp_1"));
+    deltas = table.local().wait_for_changes(as).get0();
+    validate_delta(deltas, 0, 12 + 8);
+    BOOST_REQUIRE(
+      capacities(allocator.local())
+      == std::vector<size_t>(
+        {node_initial_capacity(8) - 1,
+         node_initial_capacity(12) - 1,
+         node_initial_capacity(4) - 1}));
+
+    // batched commands are retained one by one in the snapshot
+    topic_table_updates_dispatcher_fixture fresh;
+    fresh.dispatcher
+      .apply_snapshot(
+        model::offset{},
+        model::offset(15),
+        dispatcher.take_snapshot(model::offset(15)).get0())
+      .get0();
+    BOOST_REQUIRE(
+      topics_state(fresh.table.local()) == topics_state(table.local()));
+}
+
+FIXTURE_TEST(
+  test_dispatcher_snapshot_compaction, topic_table_updates_dispatcher_fixture) {
+    auto tp_ns = make_tp_ns("test_tp_1");
+    int64_t offset = 1;
+    BOOST_REQUIRE_EQUAL(
+      apply_at(dispatcher, make_create_topic_cmd("test_tp_1", 1, 3), offset++),
+      cluster::errc::success);
+    auto ntp = model::ntp(tp_ns.ns, tp_ns.tp, model::partition_id(0));
+    auto replicas = table.local().get_partition_assignment(ntp)->replicas;
+
+    for (int i = 0; i < 50; ++i) {
+        cluster::incremental_topic_updates update;
+        update.retention_bytes.op = cluster::incremental_update_operation::set;
+        update.retention_bytes.value = tristate<size_t>(
+          std::make_optional<size_t>(i));
+        if (i == 10) {
+            update.segment_size.op = cluster::incremental_update_operation::set;
+            update.segment_size.value = 1_MiB;
+        }
+        BOOST_REQUIRE_EQUAL(
+          apply_at(
+            dispatcher,
+            cluster::update_topic_properties_cmd(tp_ns, update),
+            offset++),
+          cluster::errc::success);
+
+        BOOST_REQUIRE_EQUAL(
+          apply_at(
+            dispatcher,
+            cluster::move_partition_replicas_cmd(ntp, replicas),
+            offset++),
+          cluster::errc::success);
+        BOOST_REQUIRE_EQUAL(
+          apply_at(
+            dispatcher,
+            cluster::finish_moving_partition_replicas_cmd(ntp, replicas),
+            offset++),
+          cluster::errc::success);
+    }
+
+    // the topic is rebuilt from its creation, with the finished moves folded
+    // into its assignments, and the folded property updates
+    auto snapshot = dispatcher.take_snapshot(model::offset(offset)).get0();
+    iobuf_parser parser(snapshot.copy());
+    reflection::adl<int8_t>{}.from(parser);
+    reflection::adl<raft::group_id>{}.from(parser);
+    BOOST_REQUIRE_EQUAL(reflection::adl<int32_t>{}.from(parser), 1);
+    reflection::adl<model::topic_namespace>{}.from(parser);
+    auto cmds = reflection::adl<std::vector<model::record_batch>>{}.from(
+      parser);
+    BOOST_REQUIRE_EQUAL(cmds.size(), 2);
+
+    topic_table_updates_dispatcher_fixture fresh;
+    fresh.dispatcher
+      .apply_snapshot(
+        model::offset{}, model::offset(offset), std::move(snapshot))
+      .get0();
+    BOOST_REQUIRE(
+      topics_state(fresh.table.local()) == topics_state(table.local()));
+    BOOST_REQUIRE(
+      capacities(fresh.allocator.local()) == capacities(allocator.local()));
+    auto properties = fresh.table.local().get_topic_cfg(tp_ns)->properties;
+    BOOST_REQUIRE_EQUAL(
+      fmt::format("{}", properties),
+      fmt::format("{}", table.local().get_topic_cfg(tp_ns)->properties));
+    BOOST_REQUIRE(properties.segment_size == 1_MiB);
+    BOOST_REQUIRE(!fresh.table.local().is_update_in_progress(ntp));
+}
+
+static bool same_replicas(
+  const std::vector<model::broker_shard>& l,
+  const std::vector<model::broker_shard>& r) {
+    return std::equal(
+      l.begin(),
+      l.end(),
+      r.begin(),
+      r.end(),
+      [](const model::broker_shard& a, const model::broker_shard& b) {
+          return a.node_id == b.node_id && a.shard == b.shard;
+      });
+}
+
+FIXTURE_TEST(
+  test_dispatcher_snapshot_move_after_finished_move,
+  topic_table_updates_dispatcher_fixture) {
+    auto tp_ns = make_tp_ns("test_tp_1");
+    BOOST_REQUIRE_EQUAL(
+      apply_at(dispatcher, make_create_topic_cmd("test_tp_1", 1, 3), 1),
+      cluster::errc::success);
+    auto ntp = model::ntp(tp_ns.ns, tp_ns.tp, model::partition_id(0));
+    auto created = table.local().get_partition_assignment(ntp)->replicas;
+    auto shifted = [&created](uint32_t by) {
+        auto replicas = created;
+        for (auto& bs : replicas) {
+            bs.shard = (bs.shard + by) % 4;
+        }
+        return replicas;
+    };
+    auto first = shifted(1);
+    auto second = shifted(2);
+
+    BOOST_REQUIRE_EQUAL(
+      apply_at(dispatcher, cluster::move_partition_replicas_cmd(ntp, first), 2),
+      cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(
+      apply_at(
+        dispatcher,
+        cluster::finish_moving_partition_replicas_cmd(ntp, first),
+        3),
+      cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(
+      apply_at(
+        dispatcher, cluster::move_partition_replicas_cmd(ntp, second), 4),
+      cluster::errc::success);
+
+    // the move in progress starts from the replicas of the finished one, not
+    // from the ones the topic was created with
+    topic_table_updates_dispatcher_fixture fresh;
+    fresh.dispatcher
+      .apply_snapshot(
+        model::offset{},
+        model::offset(4),
+        dispatcher.take_snapshot(model::offset(4)).get0())
+      .get0();
+    BOOST_REQUIRE(
+      topics_state(fresh.table.local()) == topics_state(table.local()));
+    BOOST_REQUIRE(
+      capacities(fresh.allocator.local()) == capacities(allocator.local()));
+    BOOST_REQUIRE(fresh.table.local().is_update_in_progress(ntp));
+
+    auto deltas = fresh.table.local().wait_for_changes(fresh.as).get0();
+    auto update = std::find_if(
+      deltas.begin(), deltas.end(), [](const cluster::topic_table_delta& d) {
+          return d.type == cluster::topic_table_delta::op_type::update;
+      });
+    BOOST_REQUIRE(update != deltas.end());
+    BOOST_REQUIRE(update->previous_assignment.has_value());
+    BOOST_REQUIRE(same_replicas(update->previous_assignment->replicas, first));
+    BOOST_REQUIRE(same_replicas(update->new_assignment.replicas, second));
+    BOOST_REQUIRE(
+      std::none_of(
+        deltas.begin(), deltas.end(), [](const cluster::topic_table_delta& d) {
+            return d.type
+                   == cluster::topic_table_delta::op_type::update_finished;
+        }));
+}
@@ -321,6 +321,14 @@ topic_table::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return {};
 }
 
+std::optional<model::compression>
+topic_table::get_topic_compression(model::topic_namespace_view tp) const {
+    if (auto it = _topics.find(tp); it != _topics.end()) {
+        return it->second.cfg.properties.compression;
+    }
+    return {};
+}
+
 std::vector<model::topic_metadata> topic_table::all_topics_metadata() const {
     return transform_topics([](const topic_configuration_assignment& td) {
         return td.get_metadata();
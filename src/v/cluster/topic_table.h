@@ -130,9 +130,21 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
+    ///\brief Returns topics compression type
+    ///
+    /// If topic does not exists or does not set a compression type it returns
+    /// an empty optional
+    std::optional<model::compression>
+      get_topic_compression(model::topic_namespace_view) const;
+
     /// Returns metadata of all topics.
     std::vector<model::topic_metadata> all_topics_metadata() const;
 
+    /// Checks if it has given topic
+    bool contains(model::topic_namespace_view tp_ns) const {
+        return _topics.contains(tp_ns);
+    }
+
     /// Checks if it has given partition
     bool contains(model::topic_namespace_view, model::partition_id) const;
 
@@ -146,6 +158,11 @@ public:
     std::optional<partition_assignment>
     get_partition_assignment(const model::ntp&) const;
 
+    /// Checks if the replica set of the partition is being updated
+    bool is_update_in_progress(const model::ntp& ntp) const {
+        return _update_in_progress.contains(ntp);
+    }
+
 private:
     struct waiter {
         explicit waiter(uint64_t id)
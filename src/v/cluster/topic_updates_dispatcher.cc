@@ -10,9 +10,18 @@
 #include "cluster/topic_updates_dispatcher.h"
 
 #include "cluster/commands.h"
+#include "cluster/logger.h"
 #include "model/metadata.h"
 #include "raft/types.h"
+#include "reflection/adl.h"
+#include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
 #include <iterator>
 #include <system_error>
 #include <vector>
@@ -24,11 +33,19 @@ topic_updates_dispatcher::topic_updates_dispatcher(
   : _partition_allocator(pal)
   , _topic_table(table) {}
 
+static model::topic_namespace command_topic(const model::ntp& k) {
+    return model::topic_namespace(k.ns, k.tp.topic);
+}
+
 ss::future<std::error_code>
 topic_updates_dispatcher::apply_update(model::record_batch b) {
+    if (b.record_count() > 1) {
+        return apply_batched_commands(split_cmds(b));
+    }
     auto base_offset = b.base_offset();
     return deserialize(std::move(b), commands)
-      .then([this, base_offset](auto cmd) {
+      .then([this, base_offset](auto cmd) mutable {
+          auto retained = cmd;
           return ss::visit(
             std::move(cmd),
             [this, base_offset](delete_topic_cmd del_cmd) {
@@ -76,7 +93,8 @@ topic_updates_dispatcher::apply_update(model::record_batch b) {
                             it != tp_md->partitions.cend(),
                             "Reassigned partition must exist");
 
-                          reallocate_partition(it->replicas, cmd.value);
+                          reallocate_partition(
+                            cmd.key.tp.topic, it->replicas, cmd.value);
                       }
                       return ec;
                   });
@@ -86,10 +104,227 @@ topic_updates_dispatcher::apply_update(model::record_batch b) {
             },
             [this, base_offset](update_topic_properties_cmd cmd) {
                 return dispatch_updates_to_cores(std::move(cmd), base_offset);
+            })
+            .then([this, base_offset, retained = std::move(retained)](
+                    std::error_code ec) mutable {
+                if (ec == errc::success) {
+                    std::visit(
+                      [this, base_offset](auto& c) {
+                          retain(std::move(c), base_offset);
+                      },
+                      retained);
+                }
+                return ec;
             });
       });
 }
 
+ss::future<std::error_code> topic_updates_dispatcher::apply_batched_commands(
+  std::vector<model::record_batch> cmds) {
+    // commands are applied in order, a failure of one of them does not
+    // prevent the others from being applied
+    std::error_code ret = errc::success;
+    for (auto& b : cmds) {
+        auto ec = co_await apply_update(std::move(b));
+        if (ec && !ret) {
+            ret = ec;
+        }
+    }
+    co_return ret;
+}
+
+void topic_updates_dispatcher::retain(
+  create_topic_cmd cmd, model::offset o) {
+    auto tp_ns = cmd.key;
+    _topic_commands.insert_or_assign(
+      std::move(tp_ns),
+      topic_commands{.create = {.cmd = std::move(cmd), .offset = o}});
+}
+
+void topic_updates_dispatcher::retain(delete_topic_cmd cmd, model::offset) {
+    _topic_commands.erase(cmd.value);
+}
+
+void topic_updates_dispatcher::retain(
+  move_partition_replicas_cmd cmd, model::offset o) {
+    auto it = _topic_commands.find(command_topic(cmd.key));
+    if (it == _topic_commands.end()) {
+        return;
+    }
+    auto id = cmd.key.tp.partition;
+    // a move replaces the whole replica set, the previous ones do not matter
+    it->second.moves.insert_or_assign(
+      id,
+      applied_cmd<move_partition_replicas_cmd>{
+        .cmd = std::move(cmd), .offset = o});
+}
+
+void topic_updates_dispatcher::retain(
+  finish_moving_partition_replicas_cmd cmd, model::offset) {
+    auto it = _topic_commands.find(command_topic(cmd.key));
+    if (it == _topic_commands.end()) {
+        return;
+    }
+    auto move = it->second.moves.find(cmd.key.tp.partition);
+    if (move == it->second.moves.end()) {
+        return;
+    }
+    // the finished move becomes the partition assignment of the retained
+    // creation, replaying it must not leave a finish without its move or a
+    // later move without the replicas it started from
+    auto& assignments = it->second.create.cmd.value.assignments;
+    auto as = std::find_if(
+      assignments.begin(),
+      assignments.end(),
+      [id = cmd.key.tp.partition](const partition_assignment& p_as) {
+          return p_as.id == id;
+      });
+    if (as != assignments.end()) {
+        as->replicas = std::move(move->second.cmd.value);
+    }
+    it->second.moves.erase(move);
+}
+
+template<typename T>
+static void fold(property_update<T>& into, property_update<T> update) {
+    if (update.op != incremental_update_operation::none) {
+        into = std::move(update);
+    }
+}
+
+void topic_updates_dispatcher::retain(
+  update_topic_properties_cmd cmd, model::offset o) {
+    auto it = _topic_commands.find(cmd.key);
+    if (it == _topic_commands.end()) {
+        return;
+    }
+    auto& properties = it->second.properties;
+    if (!properties) {
+        properties = applied_cmd<update_topic_properties_cmd>{
+          .cmd = std::move(cmd), .offset = o};
+        return;
+    }
+    // the folded update has the same effect as applying all of them in order
+    auto& into = properties->cmd.value;
+    auto& update = cmd.value;
+    fold(into.compression, std::move(update.compression));
+    fold(
+      into.cleanup_policy_bitflags, std::move(update.cleanup_policy_bitflags));
+    fold(into.compaction_strategy, std::move(update.compaction_strategy));
+    fold(into.timestamp_type, std::move(update.timestamp_type));
+    fold(into.segment_size, std::move(update.segment_size));
+    fold(into.retention_bytes, std::move(update.retention_bytes));
+    fold(into.retention_duration, std::move(update.retention_duration));
+    properties->offset = o;
+}
+
+template<typename Cmd>
+static ss::future<> serialize_applied(
+  std::vector<model::record_batch>& out, Cmd cmd, model::offset o) {
+    auto b = co_await serialize_cmd(std::move(cmd));
+    b.header().base_offset = o;
+    out.push_back(std::move(b));
+}
+
+ss::future<iobuf> topic_updates_dispatcher::take_snapshot(model::offset) {
+    iobuf buf;
+    reflection::serialize(
+      buf,
+      snapshot_version,
+      _partition_allocator.local().highest_group(),
+      static_cast<int32_t>(_topic_commands.size()));
+    for (const auto& [tp_ns, t] : _topic_commands) {
+        std::vector<model::record_batch> cmds;
+        cmds.reserve(1 + t.properties.has_value() + t.moves.size());
+        co_await serialize_applied(cmds, t.create.cmd, t.create.offset);
+        if (t.properties) {
+            co_await serialize_applied(
+              cmds, t.properties->cmd, t.properties->offset);
+        }
+        for (const auto& [_, m] : t.moves) {
+            co_await serialize_applied(cmds, m.cmd, m.offset);
+        }
+        // replayed in the order they were applied, the creation first
+        std::sort(
+          cmds.begin(),
+          cmds.end(),
+          [](const model::record_batch& l, const model::record_batch& r) {
+              return l.base_offset() < r.base_offset();
+          });
+        reflection::serialize(
+          buf, model::topic_namespace(tp_ns), std::move(cmds));
+    }
+    co_return buf;
+}
+
+ss::future<> topic_updates_dispatcher::apply_snapshot(
+  model::offset last_applied, model::offset last_included, iobuf&& data) {
+    iobuf_parser parser(std::move(data));
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    vassert(
+      version == snapshot_version,
+      "Unsupported topics snapshot version {}",
+      version);
+    auto highest_group = reflection::adl<raft::group_id>{}.from(parser);
+    auto topics_count = reflection::adl<int32_t>{}.from(parser);
+
+    // offset of the command that created each topic in the snapshot
+    absl::flat_hash_map<
+      model::topic_namespace,
+      model::offset,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      created;
+    created.reserve(topics_count);
+    // commands not yet reflected in the current state
+    std::vector<model::record_batch> missing;
+    for (int32_t i = 0; i < topics_count; ++i) {
+        auto tp_ns = reflection::adl<model::topic_namespace>{}.from(parser);
+        auto cmds = reflection::adl<std::vector<model::record_batch>>{}.from(
+          parser);
+        created.emplace(std::move(tp_ns), cmds.front().base_offset());
+        for (auto& b : cmds) {
+            if (b.base_offset() > last_applied) {
+                missing.push_back(std::move(b));
+            }
+        }
+    }
+
+    // topics that were deleted, or deleted and created again, after the
+    // last applied offset
+    std::vector<model::topic_namespace> deleted;
+    for (const auto& [tp_ns, t] : _topic_commands) {
+        auto it = created.find(tp_ns);
+        if (it == created.end() || it->second != t.create.offset) {
+            deleted.push_back(tp_ns);
+        }
+    }
+    for (auto& tp_ns : deleted) {
+        auto b = co_await serialize_cmd(delete_topic_cmd(tp_ns, tp_ns));
+        b.header().base_offset = last_included;
+        co_await apply_update(std::move(b));
+    }
+
+    std::sort(
+      missing.begin(),
+      missing.end(),
+      [](const model::record_batch& l, const model::record_batch& r) {
+          return l.base_offset() < r.base_offset();
+      });
+    for (auto& b : missing) {
+        auto offset = b.base_offset();
+        auto ec = co_await apply_update(std::move(b));
+        if (ec) {
+            vlog(
+              clusterlog.warn,
+              "Error applying topic command at offset {} from snapshot - {}",
+              offset,
+              ec.message());
+        }
+    }
+    _partition_allocator.local().update_highest_group(highest_group);
+}
+
 template<typename Cmd>
 ss::future<std::error_code> do_apply(
   ss::shard_id shard,
@@ -134,23 +369,26 @@ topic_updates_dispatcher::dispatch_updates_to_cores(Cmd cmd, model::offset o) {
 void topic_updates_dispatcher::deallocate_topic(
   const model::topic_metadata& tp_md) {
     // we have to deallocate topics
+    auto weight = partition_allocator::partition_weight(tp_md.tp_ns.tp);
     for (auto& p : tp_md.partitions) {
         for (auto& r : p.replicas) {
-            _partition_allocator.local().deallocate(r);
+            _partition_allocator.local().deallocate(r, weight);
         }
     }
 }
 
 void topic_updates_dispatcher::reallocate_partition(
+  const model::topic& topic,
   const std::vector<model::broker_shard>& previous,
   const std::vector<model::broker_shard>& current) {
+    auto weight = partition_allocator::partition_weight(topic);
     for (auto& bs : previous) {
-        _partition_allocator.local().deallocate(bs);
+        _partition_allocator.local().deallocate(bs, weight);
     }
     // we do not want to update group id in here as we are changing partition
     // that already exists, hence group id doesn't have to be updated.
     _partition_allocator.local().update_allocation_state(
-      current, raft::group_id(0));
+      current, raft::group_id(0), weight);
 }
 
 void topic_updates_dispatcher::update_allocations(const create_topic_cmd& cmd) {
@@ -164,7 +402,9 @@ void topic_updates_dispatcher::update_allocations(const create_topic_cmd& cmd) {
     }
 
     _partition_allocator.local().update_allocation_state(
-      std::move(shards), max_group_id);
+      std::move(shards),
+      max_group_id,
+      partition_allocator::partition_weight(cmd.key.tp));
 }
 
 } // namespace cluster
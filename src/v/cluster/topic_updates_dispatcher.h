@@ -17,6 +17,11 @@
 
 #include <seastar/core/sharded.hh>
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
+
+#include <optional>
+
 namespace cluster {
 
 // The topic updates dispatcher is resposible for receiving update_apply upcalls
@@ -51,8 +56,19 @@ public:
     topic_updates_dispatcher(
       ss::sharded<partition_allocator>&, ss::sharded<topic_table>&);
 
+    /// Applies a single command or a batch of commands created with
+    /// `serialize_cmds`. Commands of a batch are applied one by one, the
+    /// result is the error of the first command that failed.
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    /// Controller snapshot support, the snapshot contains commands that
+    /// created and updated topics which still exist. They are replayed with
+    /// their original offsets so that partition revisions do not change.
+    /// Only the commands needed to rebuild the current state of the topics
+    /// are kept, see `topic_commands`.
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, model::offset, iobuf&&);
+
     static constexpr auto commands = make_commands_list<
       create_topic_cmd,
       delete_topic_cmd,
@@ -65,17 +81,56 @@ public:
     }
 
 private:
+    static constexpr int8_t snapshot_version = 0;
+
+    ss::future<std::error_code>
+      apply_batched_commands(std::vector<model::record_batch>);
+
     template<typename Cmd>
     ss::future<std::error_code> dispatch_updates_to_cores(Cmd, model::offset);
 
+    void retain(create_topic_cmd, model::offset);
+    void retain(delete_topic_cmd, model::offset);
+    void retain(move_partition_replicas_cmd, model::offset);
+    void retain(finish_moving_partition_replicas_cmd, model::offset);
+    void retain(update_topic_properties_cmd, model::offset);
+
     void update_allocations(const create_topic_cmd&);
     void deallocate_topic(const model::topic_metadata&);
     void reallocate_partition(
+      const model::topic&,
       const std::vector<model::broker_shard>&,
       const std::vector<model::broker_shard>&);
 
     ss::sharded<partition_allocator>& _partition_allocator;
     ss::sharded<topic_table>& _topic_table;
+    template<typename Cmd>
+    struct applied_cmd {
+        Cmd cmd;
+        model::offset offset;
+    };
+
+    // successfully applied commands of an existing topic. Property updates
+    // are incremental and folded into a single one, finished moves are
+    // folded into the assignments of the creation and only the moves still
+    // in progress are kept. Replaying them in offset order rebuilds the
+    // current state of the topic while the memory used is bounded by the
+    // number of partitions, not of commands.
+    struct topic_commands {
+        applied_cmd<create_topic_cmd> create;
+        std::optional<applied_cmd<update_topic_properties_cmd>> properties;
+        absl::flat_hash_map<
+          model::partition_id,
+          applied_cmd<move_partition_replicas_cmd>>
+          moves;
+    };
+
+    absl::node_hash_map<
+      model::topic_namespace,
+      topic_commands,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _topic_commands;
 };
 
 } // namespace cluster
@@ -16,7 +16,9 @@
 #include "cluster/logger.h"
 #include "cluster/partition_allocator.h"
 #include "cluster/partition_leaders_table.h"
+#include "cluster/topic_table.h"
 #include "cluster/types.h"
+#include "config/configuration.h"
 #include "model/errc.h"
 #include "model/metadata.h"
 #include "model/namespace.h"
@@ -39,12 +41,14 @@ topics_frontend::topics_frontend(
   ss::sharded<rpc::connection_cache>& con,
   ss::sharded<partition_allocator>& pal,
   ss::sharded<partition_leaders_table>& l,
+  ss::sharded<topic_table>& topics,
   ss::sharded<ss::abort_source>& as)
   : _self(self)
   , _stm(s)
   , _allocator(pal)
   , _connections(con)
   , _leaders(l)
+  , _topics(topics)
   , _as(as) {}
 
 static bool
@@ -61,41 +65,73 @@ ss::future<std::vector<topic_result>> topics_frontend::create_topics(
     vlog(clusterlog.trace, "Create topics {}", topics);
     // make sure that STM is up to date (i.e. we have the most recent state
     // available) before allocating topics
-    return _stm
-      .invoke_on(
-        controller_stm_shard,
-        [timeout](controller_stm& stm) {
-            return stm.quorum_write_empty_batch(timeout);
-        })
-      .then([this, topics = std::move(topics), timeout](
-              result<raft::replicate_result> result) mutable {
-          if (!result) {
-              return ss::make_ready_future<std::vector<topic_result>>(
-                create_topic_results(topics, errc::not_leader_controller));
-          }
-          std::vector<ss::future<topic_result>> futures;
-          futures.reserve(topics.size());
-
-          std::transform(
-            std::begin(topics),
-            std::end(topics),
-            std::back_inserter(futures),
-            [this, timeout](topic_configuration& t_cfg) {
-                return do_create_topic(std::move(t_cfg), timeout);
-            });
+    auto barrier = co_await _stm.invoke_on(
+      controller_stm_shard, [timeout](controller_stm& stm) {
+          return stm.quorum_write_empty_batch(timeout);
+      });
+    if (!barrier) {
+        co_return create_topic_results(topics, errc::not_leader_controller);
+    }
 
-          return ss::when_all_succeed(futures.begin(), futures.end());
-      })
-      .then([this, timeout](std::vector<topic_result> results) {
-          if (needs_linearizable_barrier(results)) {
-              return stm_linearizable_barrier(timeout).then(
-                [results = std::move(results)](result<model::offset>) mutable {
-                    return results;
-                });
-          }
-          return ss::make_ready_future<std::vector<topic_result>>(
-            std::move(results));
+    auto results = create_topic_results(topics, errc::success);
+    std::vector<size_t> valid;
+    std::vector<topic_configuration> to_allocate;
+    valid.reserve(topics.size());
+    to_allocate.reserve(topics.size());
+    for (size_t i = 0; i < topics.size(); ++i) {
+        if (!validate_topic_name(topics[i].tp_ns)) {
+            results[i].ec = errc::invalid_topic_name;
+        } else if (_topics.local().contains(topics[i].tp_ns)) {
+            results[i].ec = errc::topic_already_exists;
+        } else {
+            valid.push_back(i);
+            to_allocate.push_back(std::move(topics[i]));
+        }
+    }
+    if (valid.empty()) {
+        co_return results;
+    }
+
+    // all the topics are allocated with a single request to the allocator
+    auto units = co_await _allocator.invoke_on(
+      partition_allocator::shard,
+      [&to_allocate](partition_allocator& al) {
+          return al.allocate(to_allocate);
+      });
+
+    // topics are replicated in batches of up to `controller_topic_batch_size`
+    // commands, each batch is a single controller log entry
+    const size_t batch_size = std::max<size_t>(
+      config::shard_local_cfg().controller_topic_batch_size(), 1);
+    std::vector<create_batch> batches;
+    for (size_t i = 0; i < valid.size(); ++i) {
+        if (!units[i]) {
+            results[valid[i]].ec = errc::topic_invalid_partitions;
+            continue;
+        }
+        if (batches.empty() || batches.back().cfgs.size() == batch_size) {
+            batches.emplace_back();
+        }
+        auto& batch = batches.back();
+        batch.indexes.push_back(valid[i]);
+        batch.cfgs.push_back(std::move(to_allocate[i]));
+        batch.units.push_back(std::move(*units[i]));
+    }
+
+    auto batch_results = co_await ssx::parallel_transform(
+      std::move(batches), [this, timeout](create_batch batch) {
+          return replicate_create_topics(std::move(batch), timeout);
       });
+    for (auto& batch_result : batch_results) {
+        for (auto& [idx, ec] : batch_result) {
+            results[idx].ec = ec;
+        }
+    }
+
+    if (needs_linearizable_barrier(results)) {
+        co_await stm_linearizable_barrier(timeout).discard_result();
+    }
+    co_return results;
 }
 
 cluster::errc map_errc(std::error_code ec) {
@@ -222,79 +258,92 @@ ss::future<std::error_code> topics_frontend::replicate_and_wait(
       });
 }
 
-ss::future<topic_result> topics_frontend::do_create_topic(
-  topic_configuration t_cfg, model::timeout_clock::time_point timeout) {
-    if (!validate_topic_name(t_cfg.tp_ns)) {
-        return ss::make_ready_future<topic_result>(
-          topic_result(t_cfg.tp_ns, errc::invalid_topic_name));
-    }
-    return _allocator
-      .invoke_on(
-        partition_allocator::shard,
-        [t_cfg](partition_allocator& al) { return al.allocate(t_cfg); })
-      .then(
-        [this, t_cfg = std::move(t_cfg), timeout](
-          std::optional<partition_allocator::allocation_units> units) mutable {
-            // no assignments, error
-            if (!units) {
-                return ss::make_ready_future<topic_result>(
-                  topic_result(t_cfg.tp_ns, errc::topic_invalid_partitions));
-            }
-
-            return replicate_create_topic(
-              std::move(t_cfg), std::move(*units), timeout);
-        });
+template<typename Cmd>
+ss::future<std::error_code> topics_frontend::replicate_and_wait_batch(
+  std::vector<Cmd> cmds, model::timeout_clock::time_point timeout) {
+    return _stm.invoke_on(
+      controller_stm_shard,
+      [cmds = std::move(cmds), &as = _as, timeout](
+        controller_stm& stm) mutable {
+          return serialize_cmds(std::move(cmds))
+            .then([&stm, timeout, &as](model::record_batch b) {
+                return stm.replicate_and_wait(
+                  std::move(b), timeout, as.local());
+            });
+      });
 }
 
-ss::future<topic_result> topics_frontend::replicate_create_topic(
-  topic_configuration cfg,
-  partition_allocator::allocation_units units,
-  model::timeout_clock::time_point timeout) {
-    auto tp_ns = cfg.tp_ns;
-    create_topic_cmd cmd(
-      tp_ns,
-      topic_configuration_assignment(std::move(cfg), units.get_assignments()));
-
-    std::vector<ntp_leader> leaders;
-    leaders.reserve(cmd.value.assignments.size());
-    for (auto& p_as : cmd.value.assignments) {
-        std::shuffle(
-          p_as.replicas.begin(),
-          p_as.replicas.end(),
-          random_generators::internal::gen);
-        // guesstimate leaders
-        leaders.emplace_back(
-          model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
-          p_as.replicas.begin()->node_id);
+ss::future<std::vector<std::pair<size_t, errc>>>
+topics_frontend::replicate_create_topics(
+  create_batch batch, model::timeout_clock::time_point timeout) {
+    std::vector<create_topic_cmd> cmds;
+    // guesstimated leaders of every topic partitions
+    std::vector<std::vector<ntp_leader>> leaders;
+    cmds.reserve(batch.cfgs.size());
+    leaders.reserve(batch.cfgs.size());
+    for (size_t i = 0; i < batch.cfgs.size(); ++i) {
+        auto tp_ns = batch.cfgs[i].tp_ns;
+        create_topic_cmd cmd(
+          tp_ns,
+          topic_configuration_assignment(
+            std::move(batch.cfgs[i]), batch.units[i].get_assignments()));
+
+        auto& topic_leaders = leaders.emplace_back();
+        topic_leaders.reserve(cmd.value.assignments.size());
+        for (auto& p_as : cmd.value.assignments) {
+            std::shuffle(
+              p_as.replicas.begin(),
+              p_as.replicas.end(),
+              random_generators::internal::gen);
+            topic_leaders.emplace_back(
+              model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
+              p_as.replicas.begin()->node_id);
+        }
+        cmds.push_back(std::move(cmd));
     }
 
-    return replicate_and_wait(std::move(cmd), timeout)
-      .then_wrapped(
-        [this,
-         tp_ns = std::move(tp_ns),
-         units = std::move(units),
-         leaders = std::move(leaders)](ss::future<std::error_code> f) mutable {
-            try {
-                auto error_code = f.get0();
-                auto ret_f = ss::now();
-                if (!error_code) {
-                    ret_f = update_leaders_with_estimates(std::move(leaders));
-                }
-
-                return ret_f.then([tp_ns = std::move(tp_ns),
-                                   error_code]() mutable {
-                    return topic_result(std::move(tp_ns), map_errc(error_code));
-                });
+    std::vector<std::pair<size_t, errc>> ret;
+    ret.reserve(batch.indexes.size());
+    std::error_code ec;
+    try {
+        ec = co_await replicate_and_wait_batch(std::move(cmds), timeout);
+    } catch (...) {
+        vlog(
+          clusterlog.warn,
+          "Unable to create topics - {}",
+          std::current_exception());
+        for (auto idx : batch.indexes) {
+            ret.emplace_back(idx, errc::replication_error);
+        }
+        co_return ret;
+    }
 
-            } catch (...) {
-                vlog(
-                  clusterlog.warn,
-                  "Unable to create topic - {}",
-                  std::current_exception());
-                return ss::make_ready_future<topic_result>(
-                  topic_result(std::move(tp_ns), errc::replication_error));
+    // when some of the commands failed to apply the error is the one of the
+    // first failed command, a topic was created by this request if its
+    // partitions have the raft groups allocated here
+    const bool partially_applied = ec && ec.category() == error_category();
+    std::vector<ntp_leader> created_leaders;
+    for (size_t i = 0; i < batch.indexes.size(); ++i) {
+        auto result = map_errc(ec);
+        if (partially_applied && !leaders[i].empty()) {
+            const auto& first = batch.units[i].get_assignments().front();
+            auto assignment = _topics.local().get_partition_assignment(
+              leaders[i].front().first);
+            if (assignment && assignment->group == first.group) {
+                result = errc::success;
             }
-        });
+        }
+        if (result == errc::success) {
+            std::move(
+              leaders[i].begin(),
+              leaders[i].end(),
+              std::back_inserter(created_leaders));
+        }
+        ret.emplace_back(batch.indexes[i], result);
+    }
+
+    co_await update_leaders_with_estimates(std::move(created_leaders));
+    co_return ret;
 }
 
 ss::future<> topics_frontend::update_leaders_with_estimates(
@@ -314,51 +363,72 @@ ss::future<> topics_frontend::update_leaders_with_estimates(
 ss::future<std::vector<topic_result>> topics_frontend::delete_topics(
   std::vector<model::topic_namespace> topics,
   model::timeout_clock::time_point timeout) {
-    std::vector<ss::future<topic_result>> futures;
-    futures.reserve(topics.size());
-
-    std::transform(
-      std::begin(topics),
-      std::end(topics),
-      std::back_inserter(futures),
-      [this, timeout](model::topic_namespace& tp_ns) {
-          return do_delete_topic(std::move(tp_ns), timeout);
-      });
+    auto results = create_topic_results(topics, errc::success);
+    const size_t batch_size = std::max<size_t>(
+      config::shard_local_cfg().controller_topic_batch_size(), 1);
+    std::vector<delete_batch> batches;
+    for (size_t i = 0; i < topics.size(); ++i) {
+        if (!_topics.local().contains(topics[i])) {
+            results[i].ec = errc::topic_not_exists;
+            continue;
+        }
+        if (batches.empty() || batches.back().topics.size() == batch_size) {
+            batches.emplace_back();
+        }
+        batches.back().indexes.push_back(i);
+        batches.back().topics.push_back(std::move(topics[i]));
+    }
 
-    return ss::when_all_succeed(futures.begin(), futures.end())
-      .then([this, timeout](std::vector<topic_result> results) {
-          if (needs_linearizable_barrier(results)) {
-              return stm_linearizable_barrier(timeout).then(
-                [results = std::move(results)](result<model::offset>) mutable {
-                    return results;
-                });
-          }
-          return ss::make_ready_future<std::vector<topic_result>>(
-            std::move(results));
+    auto batch_results = co_await ssx::parallel_transform(
+      std::move(batches), [this, timeout](delete_batch batch) {
+          return replicate_delete_topics(std::move(batch), timeout);
       });
+    for (auto& batch_result : batch_results) {
+        for (auto& [idx, ec] : batch_result) {
+            results[idx].ec = ec;
+        }
+    }
+
+    if (needs_linearizable_barrier(results)) {
+        co_await stm_linearizable_barrier(timeout).discard_result();
+    }
+    co_return results;
 }
 
-ss::future<topic_result> topics_frontend::do_delete_topic(
-  model::topic_namespace tp_ns, model::timeout_clock::time_point timeout) {
-    delete_topic_cmd cmd(tp_ns, tp_ns);
-
-    return replicate_and_wait(std::move(cmd), timeout)
-      .then_wrapped(
-        [tp_ns = std::move(tp_ns)](ss::future<std::error_code> f) mutable {
-            try {
-                auto ec = f.get0();
-                if (ec != errc::success) {
-                    return topic_result(std::move(tp_ns), map_errc(ec));
-                }
-                return topic_result(std::move(tp_ns), errc::success);
-            } catch (...) {
-                vlog(
-                  clusterlog.warn,
-                  "Unable to delete topic - {}",
-                  std::current_exception());
-                return topic_result(std::move(tp_ns), errc::replication_error);
-            }
-        });
+ss::future<std::vector<std::pair<size_t, errc>>>
+topics_frontend::replicate_delete_topics(
+  delete_batch batch, model::timeout_clock::time_point timeout) {
+    std::vector<delete_topic_cmd> cmds;
+    cmds.reserve(batch.topics.size());
+    for (const auto& tp_ns : batch.topics) {
+        cmds.emplace_back(tp_ns, tp_ns);
+    }
+
+    std::vector<std::pair<size_t, errc>> ret;
+    ret.reserve(batch.indexes.size());
+    std::error_code ec;
+    try {
+        ec = co_await replicate_and_wait_batch(std::move(cmds), timeout);
+    } catch (...) {
+        vlog(
+          clusterlog.warn,
+          "Unable to delete topics - {}",
+          std::current_exception());
+        for (auto idx : batch.indexes) {
+            ret.emplace_back(idx, errc::replication_error);
+        }
+        co_return ret;
+    }
+
+    const bool partially_applied = ec && ec.category() == error_category();
+    for (size_t i = 0; i < batch.indexes.size(); ++i) {
+        auto result = map_errc(ec);
+        if (partially_applied && !_topics.local().contains(batch.topics[i])) {
+            result = errc::success;
+        }
+        ret.emplace_back(batch.indexes[i], result);
+    }
+    co_return ret;
 }
 
 ss::future<std::vector<topic_result>> topics_frontend::autocreate_topics(
@@ -425,9 +495,40 @@ ss::future<std::error_code> topics_frontend::move_partition_replicas(
   model::ntp ntp,
   std::vector<model::broker_shard> new_replica_set,
   model::timeout_clock::time_point tout) {
-    move_partition_replicas_cmd cmd(std::move(ntp), std::move(new_replica_set));
+    auto leader = _leaders.local().get_leader(model::controller_ntp);
 
-    return replicate_and_wait(std::move(cmd), tout);
+    // no leader available
+    if (!leader) {
+        return ss::make_ready_future<std::error_code>(
+          errc::no_leader_controller);
+    }
+    // current node is a leader, just replicate
+    if (leader == _self) {
+        move_partition_replicas_cmd cmd(
+          std::move(ntp), std::move(new_replica_set));
+
+        return replicate_and_wait(std::move(cmd), tout);
+    }
+
+    return _connections.local()
+      .with_node_client<controller_client_protocol>(
+        _self,
+        ss::this_shard_id(),
+        *leader,
+        tout,
+        [ntp = std::move(ntp), replicas = std::move(new_replica_set), tout](
+          controller_client_protocol client) mutable {
+            return client
+              .move_partition_replicas(
+                move_partition_replicas_request{
+                  .ntp = std::move(ntp),
+                  .new_replica_set = std::move(replicas)},
+                rpc::client_opts(tout))
+              .then(&rpc::get_ctx_data<move_partition_replicas_reply>);
+        })
+      .then([](result<move_partition_replicas_reply> r) {
+          return r.has_error() ? r.error() : r.value().result;
+      });
 }
 
 ss::future<std::error_code> topics_frontend::finish_moving_partition_replicas(
@@ -12,7 +12,9 @@
 #pragma once
 
 #include "cluster/controller_stm.h"
+#include "cluster/errc.h"
 #include "cluster/fwd.h"
+#include "cluster/partition_allocator.h"
 #include "model/metadata.h"
 #include "model/record.h"
 #include "model/timeout_clock.h"
@@ -35,8 +37,13 @@ public:
       ss::sharded<rpc::connection_cache>&,
       ss::sharded<partition_allocator>&,
       ss::sharded<partition_leaders_table>&,
+      ss::sharded<topic_table>&,
       ss::sharded<ss::abort_source>&);
 
+    /// Topics are allocated with a single allocator request and replicated
+    /// in batches of up to `controller_topic_batch_size` commands per
+    /// controller log entry. The default of 1 keeps one command per entry,
+    /// which is the only layout nodes before batching can apply
     ss::future<std::vector<topic_result>> create_topics(
       std::vector<topic_configuration>, model::timeout_clock::time_point);
 
@@ -62,21 +69,34 @@ public:
 private:
     using ntp_leader = std::pair<model::ntp, model::node_id>;
 
-    ss::future<topic_result>
-      do_create_topic(topic_configuration, model::timeout_clock::time_point);
+    // topics replicated with a single controller log entry, `indexes` are
+    // the positions of the topics in the request
+    struct create_batch {
+        std::vector<size_t> indexes;
+        std::vector<topic_configuration> cfgs;
+        std::vector<partition_allocator::allocation_units> units;
+    };
 
-    ss::future<topic_result> replicate_create_topic(
-      topic_configuration,
-      partition_allocator::allocation_units,
-      model::timeout_clock::time_point);
+    struct delete_batch {
+        std::vector<size_t> indexes;
+        std::vector<model::topic_namespace> topics;
+    };
+
+    ss::future<std::vector<std::pair<size_t, errc>>>
+      replicate_create_topics(create_batch, model::timeout_clock::time_point);
 
-    ss::future<topic_result>
-      do_delete_topic(model::topic_namespace, model::timeout_clock::time_point);
+    ss::future<std::vector<std::pair<size_t, errc>>>
+      replicate_delete_topics(delete_batch, model::timeout_clock::time_point);
 
     template<typename Cmd>
     ss::future<std::error_code>
     replicate_and_wait(Cmd&&, model::timeout_clock::time_point);
 
+    template<typename Cmd>
+    ss::future<std::error_code>
+    replicate_and_wait_batch(
+      std::vector<Cmd>, model::timeout_clock::time_point);
+
     ss::future<std::vector<topic_result>> dispatch_create_to_leader(
       model::node_id,
       std::vector<topic_configuration>,
@@ -96,6 +116,7 @@ private:
     ss::sharded<partition_allocator>& _allocator;
     ss::sharded<rpc::connection_cache>& _connections;
     ss::sharded<partition_leaders_table>& _leaders;
+    ss::sharded<topic_table>& _topics;
     ss::sharded<ss::abort_source>& _as;
 };
 
@@ -250,6 +250,15 @@ struct create_topics_reply {
     std::vector<topic_configuration> configs;
 };
 
+struct move_partition_replicas_request {
+    model::ntp ntp;
+    std::vector<model::broker_shard> new_replica_set;
+};
+
+struct move_partition_replicas_reply {
+    cluster::errc result;
+};
+
 struct finish_partition_update_request {
     model::ntp ntp;
     std::vector<model::broker_shard> new_replica_set;
@@ -259,6 +268,28 @@ struct finish_partition_update_reply {
     cluster::errc result;
 };
 
+struct transfer_leadership_request {
+    model::ntp ntp;
+    std::optional<model::node_id> target;
+};
+
+struct transfer_leadership_reply {
+    cluster::errc result;
+};
+
+/// load of a single core of a node, counters are cumulative
+struct shard_load {
+    // records produced to and fetched from the partitions of the core
+    uint64_t records{0};
+    uint64_t disk_bytes{0};
+};
+
+struct node_load_request {};
+
+struct node_load_reply {
+    std::vector<shard_load> shards;
+};
+
 struct update_topic_properties_request {
     std::vector<topic_properties_update> updates;
 };
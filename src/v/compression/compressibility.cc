@@ -0,0 +1,74 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/compressibility.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace compression {
+
+static constexpr size_t sample_window_size = 256;
+
+double estimate_entropy(const iobuf& buf, size_t sample_bytes) {
+    const size_t total = buf.size_bytes();
+    if (total == 0 || sample_bytes == 0) {
+        return 0;
+    }
+    std::array<uint32_t, 256> counts{};
+    size_t sampled = 0;
+    auto count = [&counts, &sampled](const char* src, size_t n) {
+        const auto* p = reinterpret_cast<const uint8_t*>(src);
+        for (size_t i = 0; i < n; ++i) {
+            ++counts[p[i]];
+        }
+        sampled += n;
+    };
+
+    if (total <= sample_bytes) {
+        for (const auto& frag : buf) {
+            count(frag.get(), frag.size());
+        }
+    } else {
+        const size_t windows = std::max<size_t>(
+          1, sample_bytes / sample_window_size);
+        const size_t stride = total / windows;
+        // absolute offset of the next window, windows crossing a fragment
+        // boundary are cut short
+        size_t next = 0;
+        size_t frag_begin = 0;
+        for (const auto& frag : buf) {
+            const size_t frag_end = frag_begin + frag.size();
+            while (next < frag_end && sampled < sample_bytes) {
+                const size_t pos = next - frag_begin;
+                count(
+                  frag.get() + pos,
+                  std::min(sample_window_size, frag.size() - pos));
+                next += stride;
+            }
+            if (sampled >= sample_bytes) {
+                break;
+            }
+            frag_begin = frag_end;
+        }
+    }
+
+    double entropy = 0;
+    const auto n = static_cast<double>(sampled);
+    for (auto c : counts) {
+        if (c != 0) {
+            const double p = c / n;
+            entropy -= p * std::log2(p);
+        }
+    }
+    return entropy;
+}
+
+} // namespace compression
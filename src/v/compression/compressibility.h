@@ -0,0 +1,30 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/iobuf.h"
+#include "units.h"
+
+namespace compression {
+
+/// \brief cheap order-0 entropy estimate of a buffer in bits per byte.
+/// Buffers larger than `sample_bytes` are sampled with small windows evenly
+/// spread over the whole buffer so that the cost does not depend on its size.
+double estimate_entropy(const iobuf&, size_t sample_bytes = 4_KiB);
+
+/// \brief entropy of already compressed or encrypted data is close to 8 bits
+/// per byte; spending CPU on compressing it again gains close to nothing
+inline bool
+is_compressible(const iobuf& buf, double max_bits_per_byte = 7.5) {
+    return estimate_entropy(buf) < max_bits_per_byte;
+}
+
+} // namespace compression
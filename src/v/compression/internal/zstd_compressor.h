@@ -16,12 +16,10 @@ namespace compression::internal {
 
 struct zstd_compressor {
     static iobuf compress(const iobuf& b) {
-        stream_zstd fn;
-        return fn.compress(b);
+        return shard_local_zstd().compress(b);
     }
     static iobuf uncompress(const iobuf& b) {
-        stream_zstd fn;
-        return fn.uncompress(b);
+        return shard_local_zstd().uncompress(b);
     }
 };
 
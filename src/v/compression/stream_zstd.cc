@@ -61,8 +61,10 @@ stream_zstd::zstd_decompress_ctx& stream_zstd::decompressor() {
 }
 
 iobuf stream_zstd::do_compress(const iobuf& x) {
-    reset_compressor();
+    // contexts are expensive to create, reuse them between frames and only
+    // drop the state of the previous (possibly failed) frame
     ZSTD_CCtx* ctx = compressor().get();
+    throw_if_error(ZSTD_CCtx_reset(ctx, ZSTD_reset_session_only));
     // NOTE: always enable content size. **decompression** depends on this
     throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, x.size_bytes()));
     // zstd requires linearized memory
@@ -133,8 +135,8 @@ iobuf stream_zstd::do_uncompress(const iobuf& x) {
         throw std::runtime_error(
           "Asked to stream_zstd::uncompress empty buffer");
     }
-    reset_decompressor();
     ZSTD_DCtx* dctx = decompressor().get();
+    throw_if_error(ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only));
     iobuf ret;
     ss::temporary_buffer<char> obuf(decompression_step(x));
     ZSTD_outBuffer out = {
@@ -157,4 +159,9 @@ iobuf stream_zstd::do_uncompress(const iobuf& x) {
     return ret;
 }
 
+stream_zstd& shard_local_zstd() {
+    static thread_local stream_zstd zstd;
+    return zstd;
+}
+
 } // namespace compression
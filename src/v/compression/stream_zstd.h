@@ -46,4 +46,8 @@ private:
     zstd_decompress_ctx _decompress{nullptr};
 };
 
+/// \brief per shard instance keeping its zstd contexts across calls, use it
+/// instead of a temporary stream_zstd on hot paths
+stream_zstd& shard_local_zstd();
+
 } // namespace compression
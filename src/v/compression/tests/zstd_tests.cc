@@ -7,6 +7,7 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "compression/compressibility.h"
 #include "compression/internal/gzip_compressor.h"
 #include "compression/internal/lz4_frame_compressor.h"
 #include "compression/internal/snappy_java_compressor.h"
@@ -85,3 +86,39 @@ SEASTAR_THREAD_TEST_CASE(gzip_test) {
     using fn = compression::internal::gzip_compressor;
     roundtrip_compression(fn::compress, fn::uncompress);
 }
+
+SEASTAR_THREAD_TEST_CASE(stream_zstd_context_reuse_test) {
+    auto& fn = compression::shard_local_zstd();
+    for (size_t i : sizes) {
+        iobuf buf = gen(i);
+        auto dbuf = fn.uncompress(fn.compress(buf));
+        BOOST_CHECK_EQUAL(dbuf, buf);
+    }
+    // a failed frame must not poison the context for the next one
+    BOOST_CHECK_THROW(fn.uncompress(gen(1_KiB)), std::runtime_error);
+    iobuf buf = gen(4_KiB);
+    BOOST_CHECK_EQUAL(fn.uncompress(fn.compress(buf)), buf);
+}
+
+SEASTAR_THREAD_TEST_CASE(entropy_estimate_test) {
+    BOOST_CHECK_EQUAL(compression::estimate_entropy(iobuf{}), 0);
+    // repeated alphanumeric text
+    BOOST_CHECK(compression::is_compressible(gen(64_KiB)));
+
+    // random bytes and the output of a compressor are not worth compressing
+    auto random = random_generators::get_bytes(64_KiB);
+    iobuf random_buf;
+    random_buf.append(random.data(), random.size());
+    BOOST_CHECK(!compression::is_compressible(random_buf));
+
+    iobuf text;
+    for (int i = 0; i < 64; ++i) {
+        auto s = random_generators::gen_alphanum_string(1_KiB);
+        text.append(s.data(), s.size());
+    }
+    auto compressed = compression::shard_local_zstd().compress(text);
+    BOOST_CHECK_GT(compression::estimate_entropy(compressed), 7.5);
+    BOOST_CHECK_LT(
+      compression::estimate_entropy(text),
+      compression::estimate_entropy(compressed));
+}
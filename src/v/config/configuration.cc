@@ -109,6 +109,36 @@ configuration::configuration()
       "raft heartbeat RPC timeout",
       required::no,
       3s)
+  , raft_idle_heartbeat_suppression(
+      *this,
+      "raft_idle_heartbeat_suppression",
+      "Replace per group heartbeats of quiescent raft groups with node level "
+      "liveness heartbeats. Nodes that predate it start elections for such "
+      "groups, enable it only once every node of the cluster is upgraded",
+      required::no,
+      false)
+  , raft_idle_heartbeat_refresh_ms(
+      *this,
+      "raft_idle_heartbeat_refresh_ms",
+      "Interval at which quiescent raft groups still send a per group "
+      "heartbeat; followers stop trusting node level liveness for a group "
+      "that did not hear from its leader for this long",
+      required::no,
+      5s)
+  , raft_leader_lease_enabled(
+      *this,
+      "raft_leader_lease_enabled",
+      "Serve linearizable reads locally on a leader holding a valid lease "
+      "instead of confirming leadership with a round of heartbeats",
+      required::no,
+      false)
+  , raft_leader_lease_max_clock_drift_ms(
+      *this,
+      "raft_leader_lease_max_clock_drift_ms",
+      "Upper bound of the clock rate drift between nodes over a single "
+      "election timeout, subtracted from the leader lease duration",
+      required::no,
+      100ms)
   , seed_servers(
       *this,
       "seed_servers",
@@ -312,6 +342,43 @@ configuration::configuration()
       "Default topic compression type",
       required::no,
       model::compression::producer)
+  , kafka_recompression_budget_bytes(
+      *this,
+      "kafka_recompression_budget_bytes",
+      "Bytes of produced batches each core recompresses to the topic "
+      "compression type at a time, batches produced above the budget are "
+      "stored as produced. Zero disables recompression",
+      required::no,
+      8_MiB)
+  , kafka_recompression_max_batch_bytes(
+      *this,
+      "kafka_recompression_max_batch_bytes",
+      "Largest produced batch recompressed to the topic compression type, "
+      "larger batches are stored as produced so that compressing one does "
+      "not stall the core",
+      required::no,
+      256_KiB)
+  , kafka_fetch_max_nonlocal_requests(
+      *this,
+      "kafka_fetch_max_nonlocal_requests",
+      "Maximum number of fetch reads each core can have in flight on other "
+      "cores, further reads wait until one completes",
+      required::no,
+      1000)
+  , kafka_produce_max_nonlocal_requests(
+      *this,
+      "kafka_produce_max_nonlocal_requests",
+      "Maximum number of produce writes each core can have in flight on other "
+      "cores, further writes wait until one completes",
+      required::no,
+      5000)
+  , raft_foreign_reader_max_nonlocal_requests(
+      *this,
+      "raft_foreign_reader_max_nonlocal_requests",
+      "Maximum number of slices of replicated batches each core can be "
+      "loading from other cores, further loads wait until one completes",
+      required::no,
+      1000)
   , transactional_id_expiration_ms(
       *this,
       "transactional_id_expiration_ms",
@@ -345,6 +412,50 @@ configuration::configuration()
       "max bytes per partition on disk before triggering a compaction",
       required::no,
       std::nullopt)
+  , log_housekeeping_concurrency(
+      *this,
+      "log_housekeeping_concurrency",
+      "Number of partitions compacted concurrently by each core",
+      required::no,
+      2)
+  , log_housekeeping_budget_bytes(
+      *this,
+      "log_housekeeping_budget_bytes",
+      "Bytes of segments waiting to be compacted that each core takes on in "
+      "a compaction round, the remaining partitions are deferred to the next "
+      "round",
+      required::no,
+      1_GiB)
+  , disk_pressure_check_interval_ms(
+      *this,
+      "disk_pressure_check_interval_ms",
+      "How often the free space of the data directory is checked, zero "
+      "disables eviction under disk pressure",
+      required::no,
+      0ms)
+  , disk_pressure_high_watermark_percent(
+      *this,
+      "disk_pressure_high_watermark_percent",
+      "Disk usage of the data directory above which the oldest segments of "
+      "all partitions are evicted",
+      required::no,
+      90)
+  , disk_pressure_low_watermark_percent(
+      *this,
+      "disk_pressure_low_watermark_percent",
+      "Disk usage of the data directory eviction under disk pressure brings "
+      "the node back to",
+      required::no,
+      80)
+  , compaction_key_fingerprints(
+      *this,
+      "compaction_key_fingerprints",
+      "Deduplicate keys during compaction by fixed width fingerprints rather "
+      "than full keys, fitting many more distinct keys in memory. Keys are "
+      "not compared, so two keys colliding on their 96 bit fingerprint are "
+      "deduplicated as one and the older record is lost",
+      required::no,
+      false)
   , group_topic_partitions(
       *this,
       "group_topic_partitions",
@@ -393,6 +504,22 @@ configuration::configuration()
       "Kafka group recovery timeout expressed in milliseconds",
       required::no,
       30'000ms)
+  , group_snapshot_interval_ms(
+      *this,
+      "group_snapshot_interval_ms",
+      "Interval at which consumer group state is snapshotted so that "
+      "coordinator recovery only replays the tail of the group log. Zero "
+      "disables snapshots",
+      required::no,
+      600'000ms)
+  , group_offset_commit_batch_window_ms(
+      *this,
+      "group_offset_commit_batch_window_ms",
+      "Time window in which offset commits of different consumer groups on "
+      "the same coordinator partition are coalesced into a single replicate "
+      "call. Zero disables coalescing",
+      required::no,
+      1ms)
   , replicate_append_timeout_ms(
       *this,
       "replicate_append_timeout_ms",
@@ -406,6 +533,13 @@ configuration::configuration()
       "follower",
       required::no,
       5s)
+  , raft_recovery_max_inflight_requests(
+      *this,
+      "raft_recovery_max_inflight_requests",
+      "Maximum number of append entries requests in flight to a single "
+      "follower while it is being recovered",
+      required::no,
+      4)
   , raft_replicate_batch_window_size(
       *this,
       "raft_replicate_batch_window_size",
@@ -540,6 +674,114 @@ configuration::configuration()
       "Interval between iterations of controller backend housekeeping loop",
       required::no,
       1s)
+  , controller_snapshot_interval_entries(
+      *this,
+      "controller_snapshot_interval_entries",
+      "Number of controller log entries applied after the latest controller "
+      "snapshot that triggers taking the next one and truncating the log, "
+      "0 disables controller snapshots",
+      required::no,
+      10'000)
+  , controller_topic_batch_size(
+      *this,
+      "controller_topic_batch_size",
+      "Maximum number of topics created or deleted with a single controller "
+      "log entry. Nodes older than multi command controller entries crash "
+      "applying them, raise it above 1 only once every node is upgraded",
+      required::no,
+      1)
+  , controller_backend_reconciliation_concurrency(
+      *this,
+      "controller_backend_reconciliation_concurrency",
+      "Maximum number of partitions reconciled concurrently on every core",
+      required::no,
+      64)
+  , enable_leader_balancer(
+      *this,
+      "enable_leader_balancer",
+      "Enable automatic balancing of partition leadership across shards",
+      required::no,
+      true)
+  , leader_balancer_dry_run(
+      *this,
+      "leader_balancer_dry_run",
+      "Compute and publish leadership balancing plans without executing them",
+      required::no,
+      false)
+  , leader_balancer_interval_ms(
+      *this,
+      "leader_balancer_interval_ms",
+      "Interval at which the leader balancer plans leadership transfers",
+      required::no,
+      60'000ms)
+  , leader_balancer_mute_timeout_ms(
+      *this,
+      "leader_balancer_mute_timeout_ms",
+      "Time during which a partition moved by the leader balancer is not "
+      "considered for another move",
+      required::no,
+      300'000ms)
+  , leader_balancer_max_transfers(
+      *this,
+      "leader_balancer_max_transfers",
+      "Maximum number of leadership transfers per leader balancer interval",
+      required::no,
+      16)
+  , partition_allocation_weights(
+      *this,
+      "partition_allocation_weights",
+      "Relative load of a single partition of a topic used when placing new "
+      "partitions, as a list of <topic>:<weight> entries. Partitions of "
+      "topics that are not listed weigh 1",
+      required::no,
+      {})
+  , partition_allocation_load_interval_ms(
+      *this,
+      "partition_allocation_load_interval_ms",
+      "Interval at which the controller leader collects the per core load of "
+      "the nodes used when placing new partitions, 0 disables load collection",
+      required::no,
+      30'000ms)
+  , enable_core_balancer(
+      *this,
+      "enable_core_balancer",
+      "Enable moving partitions between the cores of a node when their load "
+      "is skewed",
+      required::no,
+      false)
+  , core_balancer_interval_ms(
+      *this,
+      "core_balancer_interval_ms",
+      "Interval at which the core balancer samples the load of the cores",
+      required::no,
+      60'000ms)
+  , core_balancer_skew_threshold_percent(
+      *this,
+      "core_balancer_skew_threshold_percent",
+      "Difference between the busiest and idlest core, relative to the "
+      "average core load, above which partitions are moved between cores",
+      required::no,
+      50)
+  , core_balancer_sustained_intervals(
+      *this,
+      "core_balancer_sustained_intervals",
+      "Number of consecutive samples the core load skew has to stay above "
+      "the threshold before partitions are moved",
+      required::no,
+      3)
+  , core_balancer_max_moves(
+      *this,
+      "core_balancer_max_moves",
+      "Maximum number of partitions moved between cores per interval",
+      required::no,
+      1)
+  , core_balancer_mute_timeout_ms(
+      *this,
+      "core_balancer_mute_timeout_ms",
+      "Time during which a partition moved by the core balancer is not "
+      "considered for another move",
+      required::no,
+      600'000ms)
   , cloud_storage_enabled(
       *this,
       "cloud_storage_enabled",
@@ -60,6 +60,10 @@ struct configuration final : public config_store {
     property<int32_t> seed_server_meta_topic_partitions;
     property<std::chrono::milliseconds> raft_heartbeat_interval_ms;
     property<std::chrono::milliseconds> raft_heartbeat_timeout_ms;
+    property<bool> raft_idle_heartbeat_suppression;
+    property<std::chrono::milliseconds> raft_idle_heartbeat_refresh_ms;
+    property<bool> raft_leader_lease_enabled;
+    property<std::chrono::milliseconds> raft_leader_lease_max_clock_drift_ms;
     property<std::vector<seed_server>> seed_servers;
     property<int16_t> min_version;
     property<int16_t> max_version;
@@ -95,6 +99,11 @@ struct configuration final : public config_store {
     property<model::cleanup_policy_bitflags> log_cleanup_policy;
     property<model::timestamp_type> log_message_timestamp_type;
     property<model::compression> log_compression_type;
+    property<size_t> kafka_recompression_budget_bytes;
+    property<size_t> kafka_recompression_max_batch_bytes;
+    property<size_t> kafka_fetch_max_nonlocal_requests;
+    property<size_t> kafka_produce_max_nonlocal_requests;
+    property<size_t> raft_foreign_reader_max_nonlocal_requests;
     // same as transactional.id.expiration.ms in kafka
     property<std::chrono::milliseconds> transactional_id_expiration_ms;
     property<bool> enable_idempotence;
@@ -104,6 +113,12 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> log_compaction_interval_ms;
     // same as retention.size in kafka - TODO: size not implemented
     property<std::optional<size_t>> retention_bytes;
+    property<size_t> log_housekeeping_concurrency;
+    property<size_t> log_housekeeping_budget_bytes;
+    property<std::chrono::milliseconds> disk_pressure_check_interval_ms;
+    property<uint32_t> disk_pressure_high_watermark_percent;
+    property<uint32_t> disk_pressure_low_watermark_percent;
+    property<bool> compaction_key_fingerprints;
     property<int32_t> group_topic_partitions;
     property<int16_t> default_topic_replication;
     property<std::chrono::milliseconds> create_topic_timeout_ms;
@@ -112,8 +127,11 @@ struct configuration final : public config_store {
     property<bool> disable_batch_cache;
     property<std::chrono::milliseconds> raft_election_timeout_ms;
     property<std::chrono::milliseconds> kafka_group_recovery_timeout_ms;
+    property<std::chrono::milliseconds> group_snapshot_interval_ms;
+    property<std::chrono::milliseconds> group_offset_commit_batch_window_ms;
     property<std::chrono::milliseconds> replicate_append_timeout_ms;
     property<std::chrono::milliseconds> recovery_append_timeout_ms;
+    property<size_t> raft_recovery_max_inflight_requests;
     property<size_t> raft_replicate_batch_window_size;
 
     property<size_t> reclaim_min_size;
@@ -139,6 +157,22 @@ struct configuration final : public config_store {
     property<bool> enable_sasl;
     property<std::chrono::milliseconds>
       controller_backend_housekeeping_interval_ms;
+    property<size_t> controller_snapshot_interval_entries;
+    property<size_t> controller_topic_batch_size;
+    property<size_t> controller_backend_reconciliation_concurrency;
+    property<bool> enable_leader_balancer;
+    property<bool> leader_balancer_dry_run;
+    property<std::chrono::milliseconds> leader_balancer_interval_ms;
+    property<std::chrono::milliseconds> leader_balancer_mute_timeout_ms;
+    property<size_t> leader_balancer_max_transfers;
+    one_or_many_property<ss::sstring> partition_allocation_weights;
+    property<std::chrono::milliseconds> partition_allocation_load_interval_ms;
+    property<bool> enable_core_balancer;
+    property<std::chrono::milliseconds> core_balancer_interval_ms;
+    property<size_t> core_balancer_skew_threshold_percent;
+    property<size_t> core_balancer_sustained_intervals;
+    property<size_t> core_balancer_max_moves;
+    property<std::chrono::milliseconds> core_balancer_mute_timeout_ms;
 
     // Archival storage
     property<bool> cloud_storage_enabled;
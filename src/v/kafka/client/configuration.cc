@@ -67,6 +67,13 @@ configuration::configuration()
       "Delay (in milliseconds) to wait before sending batch",
       config::required::no,
       100ms)
+  , produce_compression_type(
+      *this,
+      "produce_compression_type",
+      "Compression of the batches sent to the broker (none, gzip, snappy, "
+      "lz4, zstd)",
+      config::required::no,
+      model::compression::none)
   , consumer_request_timeout(
       *this,
       "consumer_request_timeout_ms",
@@ -11,7 +11,9 @@
 
 #pragma once
 #include "config/config_store.h"
+#include "config/configuration.h"
 #include "config/tls_config.h"
+#include "model/compression.h"
 
 #include <seastar/net/inet_address.hh>
 #include <seastar/net/ip.hh>
@@ -33,6 +35,7 @@ struct configuration final : public config::config_store {
     config::property<int32_t> produce_batch_record_count;
     config::property<int32_t> produce_batch_size_bytes;
     config::property<std::chrono::milliseconds> produce_batch_delay;
+    config::property<model::compression> produce_compression_type;
     config::property<std::chrono::milliseconds> consumer_request_timeout;
     config::property<int32_t> consumer_request_max_bytes;
     config::property<std::chrono::milliseconds> consumer_session_timeout;
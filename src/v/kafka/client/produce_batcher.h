@@ -11,12 +11,15 @@
 
 #pragma once
 
+#include "compression/compression.h"
 #include "kafka/protocol/produce.h"
 #include "kafka/types.h"
 #include "model/fundamental.h"
+#include "model/compression.h"
 #include "model/metadata.h"
 #include "raft/types.h"
 #include "seastarx.h"
+#include "storage/parser_utils.h"
 #include "storage/record_batch_builder.h"
 
 #include <seastar/core/circular_buffer.hh>
@@ -45,11 +48,16 @@ typename ContainerT::value_type consume_front(ContainerT& c) {
 /// |   c_ctx0(2)   | c_ctx1(1) |       c_ctx2(3)      | client ctx(rec_count)
 /// |           b_bat0          |        b_bat1        | broker request batches
 /// |          b_ctx0(3)        |       b_ctx1(3)      | broker ctx(rec_count)
+///
+/// Broker batches are compressed with the configured codec, the broker stores
+/// them as they are sent.
 class produce_batcher {
 public:
     using partition_response = produce_response::partition;
-    explicit produce_batcher()
-      : _builder{make_builder()}
+    explicit produce_batcher(
+      model::compression compression = model::compression::none)
+      : _compression{compression}
+      , _builder{make_builder()}
       , _client_reqs{}
       , _broker_reqs{} {}
 
@@ -83,7 +91,13 @@ public:
     model::record_batch consume() {
         auto batch = std::exchange(_builder, make_builder()).build();
         _broker_reqs.emplace_back(batch.record_count());
-        return batch;
+        if (
+          batch.record_count() == 0
+          || _compression == model::compression::none
+          || _compression == model::compression::producer) {
+            return batch;
+        }
+        return compress(std::move(batch));
     }
 
     void handle_response(partition_response res) {
@@ -115,6 +129,17 @@ private:
         return {raft::data_batch_type, model::offset(0)};
     }
 
+    model::record_batch compress(model::record_batch batch) {
+        auto payload = compression::compressor::compress(
+          batch.data(), _compression);
+        auto hdr = batch.header();
+        hdr.attrs |= _compression;
+        storage::internal::reset_size_checksum_metadata(hdr, payload);
+        return model::record_batch(
+          hdr, std::move(payload), model::record_batch::tag_ctor_ng{});
+    }
+
+    model::compression _compression;
     storage::record_batch_builder _builder;
     // TODO(Ben): Maybe these should be a queue for backpressure
     ss::circular_buffer<client_context> _client_reqs;
@@ -32,7 +32,7 @@ public:
 
     produce_partition(const configuration& config, consumer&& c)
       : _config{config}
-      , _batcher{}
+      , _batcher{config.produce_compression_type()}
       , _timer{[this]() { try_consume(true); }}
       , _consumer{std::move(c)} {}
 
@@ -16,6 +16,7 @@
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "reflection/adl.h"
+#include "storage/parser_utils.h"
 #include "storage/record_batch_builder.h"
 
 #include <seastar/core/when_all.hh>
@@ -168,3 +169,43 @@ SEASTAR_THREAD_TEST_CASE(test_partition_producer_error) {
 
     BOOST_REQUIRE(ctx.consume() == 0);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_partition_producer_compressed) {
+    for (auto c : {model::compression::lz4, model::compression::zstd}) {
+        kc::produce_batcher batcher(c);
+        kc::produce_batcher reference;
+        std::vector<ss::future<kafka::produce_response::partition>> futs;
+        std::vector<ss::future<kafka::produce_response::partition>> ref_futs;
+        for (auto o : {0, 100}) {
+            futs.push_back(batcher.produce(make_batch(model::offset(o), 100)));
+            ref_futs.push_back(
+              reference.produce(make_batch(model::offset(o), 100)));
+        }
+
+        auto batch = batcher.consume();
+        BOOST_REQUIRE(batch.compressed());
+        BOOST_REQUIRE(batch.header().attrs.compression() == c);
+        BOOST_REQUIRE_EQUAL(batch.record_count(), 200);
+
+        // the broker sees the same records as without compression
+        auto records = storage::internal::decompress_batch(std::move(batch))
+                         .get0()
+                         .copy_records();
+        auto expected = reference.consume().copy_records();
+        BOOST_REQUIRE(records == expected);
+
+        for (auto* b : {&batcher, &reference}) {
+            b->handle_response(kafka::produce_response::partition{
+              .partition_index{model::partition_id(0)},
+              .error_code = kafka::error_code::none,
+              .base_offset{model::offset(42)},
+              .log_append_time_ms{model::timestamp{0}},
+              .log_start_offset{model::offset{-1}},
+            });
+        }
+        ss::when_all_succeed(ref_futs.begin(), ref_futs.end()).get();
+        auto responses = ss::when_all_succeed(futs.begin(), futs.end()).get0();
+        BOOST_REQUIRE(responses[0].base_offset == model::offset(42));
+        BOOST_REQUIRE(responses[1].base_offset == model::offset(142));
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/client/produce_batcher.h"
+#include "model/compression.h"
+#include "model/record_utils.h"
+#include "random/generators.h"
+#include "raft/types.h"
+#include "storage/record_batch_builder.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace kc = kafka::client;
+
+namespace {
+
+constexpr size_t client_batches = 100;
+constexpr size_t records_per_client_batch = 10;
+
+// json documents as produced through the REST proxy, with repeated field
+// names and a random part
+model::record_batch make_client_batch() {
+    storage::record_batch_builder builder(
+      raft::data_batch_type, model::offset(0));
+    for (size_t i = 0; i < records_per_client_batch; ++i) {
+        auto value = fmt::format(
+          R"({{"id":"{}","name":"{}","status":"active","count":{}}})",
+          random_generators::gen_alphanum_string(16),
+          random_generators::gen_alphanum_string(32),
+          i);
+        iobuf v;
+        v.append(value.data(), value.size());
+        builder.add_raw_kv(iobuf(), std::move(v));
+    }
+    return std::move(builder).build();
+}
+
+/// Batches client requests the way produce_partition does, returns the
+/// batch that is sent to the broker. Only the client side work is measured.
+model::record_batch produce(model::compression c) {
+    std::vector<model::record_batch> batches;
+    batches.reserve(client_batches);
+    for (size_t i = 0; i < client_batches; ++i) {
+        batches.push_back(make_client_batch());
+    }
+    kc::produce_batcher batcher(c);
+    perf_tests::start_measuring_time();
+    for (auto& b : batches) {
+        // the responses are never received
+        (void)batcher.produce(std::move(b));
+    }
+    auto batch = batcher.consume();
+    perf_tests::stop_measuring_time();
+    return batch;
+}
+
+void report_wire_size(model::compression c, const model::record_batch& b) {
+    static std::array<bool, 5> reported{};
+    auto idx = static_cast<size_t>(c);
+    if (idx < reported.size() && !std::exchange(reported[idx], true)) {
+        fmt::print("{} batch size on wire: {} bytes\n", c, b.size_bytes());
+    }
+}
+
+size_t client_test(model::compression c) {
+    auto batch = produce(c);
+    report_wire_size(c, batch);
+    perf_tests::do_not_optimize(batch);
+    return client_batches;
+}
+
+// the broker checks the crc of every batch it receives, it is computed over
+// the bytes on the wire
+size_t broker_test(model::compression c) {
+    auto batch = produce(c);
+    perf_tests::start_measuring_time();
+    perf_tests::do_not_optimize(model::crc_record_batch(batch));
+    perf_tests::stop_measuring_time();
+    return 1;
+}
+
+} // namespace
+
+PERF_TEST(produce_batcher, client_none) {
+    return client_test(model::compression::none);
+}
+PERF_TEST(produce_batcher, client_lz4) {
+    return client_test(model::compression::lz4);
+}
+PERF_TEST(produce_batcher, client_zstd) {
+    return client_test(model::compression::zstd);
+}
+PERF_TEST(produce_batcher, broker_crc_none) {
+    return broker_test(model::compression::none);
+}
+PERF_TEST(produce_batcher, broker_crc_lz4) {
+    return broker_test(model::compression::lz4);
+}
+PERF_TEST(produce_batcher, broker_crc_zstd) {
+    return broker_test(model::compression::zstd);
+}
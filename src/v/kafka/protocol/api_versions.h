@@ -50,7 +50,12 @@ struct api_versions_response final {
     api_versions_response_data data;
 
     void encode(const request_context& ctx, response& resp) {
-        data.encode(resp.writer(), ctx.header().version);
+        // a client using a version we do not support can only parse the v0
+        // response schema
+        auto version = data.error_code == error_code::unsupported_version
+                         ? api_version(0)
+                         : ctx.header().version;
+        data.encode(resp.writer(), version);
     }
 
     void decode(iobuf buf, api_version version) {
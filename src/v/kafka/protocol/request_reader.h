@@ -47,6 +47,10 @@ public:
         auto [i, _] = _parser.read_varlong();
         return i;
     }
+    uint32_t read_unsigned_varint() {
+        auto [i, _] = _parser.read_unsigned_varlong();
+        return static_cast<uint32_t>(i);
+    }
 
     ss::sstring read_string() { return do_read_string(read_int16()); }
 
@@ -60,6 +64,30 @@ public:
 
     bytes read_bytes() { return _parser.read_bytes(read_int32()); }
 
+    /*
+     * Compact types used by flexible versions are prefixed with an unsigned
+     * varint holding length + 1, zero length denotes null.
+     */
+    ss::sstring read_compact_string() {
+        return do_read_string(read_compact_length());
+    }
+
+    std::optional<ss::sstring> read_compact_nullable_string() {
+        auto n = read_compact_length();
+        if (n < 0) {
+            return std::nullopt;
+        }
+        return {do_read_string(n)};
+    }
+
+    bytes read_compact_bytes() {
+        auto n = read_compact_length();
+        if (unlikely(n < 0)) {
+            throw std::out_of_range("Asked to read a negative byte array");
+        }
+        return _parser.read_bytes(n);
+    }
+
     // Stronly suggested to use read_nullable_iobuf
     std::optional<iobuf> read_fragmented_nullable_bytes() {
         auto [io, count] = read_nullable_iobuf();
@@ -104,8 +132,68 @@ public:
         return do_read_array(len, std::forward<ElementParser>(parser));
     }
 
+    template<
+      typename ElementParser,
+      typename T = std::invoke_result_t<ElementParser, request_reader&>>
+    std::vector<T> read_compact_array(ElementParser&& parser) {
+        auto len = read_compact_length();
+        if (unlikely(len < 0)) {
+            throw std::out_of_range("Asked to read a null compact array");
+        }
+        return do_read_array(len, std::forward<ElementParser>(parser));
+    }
+
+    template<
+      typename ElementParser,
+      typename T = std::invoke_result_t<ElementParser, request_reader&>>
+    std::optional<std::vector<T>>
+    read_compact_nullable_array(ElementParser&& parser) {
+        auto len = read_compact_length();
+        if (len < 0) {
+            return std::nullopt;
+        }
+        return do_read_array(len, std::forward<ElementParser>(parser));
+    }
+
+    /*
+     * Consumes a tagged fields section. The handler is called with the tag of
+     * every field and returns false if the tag is unknown, in which case the
+     * field is skipped.
+     */
+    // clang-format off
+    template<typename TagHandler>
+    CONCEPT(requires requires(TagHandler h, uint32_t tag, request_reader& rr) {
+        { h(tag, rr) } -> std::same_as<bool>;
+    })
+    // clang-format on
+    void consume_tagged_fields(TagHandler&& handler) {
+        auto n = read_unsigned_varint();
+        while (n-- > 0) {
+            auto tag = read_unsigned_varint();
+            auto size = read_unsigned_varint();
+            auto start = bytes_consumed();
+            if (!handler(tag, *this)) {
+                _parser.skip(size);
+            } else if (unlikely(bytes_consumed() - start != size)) {
+                throw std::out_of_range(fmt::format(
+                  "Tagged field {} size mismatch, expected: {}, read: {}",
+                  tag,
+                  size,
+                  bytes_consumed() - start));
+            }
+        }
+    }
+
+    void consume_tagged_fields() {
+        consume_tagged_fields([](uint32_t, request_reader&) { return false; });
+    }
+
 private:
-    ss::sstring do_read_string(int16_t n) {
+    int32_t read_compact_length() {
+        return static_cast<int32_t>(read_unsigned_varint()) - 1;
+    }
+
+    ss::sstring do_read_string(int32_t n) {
         if (unlikely(n < 0)) {
             /// FIXME: maybe return empty string?
             throw std::out_of_range("Asked to read a negative byte string");
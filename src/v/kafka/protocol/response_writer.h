@@ -53,6 +53,17 @@ class response_writer {
         return x.size();
     }
 
+    uint32_t serialize_unsigned_vint(uint64_t val) {
+        auto x = vint::to_bytes_unsigned(val);
+        _out->append(x.data(), x.size());
+        return x.size();
+    }
+
+    // compact types are prefixed with length + 1, zero denotes null
+    uint32_t serialize_compact_length(size_t len) {
+        return serialize_unsigned_vint(len + 1);
+    }
+
 public:
     explicit response_writer(iobuf& out) noexcept
       : _out(&out) {}
@@ -81,6 +92,10 @@ public:
 
     uint32_t write_varlong(int64_t v) { return serialize_vint(v); }
 
+    uint32_t write_unsigned_varint(uint32_t v) {
+        return serialize_unsigned_vint(v);
+    }
+
     uint32_t write(std::string_view v) {
         auto size = serialize_int<int16_t>(v.size()) + v.size();
         _out->append(v.data(), v.size());
@@ -111,6 +126,45 @@ public:
 
     uint32_t write(const model::topic& topic) { return write(topic()); }
 
+    uint32_t write_compact(std::string_view v) {
+        auto size = serialize_compact_length(v.size()) + v.size();
+        _out->append(v.data(), v.size());
+        return size;
+    }
+
+    uint32_t write_compact(const ss::sstring& v) {
+        return write_compact(std::string_view(v));
+    }
+
+    uint32_t write_compact(std::optional<std::string_view> v) {
+        if (!v) {
+            return serialize_unsigned_vint(0);
+        }
+        return write_compact(*v);
+    }
+
+    uint32_t write_compact(const std::optional<ss::sstring>& v) {
+        if (!v) {
+            return serialize_unsigned_vint(0);
+        }
+        return write_compact(std::string_view(*v));
+    }
+
+    uint32_t write_compact(bytes_view bv) {
+        auto size = serialize_compact_length(bv.size()) + bv.size();
+        _out->append(reinterpret_cast<const char*>(bv.data()), bv.size());
+        return size;
+    }
+
+    uint32_t write_compact(const model::topic& topic) {
+        return write_compact(topic());
+    }
+
+    template<typename T, typename Tag>
+    uint32_t write_compact(const named_type<T, Tag>& t) {
+        return write_compact(t());
+    }
+
     uint32_t write(std::optional<iobuf>&& data) {
         if (!data) {
             return serialize_int<int32_t>(-1);
@@ -192,6 +246,56 @@ public:
         return write_array(*v, std::forward<ElementWriter>(writer));
     }
 
+    // clang-format off
+    template<typename T, typename ElementWriter>
+    CONCEPT(
+          requires requires(ElementWriter writer, response_writer& rw, T& elem) {
+            { writer(elem, rw) } -> std::same_as<void>;
+    })
+    // clang-format on
+    uint32_t write_compact_array(std::vector<T>& v, ElementWriter&& writer) {
+        auto start_size = uint32_t(_out->size_bytes());
+        serialize_compact_length(v.size());
+        for (auto& elem : v) {
+            writer(elem, *this);
+        }
+        return _out->size_bytes() - start_size;
+    }
+
+    // clang-format off
+    template<typename T, typename ElementWriter>
+    CONCEPT(
+          requires requires(ElementWriter writer, response_writer& rw, T& elem) {
+            { writer(elem, rw) } -> std::same_as<void>;
+    })
+    // clang-format on
+    uint32_t write_compact_nullable_array(
+      std::optional<std::vector<T>>& v, ElementWriter&& writer) {
+        if (!v) {
+            return serialize_unsigned_vint(0);
+        }
+        return write_compact_array(*v, std::forward<ElementWriter>(writer));
+    }
+
+    // writes a single entry of a tagged fields section, the field value is
+    // prefixed with its tag and size
+    // clang-format off
+    template<typename ElementWriter>
+    CONCEPT(requires requires (ElementWriter writer, response_writer& rw) {
+        { writer(rw) } -> std::same_as<void>;
+    })
+    // clang-format on
+    uint32_t write_tagged_field(uint32_t tag, ElementWriter&& writer) {
+        iobuf field;
+        response_writer field_writer(field);
+        writer(field_writer);
+        auto size = serialize_unsigned_vint(tag)
+                    + serialize_unsigned_vint(field.size_bytes())
+                    + field.size_bytes();
+        _out->append(std::move(field));
+        return size;
+    }
+
     // wrap a writer in a kafka bytes array object. the writer should return
     // true if writing no bytes should result in the encoding as nullable bytes,
     // and false otherwise.
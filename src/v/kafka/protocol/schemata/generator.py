@@ -21,12 +21,7 @@
 #   path_type_map to override types, it would be more efficient to specify the
 #   same mapping using the field_name_type_map + a whitelist of request types.
 #
-#   - The current version does not handle flexible versions. It will be some
-#   time before we encounter clients requiring this, but in principle this
-#   generator should be extensible (see type maps below). Note that when the
-#   time comes to support flexible versions, there is a filter in the templates
-#   within this file that ignores such fields, and that filter should be
-#   removed.
+#   - Tagged fields are only supported for scalar types.
 #
 #   - Handle ignorable fields. Currently we handle nullable fields properly. The
 #   ignorable flag on a field doesn't change the wire protocol, but gives
@@ -42,6 +37,22 @@ import textwrap
 import jsonschema
 import jinja2
 
+# Flexible versions
+# =================
+#
+# Starting with the version listed in the `flexibleVersions` property of a
+# schema strings, bytes and arrays are encoded with their compact variants
+# (unsigned varint length + 1, zero denoting null) and every struct is followed
+# by a section of tagged fields. Unknown tagged fields are skipped when decoding
+# and only fields with a `tag` property are written when encoding.
+#
+# Flexible requests use request header v2 and flexible responses use response
+# header v1 (with the exception of ApiVersionsResponse which always uses header
+# v0). Both header versions end with their own tagged fields section. Since the
+# header is parsed without knowledge of the message schema, the generated
+# encoders and decoders take care of the header tagged fields which directly
+# precede the message body.
+#
 # Type overrides
 # ==============
 #
@@ -223,6 +234,13 @@ field_name_type_map = {
     ("int32", "RebalanceTimeoutMs"): ("std::chrono::milliseconds", None),
 }
 
+# compact counterparts of primitive type decoders used with flexible versions
+compact_decoder_map = {
+    "read_string()": "read_compact_string()",
+    "read_nullable_string()": "read_compact_nullable_string()",
+    "read_bytes()": "read_compact_bytes()",
+}
+
 # primitive types
 basic_type_map = dict(
     string=("ss::sstring", "read_string()", "read_nullable_string()"),
@@ -350,10 +368,41 @@ class VersionRange:
             max = int(match.group("max"))
             return min, max
 
-    def guard(self):
+    @staticmethod
+    def between(min, max):
+        spec = f"{min}+" if max is None else f"{min}-{max}"
+        return VersionRange(spec)
+
+    def intersect(self, other):
+        """
+        The versions in both ranges or None if the ranges are disjoint.
+        """
+        min = self.min if self.min > other.min else other.min
+        max = self.max
+        if max is None or (other.max is not None and other.max < max):
+            max = other.max
+        if max is not None and min > max:
+            return None
+        return VersionRange.between(min, max)
+
+    def covers(self, other):
+        """
+        Whether every version of the other range is in this range.
+        """
+        if other.min < self.min:
+            return False
+        if self.max is None:
+            return True
+        return other.max is not None and other.max <= self.max
+
+    def guard(self, outer=None):
         """
-        Generate the C++ bounds check.
+        Generate the C++ bounds check. Code only reached for the versions of
+        the `outer` range, such as the elements of an array whose field is
+        already guarded, needs no check when those versions are all in range.
         """
+        if outer is not None and self.covers(outer):
+            return ""
         if self.min == self.max:
             cond = f"version == api_version({self.min})"
         else:
@@ -370,6 +419,17 @@ class VersionRange:
         return f"[{self.min}, {max}"
 
 
+def flex_guard(flex, outer):
+    """
+    The C++ check selecting the flexible encoding for code reached in the
+    `outer` versions. None if the encoding is never flexible there and an
+    empty check if it always is.
+    """
+    if flex is None or flex.intersect(outer) is None:
+        return None
+    return flex.guard(outer)
+
+
 def snake_case(name):
     """Convert camel to snake case"""
     return name[0].lower() + "".join(
@@ -439,6 +499,14 @@ class StructType(FieldType):
     def is_struct(self):
         return True
 
+    @property
+    def tagged_fields(self):
+        return [f for f in self.fields if f.is_tagged]
+
+    @property
+    def untagged_fields(self):
+        return [f for f in self.fields if not f.is_tagged]
+
     @property
     def format(self):
         """Format string for output operator"""
@@ -481,6 +549,11 @@ class Field:
         self._default_value = self._field.get("default", "")
         if self._default_value == "null":
             self._default_value = ""
+        self._tag = self._field.get("tag", None)
+        if self._tag is not None:
+            # tagged fields do not exist outside of the tagged versions
+            assert self._field["taggedVersions"] == self._field["versions"]
+            assert isinstance(self._type, ScalarType)
         assert len(self._path)
 
     @staticmethod
@@ -494,6 +567,26 @@ class Field:
     def nullable(self):
         return self._nullable_versions is not None
 
+    @property
+    def is_tagged(self):
+        return self._tag is not None
+
+    @property
+    def tag(self):
+        return self._tag
+
+    @property
+    def is_compact_scalar(self):
+        """
+        True if the encoding of the field (or of its elements in case of an
+        array) differs in flexible versions.
+        """
+        return self._type.name in ("string", "bytes")
+
+    @property
+    def is_compact_type(self):
+        return self.is_array or self.is_compact_scalar
+
     def versions(self):
         return self._versions
 
@@ -600,6 +693,19 @@ class Field:
         assert plain_decoder[1]
         return plain_decoder[1], named_type
 
+    @property
+    def compact_decoder(self):
+        """
+        The decoder used in flexible versions. Arrays are handled separately.
+        """
+        decoder, _ = self.decoder
+        if not self.is_compact_scalar:
+            return decoder
+        compact = compact_decoder_map.get(decoder, None)
+        if compact is None:
+            raise Exception(f"No compact decoder for {self._path}")
+        return compact
+
     @property
     def is_array(self):
         return isinstance(self._type, ArrayType)
@@ -693,8 +799,13 @@ SOURCE_TEMPLATE = """
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
-{% macro version_guard(field) %}
-{%- set cond = field.versions().guard() %}
+{#
+ # `outer` is the range of versions in which the generated code runs. checks
+ # implied by it, such as the field guard of an array repeated for each of its
+ # elements, are left out so that every guard is generated once.
+ #}
+{% macro version_guard(field, outer) %}
+{%- set cond = field.versions().guard(outer) %}
 {%- if cond %}
 if ({{ cond }}) {
 {{- caller() | indent }}
@@ -704,103 +815,294 @@ if ({{ cond }}) {
 {%- endif %}
 {%- endmacro %}
 
-{% macro field_encoder(field, obj) %}
+{% macro write_scalar(field, fname, outer) %}
+{%- set cond = flex_guard(flex, outer) %}
+{%- if cond is none or not field.is_compact_scalar %}
+writer.write({{ fname }});
+{%- elif cond %}
+if ({{ cond }}) {
+    writer.write_compact({{ fname }});
+} else {
+    writer.write({{ fname }});
+}
+{%- else %}
+writer.write_compact({{ fname }});
+{%- endif %}
+{%- endmacro %}
+
+{% macro read_scalar(field, outer) %}
+{%- set decoder = field.decoder[0] %}
+{%- set cond = flex_guard(flex, outer) %}
+{%- if cond is none or field.compact_decoder == decoder -%}
+reader.{{ decoder }}
+{%- elif cond -%}
+({{ cond }} ? reader.{{ field.compact_decoder }} : reader.{{ decoder }})
+{%- else -%}
+reader.{{ field.compact_decoder }}
+{%- endif %}
+{%- endmacro %}
+
+{% macro array_method(field, op) %}
+{%- if field.nullable() -%}
+{{ op }}_nullable_array
+{%- else -%}
+{{ op }}_array
+{%- endif %}
+{%- endmacro %}
+
+{% macro compact_array_method(field, op) %}
+{%- if field.nullable() -%}
+{{ op }}_compact_nullable_array
+{%- else -%}
+{{ op }}_compact_array
+{%- endif %}
+{%- endmacro %}
+
+{% macro element_encoder(field, outer) %}
+{%- if field.type().value_type().is_struct %}
+{{- struct_serde(field.type().value_type(), field_encoder, tags_encoder, "v", outer) }}
+{%- else %}
+{{- write_scalar(field, "v", outer) }}
+{%- endif %}
+{%- endmacro %}
+
+{% macro field_encoder(field, obj, outer) %}
 {%- if obj %}
 {%- set fname = obj + "." + field.name %}
 {%- else %}
 {%- set fname = field.name %}
 {%- endif %}
+{%- set cond = flex_guard(flex, outer) %}
 {%- if field.is_array %}
-{%- if field.nullable() %}
-writer.write_nullable_array({{ fname }}, [version]({{ field.value_type }}& v, response_writer& writer) {
+{%- if cond %}
+{
+    auto element_writer = [version]({{ field.value_type }}& v, response_writer& writer) {
+{{- element_encoder(field, outer) | indent(8) }}
+    };
+    if ({{ cond }}) {
+        writer.{{ compact_array_method(field, "write") }}({{ fname }}, element_writer);
+    } else {
+        writer.{{ array_method(field, "write") }}({{ fname }}, element_writer);
+    }
+}
+{%- elif cond is none %}
+writer.{{ array_method(field, "write") }}({{ fname }}, [version]({{ field.value_type }}& v, response_writer& writer) {
+{{- element_encoder(field, outer) | indent }}
+});
 {%- else %}
-writer.write_array({{ fname }}, [version]({{ field.value_type }}& v, response_writer& writer) {
+writer.{{ compact_array_method(field, "write") }}({{ fname }}, [version]({{ field.value_type }}& v, response_writer& writer) {
+{{- element_encoder(field, outer) | indent }}
+});
 {%- endif %}
-{%- if field.type().value_type().is_struct %}
-{{- struct_serde(field.type().value_type(), field_encoder, "v") | indent }}
 {%- else %}
-    writer.write(v);
+{{- write_scalar(field, fname, outer) }}
+{%- endif %}
+{%- endmacro %}
+
+{% macro tagged_fields_encoder(struct, obj, outer) %}
+uint32_t tagged_fields = 0;
+{%- for field in struct.tagged_fields %}
+{%- if outer.intersect(field.versions()) %}
+{%- call version_guard(field, outer) %}
+++tagged_fields;
+{%- endcall %}
 {%- endif %}
+{%- endfor %}
+writer.write_unsigned_varint(tagged_fields);
+{%- for field in struct.tagged_fields %}
+{%- set inner = outer.intersect(field.versions()) %}
+{%- if inner %}
+{%- call version_guard(field, outer) %}
+writer.write_tagged_field({{ field.tag }}, [&](response_writer& writer) {
+{{- field_encoder(field, obj, inner) | indent }}
 });
-{%- else %}
-writer.write({{ fname }});
+{%- endcall %}
 {%- endif %}
+{%- endfor %}
 {%- endmacro %}
 
-{% macro field_decoder(field, obj) %}
-{%- if obj %}
-{%- set fname = obj + "." + field.name %}
+{% macro tags_encoder(struct, obj, outer) %}
+{%- set cond = flex_guard(flex, outer) %}
+{%- if cond is not none %}
+{%- set inner = outer.intersect(flex) %}
+{%- if struct.tagged_fields %}
+{%- set body = tagged_fields_encoder(struct, obj, inner) %}
 {%- else %}
-{%- set fname = field.name %}
+{%- set body = "\nwriter.write_unsigned_varint(0);" %}
 {%- endif %}
-{%- if field.is_array %}
-{%- if field.nullable() %}
-{{ fname }} = reader.read_nullable_array([version](request_reader& reader) {
+{%- if cond %}
+if ({{ cond }}) {
+{{- body | indent }}
+}
 {%- else %}
-{{ fname }} = reader.read_array([version](request_reader& reader) {
+{{- body }}
 {%- endif %}
+{%- endif %}
+{%- endmacro %}
+
+{% macro element_decoder(field, outer) %}
 {%- if field.type().value_type().is_struct %}
-    {{ field.type().value_type().name }} v;
-{{- struct_serde(field.type().value_type(), field_decoder, "v") | indent }}
-    return v;
+{{ field.type().value_type().name }} v;
+{{- struct_serde(field.type().value_type(), field_decoder, tags_decoder, "v", outer) }}
+return v;
 {%- else %}
 {%- set decoder, named_type = field.decoder %}
 {%- if named_type == None %}
-    return reader.{{ decoder }};
+return {{ read_scalar(field, outer) }};
 {%- elif field.nullable() %}
-    {
-        auto tmp = reader.{{ decoder }};
-        if (tmp) {
-            return {{ named_type }}(std::move(*tmp));
-        }
-        return std::nullopt;
+{
+    auto tmp = {{ read_scalar(field, outer) }};
+    if (tmp) {
+        return {{ named_type }}(std::move(*tmp));
     }
+    return std::nullopt;
+}
 {%- else %}
-    return {{ named_type }}(reader.{{ decoder }});
+return {{ named_type }}({{ read_scalar(field, outer) }});
 {%- endif %}
 {%- endif %}
+{%- endmacro %}
+
+{% macro field_decoder(field, obj, outer) %}
+{%- if obj %}
+{%- set fname = obj + "." + field.name %}
+{%- else %}
+{%- set fname = field.name %}
+{%- endif %}
+{%- set cond = flex_guard(flex, outer) %}
+{%- if field.is_array %}
+{%- if cond %}
+{
+    auto element_reader = [version](request_reader& reader) {
+{{- element_decoder(field, outer) | indent(8) }}
+    };
+    if ({{ cond }}) {
+        {{ fname }} = reader.{{ compact_array_method(field, "read") }}(element_reader);
+    } else {
+        {{ fname }} = reader.{{ array_method(field, "read") }}(element_reader);
+    }
+}
+{%- elif cond is none %}
+{{ fname }} = reader.{{ array_method(field, "read") }}([version](request_reader& reader) {
+{{- element_decoder(field, outer) | indent }}
+});
+{%- else %}
+{{ fname }} = reader.{{ compact_array_method(field, "read") }}([version](request_reader& reader) {
+{{- element_decoder(field, outer) | indent }}
 });
+{%- endif %}
 {%- else %}
 {%- set decoder, named_type = field.decoder %}
 {%- if named_type == None %}
-{{ fname }} = reader.{{ decoder }};
+{{ fname }} = {{ read_scalar(field, outer) }};
 {%- elif field.nullable() %}
 {
-    auto tmp = reader.{{ decoder }};
+    auto tmp = {{ read_scalar(field, outer) }};
     if (tmp) {
         {{ fname }} = {{ named_type }}(std::move(*tmp));
     }
 }
 {%- else %}
-{{ fname }} = {{ named_type }}(reader.{{ decoder }});
+{{ fname }} = {{ named_type }}({{ read_scalar(field, outer) }});
 {%- endif %}
 {%- endif %}
 {%- endmacro %}
 
-{% macro struct_serde(struct, field_serde, obj = "") %}
-{%- for field in struct.fields %}
-{%- call version_guard(field) %}
-{{- field_serde(field, obj) }}
+{% macro tagged_fields_decoder(struct, obj, outer) %}
+reader.consume_tagged_fields([&](uint32_t tag, request_reader& reader) {
+    switch (tag) {
+{%- for field in struct.tagged_fields %}
+{%- set inner = outer.intersect(field.versions()) %}
+{%- if inner %}
+    case {{ field.tag }}:
+{{- field_decoder(field, obj, inner) | indent(8) }}
+        return true;
+{%- endif %}
+{%- endfor %}
+    default:
+        return false;
+    }
+});
+{%- endmacro %}
+
+{% macro tags_decoder(struct, obj, outer) %}
+{%- set cond = flex_guard(flex, outer) %}
+{%- if cond is not none %}
+{%- set inner = outer.intersect(flex) %}
+{%- if struct.tagged_fields %}
+{%- set body = tagged_fields_decoder(struct, obj, inner) %}
+{%- else %}
+{%- set body = "\nreader.consume_tagged_fields();" %}
+{%- endif %}
+{%- if cond %}
+if ({{ cond }}) {
+{{- body | indent }}
+}
+{%- else %}
+{{- body }}
+{%- endif %}
+{%- endif %}
+{%- endmacro %}
+
+{% macro header_tags_encoder() %}
+{%- set cond = flex_guard(flex, all_versions) %}
+{%- if cond is not none and header_tags %}
+// header tagged fields
+{%- if cond %}
+if ({{ cond }}) {
+    writer.write_unsigned_varint(0);
+}
+{%- else %}
+writer.write_unsigned_varint(0);
+{%- endif %}
+{%- endif %}
+{%- endmacro %}
+
+{% macro header_tags_decoder() %}
+{%- set cond = flex_guard(flex, all_versions) %}
+{%- if cond is not none and header_tags %}
+// header tagged fields
+{%- if cond %}
+if ({{ cond }}) {
+    reader.consume_tagged_fields();
+}
+{%- else %}
+reader.consume_tagged_fields();
+{%- endif %}
+{%- endif %}
+{%- endmacro %}
+
+{% macro struct_serde(struct, field_serde, tags_serde, obj, outer) %}
+{%- for field in struct.untagged_fields %}
+{%- set inner = outer.intersect(field.versions()) %}
+{%- if inner %}
+{%- call version_guard(field, outer) %}
+{{- field_serde(field, obj, inner) }}
 {%- endcall %}
+{%- endif %}
 {%- endfor %}
+{{- tags_serde(struct, obj, outer) }}
 {%- endmacro %}
 
 namespace kafka {
 
-{%- if struct.fields %}
+{%- if struct.fields or flex %}
 void {{ struct.name }}::encode(response_writer& writer, [[maybe_unused]] api_version version) {
-{{- struct_serde(struct, field_encoder) | indent }}
+{{- header_tags_encoder() | indent }}
+{{- struct_serde(struct, field_encoder, tags_encoder, "", all_versions) | indent }}
 }
 
 {%- if op_type == "request" %}
 void {{ struct.name }}::decode(request_reader& reader, [[maybe_unused]] api_version version) {
-{{- struct_serde(struct, field_decoder) | indent }}
+{{- header_tags_decoder() | indent }}
+{{- struct_serde(struct, field_decoder, tags_decoder, "", all_versions) | indent }}
 }
 {%- else %}
 void {{ struct.name }}::decode(iobuf buf, [[maybe_unused]] api_version version) {
     request_reader reader(std::move(buf));
 
-{{- struct_serde(struct, field_decoder) | indent }}
+{{- header_tags_decoder() | indent }}
+{{- struct_serde(struct, field_decoder, tags_decoder, "", all_versions) | indent }}
 }
 {%- endif %}
 {%- else %}
@@ -997,6 +1299,15 @@ if __name__ == "__main__":
     # request or response
     op_type = msg["type"]
 
+    # flexible versions or None if the message has none
+    flex = None
+    if msg["flexibleVersions"] != "none":
+        flex = VersionRange(msg["flexibleVersions"])
+
+    # ApiVersionsResponse always uses response header v0 so that clients can
+    # parse it regardless of the version they requested
+    header_tags = not (op_type == "response" and msg["apiKey"] == 18)
+
     with open(hdr, 'w') as f:
         f.write(
             jinja2.Template(HEADER_TEMPLATE).render(
@@ -1006,6 +1317,11 @@ if __name__ == "__main__":
 
     with open(src, 'w') as f:
         f.write(
-            jinja2.Template(SOURCE_TEMPLATE).render(struct=struct,
-                                                    header=hdr.name,
-                                                    op_type=op_type))
+            jinja2.Template(SOURCE_TEMPLATE).render(
+                struct=struct,
+                header=hdr.name,
+                op_type=op_type,
+                flex=flex,
+                flex_guard=flex_guard,
+                all_versions=VersionRange("0+"),
+                header_tags=header_tags))
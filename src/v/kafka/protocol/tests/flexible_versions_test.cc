@@ -0,0 +1,85 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+#define BOOST_TEST_MODULE example
+#include "kafka/protocol/request_reader.h"
+#include "kafka/protocol/response_writer.h"
+#include "kafka/protocol/schemata/heartbeat_request.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace kafka {
+
+static heartbeat_request_data
+roundtrip(heartbeat_request_data in, api_version version) {
+    iobuf buf;
+    response_writer writer(buf);
+    in.encode(writer, version);
+
+    heartbeat_request_data out;
+    request_reader reader(std::move(buf));
+    out.decode(reader, version);
+    BOOST_REQUIRE_EQUAL(reader.bytes_left(), 0);
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(compact_encoding_roundtrip) {
+    heartbeat_request_data in{
+      .group_id = group_id("group"),
+      .generation_id = generation_id(42),
+      .member_id = member_id("member"),
+      .group_instance_id = group_instance_id("instance"),
+    };
+
+    for (auto v : {api_version(3), api_version(4)}) {
+        auto out = roundtrip(in, v);
+        BOOST_REQUIRE_EQUAL(out.group_id, in.group_id);
+        BOOST_REQUIRE_EQUAL(out.generation_id, in.generation_id);
+        BOOST_REQUIRE_EQUAL(out.member_id, in.member_id);
+        BOOST_REQUIRE(out.group_instance_id == in.group_instance_id);
+    }
+
+    in.group_instance_id = std::nullopt;
+    auto out = roundtrip(in, api_version(4));
+    BOOST_REQUIRE(!out.group_instance_id);
+}
+
+BOOST_AUTO_TEST_CASE(compact_encoding_is_smaller) {
+    heartbeat_request_data in{
+      .group_id = group_id("group"),
+      .generation_id = generation_id(1),
+      .member_id = member_id("member"),
+    };
+
+    auto encoded_size = [&in](api_version v) {
+        iobuf buf;
+        response_writer writer(buf);
+        in.encode(writer, v);
+        return buf.size_bytes();
+    };
+
+    // v3: 2 byte string lengths, v4: 1 byte compact lengths plus empty tag
+    // sections for the header and the request body
+    BOOST_REQUIRE_EQUAL(encoded_size(api_version(3)), 21);
+    BOOST_REQUIRE_EQUAL(encoded_size(api_version(4)), 20);
+}
+
+BOOST_AUTO_TEST_CASE(unknown_tagged_fields_are_skipped) {
+    iobuf buf;
+    response_writer writer(buf);
+    writer.write_unsigned_varint(1);
+    writer.write_tagged_field(
+      7, [](response_writer& w) { w.write(int32_t(5)); });
+    writer.write(int32_t(11));
+
+    request_reader reader(std::move(buf));
+    reader.consume_tagged_fields();
+    BOOST_REQUIRE_EQUAL(reader.read_int32(), 11);
+}
+
+} // namespace kafka
@@ -50,7 +50,8 @@ group::group(
   kafka::group_id id,
   group_state s,
   config::configuration& conf,
-  ss::lw_shared_ptr<cluster::partition> partition)
+  ss::lw_shared_ptr<cluster::partition> partition,
+  ss::lw_shared_ptr<offset_commit_batcher> commit_batcher)
   : _id(std::move(id))
   , _state(s)
   , _state_timestamp(clock_type::now())
@@ -58,18 +59,21 @@ group::group(
   , _num_members_joining(0)
   , _new_member_added(false)
   , _conf(conf)
-  , _partition(std::move(partition)) {}
+  , _partition(std::move(partition))
+  , _commit_batcher(std::move(commit_batcher)) {}
 
 group::group(
   kafka::group_id id,
   group_log_group_metadata& md,
   config::configuration& conf,
-  ss::lw_shared_ptr<cluster::partition> partition)
+  ss::lw_shared_ptr<cluster::partition> partition,
+  ss::lw_shared_ptr<offset_commit_batcher> commit_batcher)
   : _id(std::move(id))
   , _num_members_joining(0)
   , _new_member_added(false)
   , _conf(conf)
-  , _partition(std::move(partition)) {
+  , _partition(std::move(partition))
+  , _commit_batcher(std::move(commit_batcher)) {
     _state = md.members.empty() ? group_state::empty : group_state::stable;
     _generation = md.generation;
     _protocol_type = md.protocol_type;
@@ -1176,10 +1180,28 @@ void group::fail_offset_commit(
     }
 }
 
-ss::future<offset_commit_response>
-group::store_offsets(offset_commit_request&& r) {
+ss::future<result<raft::replicate_result>>
+group::replicate_offsets(std::vector<offset_commit_batcher::record> records) {
+    if (_commit_batcher) {
+        return _commit_batcher->replicate(std::move(records));
+    }
+
     cluster::simple_batch_builder builder(
       raft::data_batch_type, model::offset(0));
+    for (auto& r : records) {
+        builder.add_raw_kv(std::move(r.key), std::move(r.value));
+    }
+    auto batch = std::move(builder).build();
+    auto reader = model::make_memory_record_batch_reader(std::move(batch));
+
+    return _partition->replicate(
+      std::move(reader),
+      raft::replicate_options(raft::consistency_level::quorum_ack));
+}
+
+ss::future<offset_commit_response>
+group::store_offsets(offset_commit_request&& r) {
+    std::vector<offset_commit_batcher::record> records;
 
     std::vector<std::pair<model::topic_partition, offset_metadata>>
       offset_commits;
@@ -1199,7 +1221,10 @@ group::store_offsets(offset_commit_request&& r) {
               p.committed_leader_epoch,
               p.committed_metadata,
             };
-            builder.add_kv(std::move(key), std::move(val));
+            records.push_back(offset_commit_batcher::record{
+              .key = reflection::to_iobuf(std::move(key)),
+              .value = reflection::to_iobuf(std::move(val)),
+            });
 
             model::topic_partition tp(t.name, p.partition_index);
             offset_metadata md{
@@ -1215,13 +1240,13 @@ group::store_offsets(offset_commit_request&& r) {
         }
     }
 
-    auto batch = std::move(builder).build();
-    auto reader = model::make_memory_record_batch_reader(std::move(batch));
+    if (records.empty()) {
+        // nothing to replicate, there is no log offset to report
+        return ss::make_ready_future<offset_commit_response>(
+          offset_commit_response(r, error_code::none));
+    }
 
-    return _partition
-      ->replicate(
-        std::move(reader),
-        raft::replicate_options(raft::consistency_level::quorum_ack))
+    return replicate_offsets(std::move(records))
       .then([this, req = std::move(r), commits = std::move(offset_commits)](
               result<raft::replicate_result> r) mutable {
           error_code error = r ? error_code::none : error_code::not_coordinator;
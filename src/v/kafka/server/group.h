@@ -15,6 +15,7 @@
 #include "kafka/protocol/fwd.h"
 #include "kafka/server/logger.h"
 #include "kafka/server/member.h"
+#include "kafka/server/offset_commit_batcher.h"
 #include "kafka/types.h"
 #include "model/fundamental.h"
 #include "model/record.h"
@@ -109,18 +110,24 @@ public:
         ss::sstring metadata;
     };
 
+    /*
+     * offset commits are replicated through the commit batcher, when present,
+     * which coalesces them with commits of other groups on the same partition.
+     */
     group(
       kafka::group_id id,
       group_state s,
       config::configuration& conf,
-      ss::lw_shared_ptr<cluster::partition> partition);
+      ss::lw_shared_ptr<cluster::partition> partition,
+      ss::lw_shared_ptr<offset_commit_batcher> commit_batcher = nullptr);
 
     // constructor used when loading state from log
     group(
       kafka::group_id id,
       group_log_group_metadata& md,
       config::configuration& conf,
-      ss::lw_shared_ptr<cluster::partition> partition);
+      ss::lw_shared_ptr<cluster::partition> partition,
+      ss::lw_shared_ptr<offset_commit_batcher> commit_batcher = nullptr);
 
     /// Get the group id.
     const kafka::group_id& id() const { return _id; }
@@ -425,6 +432,9 @@ private:
 
     model::record_batch checkpoint(const assignments_type& assignments);
 
+    ss::future<result<raft::replicate_result>>
+      replicate_offsets(std::vector<offset_commit_batcher::record>);
+
     kafka::group_id _id;
     group_state _state;
     clock_type::time_point _state_timestamp;
@@ -440,6 +450,7 @@ private:
     bool _new_member_added;
     config::configuration& _conf;
     ss::lw_shared_ptr<cluster::partition> _partition;
+    ss::lw_shared_ptr<offset_commit_batcher> _commit_batcher;
     absl::node_hash_map<model::topic_partition, offset_metadata> _offsets;
     absl::node_hash_map<model::topic_partition, offset_metadata>
       _pending_offset_commits;
@@ -9,6 +9,7 @@
 
 #include "kafka/server/group_manager.h"
 
+#include "bytes/iobuf.h"
 #include "cluster/cluster_utils.h"
 #include "cluster/partition_manager.h"
 #include "cluster/simple_batch_builder.h"
@@ -21,10 +22,14 @@
 #include "model/fundamental.h"
 #include "model/namespace.h"
 #include "model/record.h"
+#include "reflection/adl.h"
 #include "resource_mgmt/io_priority.h"
+#include "storage/snapshot.h"
 
 #include <seastar/core/coroutine.hh>
 
+#include <filesystem>
+
 namespace kafka {
 
 group_manager::group_manager(
@@ -38,6 +43,18 @@ group_manager::group_manager(
   , _conf(conf)
   , _self(cluster::make_self_broker(config::shard_local_cfg())) {}
 
+group_manager::attached_partition::attached_partition(
+  ss::lw_shared_ptr<cluster::partition> p,
+  std::chrono::milliseconds commit_window)
+  : loading(true)
+  , partition(std::move(p))
+  , snapshot_mgr(
+      std::filesystem::path(partition->get_ntp_config().work_directory()),
+      snapshot_name,
+      ss::default_priority_class())
+  , commit_batcher(
+      ss::make_lw_shared<offset_commit_batcher>(partition, commit_window)) {}
+
 ss::future<> group_manager::start() {
     /*
      * receive notifications for partition leadership changes. when we become a
@@ -78,6 +95,19 @@ ss::future<> group_manager::start() {
             handle_topic_delta(deltas);
         });
 
+    /*
+     * periodically snapshot the deduplicated group state so that recovery on
+     * leadership change only needs to replay the tail of the log.
+     */
+    _snapshot_timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] { return snapshot_partitions(); })
+          .handle_exception([](std::exception_ptr e) {
+              vlog(klog.warn, "Group snapshot encountered error: {}", e);
+          })
+          .finally([this] { arm_snapshot_timer(); });
+    });
+    arm_snapshot_timer();
+
     return ss::make_ready_future<>();
 }
 
@@ -86,17 +116,23 @@ ss::future<> group_manager::stop() {
     _gm.local().unregister_leadership_notification(_leader_notify_handle);
     _topic_table.local().unregister_delta_notification(
       _topic_table_notify_handle);
+    _snapshot_timer.cancel();
 
     for (auto& e : _partitions) {
         e.second->as.request_abort();
     }
 
-    return _gate.close();
+    return _gate.close().then([this] {
+        return ss::parallel_for_each(_partitions, [](auto& e) {
+            return e.second->commit_batcher->stop();
+        });
+    });
 }
 
 void group_manager::attach_partition(ss::lw_shared_ptr<cluster::partition> p) {
     klog.debug("attaching group metadata partition {}", p->ntp());
-    auto attached = ss::make_lw_shared<attached_partition>(p);
+    auto attached = ss::make_lw_shared<attached_partition>(
+      p, _conf.group_offset_commit_batch_window_ms());
     auto res = _partitions.try_emplace(p->ntp(), attached);
     // TODO: this is not a forever assertion. this should just generally never
     // happen _now_ because we don't support partition migration / removal.
@@ -224,34 +260,27 @@ ss::future<> group_manager::handle_partition_leader_change(
          */
         return inject_noop(p->partition, timeout).then([this, timeout, p] {
             /*
-             * the full log is read and deduplicated. the dedupe processing is
-             * based on the record keys, so this code should be ready to
-             * transparently take advantage of key-based compaction in the
-             * future.
+             * the log is read and deduplicated on top of the latest group
+             * snapshot, if any. the dedupe processing is based on the record
+             * keys, so this code should be ready to transparently take
+             * advantage of key-based compaction in the future.
              */
-            storage::log_reader_config reader_config(
-              p->partition->start_offset(),
-              model::model_limits<model::offset>::max(),
-              0,
-              std::numeric_limits<size_t>::max(),
-              kafka_read_priority(),
-              raft::data_batch_type,
-              std::nullopt,
-              std::nullopt);
-
-            return p->partition->make_reader(reader_config)
-              .then([this, p, timeout](model::record_batch_reader reader) {
-                  return std::move(reader)
-                    .consume(recovery_batch_consumer(p->as), timeout)
-                    .then([this, p](recovery_batch_consumer_state state) {
-                        // avoid trying to recover if we stopped the reader
-                        // because an abort was requested
-                        if (p->as.abort_requested()) {
-                            return ss::make_ready_future<>();
-                        }
-                        return recover_partition(p->partition, std::move(state))
-                          .then([p] { p->loading = false; });
-                    });
+            return read_snapshot(p)
+              .then([this, p, timeout](std::optional<group_snapshot> snap) {
+                  return replay_partition(
+                    p,
+                    std::move(snap),
+                    model::model_limits<model::offset>::max(),
+                    timeout);
+              })
+              .then([this, p](recovery_batch_consumer_state state) {
+                  // avoid trying to recover if we stopped the reader
+                  // because an abort was requested
+                  if (p->as.abort_requested()) {
+                      return ss::make_ready_future<>();
+                  }
+                  return recover_partition(p, std::move(state))
+                    .then([p] { p->loading = false; });
               });
         });
     } else {
@@ -260,13 +289,198 @@ ss::future<> group_manager::handle_partition_leader_change(
     }
 }
 
+ss::future<recovery_batch_consumer_state> group_manager::replay_partition(
+  ss::lw_shared_ptr<attached_partition> p,
+  std::optional<group_snapshot> snapshot,
+  model::offset max_offset,
+  ss::lowres_clock::time_point timeout) {
+    auto start = p->partition->start_offset();
+    recovery_batch_consumer_state state;
+    if (snapshot) {
+        if (snapshot->last_offset > p->partition->dirty_offset()) {
+            vlog(
+              klog.warn,
+              "Ignoring group snapshot of {} at offset {} past end of log {}",
+              p->partition->ntp(),
+              snapshot->last_offset,
+              p->partition->dirty_offset());
+        } else {
+            start = std::max(start, snapshot->last_offset + model::offset(1));
+            state = std::move(snapshot->state);
+        }
+    }
+
+    if (start > max_offset) {
+        co_return state;
+    }
+
+    storage::log_reader_config reader_config(
+      start,
+      max_offset,
+      0,
+      std::numeric_limits<size_t>::max(),
+      kafka_read_priority(),
+      raft::data_batch_type,
+      std::nullopt,
+      std::nullopt);
+
+    auto reader = co_await p->partition->make_reader(reader_config);
+    co_return co_await std::move(reader).consume(
+      recovery_batch_consumer(p->as, std::move(state)), timeout);
+}
+
+ss::future<std::optional<group_snapshot>>
+group_manager::read_snapshot(ss::lw_shared_ptr<attached_partition> p) {
+    /*
+     * the log remains the source of truth, so a snapshot that cannot be read
+     * only costs a full replay.
+     */
+    std::optional<storage::snapshot_reader> reader;
+    std::optional<group_snapshot> snapshot;
+    std::exception_ptr ex;
+    try {
+        reader = co_await p->snapshot_mgr.open_snapshot();
+        if (reader) {
+            iobuf_parser meta(co_await reader->read_metadata());
+            auto version = reflection::adl<int8_t>{}.from(meta);
+            if (version != group_snapshot::version) {
+                throw std::runtime_error(fmt::format(
+                  "Unsupported group snapshot version {}", version));
+            }
+            auto last_offset = reflection::adl<model::offset>{}.from(meta);
+            auto size = reflection::adl<uint64_t>{}.from(meta);
+            auto data = co_await read_iobuf_exactly(reader->input(), size);
+            if (data.size_bytes() != size) {
+                throw std::runtime_error(fmt::format(
+                  "Short group snapshot read {} of {} bytes",
+                  data.size_bytes(),
+                  size));
+            }
+            snapshot = group_snapshot{
+              .last_offset = last_offset,
+              .state = deserialize_group_snapshot_state(std::move(data)),
+            };
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+
+    if (reader) {
+        co_await reader->close();
+    }
+
+    if (ex) {
+        vlog(
+          klog.warn,
+          "Ignoring group snapshot {}: {}",
+          p->snapshot_mgr.snapshot_path(),
+          ex);
+        co_return std::nullopt;
+    }
+
+    co_return snapshot;
+}
+
+ss::future<> group_manager::write_snapshot(
+  ss::lw_shared_ptr<attached_partition> p, group_snapshot snapshot) {
+    auto data = serialize_group_snapshot_state(std::move(snapshot.state));
+    iobuf meta;
+    reflection::serialize(
+      meta,
+      group_snapshot::version,
+      snapshot.last_offset,
+      static_cast<uint64_t>(data.size_bytes()));
+
+    auto writer = co_await p->snapshot_mgr.start_snapshot();
+    std::exception_ptr ex;
+    try {
+        co_await writer.write_metadata(std::move(meta));
+        co_await write_iobuf_to_output_stream(std::move(data), writer.output());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await writer.close();
+
+    if (ex) {
+        co_await p->snapshot_mgr.remove_partial_snapshots();
+        std::rethrow_exception(ex);
+    }
+
+    co_await p->snapshot_mgr.finish_snapshot(writer);
+    vlog(
+      klog.debug,
+      "Wrote group snapshot for {} at offset {}",
+      p->partition->ntp(),
+      snapshot.last_offset);
+}
+
+void group_manager::arm_snapshot_timer() {
+    auto interval = _conf.group_snapshot_interval_ms();
+    if (interval.count() > 0 && !_gate.is_closed()) {
+        _snapshot_timer.arm(interval);
+    }
+}
+
+ss::future<> group_manager::snapshot_partitions() {
+    // iterate over a copy, partitions may be attached concurrently
+    std::vector<ss::lw_shared_ptr<attached_partition>> partitions;
+    partitions.reserve(_partitions.size());
+    for (auto& e : _partitions) {
+        partitions.push_back(e.second);
+    }
+
+    for (auto& p : partitions) {
+        if (p->as.abort_requested()) {
+            continue;
+        }
+        try {
+            co_await ss::with_semaphore(
+              p->sem, 1, [this, p] { return snapshot_partition(p); });
+        } catch (...) {
+            vlog(
+              klog.warn,
+              "Unable to snapshot group partition {}: {}",
+              p->partition->ntp(),
+              std::current_exception());
+        }
+    }
+}
+
+ss::future<>
+group_manager::snapshot_partition(ss::lw_shared_ptr<attached_partition> p) {
+    auto committed = p->partition->committed_offset();
+    if (committed < model::offset(0)) {
+        co_return;
+    }
+
+    auto snapshot = co_await read_snapshot(p);
+    if (snapshot && snapshot->last_offset >= committed) {
+        co_return;
+    }
+
+    auto timeout = ss::lowres_clock::now()
+                   + _conf.kafka_group_recovery_timeout_ms();
+    auto state = co_await replay_partition(
+      p, std::move(snapshot), committed, timeout);
+    if (p->as.abort_requested()) {
+        co_return;
+    }
+
+    co_await write_snapshot(
+      p,
+      group_snapshot{
+        .last_offset = committed,
+        .state = std::move(state),
+      });
+}
+
 /*
  * TODO: this routine can be improved from a copy vs move perspective, but is
  * rather complicated at the moment to start having to also analyze all the data
  * dependencies that would support optimizing for moves.
  */
 ss::future<> group_manager::recover_partition(
-  ss::lw_shared_ptr<cluster::partition> p, recovery_batch_consumer_state ctx) {
+  ss::lw_shared_ptr<attached_partition> p, recovery_batch_consumer_state ctx) {
     /*
      * [group-id -> [topic-partition -> offset-metadata]]
      */
@@ -304,7 +518,8 @@ ss::future<> group_manager::recover_partition(
             continue;
         }
 
-        group = ss::make_lw_shared<kafka::group>(e.first, e.second, _conf, p);
+        group = ss::make_lw_shared<kafka::group>(
+          e.first, e.second, _conf, p->partition, p->commit_batcher);
 
         for (auto& e : offsets) {
             group->insert_offset(
@@ -328,7 +543,11 @@ ss::future<> group_manager::recover_partition(
         }
 
         group = ss::make_lw_shared<kafka::group>(
-          e.first, group_state::empty, _conf, p);
+          e.first,
+          group_state::empty,
+          _conf,
+          p->partition,
+          p->commit_batcher);
 
         for (auto& e : e.second) {
             group->insert_offset(
@@ -364,6 +583,59 @@ ss::future<> group_manager::recover_partition(
     return ss::make_ready_future<>();
 }
 
+iobuf serialize_group_snapshot_state(recovery_batch_consumer_state st) {
+    iobuf out;
+    reflection::serialize(out, static_cast<uint32_t>(st.loaded_groups.size()));
+    for (auto& [id, md] : st.loaded_groups) {
+        // the group metadata decoder consumes trailing optional fields, so
+        // each entry is framed in its own buffer.
+        reflection::serialize(out, id, reflection::to_iobuf(std::move(md)));
+    }
+
+    std::vector<kafka::group_id> removed(
+      st.removed_groups.begin(), st.removed_groups.end());
+    reflection::serialize(out, std::move(removed));
+
+    reflection::serialize(out, static_cast<uint32_t>(st.loaded_offsets.size()));
+    for (auto& [key, e] : st.loaded_offsets) {
+        reflection::serialize(out, key, e.first, std::move(e.second));
+    }
+    return out;
+}
+
+recovery_batch_consumer_state deserialize_group_snapshot_state(iobuf buf) {
+    iobuf_parser in(std::move(buf));
+    recovery_batch_consumer_state st;
+
+    auto groups = reflection::adl<uint32_t>{}.from(in);
+    st.loaded_groups.reserve(groups);
+    for (uint32_t i = 0; i < groups; ++i) {
+        auto id = reflection::adl<kafka::group_id>{}.from(in);
+        auto md = reflection::adl<iobuf>{}.from(in);
+        st.loaded_groups.emplace(
+          std::move(id),
+          reflection::from_iobuf<group_log_group_metadata>(std::move(md)));
+    }
+
+    auto removed = reflection::adl<std::vector<kafka::group_id>>{}.from(in);
+    st.removed_groups.reserve(removed.size());
+    for (auto& id : removed) {
+        st.removed_groups.emplace(std::move(id));
+    }
+
+    auto offsets = reflection::adl<uint32_t>{}.from(in);
+    st.loaded_offsets.reserve(offsets);
+    for (uint32_t i = 0; i < offsets; ++i) {
+        auto key = reflection::adl<group_log_offset_key>{}.from(in);
+        auto offset = reflection::adl<model::offset>{}.from(in);
+        auto md = reflection::adl<group_log_offset_metadata>{}.from(in);
+        st.loaded_offsets.emplace(
+          std::move(key), std::make_pair(offset, std::move(md)));
+    }
+
+    return st;
+}
+
 ss::future<ss::stop_iteration>
 recovery_batch_consumer::operator()(model::record_batch batch) {
     if (unlikely(batch.header().type != raft::data_batch_type)) {
@@ -499,9 +771,13 @@ group_manager::join_group(join_group_request&& r) {
             return make_join_error(
               r.data.member_id, error_code::not_coordinator);
         }
-        auto p = it->second->partition;
+        auto& p = it->second;
         group = ss::make_lw_shared<kafka::group>(
-          r.data.group_id, group_state::empty, _conf, p);
+          r.data.group_id,
+          group_state::empty,
+          _conf,
+          p->partition,
+          p->commit_batcher);
         _groups.emplace(r.data.group_id, group);
         _groups.rehash(0);
         klog.trace("created new group {}", group);
@@ -609,9 +885,13 @@ group_manager::offset_commit(offset_commit_request&& r) {
         if (r.data.generation_id < 0) {
             // <kafka>the group is not relying on Kafka for group management, so
             // allow the commit</kafka>
-            auto p = _partitions.find(r.ntp)->second->partition;
+            auto& p = _partitions.find(r.ntp)->second;
             group = ss::make_lw_shared<kafka::group>(
-              r.data.group_id, group_state::empty, _conf, p);
+              r.data.group_id,
+              group_state::empty,
+              _conf,
+              p->partition,
+              p->commit_batcher);
             _groups.emplace(r.data.group_id, group);
             _groups.rehash(0);
         } else {
@@ -23,13 +23,16 @@
 #include "kafka/protocol/sync_group.h"
 #include "kafka/server/group.h"
 #include "kafka/server/member.h"
+#include "kafka/server/offset_commit_batcher.h"
 #include "model/namespace.h"
 #include "raft/group_manager.h"
 #include "seastarx.h"
+#include "storage/snapshot.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
 
 #include <absl/container/node_hash_map.h>
 #include <cluster/partition_manager.h>
@@ -37,6 +40,7 @@
 namespace kafka {
 
 struct recovery_batch_consumer_state;
+struct group_snapshot;
 
 /*
  * \brief Manages the Kafka group lifecycle.
@@ -89,8 +93,17 @@ struct recovery_batch_consumer_state;
  * - Both recovery and partition unload are serialized per-partition
  * - Recovery occurs when the local node is leader, else unload (below)
  *
- * The recovery process reads the entire log and deduplicates entries into the
- * `recovery_batch_consumer` object.
+ * The recovery process reads the log and deduplicates entries into the
+ * `recovery_batch_consumer` object. When a group snapshot exists recovery
+ * starts from the deduplicated state in the snapshot and only replays the
+ * tail of the log written after it.
+ *
+ * Snapshots (background)
+ * ======================
+ *
+ * - Taken periodically for every attached partition (group_snapshot_interval)
+ * - Serialized with recovery and unload through the partition's semaphore
+ * - Built by replaying the committed tail on top of the previous snapshot
  *
  * After the log is read the deduplicated state is used to re-populate the
  * in-memory cache of groups/commits through.
@@ -168,14 +181,18 @@ private:
     void attach_partition(ss::lw_shared_ptr<cluster::partition>);
 
     struct attached_partition {
+        static constexpr const char* snapshot_name = "group";
+
         bool loading;
         ss::semaphore sem{1};
         ss::abort_source as;
         ss::lw_shared_ptr<cluster::partition> partition;
+        storage::snapshot_manager snapshot_mgr;
+        ss::lw_shared_ptr<offset_commit_batcher> commit_batcher;
 
-        explicit attached_partition(ss::lw_shared_ptr<cluster::partition> p)
-          : loading(true)
-          , partition(std::move(p)) {}
+        attached_partition(
+          ss::lw_shared_ptr<cluster::partition> p,
+          std::chrono::milliseconds commit_window);
     };
 
     absl::node_hash_map<model::ntp, ss::lw_shared_ptr<attached_partition>>
@@ -197,7 +214,26 @@ private:
       std::optional<model::node_id> leader_id);
 
     ss::future<> recover_partition(
-      ss ::lw_shared_ptr<cluster::partition>, recovery_batch_consumer_state);
+      ss::lw_shared_ptr<attached_partition>, recovery_batch_consumer_state);
+
+    /*
+     * deduplicate the log of the partition up to and including max_offset on
+     * top of the state contained in the snapshot (if any).
+     */
+    ss::future<recovery_batch_consumer_state> replay_partition(
+      ss::lw_shared_ptr<attached_partition>,
+      std::optional<group_snapshot>,
+      model::offset max_offset,
+      ss::lowres_clock::time_point timeout);
+
+    ss::future<std::optional<group_snapshot>>
+      read_snapshot(ss::lw_shared_ptr<attached_partition>);
+    ss::future<>
+      write_snapshot(ss::lw_shared_ptr<attached_partition>, group_snapshot);
+
+    void arm_snapshot_timer();
+    ss::future<> snapshot_partitions();
+    ss::future<> snapshot_partition(ss::lw_shared_ptr<attached_partition>);
 
     ss::future<> inject_noop(
       ss::lw_shared_ptr<cluster::partition> p,
@@ -209,6 +245,7 @@ private:
     config::configuration& _conf;
     absl::node_hash_map<group_id, group_ptr> _groups;
     model::broker _self;
+    ss::timer<> _snapshot_timer;
 };
 
 /**
@@ -298,10 +335,32 @@ struct recovery_batch_consumer_state {
       loaded_offsets;
 };
 
+/*
+ * A snapshot of the deduplicated state of a group metadata partition covering
+ * all records up to and including `last_offset`.
+ */
+struct group_snapshot {
+    static constexpr int8_t version = 0;
+
+    model::offset last_offset;
+    recovery_batch_consumer_state state;
+};
+
+iobuf serialize_group_snapshot_state(recovery_batch_consumer_state);
+recovery_batch_consumer_state deserialize_group_snapshot_state(iobuf);
+
 struct recovery_batch_consumer {
     explicit recovery_batch_consumer(ss::abort_source& as)
       : as(as) {}
 
+    /*
+     * resume deduplication from previously recovered (e.g. snapshot) state.
+     */
+    recovery_batch_consumer(
+      ss::abort_source& as, recovery_batch_consumer_state st)
+      : st(std::move(st))
+      , as(as) {}
+
     ss::future<ss::stop_iteration> operator()(model::record_batch batch);
 
     ss::future<> handle_record(model::record);
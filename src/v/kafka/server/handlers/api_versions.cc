@@ -13,6 +13,10 @@
 #include "kafka/server/request_context.h"
 #include "kafka/server/response.h"
 
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
 namespace kafka {
 
 std::ostream& operator<<(std::ostream& os, const api_versions_response& r) {
@@ -75,6 +79,28 @@ std::vector<api_versions_response_key> get_supported_apis() {
     return serialize_apis(request_types{});
 }
 
+static bool is_valid_client_software_field(std::string_view v) {
+    // must match [a-zA-Z0-9](?:[a-zA-Z0-9\-.]*[a-zA-Z0-9])?
+    auto is_alnum = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0;
+    };
+    if (v.empty() || !is_alnum(v.front()) || !is_alnum(v.back())) {
+        return false;
+    }
+    return std::all_of(v.begin(), v.end(), [&is_alnum](char c) {
+        return is_alnum(c) || c == '-' || c == '.';
+    });
+}
+
+static bool
+is_valid_request(const api_versions_request& r, api_version version) {
+    if (version < api_version(3)) {
+        return true;
+    }
+    return is_valid_client_software_field(r.data.client_software_name)
+           && is_valid_client_software_field(r.data.client_software_version);
+}
+
 api_versions_response api_versions_handler::handle_raw(request_context& ctx) {
     // Unlike other request types, we handle ApiVersion requests
     // with higher versions than supported. We treat such a request
@@ -89,7 +115,9 @@ api_versions_response api_versions_handler::handle_raw(request_context& ctx) {
     } else {
         api_versions_request request;
         request.decode(ctx.reader(), ctx.header().version);
-        r.data.error_code = error_code::none;
+        r.data.error_code = is_valid_request(request, ctx.header().version)
+                              ? error_code::none
+                              : error_code::invalid_request;
     }
 
     if (ctx.header().version > api_version(1)) {
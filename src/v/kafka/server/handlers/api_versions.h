@@ -14,7 +14,7 @@
 
 namespace kafka {
 
-struct api_versions_handler : public handler<api_versions_api, 0, 2> {
+struct api_versions_handler : public handler<api_versions_api, 0, 3> {
     static ss::future<response_ptr>
       handle(request_context, ss::smp_service_group);
 
@@ -575,6 +575,10 @@ handle_shard_fetch(ss::shard_id shard, op_context& octx, shard_fetch fetch) {
     }
 
     bool foreign_read = shard != ss::this_shard_id();
+    auto& nonlocal = octx.rctx.fetch_nonlocal_requests();
+    if (foreign_read) {
+        ++nonlocal;
+    }
 
     // dispatch to remote core
     return octx.rctx.partition_manager()
@@ -588,6 +592,11 @@ handle_shard_fetch(ss::shard_id shard, op_context& octx, shard_fetch fetch) {
             return fetch_ntps_in_parallel(
               mgr, std::move(configs), foreign_read, deadline);
         })
+      .finally([&nonlocal, foreign_read] {
+          if (foreign_read) {
+              --nonlocal;
+          }
+      })
       .then([responses = std::move(fetch.responses)](
               std::vector<read_result> results) mutable {
           return fill_fetch_responsens(
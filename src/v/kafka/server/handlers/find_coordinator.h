@@ -14,6 +14,6 @@
 
 namespace kafka {
 
-using find_coordinator_handler = handler<find_coordinator_api, 0, 2>;
+using find_coordinator_handler = handler<find_coordinator_api, 0, 3>;
 
 } // namespace kafka
@@ -14,6 +14,6 @@
 
 namespace kafka {
 
-using heartbeat_handler = handler<heartbeat_api, 0, 3>;
+using heartbeat_handler = handler<heartbeat_api, 0, 4>;
 
 }
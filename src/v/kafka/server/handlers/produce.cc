@@ -13,6 +13,9 @@
 #include "cluster/metadata_cache.h"
 #include "cluster/partition_manager.h"
 #include "cluster/shard_table.h"
+#include "compression/compressibility.h"
+#include "compression/compression.h"
+#include "config/configuration.h"
 #include "kafka/protocol/errors.h"
 #include "kafka/protocol/kafka_batch_adapter.h"
 #include "likely.h"
@@ -22,19 +25,23 @@
 #include "model/record_batch_reader.h"
 #include "model/timestamp.h"
 #include "raft/types.h"
+#include "storage/parser_utils.h"
 #include "storage/shard_assignment.h"
+#include "utils/mutex.h"
 #include "utils/remote.h"
 #include "utils/to_string.h"
 #include "vlog.h"
 
 #include <seastar/core/execution_stage.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/scheduling.hh>
 #include <seastar/util/log.hh>
 
 #include <boost/container_hash/extensions.hpp>
 #include <fmt/ostream.h>
 
 #include <chrono>
+#include <optional>
 #include <string_view>
 
 namespace kafka {
@@ -145,6 +152,165 @@ static ss::future<produce_response::partition> partition_append(
         });
 }
 
+/*
+ * Batch encoded with \p target compression, or nullopt when that does not make
+ * the batch smaller than the producer made it or fails. \p records are the
+ * uncompressed records of the batch.
+ */
+static std::optional<model::record_batch> compress_records(
+  const model::record_batch& batch,
+  const iobuf& records,
+  model::compression target) noexcept {
+    try {
+        if (!compression::is_compressible(records)) {
+            return std::nullopt;
+        }
+        auto payload = compression::compressor::compress(records, target);
+        if (payload.size_bytes() >= batch.data().size_bytes()) {
+            return std::nullopt;
+        }
+        auto hdr = batch.header();
+        hdr.attrs.remove_compression();
+        hdr.attrs |= target;
+        storage::internal::reset_size_checksum_metadata(hdr, payload);
+        return model::record_batch(
+          hdr, std::move(payload), model::record_batch::tag_ctor_ng{});
+    } catch (...) {
+        vlog(
+          klog.warn,
+          "Unable to recompress batch {} to {}: {}",
+          batch.header(),
+          target,
+          std::current_exception());
+        return std::nullopt;
+    }
+}
+
+/*
+ * Decompression and compression of a batch run as separate tasks so that the
+ * reactor is not held for both at once, the size of the batches recompressed
+ * is bounded by `kafka_recompression_max_batch_bytes` for the same reason.
+ */
+static ss::future<model::record_batch>
+recompress(model::record_batch batch, model::compression target) {
+    if (!batch.compressed()) {
+        auto r = compress_records(batch, batch.data(), target);
+        return ss::make_ready_future<model::record_batch>(
+          r ? std::move(*r) : std::move(batch));
+    }
+    iobuf records;
+    try {
+        records = compression::compressor::uncompress(
+          batch.data(), batch.header().attrs.compression());
+    } catch (...) {
+        vlog(
+          klog.warn,
+          "Unable to decompress batch {}: {}",
+          batch.header(),
+          std::current_exception());
+        return ss::make_ready_future<model::record_batch>(std::move(batch));
+    }
+    return ss::later().then([batch = std::move(batch),
+                             records = std::move(records),
+                             target]() mutable {
+        auto r = compress_records(batch, records, target);
+        return r ? std::move(*r) : std::move(batch);
+    });
+}
+
+static bool
+needs_recompression(const model::record_batch& batch, model::compression t) {
+    return t != model::compression::none && t != model::compression::producer
+           && t != batch.header().attrs.compression()
+           && !batch.header().attrs.is_control() && batch.record_count() > 0
+           && static_cast<size_t>(batch.size_bytes())
+                <= config::shard_local_cfg()
+                     .kafka_recompression_max_batch_bytes();
+}
+
+/*
+ * Batches are stored with the compression type of their topic when it sets
+ * one, so that topics fed by producers that do not compress take less disk
+ * and less bandwidth to replicate and archive. Recompression runs in its own
+ * scheduling group and within a per core budget of bytes; batches produced
+ * while the budget is used up are stored as produced rather than delaying the
+ * request.
+ */
+static ss::future<model::record_batch> maybe_recompress(
+  produce_ctx& octx, model::record_batch batch, model::compression target) {
+    if (!needs_recompression(batch, target)) {
+        return ss::make_ready_future<model::record_batch>(std::move(batch));
+    }
+    const auto units = static_cast<size_t>(batch.size_bytes());
+    auto& budget = octx.rctx.recompression_budget();
+    if (!budget.try_wait(units)) {
+        return ss::make_ready_future<model::record_batch>(std::move(batch));
+    }
+    return ss::with_scheduling_group(
+             octx.rctx.compression_sg(),
+             [batch = std::move(batch), target]() mutable {
+                 return recompress(std::move(batch), target);
+             })
+      .finally([&budget, units] { budget.signal(units); });
+}
+
+/*
+ * Submits the batch to the partition on its home shard. Batches of a partition
+ * are appended in the order they are submitted.
+ */
+static ss::future<produce_response::partition> dispatch_append(
+  produce_ctx& octx,
+  model::ntp ntp,
+  ss::shard_id shard,
+  model::record_batch batch) {
+    const auto& hdr = batch.header();
+    auto bid = model::batch_identity::from(hdr);
+
+    auto num_records = batch.record_count();
+    auto reader = reader_from_lcore_batch(std::move(batch));
+    const bool nonlocal = shard != ss::this_shard_id();
+    auto& in_flight = octx.rctx.produce_nonlocal_requests();
+    if (nonlocal) {
+        ++in_flight;
+    }
+    return octx.rctx.partition_manager()
+      .invoke_on(
+        shard,
+        octx.ssg,
+        [reader = std::move(reader),
+         ntp = std::move(ntp),
+         num_records,
+         bid,
+         acks = octx.request.data.acks](
+          cluster::partition_manager& mgr) mutable {
+            auto partition = mgr.get(ntp);
+            if (!partition) {
+                return ss::make_ready_future<produce_response::partition>(
+                  produce_response::partition{
+                    .partition_index = ntp.tp.partition,
+                    .error_code = error_code::unknown_topic_or_partition});
+            }
+            if (unlikely(!partition->is_leader())) {
+                return ss::make_ready_future<produce_response::partition>(
+                  produce_response::partition{
+                    .partition_index = ntp.tp.partition,
+                    .error_code = error_code::not_leader_for_partition});
+            }
+            return partition_append(
+              ntp.tp.partition,
+              partition,
+              bid,
+              std::move(reader),
+              acks,
+              num_records);
+        })
+      .finally([&in_flight, nonlocal] {
+          if (nonlocal) {
+              --in_flight;
+          }
+      });
+}
+
 /**
  * \brief handle writing to a single topic partition.
  */
@@ -187,40 +353,54 @@ static ss::future<produce_response::partition> produce_topic_partition(
           model::timestamp_type::append_time, model::timestamp::now());
     }
 
-    const auto& hdr = batch.header();
-    auto bid = model::batch_identity::from(hdr);
+    auto compression
+      = octx.rctx.metadata_cache()
+          .get_topic_compression(
+            model::topic_namespace_view(model::kafka_namespace, topic.name))
+          .value_or(octx.rctx.metadata_cache().get_default_compression());
 
-    auto num_records = batch.record_count();
-    auto reader = reader_from_lcore_batch(std::move(batch));
-    return octx.rctx.partition_manager().invoke_on(
-      *shard,
-      octx.ssg,
-      [reader = std::move(reader),
-       ntp = std::move(ntp),
-       num_records,
-       bid,
-       acks = octx.request.data.acks](cluster::partition_manager& mgr) mutable {
-          auto partition = mgr.get(ntp);
-          if (!partition) {
-              return ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .partition_index = ntp.tp.partition,
-                  .error_code = error_code::unknown_topic_or_partition});
-          }
-          if (unlikely(!partition->is_leader())) {
-              return ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .partition_index = ntp.tp.partition,
-                  .error_code = error_code::not_leader_for_partition});
+    /*
+     * Requests are processed concurrently, a batch being recompressed holds
+     * back the batches of the same partition that follow it, or they could be
+     * appended first and break the sequence of idempotent producers. Batches
+     * of partitions with nothing held back are appended right away.
+     */
+    auto& order = octx.rctx.produce_order();
+    auto it = order.find(ntp);
+    if (it == order.end()) {
+        if (!needs_recompression(batch, compression)) {
+            return dispatch_append(
+              octx, std::move(ntp), *shard, std::move(batch));
+        }
+        it = order.emplace(ntp, ss::make_lw_shared<mutex>()).first;
+    }
+    auto m = it->second;
+
+    // the append is submitted while holding the lock and awaited after it
+    struct submitted {
+        ss::future<produce_response::partition> append;
+    };
+    return m
+      ->with([&octx,
+              ntp,
+              shard = *shard,
+              compression,
+              batch = std::move(batch)]() mutable {
+          return maybe_recompress(octx, std::move(batch), compression)
+            .then([&octx, ntp = std::move(ntp), shard](
+                    model::record_batch batch) mutable {
+                auto append = dispatch_append(
+                  octx, std::move(ntp), shard, std::move(batch));
+                return submitted{.append = std::move(append)};
+            });
+      })
+      .finally([&order, ntp, m = std::move(m)] {
+          // nothing else of the partition is waiting
+          if (m.use_count() == 2) {
+              order.erase(ntp);
           }
-          return partition_append(
-            ntp.tp.partition,
-            partition,
-            bid,
-            std::move(reader),
-            acks,
-            num_records);
-      });
+      })
+      .then([](submitted s) { return std::move(s.append); });
 }
 
 /**
@@ -14,6 +14,6 @@
 
 namespace kafka {
 
-using sync_group_handler = handler<sync_group_api, 0, 3>;
+using sync_group_handler = handler<sync_group_api, 0, 4>;
 
 }
@@ -0,0 +1,185 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/server/offset_commit_batcher.h"
+
+#include "cluster/partition.h"
+#include "config/configuration.h"
+#include "kafka/server/logger.h"
+#include "model/record_batch_reader.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "raft/errc.h"
+#include "storage/record_batch_builder.h"
+
+#include <seastar/core/metrics.hh>
+
+#include <system_error>
+
+namespace kafka {
+
+offset_commit_batcher::offset_commit_batcher(
+  ss::lw_shared_ptr<cluster::partition> partition,
+  std::chrono::milliseconds window)
+  : offset_commit_batcher(
+    partition->ntp(),
+    [partition](model::record_batch batch) {
+        return partition->replicate(
+          model::make_memory_record_batch_reader(std::move(batch)),
+          raft::replicate_options(raft::consistency_level::quorum_ack));
+    },
+    window) {}
+
+offset_commit_batcher::offset_commit_batcher(
+  model::ntp ntp, replicate_fn replicate, std::chrono::milliseconds window)
+  : _ntp(std::move(ntp))
+  , _replicate(std::move(replicate))
+  , _window(window) {
+    _timer.set_callback([this] { flush(); });
+    setup_metrics();
+}
+
+ss::future<result<raft::replicate_result>>
+offset_commit_batcher::replicate(std::vector<record> records) {
+    if (_gate.is_closed()) {
+        return ss::make_ready_future<result<raft::replicate_result>>(
+          make_error_code(raft::errc::shutting_down));
+    }
+    if (records.empty()) {
+        return ss::make_ready_future<result<raft::replicate_result>>(
+          std::make_error_code(std::errc::invalid_argument));
+    }
+
+    ++_appends;
+    for (auto& r : records) {
+        _pending_bytes += r.key.size_bytes();
+        if (r.value) {
+            _pending_bytes += r.value->size_bytes();
+        }
+        _records.push_back(std::move(r));
+    }
+    _waiters.push_back(waiter{.records = _records.size()});
+    auto f = _waiters.back().promise.get_future();
+
+    if (_window.count() == 0 || _pending_bytes >= max_pending_bytes) {
+        flush();
+    } else if (!_timer.armed()) {
+        _timer.arm(_window);
+    }
+    return f;
+}
+
+void offset_commit_batcher::flush() {
+    _timer.cancel();
+    if (_waiters.empty()) {
+        return;
+    }
+
+    storage::record_batch_builder builder(
+      raft::data_batch_type, model::offset(0));
+    for (auto& r : _records) {
+        builder.add_raw_kv(std::move(r.key), std::move(r.value));
+    }
+    auto total = _records.size();
+    auto waiters = std::exchange(_waiters, {});
+    _records.clear();
+    _pending_bytes = 0;
+
+    ++_replicates;
+    _replicated_records += total;
+    vlog(
+      klog.trace,
+      "Replicating {} offset commit records of {} requests on {}",
+      total,
+      waiters.size(),
+      _ntp);
+
+    (void)ss::with_gate(
+      _gate,
+      [this,
+       total,
+       batch = std::move(builder).build(),
+       waiters = std::move(waiters)]() mutable {
+          return _replicate(std::move(batch))
+            .then_wrapped(
+              [total, waiters = std::move(waiters)](
+                ss::future<result<raft::replicate_result>> f) mutable {
+                  if (f.failed()) {
+                      auto e = f.get_exception();
+                      for (auto& w : waiters) {
+                          w.promise.set_exception(e);
+                      }
+                      return;
+                  }
+                  auto r = f.get0();
+                  for (auto& w : waiters) {
+                      if (!r) {
+                          w.promise.set_value(r.error());
+                          continue;
+                      }
+                      // offset of the last record of this append
+                      auto last = r.value().last_offset
+                                  - model::offset(total - w.records);
+                      w.promise.set_value(
+                        raft::replicate_result{.last_offset = last});
+                  }
+              });
+      });
+}
+
+ss::future<> offset_commit_batcher::stop() {
+    flush();
+    return _gate.close();
+}
+
+void offset_commit_batcher::setup_metrics() {
+    namespace sm = ss::metrics;
+
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    const auto& ntp = _ntp;
+    const std::vector<sm::label_instance> labels = {
+      sm::label("namespace")(ntp.ns()),
+      sm::label("topic")(ntp.tp.topic()),
+      sm::label("partition")(ntp.tp.partition()),
+    };
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:group_offset_commit"),
+      {
+        sm::make_derive(
+          "requests",
+          [this] { return _appends; },
+          sm::description("Number of offset commit requests appended"),
+          labels),
+        sm::make_derive(
+          "replicates",
+          [this] { return _replicates; },
+          sm::description("Number of raft replicate calls for offset commits"),
+          labels),
+        sm::make_derive(
+          "records",
+          [this] { return _replicated_records; },
+          sm::description("Number of replicated offset commit records"),
+          labels),
+        sm::make_gauge(
+          "coalescing_factor",
+          [this] {
+              return _replicates == 0
+                       ? 0.0
+                       : static_cast<double>(_appends) / _replicates;
+          },
+          sm::description(
+            "Average number of commit requests per replicate call"),
+          labels),
+      });
+}
+
+} // namespace kafka
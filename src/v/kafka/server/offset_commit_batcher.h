@@ -0,0 +1,98 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/iobuf.h"
+#include "cluster/fwd.h"
+#include "model/fundamental.h"
+#include "model/record.h"
+#include "outcome.h"
+#include "raft/types.h"
+#include "seastarx.h"
+#include "units.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace kafka {
+
+/**
+ * Coalesces offset commits of different groups hosted on the same group
+ * metadata partition into a single raft replicate call.
+ *
+ * Records appended within the batching window are replicated as one batch.
+ * Each caller is completed independently with a result whose last offset is
+ * the offset of its own last record in the shared batch, so the log offset
+ * based ordering of commits within a group is preserved.
+ *
+ * A zero window disables coalescing and every append is replicated on its
+ * own. Empty appends have no offset to report and are rejected.
+ */
+class offset_commit_batcher {
+public:
+    // flush early once this many bytes are pending
+    static constexpr size_t max_pending_bytes = 512_KiB;
+
+    struct record {
+        iobuf key;
+        std::optional<iobuf> value;
+    };
+
+    using replicate_fn = ss::noncopyable_function<
+      ss::future<result<raft::replicate_result>>(model::record_batch)>;
+
+    offset_commit_batcher(
+      ss::lw_shared_ptr<cluster::partition>, std::chrono::milliseconds window);
+
+    /// batches are replicated with the given function rather than on a
+    /// partition, i.e. in tests
+    offset_commit_batcher(
+      model::ntp, replicate_fn, std::chrono::milliseconds window);
+
+    ss::future<result<raft::replicate_result>> replicate(std::vector<record>);
+
+    /// replicates pending records and waits for in-flight batches
+    ss::future<> stop();
+
+private:
+    struct waiter {
+        // number of pending records up to and including this append
+        size_t records;
+        ss::promise<result<raft::replicate_result>> promise;
+    };
+
+    void flush();
+    void setup_metrics();
+
+    model::ntp _ntp;
+    replicate_fn _replicate;
+    std::chrono::milliseconds _window;
+    std::vector<record> _records;
+    std::vector<waiter> _waiters;
+    size_t _pending_bytes{0};
+    ss::timer<> _timer;
+    ss::gate _gate;
+
+    uint64_t _appends{0};
+    uint64_t _replicates{0};
+    uint64_t _replicated_records{0};
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace kafka
@@ -15,6 +15,7 @@
 #include "kafka/server/logger.h"
 #include "kafka/server/request_context.h"
 #include "kafka/server/response.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "security/scram_algorithm.h"
 #include "utils/utf8.h"
 #include "vlog.h"
@@ -34,6 +35,9 @@ namespace kafka {
 
 protocol::protocol(
   ss::smp_service_group smp,
+  ss::smp_service_group fetch_smp,
+  ss::smp_service_group produce_smp,
+  ss::scheduling_group compression_sg,
   ss::sharded<cluster::metadata_cache>& meta,
   ss::sharded<cluster::topics_frontend>& tf,
   ss::sharded<quota_manager>& quota,
@@ -45,8 +49,13 @@ protocol::protocol(
   ss::sharded<cluster::id_allocator_frontend>& id_allocator_frontend,
   ss::sharded<security::credential_store>& credentials,
   ss::sharded<security::authorizer>& authorizer,
-  ss::sharded<cluster::security_frontend>& sec_fe) noexcept
+  ss::sharded<cluster::security_frontend>& sec_fe)
   : _smp_group(smp)
+  , _fetch_smp_group(fetch_smp)
+  , _produce_smp_group(produce_smp)
+  , _compression_sg(compression_sg)
+  , _recompression_budget(
+      config::shard_local_cfg().kafka_recompression_budget_bytes())
   , _topics_frontend(tf)
   , _metadata_cache(meta)
   , _quota_mgr(quota)
@@ -60,7 +69,31 @@ protocol::protocol(
       config::shard_local_cfg().enable_idempotence.value())
   , _credentials(credentials)
   , _authorizer(authorizer)
-  , _security_frontend(sec_fe) {}
+  , _security_frontend(sec_fe) {
+    setup_metrics();
+}
+
+void protocol::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:smp"),
+      {
+        sm::make_gauge(
+          "fetch_nonlocal_requests",
+          [this] { return _fetch_nonlocal_requests; },
+          sm::description("Fetch reads submitted to other cores, queued or "
+                          "running")),
+        sm::make_gauge(
+          "produce_nonlocal_requests",
+          [this] { return _produce_nonlocal_requests; },
+          sm::description("Produce writes submitted to other cores, queued "
+                          "or running")),
+      });
+}
 
 ss::future<> protocol::apply(rpc::server::resources rs) {
     /*
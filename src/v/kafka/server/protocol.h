@@ -14,20 +14,30 @@
 #include "cluster/fwd.h"
 #include "config/configuration.h"
 #include "kafka/server/fwd.h"
+#include "model/fundamental.h"
 #include "rpc/server.h"
 #include "security/authorizer.h"
 #include "security/credential_store.h"
+#include "utils/mutex.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/smp.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 namespace kafka {
 
 class protocol final : public rpc::server::protocol {
 public:
     protocol(
       ss::smp_service_group,
+      ss::smp_service_group fetch_smp,
+      ss::smp_service_group produce_smp,
+      ss::scheduling_group compression_sg,
       ss::sharded<cluster::metadata_cache>&,
       ss::sharded<cluster::topics_frontend>&,
       ss::sharded<quota_manager>&,
@@ -39,12 +49,12 @@ public:
       ss::sharded<cluster::id_allocator_frontend>&,
       ss::sharded<security::credential_store>&,
       ss::sharded<security::authorizer>&,
-      ss::sharded<cluster::security_frontend>&) noexcept;
+      ss::sharded<cluster::security_frontend>&);
 
     ~protocol() noexcept override = default;
     protocol(const protocol&) = delete;
     protocol& operator=(const protocol&) = delete;
-    protocol(protocol&&) noexcept = default;
+    protocol(protocol&&) noexcept = delete;
     protocol& operator=(protocol&&) noexcept = delete;
 
     const char* name() const final { return "kafka rpc protocol"; }
@@ -53,6 +63,23 @@ public:
     ss::future<> apply(rpc::server::resources) final;
 
     ss::smp_service_group smp_group() const { return _smp_group; }
+    /// cross shard reads and writes of fetch and produce requests are
+    /// submitted under groups of their own
+    ss::smp_service_group fetch_smp_group() const { return _fetch_smp_group; }
+    ss::smp_service_group produce_smp_group() const {
+        return _produce_smp_group;
+    }
+    /// reads and writes submitted to other shards and not completed yet
+    size_t& fetch_nonlocal_requests() { return _fetch_nonlocal_requests; }
+    size_t& produce_nonlocal_requests() { return _produce_nonlocal_requests; }
+    ss::scheduling_group compression_sg() const { return _compression_sg; }
+    ss::semaphore& recompression_budget() { return _recompression_budget; }
+    /// partitions with produced batches being recompressed, the batches that
+    /// follow them wait on the mutex to be appended in order
+    absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<mutex>>&
+    produce_order() {
+        return _produce_order;
+    }
     cluster::topics_frontend& topics_frontend() {
         return _topics_frontend.local();
     }
@@ -85,7 +112,17 @@ public:
     }
 
 private:
+    void setup_metrics();
+
     ss::smp_service_group _smp_group;
+    ss::smp_service_group _fetch_smp_group;
+    ss::smp_service_group _produce_smp_group;
+    size_t _fetch_nonlocal_requests{0};
+    size_t _produce_nonlocal_requests{0};
+    ss::scheduling_group _compression_sg;
+    // bytes of produced batches being recompressed to the topic compression
+    ss::semaphore _recompression_budget;
+    absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<mutex>> _produce_order;
     ss::sharded<cluster::topics_frontend>& _topics_frontend;
     ss::sharded<cluster::metadata_cache>& _metadata_cache;
     ss::sharded<quota_manager>& _quota_mgr;
@@ -99,6 +136,7 @@ private:
     ss::sharded<security::credential_store>& _credentials;
     ss::sharded<security::authorizer>& _authorizer;
     ss::sharded<cluster::security_frontend>& _security_frontend;
+    ss::metrics::metric_groups _metrics;
 };
 
 } // namespace kafka
@@ -120,6 +120,35 @@ public:
         return _conn->server().fetch_sessions_cache();
     }
 
+    ss::scheduling_group compression_sg() const {
+        return _conn->server().compression_sg();
+    }
+
+    ss::semaphore& recompression_budget() {
+        return _conn->server().recompression_budget();
+    }
+
+    absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<mutex>>&
+    produce_order() {
+        return _conn->server().produce_order();
+    }
+
+    ss::smp_service_group fetch_smp_group() const {
+        return _conn->server().fetch_smp_group();
+    }
+
+    ss::smp_service_group produce_smp_group() const {
+        return _conn->server().produce_smp_group();
+    }
+
+    size_t& fetch_nonlocal_requests() {
+        return _conn->server().fetch_nonlocal_requests();
+    }
+
+    size_t& produce_nonlocal_requests() {
+        return _conn->server().produce_nonlocal_requests();
+    }
+
     // clang-format off
     template<typename ResponseType>
     CONCEPT(requires requires (
@@ -200,14 +200,18 @@ process_request(request_context&& ctx, ss::smp_service_group g) {
         return do_process<find_coordinator_handler>(std::move(ctx), g);
     case offset_fetch_handler::api::key:
         return do_process<offset_fetch_handler>(std::move(ctx), g);
-    case produce_handler::api::key:
-        return do_process<produce_handler>(std::move(ctx), g);
+    case produce_handler::api::key: {
+        auto produce_g = ctx.produce_smp_group();
+        return do_process<produce_handler>(std::move(ctx), produce_g);
+    }
     case list_offsets_handler::api::key:
         return do_process<list_offsets_handler>(std::move(ctx), g);
     case offset_commit_handler::api::key:
         return do_process<offset_commit_handler>(std::move(ctx), g);
-    case fetch_handler::api::key:
-        return do_process<fetch_handler>(std::move(ctx), g);
+    case fetch_handler::api::key: {
+        auto fetch_g = ctx.fetch_smp_group();
+        return do_process<fetch_handler>(std::move(ctx), fetch_g);
+    }
     case join_group_handler::api::key:
         return do_process<join_group_handler>(std::move(ctx), g);
     case heartbeat_handler::api::key:
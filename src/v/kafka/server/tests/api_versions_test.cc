@@ -18,23 +18,22 @@
 
 // https://github.com/apache/kafka/blob/eaccb92/core/src/test/scala/unit/kafka/server/ApiVersionsRequestTest.scala
 
-// version 3 is not supported
-#if 0
 FIXTURE_TEST(validate_latest_version, redpanda_thread_fixture) {
     auto client = make_kafka_client().get0();
     client.connect().get();
 
     kafka::api_versions_request request;
-    request.client_software_name = "name";
-    request.client_software_version = "version";
-    auto response = client.dispatch(request).get0();
-    BOOST_TEST(response.error == kafka::error_code::none);
+    request.data.client_software_name = "name";
+    request.data.client_software_version = "version";
+    auto response
+      = client.dispatch(request, kafka::api_versions_handler::max_supported)
+          .get0();
+    BOOST_TEST(response.data.error_code == kafka::error_code::none);
     client.stop().then([&client] { client.shutdown(); }).get();
 
     auto expected = kafka::get_supported_apis();
-    BOOST_TEST(response.apis == expected);
+    BOOST_TEST(response.data.api_keys == expected);
 }
-#endif
 
 FIXTURE_TEST(validate_v0, redpanda_thread_fixture) {
     auto client = make_kafka_client().get0();
@@ -49,8 +48,6 @@ FIXTURE_TEST(validate_v0, redpanda_thread_fixture) {
     BOOST_TEST(response.data.api_keys == expected);
 }
 
-// version 3 is not supported
-#if 0
 FIXTURE_TEST(validate_v3, redpanda_thread_fixture) {
     auto client = make_kafka_client().get0();
     client.connect().get();
@@ -60,9 +57,8 @@ FIXTURE_TEST(validate_v3, redpanda_thread_fixture) {
     client.stop().then([&client] { client.shutdown(); }).get();
 
     // invalid since name/version are empty in the request
-    BOOST_TEST(response.error == kafka::error_code::invalid_request);
+    BOOST_TEST(response.data.error_code == kafka::error_code::invalid_request);
 }
-#endif
 
 FIXTURE_TEST(unsupported_version, redpanda_thread_fixture) {
     auto client = make_kafka_client().get0();
@@ -0,0 +1,148 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/simple_batch_builder.h"
+#include "kafka/server/group_manager.h"
+#include "raft/types.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+namespace kafka {
+
+static group_log_record_key
+offset_key(ss::sstring group, ss::sstring topic, int32_t partition) {
+    return group_log_record_key{
+      .record_type = group_log_record_key::type::offset_commit,
+      .key = reflection::to_iobuf(group_log_offset_key{
+        kafka::group_id(std::move(group)),
+        model::topic(std::move(topic)),
+        model::partition_id(partition),
+      }),
+    };
+}
+
+static void add_offset(
+  cluster::simple_batch_builder& builder,
+  ss::sstring group,
+  ss::sstring topic,
+  int32_t partition,
+  int64_t offset) {
+    builder.add_kv(
+      offset_key(std::move(group), std::move(topic), partition),
+      group_log_offset_metadata{
+        .offset = model::offset(offset),
+        .leader_epoch = 1,
+        .metadata = "md",
+      });
+}
+
+static void add_group(cluster::simple_batch_builder& builder, ss::sstring id) {
+    builder.add_kv(
+      group_log_record_key{
+        .record_type = group_log_record_key::type::group_metadata,
+        .key = reflection::to_iobuf(kafka::group_id(std::move(id))),
+      },
+      group_log_group_metadata{
+        .protocol_type = kafka::protocol_type("consumer"),
+        .generation = kafka::generation_id(3),
+        .protocol = kafka::protocol_name("range"),
+        .leader = kafka::member_id("m"),
+        .state_timestamp = 10,
+      });
+}
+
+/*
+ * the log is split in a head that is covered by the snapshot and a tail that
+ * is replayed on top of it.
+ */
+static model::record_batch make_head() {
+    cluster::simple_batch_builder builder(
+      raft::data_batch_type, model::offset(0));
+    add_group(builder, "g0");
+    add_group(builder, "g1");
+    add_offset(builder, "g0", "t", 0, 10);
+    add_offset(builder, "g0", "t", 1, 20);
+    add_offset(builder, "g2", "t", 0, 30);
+    return std::move(builder).build();
+}
+
+static model::record_batch make_tail() {
+    cluster::simple_batch_builder builder(
+      raft::data_batch_type, model::offset(5));
+    // g1 removed, g0 offset updated, g2 offset deleted
+    builder.add_raw_kv(
+      reflection::to_iobuf(group_log_record_key{
+        .record_type = group_log_record_key::type::group_metadata,
+        .key = reflection::to_iobuf(kafka::group_id("g1")),
+      }),
+      std::nullopt);
+    add_offset(builder, "g0", "t", 0, 11);
+    builder.add_raw_kv(
+      reflection::to_iobuf(offset_key("g2", "t", 0)), std::nullopt);
+    return std::move(builder).build();
+}
+
+static void check_state(const recovery_batch_consumer_state& st) {
+    BOOST_REQUIRE_EQUAL(st.loaded_groups.size(), 1);
+    auto& g0 = st.loaded_groups.at(kafka::group_id("g0"));
+    BOOST_REQUIRE_EQUAL(g0.generation, kafka::generation_id(3));
+    BOOST_REQUIRE(g0.protocol == kafka::protocol_name("range"));
+
+    BOOST_REQUIRE_EQUAL(st.removed_groups.size(), 1);
+    BOOST_REQUIRE(st.removed_groups.contains(kafka::group_id("g1")));
+
+    BOOST_REQUIRE_EQUAL(st.loaded_offsets.size(), 2);
+    auto p0 = st.loaded_offsets.at(group_log_offset_key{
+      kafka::group_id("g0"), model::topic("t"), model::partition_id(0)});
+    BOOST_REQUIRE_EQUAL(p0.first, model::offset(5));
+    BOOST_REQUIRE_EQUAL(p0.second.offset, model::offset(11));
+    auto p1 = st.loaded_offsets.at(group_log_offset_key{
+      kafka::group_id("g0"), model::topic("t"), model::partition_id(1)});
+    BOOST_REQUIRE_EQUAL(p1.first, model::offset(0));
+    BOOST_REQUIRE_EQUAL(p1.second.offset, model::offset(20));
+    BOOST_REQUIRE(p1.second.metadata == ss::sstring("md"));
+}
+
+SEASTAR_THREAD_TEST_CASE(full_replay) {
+    ss::abort_source as;
+    recovery_batch_consumer consumer(as);
+    consumer(make_head()).get();
+    consumer(make_tail()).get();
+    check_state(consumer.end_of_stream());
+}
+
+SEASTAR_THREAD_TEST_CASE(snapshot_and_tail_replay) {
+    ss::abort_source as;
+    recovery_batch_consumer head(as);
+    head(make_head()).get();
+
+    auto snapshot = serialize_group_snapshot_state(head.end_of_stream());
+    auto restored = deserialize_group_snapshot_state(std::move(snapshot));
+    BOOST_REQUIRE_EQUAL(restored.loaded_groups.size(), 2);
+    BOOST_REQUIRE_EQUAL(restored.loaded_offsets.size(), 3);
+
+    recovery_batch_consumer tail(as, std::move(restored));
+    tail(make_tail()).get();
+    check_state(tail.end_of_stream());
+}
+
+SEASTAR_THREAD_TEST_CASE(snapshot_roundtrip_with_removed_groups) {
+    ss::abort_source as;
+    recovery_batch_consumer consumer(as);
+    consumer(make_head()).get();
+    consumer(make_tail()).get();
+
+    auto snapshot = serialize_group_snapshot_state(consumer.end_of_stream());
+    check_state(deserialize_group_snapshot_state(std::move(snapshot)));
+}
+
+} // namespace kafka
@@ -0,0 +1,187 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "kafka/server/offset_commit_batcher.h"
+#include "model/fundamental.h"
+#include "model/namespace.h"
+#include "model/record.h"
+#include "raft/errc.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+#include <system_error>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// log of the group partition, offsets start at 10
+struct fake_log {
+    model::offset next{10};
+    std::vector<int32_t> batches;
+    std::optional<std::error_code> error;
+
+    kafka::offset_commit_batcher::replicate_fn replicate() {
+        return [this](model::record_batch b) {
+            using ret_t = result<raft::replicate_result>;
+            batches.push_back(b.record_count());
+            if (error) {
+                return ss::make_ready_future<ret_t>(*error);
+            }
+            auto last = next + model::offset(b.record_count() - 1);
+            next = last + model::offset(1);
+            return ss::make_ready_future<ret_t>(
+              raft::replicate_result{.last_offset = last});
+        };
+    }
+};
+
+std::vector<kafka::offset_commit_batcher::record>
+make_records(size_t n, size_t value_size = 8) {
+    std::vector<kafka::offset_commit_batcher::record> ret;
+    for (size_t i = 0; i < n; ++i) {
+        iobuf key;
+        key.append("key", 3);
+        iobuf value;
+        std::string v(value_size, 'v');
+        value.append(v.data(), v.size());
+        ret.push_back({.key = std::move(key), .value = std::move(value)});
+    }
+    return ret;
+}
+
+model::ntp group_ntp() {
+    return model::ntp(
+      model::kafka_internal_namespace,
+      model::topic("group"),
+      model::partition_id(0));
+}
+
+void disable_metrics() {
+    config::shard_local_cfg().get("disable_metrics").set_value(true);
+}
+
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(coalesces_appends_within_window) {
+    disable_metrics();
+    fake_log log;
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 1h);
+
+    auto f1 = batcher.replicate(make_records(2));
+    auto f2 = batcher.replicate(make_records(3));
+    auto f3 = batcher.replicate(make_records(1));
+    // nothing is replicated before the window closes
+    BOOST_REQUIRE(log.batches.empty());
+    batcher.stop().get();
+
+    BOOST_REQUIRE(log.batches == std::vector<int32_t>({6}));
+    // the shared batch takes offsets 10 to 15, every append gets the offset
+    // of its own last record
+    BOOST_REQUIRE_EQUAL(f1.get0().value().last_offset, model::offset(11));
+    BOOST_REQUIRE_EQUAL(f2.get0().value().last_offset, model::offset(14));
+    BOOST_REQUIRE_EQUAL(f3.get0().value().last_offset, model::offset(15));
+}
+
+SEASTAR_THREAD_TEST_CASE(flushes_when_window_closes) {
+    disable_metrics();
+    fake_log log;
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 10ms);
+
+    auto f1 = batcher.replicate(make_records(1));
+    auto f2 = batcher.replicate(make_records(1));
+    BOOST_REQUIRE_EQUAL(f1.get0().value().last_offset, model::offset(10));
+    BOOST_REQUIRE_EQUAL(f2.get0().value().last_offset, model::offset(11));
+    BOOST_REQUIRE(log.batches == std::vector<int32_t>({2}));
+
+    // a new window starts with the next append
+    auto f3 = batcher.replicate(make_records(1));
+    BOOST_REQUIRE_EQUAL(f3.get0().value().last_offset, model::offset(12));
+    BOOST_REQUIRE(log.batches == std::vector<int32_t>({2, 1}));
+    batcher.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(flushes_on_pending_bytes) {
+    disable_metrics();
+    fake_log log;
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 1h);
+
+    auto f1 = batcher.replicate(make_records(1));
+    BOOST_REQUIRE(log.batches.empty());
+    auto f2 = batcher.replicate(
+      make_records(1, kafka::offset_commit_batcher::max_pending_bytes));
+    // replicated right away, without waiting for the window
+    BOOST_REQUIRE(log.batches == std::vector<int32_t>({2}));
+    BOOST_REQUIRE_EQUAL(f1.get0().value().last_offset, model::offset(10));
+    BOOST_REQUIRE_EQUAL(f2.get0().value().last_offset, model::offset(11));
+    batcher.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(zero_window_replicates_every_append) {
+    disable_metrics();
+    fake_log log;
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 0ms);
+
+    auto f1 = batcher.replicate(make_records(2));
+    auto f2 = batcher.replicate(make_records(2));
+    BOOST_REQUIRE_EQUAL(f1.get0().value().last_offset, model::offset(11));
+    BOOST_REQUIRE_EQUAL(f2.get0().value().last_offset, model::offset(13));
+    BOOST_REQUIRE(log.batches == std::vector<int32_t>({2, 2}));
+    batcher.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(stop_completes_pending_appends) {
+    disable_metrics();
+    fake_log log;
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 1h);
+
+    auto f = batcher.replicate(make_records(1));
+    batcher.stop().get();
+    BOOST_REQUIRE(f.available());
+    BOOST_REQUIRE_EQUAL(f.get0().value().last_offset, model::offset(10));
+
+    // appends after stop are rejected
+    auto r = batcher.replicate(make_records(1)).get0();
+    BOOST_REQUIRE(!r);
+    BOOST_REQUIRE_EQUAL(r.error(), make_error_code(raft::errc::shutting_down));
+    BOOST_REQUIRE(log.batches == std::vector<int32_t>({1}));
+}
+
+SEASTAR_THREAD_TEST_CASE(stop_fails_pending_appends_on_error) {
+    disable_metrics();
+    fake_log log;
+    log.error = make_error_code(raft::errc::not_leader);
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 1h);
+
+    auto f1 = batcher.replicate(make_records(1));
+    auto f2 = batcher.replicate(make_records(2));
+    batcher.stop().get();
+    for (auto* f : {&f1, &f2}) {
+        BOOST_REQUIRE(f->available());
+        auto r = f->get0();
+        BOOST_REQUIRE(!r);
+        BOOST_REQUIRE_EQUAL(r.error(), make_error_code(raft::errc::not_leader));
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(rejects_empty_append) {
+    disable_metrics();
+    fake_log log;
+    kafka::offset_commit_batcher batcher(group_ntp(), log.replicate(), 0ms);
+
+    auto r = batcher.replicate({}).get0();
+    BOOST_REQUIRE(!r);
+    BOOST_REQUIRE(log.batches.empty());
+    batcher.stop().get();
+}
@@ -23,7 +23,7 @@
 using namespace std::chrono_literals;
 
 struct prod_consume_fixture : public redpanda_thread_fixture {
-    void start() {
+    void start(cluster::topic_properties props = {}) {
         consumer = std::make_unique<kafka::client::transport>(
           make_kafka_client().get0());
         producer = std::make_unique<kafka::client::transport>(
@@ -31,7 +31,7 @@ struct prod_consume_fixture : public redpanda_thread_fixture {
         consumer->connect().get0();
         producer->connect().get0();
         model::topic_namespace tp_ns(model::ns("kafka"), test_topic);
-        add_topic(tp_ns).get0();
+        add_topic(tp_ns, 1, std::move(props)).get0();
         model::ntp ntp(tp_ns.ns, tp_ns.tp, model::partition_id(0));
         tests::cooperative_spin_wait_with_timeout(2s, [ntp, this] {
             auto shard = app.shard_table.local().shard_for(ntp);
@@ -64,6 +64,26 @@ struct prod_consume_fixture : public redpanda_thread_fixture {
         return res;
     }
 
+    std::vector<kafka::produce_request::partition>
+    compressible_batches(size_t count) {
+        storage::record_batch_builder builder(
+          model::well_known_record_batch_types[1], model::offset(0));
+
+        for (int i = 0; i < count; ++i) {
+            iobuf v{};
+            v.append(ss::sstring(1_KiB, 'v').data(), 1_KiB);
+            builder.add_raw_kv(iobuf{}, std::move(v));
+        }
+
+        std::vector<kafka::produce_request::partition> res;
+
+        kafka::produce_request::partition partition;
+        partition.partition_index = model::partition_id(0);
+        partition.records.emplace(std::move(builder).build());
+        res.push_back(std::move(partition));
+        return res;
+    }
+
     template<typename T>
     ss::future<size_t> produce(T&& batch_factory) {
         kafka::produce_request::topic tp;
@@ -156,3 +176,54 @@ FIXTURE_TEST(test_produce_consume_small_batches, prod_consume_fixture) {
       resp_2.partitions.begin()->responses.begin()->record_set->last_offset()(),
       initial_offset + cnt_1 + cnt_2);
 };
+
+FIXTURE_TEST(test_produce_recompressed_to_topic_codec, prod_consume_fixture) {
+    wait_for_controller_leadership().get0();
+    start(cluster::topic_properties{.compression = model::compression::zstd});
+    auto cnt = produce([this](size_t cnt) {
+                   return compressible_batches(cnt);
+               }).get0();
+    auto resp = fetch_next().get0();
+
+    BOOST_REQUIRE_EQUAL(resp.partitions.empty(), false);
+    BOOST_REQUIRE_EQUAL(resp.partitions.begin()->responses.empty(), false);
+    auto& r = *resp.partitions.begin()->responses.begin();
+    BOOST_REQUIRE_EQUAL(r.error, kafka::error_code::none);
+    auto adapter = r.record_set->consume_batch();
+    BOOST_REQUIRE(adapter.batch);
+    // produced uncompressed, stored with the compression of the topic
+    BOOST_REQUIRE_EQUAL(
+      adapter.batch->header().attrs.compression(), model::compression::zstd);
+    BOOST_REQUIRE_EQUAL(adapter.batch->record_count(), cnt);
+    BOOST_REQUIRE_LT(adapter.batch->size_bytes(), cnt * 1_KiB);
+}
+
+FIXTURE_TEST(
+  test_produce_recompressed_in_partition_order, prod_consume_fixture) {
+    wait_for_controller_leadership().get0();
+    start(cluster::topic_properties{.compression = model::compression::zstd});
+    auto make_request = [this](auto partitions) {
+        kafka::produce_request::topic tp;
+        tp.partitions = std::move(partitions);
+        tp.name = test_topic;
+        std::vector<kafka::produce_request::topic> topics;
+        topics.push_back(std::move(tp));
+        kafka::produce_request req(std::nullopt, 1, std::move(topics));
+        req.data.timeout_ms = std::chrono::seconds(2);
+        req.has_idempotent = false;
+        req.has_transactional = false;
+        return req;
+    };
+    // the large batch is recompressed, the small one sent right after it is
+    // appended after it nonetheless
+    auto first = producer->dispatch(make_request(compressible_batches(100)));
+    auto second = producer->dispatch(make_request(small_batches(1)));
+    auto r1 = first.get0();
+    auto r2 = second.get0();
+
+    auto& p1 = r1.data.responses.front().partitions.front();
+    auto& p2 = r2.data.responses.front().partitions.front();
+    BOOST_REQUIRE_EQUAL(p1.error_code, kafka::error_code::none);
+    BOOST_REQUIRE_EQUAL(p2.error_code, kafka::error_code::none);
+    BOOST_REQUIRE_LT(p1.base_offset, p2.base_offset);
+}
@@ -9,22 +9,33 @@
 
 #include "model/record_batch_reader.h"
 
+#include "bytes/foreign_iobuf.h"
+
 #include <seastar/core/sharded.hh>
 #include <seastar/core/smp.hh>
 
 #include <memory>
 
 namespace model {
+// slices of foreign readers loaded from this shard and not completed yet
+static thread_local size_t foreign_loads_in_flight = 0;
+
+size_t foreign_record_batch_reader_loads() { return foreign_loads_in_flight; }
+
 using data_t = record_batch_reader::data_t;
 using foreign_data_t = record_batch_reader::foreign_data_t;
 using storage_t = record_batch_reader::storage_t;
 
 /// \brief wraps a reader into a foreign_ptr<unique_ptr>
-record_batch_reader make_foreign_record_batch_reader(record_batch_reader&& r) {
+record_batch_reader make_foreign_record_batch_reader(
+  record_batch_reader&& r, ss::smp_service_group ssg) {
     class foreign_reader final : public record_batch_reader::impl {
     public:
-        explicit foreign_reader(std::unique_ptr<record_batch_reader::impl> i)
-          : _ptr(std::move(i)) {}
+        foreign_reader(
+          std::unique_ptr<record_batch_reader::impl> i,
+          ss::smp_service_group ssg)
+          : _ptr(std::move(i))
+          , _ssg(ssg) {}
         foreign_reader(const foreign_reader&) = delete;
         foreign_reader& operator=(const foreign_reader&) = delete;
         foreign_reader(foreign_reader&&) = delete;
@@ -49,8 +60,8 @@ record_batch_reader make_foreign_record_batch_reader(record_batch_reader&& r) {
             if (shard == ss::this_shard_id()) {
                 return _ptr->do_load_slice(t);
             }
-            // TODO: this function should take an SMP group
-            return ss::smp::submit_to(shard, [this, t] {
+            ++foreign_loads_in_flight;
+            auto f = ss::smp::submit_to(shard, _ssg, [this, t] {
                 return _ptr->do_load_slice(t).then([](storage_t recs) {
                     if (likely(std::holds_alternative<data_t>(recs))) {
                         auto& d = std::get<data_t>(recs);
@@ -62,15 +73,42 @@ record_batch_reader make_foreign_record_batch_reader(record_batch_reader&& r) {
                     return recs;
                 });
             });
+            return f.finally([] { --foreign_loads_in_flight; });
         }
 
     private:
         ss::foreign_ptr<std::unique_ptr<record_batch_reader::impl>> _ptr;
+        ss::smp_service_group _ssg;
     };
-    auto frn = std::make_unique<foreign_reader>(std::move(r).release());
+    auto frn = std::make_unique<foreign_reader>(std::move(r).release(), ssg);
     return record_batch_reader(std::move(frn));
 }
 
+storage_t record_batch_reader::impl::localize(storage_t s) {
+    if (std::holds_alternative<data_t>(s)) {
+        return s;
+    }
+    auto& d = std::get<foreign_data_t>(s);
+    auto& batches = *d.buffer;
+    data_t ret;
+    ret.reserve(batches.size() - std::min(d.index, batches.size()));
+    if (d.buffer.get_owner_shard() == ss::this_shard_id()) {
+        for (auto i = d.index; i < batches.size(); ++i) {
+            ret.push_back(std::move(batches[i]));
+        }
+        return ret;
+    }
+    auto keepalive = make_foreign_deleter(std::move(d.buffer));
+    for (auto i = d.index; i < batches.size(); ++i) {
+        const auto& b = batches[i];
+        ret.emplace_back(
+          b.header(),
+          iobuf_share_foreign(b.data(), keepalive.share()),
+          record_batch::tag_ctor_ng{});
+    }
+    return ret;
+}
+
 record_batch_reader make_memory_record_batch_reader(storage_t batches) {
     class reader final : public record_batch_reader::impl {
     public:
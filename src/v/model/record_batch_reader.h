@@ -21,6 +21,7 @@
 #include <seastar/core/do_with.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/optimized_optional.hh>
 
@@ -118,9 +119,13 @@ public:
         ss::future<> load_slice(timeout_clock::time_point timeout) {
             return do_load_slice(timeout).then([this](storage_t s) {
                 // reassign the local cache
-                _slice = std::move(s);
+                _slice = localize(std::move(s));
             });
         }
+        /// batches of a slice loaded from another shard share its memory
+        /// rather than being copied one by one, the memory is released to
+        /// its shard once all the batches are gone
+        static storage_t localize(storage_t);
         template<typename ReferenceConsumer>
         auto do_for_each_ref(
           ReferenceConsumer& refc, timeout_clock::time_point timeout) {
@@ -321,8 +326,15 @@ record_batch_reader make_generating_record_batch_reader(
 ss::future<record_batch_reader::data_t> consume_reader_to_memory(
   record_batch_reader, timeout_clock::time_point timeout);
 
-/// \brief wraps a reader into a foreign_ptr<unique_ptr>
-record_batch_reader make_foreign_record_batch_reader(record_batch_reader&&);
+/// \brief wraps a reader into a foreign_ptr<unique_ptr>, slices are loaded
+/// from the owner shard under the given smp service group
+record_batch_reader
+make_foreign_record_batch_reader(record_batch_reader&&, ss::smp_service_group);
+
+/// slices of foreign readers this shard is loading from other shards, queued
+/// for the smp service group or running
+size_t foreign_record_batch_reader_loads();
+
 std::ostream& operator<<(std::ostream& os, const record_batch_reader& r);
 
 } // namespace model
@@ -14,6 +14,8 @@
 #include "reflection/adl.h"
 #include "utils/vint.h"
 
+#include <array>
+
 namespace model {
 
 template<typename T, typename = std::enable_if_t<std::is_integral_v<T>, T>>
@@ -116,9 +118,10 @@ static model::record do_parse_one_record_from_buffer(
   int32_t record_size,
   model::record_attributes::type attr,
   ParserData parser_data) {
-    auto [timestamp_delta, tv] = parser.read_varlong();
-    auto [offset_delta, ov] = parser.read_varlong();
-    auto [key_length, kv] = parser.read_varlong();
+    // timestamp delta, offset delta and key length are laid out back to back
+    std::array<int64_t, 3> meta; // NOLINT
+    parser.read_varlongs(meta.data(), meta.size());
+    const auto [timestamp_delta, offset_delta, key_length] = meta;
     iobuf key;
     if (key_length > 0) {
         key = parser_data(parser, key_length);
@@ -177,6 +180,14 @@ static inline void append_vint_to_iobuf(iobuf& b, int64_t v) {
     b.append(vb.data(), vb.size());
 }
 
+template<size_t N>
+static inline void
+append_vints_to_iobuf(iobuf& b, const std::array<int64_t, N>& v) {
+    std::array<uint8_t, N * vint::max_length> staging; // NOLINT
+    auto sz = vint::serialize_array(v.data(), v.size(), staging.data());
+    b.append(staging.data(), sz);
+}
+
 void append_record_to_buffer(iobuf& a, const model::record& r) {
     a.reserve_memory(vint::max_length * 6);
     append_vint_to_iobuf(a, r.size_bytes());
@@ -185,11 +196,9 @@ void append_record_to_buffer(iobuf& a, const model::record& r) {
     // NOLINTNEXTLINE
     a.append(reinterpret_cast<const char*>(&attrs), sizeof(attrs));
 
-    append_vint_to_iobuf(a, r.timestamp_delta());
-    append_vint_to_iobuf(a, r.offset_delta());
-
     a.reserve_memory(r.key_size() + r.value_size());
-    append_vint_to_iobuf(a, r.key_size());
+    append_vints_to_iobuf<3>(
+      a, {r.timestamp_delta(), r.offset_delta(), r.key_size()});
     if (r.key_size() > 0) {
         for (auto& f : r.key()) {
             a.append(f.get(), f.size());
@@ -0,0 +1,149 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/foreign_iobuf.h"
+#include "model/record.h"
+#include "model/record_batch_reader.h"
+#include "model/timeout_clock.h"
+#include "storage/tests/utils/random_batch.h"
+
+#include <seastar/core/future-util.hh>
+#include <seastar/core/memory.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/core.h>
+
+/*
+ * Batches handed over to another shard through a foreign memory reader, as
+ * kafka produce does towards the partition shard and fetch does back to the
+ * connection shard. The consumer owns the batches it read and drops them, the
+ * memory is released back to the producing shard.
+ *
+ * The copy variant also copies every batch on the consuming shard, which is
+ * what readers did with foreign batches before they were shared.
+ *
+ * Reported per test: bytes per iteration, frees of memory of another shard
+ * made by the consuming shard's allocator and messages sent to release
+ * memory to its owner in bulk.
+ */
+struct cross_shard_bench {
+    using data_t = model::record_batch_reader::data_t;
+
+    struct stats {
+        size_t bytes{0};
+        uint64_t cross_cpu_frees{0};
+        uint64_t release_messages{0};
+    };
+
+    static ss::shard_id consumer_shard() {
+        return (ss::this_shard_id() + 1) % ss::smp::count;
+    }
+
+    static size_t size_bytes(const data_t& batches) {
+        size_t ret = 0;
+        for (const auto& b : batches) {
+            ret += b.size_bytes();
+        }
+        return ret;
+    }
+
+    template<typename Func>
+    ss::future<size_t> hand_over(data_t batches, Func consume) {
+        auto rdr = model::make_foreign_memory_record_batch_reader(
+          std::move(batches));
+        perf_tests::start_measuring_time();
+        return ss::smp::submit_to(
+                 consumer_shard(),
+                 [rdr = std::move(rdr), consume]() mutable {
+                     const auto frees
+                       = ss::memory::stats().cross_cpu_frees();
+                     const auto messages = details::foreign_release_queue::
+                                             local()
+                                               .messages();
+                     return consume(std::move(rdr))
+                       .then([](size_t bytes) {
+                           // let the releases of this task be flushed
+                           return ss::later().then([bytes] { return bytes; });
+                       })
+                       .then([frees, messages](size_t bytes) {
+                           return stats{
+                             .bytes = bytes,
+                             .cross_cpu_frees
+                             = ss::memory::stats().cross_cpu_frees() - frees,
+                             .release_messages
+                             = details::foreign_release_queue::local()
+                                 .messages()
+                               - messages,
+                           };
+                       });
+                 })
+          .then([this](stats s) {
+              perf_tests::stop_measuring_time();
+              report(s);
+              return s.bytes;
+          });
+    }
+
+    void report(const stats& s) {
+        if (reported) {
+            return;
+        }
+        reported = true;
+        fmt::print(
+          "{} bytes per iteration, {} cross shard frees, {} release "
+          "messages\n",
+          s.bytes,
+          s.cross_cpu_frees,
+          s.release_messages);
+    }
+
+    static ss::future<size_t> share(model::record_batch_reader rdr) {
+        return model::consume_reader_to_memory(
+                 std::move(rdr), model::no_timeout)
+          .then([](data_t batches) { return size_bytes(batches); });
+    }
+
+    static ss::future<size_t> copy(model::record_batch_reader rdr) {
+        return model::consume_reader_to_memory(
+                 std::move(rdr), model::no_timeout)
+          .then([](data_t batches) {
+              data_t copies;
+              for (const auto& b : batches) {
+                  copies.push_back(b.copy());
+              }
+              return size_bytes(copies);
+          });
+    }
+
+    bool reported{false};
+};
+
+// one small batch per request, as produced by kafka clients
+PERF_TEST_F(cross_shard_bench, produce_share) {
+    return hand_over(
+      storage::test::make_random_batches(model::offset(0), 1, false), share);
+}
+
+PERF_TEST_F(cross_shard_bench, produce_copy) {
+    return hand_over(
+      storage::test::make_random_batches(model::offset(0), 1, false), copy);
+}
+
+// many batches per slice, as read by fetch
+PERF_TEST_F(cross_shard_bench, fetch_share) {
+    return hand_over(
+      storage::test::make_random_batches(model::offset(0), 50, false), share);
+}
+
+PERF_TEST_F(cross_shard_bench, fetch_copy) {
+    return hand_over(
+      storage::test::make_random_batches(model::offset(0), 50, false), copy);
+}
@@ -11,6 +11,7 @@
 #include "model/record_batch_reader.h"
 #include "storage/tests/utils/random_batch.h"
 
+#include <seastar/core/smp.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/testing/thread_test_case.hh>
 
@@ -155,6 +156,38 @@ SEASTAR_THREAD_TEST_CASE(test_interrupt_consume_multiple_slices) {
     do_test_interrupt_consume(make_generating_reader(
       make_batches(offset(1), offset(2), offset(3), offset(4), offset(5))));
 }
+SEASTAR_THREAD_TEST_CASE(test_consume_foreign_reader) {
+    // slices are loaded from the owner shard one at a time
+    ss::smp_service_group_config cfg;
+    cfg.max_nonlocal_requests = 1;
+    auto ssg = ss::create_smp_service_group(cfg).get0();
+    auto reader = make_foreign_record_batch_reader(
+      make_generating_reader(
+        make_batches(offset(1), offset(2), offset(3), offset(4))),
+      ssg);
+
+    auto other = (ss::this_shard_id() + 1) % ss::smp::count;
+    auto offsets = ss::smp::submit_to(other, [&reader] {
+                       return reader.consume(consumer(4), no_timeout)
+                         .then([](ss::circular_buffer<record_batch> batches) {
+                             std::vector<offset> ret;
+                             for (auto& b : batches) {
+                                 ret.push_back(b.base_offset());
+                             }
+                             return ret;
+                         });
+                   }).get0();
+    BOOST_CHECK(
+      offsets
+      == std::vector<offset>({offset(1), offset(2), offset(3), offset(4)}));
+    // every load completed on the shard that consumed the reader
+    auto loads = ss::smp::submit_to(other, [] {
+                     return foreign_record_batch_reader_loads();
+                 }).get0();
+    BOOST_CHECK_EQUAL(loads, 0);
+    ss::destroy_smp_service_group(ssg).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(record_batch_sharing) {
     auto v1 = make_batches(
       offset(1), offset(2), offset(3), offset(4), offset(5));
@@ -18,6 +18,7 @@
 #include "raft/errc.h"
 #include "raft/group_configuration.h"
 #include "raft/logger.h"
+#include "raft/peer_liveness.h"
 #include "raft/prevote_stm.h"
 #include "raft/recovery_stm.h"
 #include "raft/rpc_client_protocol.h"
@@ -125,6 +126,11 @@ clock_type::time_point consensus::majority_heartbeat() const {
         }
 
         if (auto it = _fstats.find(rni); it != _fstats.end()) {
+            if (is_follower_idle(rni)) {
+                return std::max(
+                  it->second.last_hbeat_timestamp,
+                  shard_local_peer_liveness().last_seen(rni.id()));
+            }
             return it->second.last_hbeat_timestamp;
         }
 
@@ -222,6 +228,7 @@ consensus::success_reply consensus::update_follower_index(
     }
 
     update_node_hbeat_timestamp(node);
+    maybe_update_lease(idx, seq, reply);
 
     if (
       seq < idx.last_received_seq
@@ -298,6 +305,9 @@ consensus::success_reply consensus::update_follower_index(
             idx.last_dirty_log_index = reply.last_dirty_log_index;
             idx.last_committed_log_index = reply.last_committed_log_index;
             idx.next_index = details::next_offset(idx.last_dirty_log_index);
+            // requests in flight were built on top of state which is no
+            // longer valid
+            idx.last_sent_offset = model::offset{};
             idx.follower_state_change.broadcast();
         }
         return success_reply::no;
@@ -410,6 +420,7 @@ void consensus::dispatch_recovery(follower_index_metadata& idx) {
           log_max_offset);
         idx.next_index = log_max_offset;
     }
+    idx.last_sent_offset = model::offset{};
     idx.is_recovering = true;
     // background
     (void)with_gate(_bg, [this, node_id = idx.node_id] {
@@ -433,6 +444,12 @@ ss::future<result<model::offset>> consensus::linearizable_barrier() {
         model::term_id term;
     };
 
+    if (lease_valid()) {
+        _probe.lease_read();
+        co_return ret_t(_commit_index);
+    }
+    _probe.barrier_read();
+
     std::optional<ss::semaphore_units<>> u = co_await _op_lock.get_units();
 
     if (_vstate != vote_state::leader) {
@@ -639,7 +656,7 @@ bool consensus::should_skip_vote(bool ignore_heartbeat) {
 
     if (likely(!ignore_heartbeat)) {
         auto last_election = clock_type::now() - _jit.base_duration();
-        skip_vote |= (_hbeat > last_election); // nothing to do.
+        skip_vote |= heard_from_leader(last_election); // nothing to do.
     }
 
     skip_vote |= _vstate == vote_state::leader; // already a leader
@@ -1173,10 +1190,16 @@ ss::future<vote_reply> consensus::do_vote(vote_request&& r) {
     // Check if we updated the heartbeat timepoint in the last election
     // timeout duration When the vote was requested because of leadership
     // transfer grant the vote immediately.
+    // With leader leases enabled the vote we gave in an earlier term does not
+    // count, the leader we heard from may be holding a lease on our promise
     auto prev_election = clock_type::now() - _jit.base_duration();
+    const bool repeated_vote
+      = r.node_id == _voted_for
+        && (r.term == _term
+            || !config::shard_local_cfg().raft_leader_lease_enabled());
     if (
-      _hbeat > prev_election && !r.leadership_transfer
-      && r.node_id != _voted_for) {
+      heard_from_leader(prev_election) && !r.leadership_transfer
+      && !repeated_vote) {
         vlog(
           _ctxlog.trace,
           "Already heard from the leader, not granting vote to node {}",
@@ -1197,6 +1220,7 @@ ss::future<vote_reply> consensus::do_vote(vote_request&& r) {
         reply.term = r.term;
         _term = r.term;
         _voted_for = {};
+        _leader_idle = false;
         do_step_down();
 
         // do not grant vote if log isn't ok
@@ -1282,6 +1306,7 @@ consensus::do_append_entries(append_entries_request&& r) {
      */
     _target_priority = voter_priority::max();
     do_step_down();
+    _leader_idle = false;
     if (r.meta.term > _term) {
         vlog(
           _ctxlog.debug,
@@ -1363,6 +1388,9 @@ consensus::do_append_entries(append_entries_request&& r) {
           lstats.dirty_offset, r.meta.last_visible_index);
         // on the follower leader control visibility of entries in the log
         maybe_update_last_visible_index(last_visible);
+        // the leader has nothing more to send, it may stop sending per group
+        // heartbeats and rely on node liveness until anything changes
+        _leader_idle = r.meta.commit_index == r.meta.prev_log_index;
         return maybe_update_follower_commit_idx(
                  model::offset(r.meta.commit_index))
           .then([reply = std::move(reply)]() mutable {
@@ -1628,6 +1656,43 @@ ss::future<install_snapshot_reply> consensus::finish_snapshot(
       });
 }
 
+ss::future<std::optional<snapshot_payload>> consensus::read_snapshot() {
+    using ret_t = std::optional<snapshot_payload>;
+    return _snapshot_mgr.open_snapshot().then(
+      [](std::optional<storage::snapshot_reader> reader) {
+          if (!reader) {
+              return ss::make_ready_future<ret_t>();
+          }
+          return ss::do_with(
+            std::move(*reader), [](storage::snapshot_reader& reader) {
+                return reader.read_metadata()
+                  .then([&reader](iobuf buf) {
+                      auto metadata_size = buf.size_bytes();
+                      iobuf_parser parser(std::move(buf));
+                      auto md = reflection::adl<snapshot_metadata>{}.from(
+                        parser);
+                      return reader.get_snapshot_size().then(
+                        [&reader,
+                         metadata_size,
+                         last_included = md.last_included_index](size_t size) {
+                            // snapshot data follows the header and metadata
+                            auto data_size = size
+                                             - storage::snapshot_header::
+                                               ondisk_size
+                                             - metadata_size;
+                            return read_iobuf_exactly(reader.input(), data_size)
+                              .then([last_included](iobuf data) {
+                                  return ret_t(snapshot_payload{
+                                    .last_included_index = last_included,
+                                    .data = std::move(data)});
+                              });
+                        });
+                  })
+                  .finally([&reader] { return reader.close(); });
+            });
+      });
+}
+
 ss::future<> consensus::write_snapshot(write_snapshot_cfg cfg) {
     return _op_lock.with([this, cfg = std::move(cfg)]() mutable {
         // do nothing, we already have snapshot for this offset
@@ -1819,6 +1884,10 @@ clock_type::time_point consensus::last_append_timestamp(vnode id) {
     return _fstats.get(id).last_append_timestamp;
 }
 
+clock_type::time_point consensus::last_hbeat_timestamp(vnode id) {
+    return _fstats.get(id).last_hbeat_timestamp;
+}
+
 void consensus::update_node_append_timestamp(vnode id) {
     if (auto it = _fstats.find(id); it != _fstats.end()) {
         it->second.last_append_timestamp = clock_type::now();
@@ -1832,7 +1901,13 @@ void consensus::update_node_hbeat_timestamp(vnode id) {
 
 follower_req_seq consensus::next_follower_sequence(vnode id) {
     if (auto it = _fstats.find(id); it != _fstats.end()) {
-        return it->second.last_sent_seq++;
+        auto& idx = it->second;
+        if (!idx.lease_checkpoint_pending) {
+            idx.lease_checkpoint_pending = true;
+            idx.lease_checkpoint_seq = idx.last_sent_seq;
+            idx.lease_checkpoint_sent = clock_type::now();
+        }
+        return idx.last_sent_seq++;
     }
 
     return follower_req_seq{};
@@ -2176,6 +2251,7 @@ consensus::transfer_leadership(std::optional<model::node_id> target) {
          * complete the transfer.
          */
         _transferring_leadership = true;
+        _lease_disabled_term = _term;
 
         /*
          * the follower's log needs to be up-to-date so that it will
@@ -2324,6 +2400,111 @@ void consensus::update_suppress_heartbeats(
     }
 }
 
+bool consensus::is_follower_idle(vnode id) const {
+    if (!is_leader() || _transferring_leadership) {
+        return false;
+    }
+    auto it = _fstats.find(id);
+    if (it == _fstats.end()) {
+        return false;
+    }
+    const auto& f = it->second;
+    auto dirty_offset = _log.offsets().dirty_offset;
+    return _commit_index == dirty_offset && f.idle_offset == dirty_offset
+           && f.match_index == dirty_offset && !f.is_recovering;
+}
+
+void consensus::update_follower_idle_offset(vnode id, model::offset o) {
+    if (auto it = _fstats.find(id); it != _fstats.end()) {
+        it->second.idle_offset = o;
+    }
+}
+
+bool consensus::heard_from_leader(clock_type::time_point since) const {
+    if (_hbeat > since) {
+        return true;
+    }
+    if (!_leader_idle || !_leader_id) {
+        return false;
+    }
+    // the idle lease has to be renewed by a per group heartbeat every so often
+    // so that a group which is gone from a live leader node gets a new leader
+    const auto& cfg = config::shard_local_cfg();
+    auto lease = cfg.raft_idle_heartbeat_refresh_ms() + _jit.base_duration();
+    if (_hbeat + lease < clock_type::now()) {
+        return false;
+    }
+    return shard_local_peer_liveness().last_seen(_leader_id->id()) > since;
+}
+
+void consensus::maybe_update_lease(
+  follower_index_metadata& idx,
+  follower_req_seq seq,
+  const append_entries_reply& reply) {
+    if (!idx.lease_checkpoint_pending || seq < idx.lease_checkpoint_seq) {
+        return;
+    }
+    idx.lease_checkpoint_pending = false;
+    /**
+     * A successful reply in the current term means that the follower accepted
+     * this node as a leader after the checkpoint was sent. Replies to requests
+     * sent after the checkpoint are also fine, the checkpoint send time is
+     * then just a conservative estimate.
+     */
+    if (
+      !is_leader() || reply.term != _term
+      || reply.result != append_entries_reply::status::success) {
+        return;
+    }
+    if (idx.lease_term != _term || idx.lease_ack < idx.lease_checkpoint_sent) {
+        idx.lease_ack = idx.lease_checkpoint_sent;
+        idx.lease_term = _term;
+    }
+}
+
+bool consensus::lease_valid() {
+    const auto& cfg = config::shard_local_cfg();
+    if (!cfg.raft_leader_lease_enabled()) {
+        return false;
+    }
+    /**
+     * Leadership transfer makes followers ignore the stable leadership check
+     * when voting, the lease is not valid for the rest of the term then.
+     */
+    if (
+      !is_leader() || _transferring_leadership
+      || _lease_disabled_term == _term) {
+        return false;
+    }
+    // the leader must have committed an entry from its own term, before
+    // that the commit index may lag behind what the previous leader served
+    if (get_term(_commit_index) != _term) {
+        return false;
+    }
+    auto duration = std::chrono::duration_cast<clock_type::duration>(
+      _jit.base_duration());
+    auto drift = std::chrono::duration_cast<clock_type::duration>(
+      cfg.raft_leader_lease_max_clock_drift_ms());
+    if (duration <= drift) {
+        return false;
+    }
+    auto start = config().quorum_match([this](vnode rni) {
+        if (rni == _self) {
+            return clock_type::now();
+        }
+        if (auto it = _fstats.find(rni); it != _fstats.end()) {
+            if (it->second.lease_term == _term) {
+                return it->second.lease_ack;
+            }
+        }
+        return clock_type::time_point::min();
+    });
+    if (start == clock_type::time_point::min()) {
+        return false;
+    }
+    return start + (duration - drift) > clock_type::now();
+}
+
 voter_priority consensus::next_target_priority() {
     return voter_priority(std::max<voter_priority::type>(
       (_target_priority / 5) * 4, min_voter_priority));
@@ -133,6 +133,15 @@ public:
      */
     ss::future<result<model::offset>> linearizable_barrier();
 
+    /**
+     * True if a leader lease is held. Followers do not vote for anybody else
+     * within an election timeout of hearing from the leader, so when majority
+     * accepted requests sent at or after `t` in the current term no other
+     * leader can be elected before `t + election timeout - max clock drift`.
+     * With a valid lease the linearizable barrier is answered locally.
+     */
+    bool lease_valid();
+
     vnode self() const { return _self; }
     protocol_metadata meta() const {
         auto lstats = _log.offsets();
@@ -151,6 +160,7 @@ public:
     clock_type::time_point last_heartbeat() const { return _hbeat; };
 
     clock_type::time_point last_append_timestamp(vnode);
+    clock_type::time_point last_hbeat_timestamp(vnode);
     /**
      * \brief Persist snapshot with given data and start offset
      *
@@ -160,6 +170,18 @@ public:
      */
     ss::future<> write_snapshot(write_snapshot_cfg);
 
+    /**
+     * \brief Read back the state machine data of the latest snapshot
+     *
+     * Used by state machines that keep their state in raft snapshots to
+     * rebuild it when the log prefix they need has already been truncated or
+     * when the snapshot was installed by the leader. Returns an empty optional
+     * when no snapshot exists.
+     */
+    ss::future<std::optional<snapshot_payload>> read_snapshot();
+
+    model::offset last_snapshot_index() const { return _last_snapshot_index; }
+
     /// Increment and returns next append_entries order tracking sequence for
     /// follower with given node id
     follower_req_seq next_follower_sequence(vnode);
@@ -298,6 +320,19 @@ public:
     void update_suppress_heartbeats(
       vnode, follower_req_seq, heartbeats_suppressed);
 
+    /**
+     * A group is idle for a follower when the leader has nothing to replicate
+     * or commit and the follower acknowledged a heartbeat saying so. For idle
+     * followers the heartbeat manager only sends a per group heartbeat every
+     * raft_idle_heartbeat_refresh_ms and relies on node level liveness in
+     * between.
+     */
+    bool is_follower_idle(vnode) const;
+
+    /// called with the dirty offset of a successful heartbeat that carried
+    /// a commit index equal to that offset
+    void update_follower_idle_offset(vnode, model::offset);
+
     std::vector<follower_metrics> get_follower_metrics() const;
 
 private:
@@ -369,6 +404,13 @@ private:
     void dispatch_vote(bool leadership_transfer);
     ss::future<bool> dispatch_prevote(bool leadership_transfer);
     bool should_skip_vote(bool ignore_heartbeat);
+    /// true if the leader was heard from since the given time point, either
+    /// directly or, for idle groups, through node level liveness
+    bool heard_from_leader(clock_type::time_point) const;
+    void maybe_update_lease(
+      follower_index_metadata&,
+      follower_req_seq,
+      const append_entries_reply&);
 
     /// Replicates configuration to other nodes,
     //  caller have to pass in _op_sem semaphore units
@@ -483,9 +525,14 @@ private:
     vnode _voted_for;
     std::optional<vnode> _leader_id;
     bool _transferring_leadership{false};
+    /// leader lease is not used in a term in which leadership transfer started
+    model::term_id _lease_disabled_term;
 
     /// useful for when we are not the leader
     clock_type::time_point _hbeat = clock_type::now();
+    /// set on followers when the last heartbeat from the leader left nothing
+    /// to replicate or commit, see is_follower_idle()
+    bool _leader_idle{false};
     clock_type::time_point _became_leader_at = clock_type::now();
     /// used to keep track if we are a leader, or transitioning
     vote_state _vstate = vote_state::follower;
@@ -11,6 +11,7 @@
 
 #include "config/configuration.h"
 #include "model/metadata.h"
+#include "model/record_batch_reader.h"
 #include "prometheus/prometheus_sanitize.h"
 #include "resource_mgmt/io_priority.h"
 
@@ -107,9 +108,14 @@ void group_manager::setup_metrics() {
     _metrics.add_group(
       prometheus_sanitize::metrics_name("raft"),
       {sm::make_gauge(
-        "group_count",
-        [this] { return _groups.size(); },
-        sm::description("Number of raft groups"))});
+         "group_count",
+         [this] { return _groups.size(); },
+         sm::description("Number of raft groups")),
+       sm::make_gauge(
+         "foreign_reader_loads",
+         [] { return model::foreign_record_batch_reader_loads(); },
+         sm::description("Slices of replicated batches being loaded from "
+                         "other cores, queued or running"))});
 }
 
 } // namespace raft
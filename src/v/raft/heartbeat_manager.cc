@@ -16,6 +16,7 @@
 #include "raft/consensus_client_protocol.h"
 #include "raft/errc.h"
 #include "raft/group_configuration.h"
+#include "raft/peer_liveness.h"
 #include "raft/raftgen_service.h"
 #include "raft/types.h"
 #include "rpc/reconnect_transport.h"
@@ -27,6 +28,7 @@
 #include <seastar/core/with_timeout.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <bits/stdint-uintn.h>
 #include <boost/range/iterator_range.hpp>
 
@@ -36,15 +38,23 @@ using consensus_ptr = heartbeat_manager::consensus_ptr;
 using consensus_set = heartbeat_manager::consensus_set;
 
 static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
-  const consensus_set& c, clock_type::duration heartbeat_interval) {
+  const consensus_set& c,
+  clock_type::duration heartbeat_interval,
+  model::node_id self) {
     absl::flat_hash_map<
       model::node_id,
       std::vector<std::pair<heartbeat_metadata, follower_req_seq>>>
       pending_beats;
+    // nodes hosting followers of idle groups, they get a node level heartbeat
+    absl::flat_hash_set<model::node_id> idle_nodes;
     if (c.empty()) {
         return {};
     }
-    auto last_heartbeat = clock_type::now() - heartbeat_interval;
+    const auto now = clock_type::now();
+    auto last_heartbeat = now - heartbeat_interval;
+    const auto& cfg = config::shard_local_cfg();
+    const bool suppress_idle = cfg.raft_idle_heartbeat_suppression();
+    auto last_idle_refresh = now - cfg.raft_idle_heartbeat_refresh_ms();
     for (auto& ptr : c) {
         if (!ptr->is_leader()) {
             continue;
@@ -52,7 +62,10 @@ static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
 
         auto maybe_create_follower_request = [ptr,
                                               last_heartbeat,
-                                              &pending_beats](
+                                              suppress_idle,
+                                              last_idle_refresh,
+                                              &pending_beats,
+                                              &idle_nodes](
                                                const vnode& rni) mutable {
             // special case self beat
             // self beat is used to make sure that the protocol will make
@@ -81,6 +94,14 @@ static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
                 return;
             }
 
+            if (suppress_idle && ptr->is_follower_idle(rni)) {
+                idle_nodes.insert(rni.id());
+                if (ptr->last_hbeat_timestamp(rni) > last_idle_refresh) {
+                    // node level heartbeat keeps the group alive
+                    return;
+                }
+            }
+
             auto seq_id = ptr->next_follower_sequence(rni);
             ptr->update_suppress_heartbeats(
               rni, seq_id, heartbeats_suppressed::yes);
@@ -107,11 +128,33 @@ static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
             meta_map.emplace(
               hb.meta.group,
               heartbeat_manager::follower_request_meta{
-                seq, hb.meta.prev_log_index, hb.target_node_id});
+                .seq = seq,
+                .dirty_offset = hb.meta.prev_log_index,
+                .follower_vnode = hb.target_node_id,
+                .idle = hb.meta.commit_index == hb.meta.prev_log_index});
             requests.push_back(std::move(hb));
         }
         reqs.emplace_back(
-          p.first, heartbeat_request{std::move(requests)}, std::move(meta_map));
+          p.first,
+          heartbeat_request{
+            .heartbeats = std::move(requests),
+            .node_id = self,
+            .target_node_id = p.first},
+          std::move(meta_map));
+    }
+
+    // any heartbeat request refreshes node liveness, only nodes that would
+    // otherwise receive nothing need a dedicated one
+    for (auto id : idle_nodes) {
+        if (pending_beats.contains(id)) {
+            continue;
+        }
+        reqs.emplace_back(
+          id,
+          heartbeat_request{.node_id = self, .target_node_id = id},
+          absl::flat_hash_map<
+            raft::group_id,
+            heartbeat_manager::follower_request_meta>{});
     }
 
     return reqs;
@@ -149,7 +192,8 @@ heartbeat_manager::send_heartbeats(std::vector<node_heartbeat> reqs) {
 }
 
 ss::future<> heartbeat_manager::do_dispatch_heartbeats() {
-    auto reqs = requests_for_range(_consensus_groups, _heartbeat_interval);
+    auto reqs = requests_for_range(
+      _consensus_groups, _heartbeat_interval, _self);
     return send_heartbeats(std::move(reqs));
 }
 
@@ -225,6 +269,7 @@ void heartbeat_manager::process_reply(
         }
         return;
     }
+    shard_local_peer_liveness().mark_alive(n);
     for (auto& m : r.value().meta) {
         auto it = _consensus_groups.find(m.group);
         if (it == _consensus_groups.end()) {
@@ -235,6 +280,11 @@ void heartbeat_manager::process_reply(
         auto meta = groups.find(m.group)->second;
         (*it)->update_suppress_heartbeats(
           meta.follower_vnode, meta.seq, heartbeats_suppressed::no);
+        const bool idle = meta.idle
+                          && m.result == append_entries_reply::status::success;
+        (*it)->update_follower_idle_offset(
+          meta.follower_vnode,
+          idle ? meta.dirty_offset : model::offset::min());
         (*it)->process_append_entries_reply(
           n,
           result<append_entries_reply>(std::move(m)),
@@ -82,6 +82,15 @@ extern ss::logger hbeatlog;
  *
  *    heartbeat({L0, L1}) -> {F0, F1}(node-b)
  *    heartbeat({L0, L1}) -> {F0, F1}(node-c)
+ *
+ * Batching still costs work proportional to the number of groups. Groups that
+ * are quiescent (nothing to replicate or commit, followers caught up) enter an
+ * idle mode in which per group heartbeats are only sent every
+ * raft_idle_heartbeat_refresh_ms. In between the leader node sends a single
+ * node level heartbeat (a request without group heartbeats) to every node
+ * hosting followers of idle groups, and both sides use that node liveness in
+ * place of the group heartbeats, see peer_liveness. Any append or commit takes
+ * the group out of idle mode.
  */
 class heartbeat_manager {
 public:
@@ -93,6 +102,8 @@ public:
         follower_req_seq seq;
         model::offset dirty_offset;
         vnode follower_vnode;
+        // heartbeat tells the follower that there is nothing left to commit
+        bool idle = false;
     };
     // Heartbeats from all groups for single node
     struct node_heartbeat {
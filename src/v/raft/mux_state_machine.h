@@ -19,9 +19,12 @@
 #include "raft/consensus.h"
 #include "raft/errc.h"
 #include "raft/state_machine.h"
+#include "reflection/adl.h"
 #include "utils/expiring_promise.h"
 #include "utils/mutex.h"
+#include "utils/named_type.h"
 #include "vassert.h"
+#include "vlog.h"
 
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
@@ -30,8 +33,10 @@
 
 #include <absl/container/node_hash_map.h>
 
+#include <algorithm>
 #include <optional>
 #include <system_error>
+#include <type_traits>
 #include <variant>
 
 namespace raft {
@@ -51,6 +56,35 @@ CONCEPT(
 using persistent_last_applied
   = ss::bool_class<struct persistent_last_applied_tag>;
 
+// number of log entries applied after the latest snapshot that triggers taking
+// the next one, zero disables taking snapshots
+using snapshot_interval = named_type<size_t, struct snapshot_interval_tag>;
+
+// States may keep their content in the raft snapshot of the multiplexing STM.
+// A snapshotable state provides
+//
+//   ss::future<iobuf> take_snapshot(model::offset last_applied);
+//   ss::future<> apply_snapshot(
+//     model::offset last_applied, model::offset last_included, iobuf&&);
+//
+// `take_snapshot` is called right after the batch ending at `last_applied` was
+// applied and before any following batch is. `apply_snapshot` replaces the
+// state with the snapshot content. It is called both on an empty state (node
+// startup after the log prefix was truncated) and on a state that applied the
+// log up to `last_applied` (lagging follower that received the snapshot from
+// the leader).
+template<typename T, typename = void>
+struct is_snapshotable_state : std::false_type {};
+
+template<typename T>
+struct is_snapshotable_state<
+  T,
+  std::void_t<
+    decltype(std::declval<T&>().take_snapshot(model::offset{})),
+    decltype(std::declval<T&>().apply_snapshot(
+      model::offset{}, model::offset{}, std::declval<iobuf&&>()))>>
+  : std::true_type {};
+
 // The multiplexing STM allows building multiple state machines on top of
 // single consensus instance. The mux_stm dispatches state
 // applications to correct state implementations using
@@ -67,6 +101,11 @@ using persistent_last_applied
 // when batch is applicable for one state is has to be not applicable for
 // another
 //
+// When all the states are snapshotable (see `is_snapshotable_state`) the STM
+// periodically snapshots them into the raft snapshot, which prefix truncates
+// the log, and rebuilds them from the snapshot when entries it still has to
+// apply were already truncated.
+//
 // +---------+               +---------+      +-------+ +---------+
 // | caller  |               | mux_stm |      | raft  | | state_1 |
 // +---------+               +---------+      +-------+ +---------+
@@ -99,6 +138,13 @@ public:
     explicit mux_state_machine(
       ss::logger&, consensus*, persistent_last_applied, T&...);
 
+    mux_state_machine(
+      ss::logger&,
+      consensus*,
+      persistent_last_applied,
+      snapshot_interval,
+      T&...);
+
     // Lifecycle management
     ss::future<> start() { return raft::state_machine::start(); }
 
@@ -121,6 +167,10 @@ public:
       ss::abort_source& as);
 
 private:
+    static constexpr bool snapshots_supported
+      = (is_snapshotable_state<T>::value && ...);
+    static constexpr int8_t snapshot_version = 0;
+
     using promise_t = expiring_promise<std::error_code>;
     // promises used to wait for result of state applies, keyed by offser
     // returned in replication result (i.e. last batch end offset)
@@ -129,6 +179,11 @@ private:
 
     ss::future<> apply(model::record_batch b) final;
 
+    bool has_snapshot_state() const final { return snapshots_supported; }
+    ss::future<> apply_snapshot(model::offset, iobuf&&) final;
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> maybe_take_snapshot(model::offset);
+
     container_t _promises;
 
     /*
@@ -170,6 +225,8 @@ private:
     mutex _mutex;
     consensus* _c;
     const persistent_last_applied _persist_last_applied;
+    const snapshot_interval _snapshot_interval;
+    bool _snapshot_in_progress{false};
     // we keep states in a tuple to automatically dispatch updates to correct
     // state
     std::tuple<T&...> _state;
@@ -182,9 +239,20 @@ mux_state_machine<T...>::mux_state_machine(
   consensus* c,
   persistent_last_applied persist,
   T&... state)
+  : mux_state_machine(logger, c, persist, snapshot_interval(0), state...) {}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+mux_state_machine<T...>::mux_state_machine(
+  ss::logger& logger,
+  consensus* c,
+  persistent_last_applied persist,
+  snapshot_interval interval,
+  T&... state)
   : raft::state_machine(c, logger, ss::default_priority_class())
   , _c(c)
   , _persist_last_applied(persist)
+  , _snapshot_interval(interval)
   , _state(state...) {}
 
 template<typename... T>
@@ -286,13 +354,112 @@ ss::future<> mux_state_machine<T...>::apply(model::record_batch b) {
                     it->second.set_value(ec);
                 }
             });
-            if (!_persist_last_applied) {
-                return f;
+            if (_persist_last_applied) {
+                f = f.then([this, last_offset] {
+                    return write_last_applied(last_offset);
+                });
             }
             return f.then(
-              [this, last_offset] { return write_last_applied(last_offset); });
+              [this, last_offset] { return maybe_take_snapshot(last_offset); });
         });
     });
 }
 
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<iobuf> mux_state_machine<T...>::take_snapshot(model::offset o) {
+    std::vector<ss::future<iobuf>> futures;
+    futures.reserve(sizeof...(T));
+    std::apply(
+      [&futures, o](T&... st) {
+          (futures.push_back(st.take_snapshot(o)), ...);
+      },
+      _state);
+    return ss::when_all_succeed(futures.begin(), futures.end())
+      .then([](std::vector<iobuf> states) {
+          iobuf ret;
+          reflection::serialize(ret, snapshot_version, std::move(states));
+          return ret;
+      });
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::maybe_take_snapshot(model::offset o) {
+    if constexpr (!snapshots_supported) {
+        return ss::now();
+    } else {
+        // the log starts at offset 0 when there is no snapshot yet
+        auto last_snapshot = std::max(last_snapshot_index(), model::offset(-1));
+        if (
+          _snapshot_interval() == 0 || _snapshot_in_progress
+          || o < last_snapshot + model::offset(_snapshot_interval())) {
+            return ss::now();
+        }
+        _snapshot_in_progress = true;
+        // states are captured before the next batch is applied, persisting
+        // the snapshot and truncating the log are done in the background
+        return take_snapshot(o)
+          .then([this, o](iobuf data) {
+              (void)ss::with_gate(
+                _gate, [this, o, data = std::move(data)]() mutable {
+                    return write_snapshot(o, std::move(data))
+                      .handle_exception([this, o](const std::exception_ptr& e) {
+                          vlog(
+                            logger().warn,
+                            "Error persisting snapshot at offset {} - {}",
+                            o,
+                            e);
+                      })
+                      .finally([this] { _snapshot_in_progress = false; });
+                });
+          })
+          .handle_exception([this](const std::exception_ptr& e) {
+              _snapshot_in_progress = false;
+              return ss::make_exception_future<>(e);
+          });
+    }
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::apply_snapshot(
+  model::offset last_included, iobuf&& data) {
+    if constexpr (!snapshots_supported) {
+        return ss::now();
+    } else {
+        iobuf_parser parser(std::move(data));
+        auto version = reflection::adl<int8_t>{}.from(parser);
+        vassert(
+          version == snapshot_version,
+          "Unsupported state machine snapshot version {}",
+          version);
+        auto states = reflection::adl<std::vector<iobuf>>{}.from(parser);
+        vassert(
+          states.size() == sizeof...(T),
+          "Snapshot contains {} states, expected {}",
+          states.size(),
+          sizeof...(T));
+
+        auto last_applied = next() - model::offset(1);
+        std::vector<ss::future<>> futures;
+        futures.reserve(sizeof...(T));
+        size_t idx = 0;
+        std::apply(
+          [&](T&... st) {
+              (futures.push_back(st.apply_snapshot(
+                 last_applied, last_included, std::move(states[idx++]))),
+               ...);
+          },
+          _state);
+        return ss::when_all_succeed(futures.begin(), futures.end())
+          .then([this, last_included] {
+              if (!_persist_last_applied) {
+                  return ss::now();
+              }
+              return write_last_applied(last_included);
+          });
+    }
+}
+
 } // namespace raft
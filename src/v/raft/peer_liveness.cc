@@ -0,0 +1,19 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/peer_liveness.h"
+
+namespace raft {
+
+peer_liveness& shard_local_peer_liveness() {
+    static thread_local peer_liveness liveness;
+    return liveness;
+}
+
+} // namespace raft
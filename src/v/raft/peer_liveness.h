@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/metadata.h"
+#include "raft/types.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+
+namespace raft {
+
+/**
+ * Shard local record of the last time each peer node was known to be alive.
+ *
+ * Quiescent raft groups (no appends, stable term, followers fully caught up)
+ * stop exchanging per group heartbeats, see heartbeat_manager. Instead the
+ * leader node sends a single node level heartbeat to every peer. Followers of
+ * an idle group then use the liveness of the leader node in place of the
+ * group heartbeat when deciding whether to start an election, and leaders use
+ * the liveness of follower nodes to decide whether they still hold a majority.
+ */
+class peer_liveness {
+public:
+    void mark_alive(model::node_id id, clock_type::time_point t) {
+        auto& last = _last_seen[id];
+        last = std::max(last, t);
+    }
+
+    void mark_alive(model::node_id id) { mark_alive(id, clock_type::now()); }
+
+    /// time_point::min() when nothing was heard from the node
+    clock_type::time_point last_seen(model::node_id id) const {
+        if (auto it = _last_seen.find(id); it != _last_seen.end()) {
+            return it->second;
+        }
+        return clock_type::time_point::min();
+    }
+
+private:
+    absl::flat_hash_map<model::node_id, clock_type::time_point> _last_seen;
+};
+
+peer_liveness& shard_local_peer_liveness();
+
+} // namespace raft
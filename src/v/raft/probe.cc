@@ -103,6 +103,19 @@ void probe::setup_metrics(const model::ntp& ntp) {
          "recovery_requests_errors",
          [this] { return _recovery_request_error; },
          sm::description("Number of failed recovery requests"),
+         labels),
+       sm::make_derive(
+         "lease_reads",
+         [this] { return _lease_reads; },
+         sm::description(
+           "Number of linearizable barriers served under the leader lease"),
+         labels),
+       sm::make_derive(
+         "barrier_reads",
+         [this] { return _barrier_reads; },
+         sm::description(
+           "Number of linearizable barriers that required a round of "
+           "heartbeats"),
          labels)});
 }
 
@@ -47,6 +47,9 @@ public:
     void replicate_request_error() { ++_replicate_request_error; };
     void recovery_request_error() { ++_recovery_request_error; };
 
+    void lease_read() { ++_lease_reads; }
+    void barrier_read() { ++_barrier_reads; }
+
 private:
     uint64_t _vote_requests = 0;
     uint64_t _append_requests = 0;
@@ -64,6 +67,8 @@ private:
     uint64_t _heartbeat_request_error = 0;
     uint64_t _replicate_request_error = 0;
     uint64_t _recovery_request_error = 0;
+    uint64_t _lease_reads = 0;
+    uint64_t _barrier_reads = 0;
 
     ss::metrics::metric_groups _metrics;
 };
@@ -9,6 +9,7 @@
 
 #include "raft/recovery_stm.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/record_batch_reader.h"
 #include "outcome_future_utils.h"
@@ -31,9 +32,24 @@ recovery_stm::recovery_stm(
   , _node_id(node_id)
   , _term(_ptr->term())
   , _prio(prio)
-  , _ctxlog(_ptr->_ctxlog) {}
+  , _ctxlog(_ptr->_ctxlog)
+  , _max_inflight_requests(std::max<size_t>(
+      config::shard_local_cfg().raft_recovery_max_inflight_requests(), 1))
+  , _inflight_sem(_max_inflight_requests) {}
 
 ss::future<> recovery_stm::do_recover() {
+    // every append entries request holds a unit until its reply is processed,
+    // this way we do not wait for a round trip before sending next range but
+    // the number of requests in flight is still bounded
+    return ss::get_units(_inflight_sem, 1).then(
+      [this](ss::semaphore_units<> u) { return do_recover(std::move(u)); });
+}
+
+ss::future<> recovery_stm::do_recover(ss::semaphore_units<> u) {
+    // state may have changed while we were waiting for the in flight requests
+    if (_stop_requested || _term != _ptr->term() || !_ptr->is_leader()) {
+        return ss::now();
+    }
     // We have to send all the records that leader have, event those that are
     // beyond commit index, thanks to that after majority have recovered
     // leader can update its commit index
@@ -47,6 +63,11 @@ ss::future<> recovery_stm::do_recover() {
     auto lstats = _ptr->_log.offsets();
     // follower last index was already evicted at the leader, use snapshot
     if (meta.value()->next_index < lstats.start_offset) {
+        // snapshot delivery is not pipelined, drain requests in flight first
+        u.return_all();
+        if (_inflight_requests > 0) {
+            return wait_for_inflight_requests();
+        }
         return install_snapshot();
     }
 
@@ -82,13 +103,19 @@ ss::future<> recovery_stm::do_recover() {
      */
     _committed_offset = _ptr->committed_offset();
 
-    auto follower_next_offset = meta.value()->next_index;
+    auto follower_next_offset = next_offset_to_send(*meta.value());
     auto follower_committed_match_index = meta.value()->match_committed_index();
     auto f = ss::now();
 
     // we do not have next entry for the follower yet, wait for next disk append
     // of follower state change
     if (lstats.dirty_offset < follower_next_offset) {
+        if (_inflight_requests > 0) {
+            // everything we have was already sent, wait for the follower
+            // replies before deciding whether recovery is finished
+            u.return_all();
+            return wait_for_inflight_requests();
+        }
         f = meta.value()
               ->follower_state_change.wait([this] { return state_changed(); })
               .handle_exception_type(
@@ -99,8 +126,12 @@ ss::future<> recovery_stm::do_recover() {
 
     // read & replicate log entries
     return f
-      .then([this, follower_next_offset, follower_committed_match_index] {
+      .then([this,
+             u = std::move(u),
+             follower_next_offset,
+             follower_committed_match_index]() mutable {
           return read_range_for_recovery(
+            std::move(u),
             follower_next_offset,
             _ptr->_log.offsets().dirty_offset,
             follower_committed_match_index);
@@ -123,6 +154,19 @@ ss::future<> recovery_stm::do_recover() {
       });
 }
 
+model::offset
+recovery_stm::next_offset_to_send(const follower_index_metadata& meta) const {
+    // offsets up to last_sent_offset are already on their way to the follower
+    return std::max(
+      meta.next_index, details::next_offset(meta.last_sent_offset));
+}
+
+ss::future<> recovery_stm::wait_for_inflight_requests() {
+    return _inflight_sem.wait(_max_inflight_requests).then([this] {
+        _inflight_sem.signal(_max_inflight_requests);
+    });
+}
+
 bool recovery_stm::state_changed() {
     auto meta = get_follower_meta();
     if (!meta) {
@@ -161,6 +205,7 @@ recovery_stm::should_flush(model::offset follower_committed_match_index) const {
 }
 
 ss::future<> recovery_stm::read_range_for_recovery(
+  ss::semaphore_units<> u,
   model::offset start_offset,
   model::offset end_offset,
   model::offset follower_committed_match_index) {
@@ -191,8 +236,11 @@ ss::future<> recovery_stm::read_range_for_recovery(
           return model::consume_reader_to_memory(
             std::move(reader), model::no_timeout);
       })
-      .then([this, start_offset, follower_committed_match_index](
-              ss::circular_buffer<model::record_batch> batches) {
+      .then([this,
+             u = std::move(u),
+             start_offset,
+             follower_committed_match_index](
+              ss::circular_buffer<model::record_batch> batches) mutable {
           vlog(
             _ctxlog.trace,
             "Read {} batches for {} node recovery",
@@ -211,7 +259,9 @@ ss::future<> recovery_stm::read_range_for_recovery(
             std::move(gap_filled_batches));
 
           return replicate(
-            std::move(f_reader), should_flush(follower_committed_match_index));
+            std::move(u),
+            std::move(f_reader),
+            should_flush(follower_committed_match_index));
       });
 }
 
@@ -316,6 +366,7 @@ ss::future<> recovery_stm::install_snapshot() {
 }
 
 ss::future<> recovery_stm::replicate(
+  ss::semaphore_units<> u,
   model::record_batch_reader&& reader,
   append_entries_request::flush_after_append flush) {
     // collect metadata for append entries request
@@ -334,9 +385,19 @@ ss::future<> recovery_stm::replicate(
         prev_log_term = _ptr->_last_snapshot_term;
     } else {
         // no entry for prev_log_idx, fallback to install snapshot
+        u.return_all();
+        if (_inflight_requests > 0) {
+            return wait_for_inflight_requests();
+        }
         return install_snapshot();
     }
 
+    auto meta = get_follower_meta();
+    if (!meta) {
+        _stop_requested = true;
+        return ss::now();
+    }
+
     // calculate commit index for follower to update immediately
     auto commit_idx = std::min(_last_batch_offset, _committed_offset);
     auto last_visible_idx = std::min(
@@ -359,57 +420,95 @@ ss::future<> recovery_stm::replicate(
 
     auto seq = _ptr->next_follower_sequence(_node_id);
     _ptr->update_suppress_heartbeats(_node_id, seq, heartbeats_suppressed::yes);
-    return dispatch_append_entries(std::move(r))
-      .finally([this, seq] {
-          _ptr->update_suppress_heartbeats(
-            _node_id, seq, heartbeats_suppressed::no);
-      })
-      .then([this, seq, dirty_offset = lstats.dirty_offset](auto r) {
-          if (!r) {
-              vlog(
-                _ctxlog.error,
-                "recovery_stm: not replicate entry: {} - {}",
-                r,
-                r.error().message());
-              _stop_requested = true;
-              _ptr->get_probe().recovery_request_error();
-          }
-          _ptr->process_append_entries_reply(
-            _node_id.id(), r.value(), seq, dirty_offset);
-          // If follower stats aren't present we have to stop recovery as
-          // follower was removed from configuration
-          if (!_ptr->_fstats.contains(_node_id)) {
-              _stop_requested = true;
-              return;
-          }
-          // If request was reordered we have to stop recovery as follower state
-          // is not known
-          if (seq < _ptr->_fstats.get(_node_id).last_received_seq) {
-              _stop_requested = true;
-              return;
-          }
-          // move the follower next index backward if recovery were not
-          // successfull
-          //
-          // Raft paper:
-          // If AppendEntries fails because of log inconsistency: decrement
-          // nextIndex and retry(§5.3)
-
-          if (r.value().result == append_entries_reply::status::failure) {
-              auto meta = get_follower_meta();
-              if (!meta) {
-                  _stop_requested = true;
-                  return;
-              }
-              meta.value()->next_index = std::max(
-                model::offset(0), details::prev_offset(_base_batch_offset));
-              vlog(
-                _ctxlog.trace,
-                "Move node {} next index {} backward",
-                _node_id,
-                meta.value()->next_index);
-          }
+    // next range is sent without waiting for this request reply
+    meta.value()->last_sent_offset = _last_batch_offset;
+    ++_inflight_requests;
+
+    // reply is processed in background, the semaphore units are released when
+    // it is done
+    (void)ss::with_gate(
+      _inflight_gate,
+      [this,
+       u = std::move(u),
+       r = std::move(r),
+       seq,
+       base_offset = _base_batch_offset,
+       dirty_offset = lstats.dirty_offset]() mutable {
+          return dispatch_append_entries(std::move(r))
+            .then([this, seq, base_offset, dirty_offset](
+                    result<append_entries_reply> reply) {
+                handle_append_entries_reply(
+                  std::move(reply), seq, base_offset, dirty_offset);
+            })
+            .handle_exception([this](const std::exception_ptr& e) {
+                vlog(
+                  _ctxlog.warn,
+                  "Error processing node {} recovery reply - {}",
+                  _node_id,
+                  e);
+                _stop_requested = true;
+            })
+            .finally([this, seq, u = std::move(u)] {
+                if (--_inflight_requests == 0) {
+                    _ptr->update_suppress_heartbeats(
+                      _node_id, seq, heartbeats_suppressed::no);
+                }
+            });
       });
+    return ss::now();
+}
+
+void recovery_stm::handle_append_entries_reply(
+  result<append_entries_reply> r,
+  follower_req_seq seq,
+  model::offset base_offset,
+  model::offset dirty_offset) {
+    if (!r) {
+        vlog(
+          _ctxlog.error,
+          "recovery_stm: not replicate entry: {} - {}",
+          r,
+          r.error().message());
+        _stop_requested = true;
+        _ptr->get_probe().recovery_request_error();
+        return;
+    }
+    _ptr->process_append_entries_reply(
+      _node_id.id(), r.value(), seq, dirty_offset);
+    // If follower stats aren't present we have to stop recovery as
+    // follower was removed from configuration
+    auto meta = get_follower_meta();
+    if (!meta) {
+        _stop_requested = true;
+        return;
+    }
+    // If request was reordered follower state is not known, restart the
+    // pipeline from the last offset acknowledged by the follower
+    if (seq < meta.value()->last_received_seq) {
+        meta.value()->last_sent_offset = model::offset{};
+        return;
+    }
+    // move the follower next index backward if recovery were not
+    // successfull
+    //
+    // Raft paper:
+    // If AppendEntries fails because of log inconsistency: decrement
+    // nextIndex and retry(§5.3)
+    //
+    // With multiple requests in flight all of the requests following the
+    // failed one fail as well, we move back to the lowest of them
+    if (r.value().result == append_entries_reply::status::failure) {
+        meta.value()->next_index = std::max(
+          model::offset(0),
+          std::min(
+            meta.value()->next_index, details::prev_offset(base_offset)));
+        meta.value()->last_sent_offset = model::offset{};
+        vlog(
+          _ctxlog.trace,
+          "Move node {} next index {} backward",
+          _node_id,
+          meta.value()->next_index);
+    }
 }
 
 clock_type::time_point recovery_stm::append_entries_timeout() {
@@ -473,16 +572,20 @@ ss::future<> recovery_stm::apply() {
                  });
              })
       .finally([this] {
-          vlog(_ctxlog.trace, "Finished node {} recovery", _node_id);
-          auto meta = get_follower_meta();
-          if (meta) {
-              meta.value()->is_recovering = false;
-              meta.value()->recovery_finished.broadcast();
-          }
-          if (_snapshot_reader != nullptr) {
-              return close_snapshot_reader();
-          }
-          return ss::now();
+          // wait for replies to requests that are still in flight
+          return _inflight_gate.close().then([this] {
+              vlog(_ctxlog.trace, "Finished node {} recovery", _node_id);
+              auto meta = get_follower_meta();
+              if (meta) {
+                  meta.value()->is_recovering = false;
+                  meta.value()->last_sent_offset = model::offset{};
+                  meta.value()->recovery_finished.broadcast();
+              }
+              if (_snapshot_reader != nullptr) {
+                  return close_snapshot_reader();
+              }
+              return ss::now();
+          });
       });
 }
 
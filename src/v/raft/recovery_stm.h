@@ -16,6 +16,9 @@
 #include "raft/logger.h"
 #include "storage/snapshot.h"
 
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+
 namespace raft {
 
 class recovery_stm {
@@ -25,10 +28,20 @@ public:
 
 private:
     ss::future<> do_recover();
-    ss::future<>
-      read_range_for_recovery(model::offset, model::offset, model::offset);
+    ss::future<> do_recover(ss::semaphore_units<>);
+    ss::future<> read_range_for_recovery(
+      ss::semaphore_units<>, model::offset, model::offset, model::offset);
     ss::future<> replicate(
-      model::record_batch_reader&&, append_entries_request::flush_after_append);
+      ss::semaphore_units<>,
+      model::record_batch_reader&&,
+      append_entries_request::flush_after_append);
+    void handle_append_entries_reply(
+      result<append_entries_reply>,
+      follower_req_seq,
+      model::offset,
+      model::offset);
+    ss::future<> wait_for_inflight_requests();
+    model::offset next_offset_to_send(const follower_index_metadata&) const;
     ss::future<result<append_entries_reply>>
     dispatch_append_entries(append_entries_request&&);
     std::optional<follower_index_metadata*> get_follower_meta();
@@ -57,6 +70,11 @@ private:
     size_t _snapshot_size = 0;
     // needed to early exit. (node down)
     bool _stop_requested = false;
+    // bounds number of append entries requests in flight to the follower
+    size_t _max_inflight_requests;
+    size_t _inflight_requests = 0;
+    ss::semaphore _inflight_sem;
+    ss::gate _inflight_gate;
 };
 
 } // namespace raft
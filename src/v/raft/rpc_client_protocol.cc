@@ -25,6 +25,7 @@ ss::future<result<vote_reply>> rpc_client_protocol::vote(
       ss::this_shard_id(),
       n,
       opts.timeout,
+      raftgen_client_protocol::vote_lane,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.vote(std::move(r), std::move(opts))
@@ -39,6 +40,7 @@ ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
       ss::this_shard_id(),
       n,
       opts.timeout,
+      raftgen_client_protocol::append_entries_lane,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.append_entries(std::move(r), std::move(opts))
@@ -53,6 +55,7 @@ ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
       ss::this_shard_id(),
       n,
       opts.timeout,
+      raftgen_client_protocol::heartbeat_lane,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.heartbeat(std::move(r), std::move(opts))
@@ -68,6 +71,7 @@ rpc_client_protocol::install_snapshot(
       ss::this_shard_id(),
       n,
       opts.timeout,
+      raftgen_client_protocol::install_snapshot_lane,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.install_snapshot(std::move(r), std::move(opts))
@@ -82,6 +86,7 @@ ss::future<result<timeout_now_reply>> rpc_client_protocol::timeout_now(
       ss::this_shard_id(),
       n,
       opts.timeout,
+      raftgen_client_protocol::timeout_now_lane,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.timeout_now(std::move(r), std::move(opts))
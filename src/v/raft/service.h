@@ -13,6 +13,7 @@
 
 #include "likely.h"
 #include "raft/consensus.h"
+#include "raft/peer_liveness.h"
 #include "raft/raftgen_service.h"
 #include "raft/types.h"
 #include "seastarx.h"
@@ -53,11 +54,14 @@ public:
       ss::smp_service_group ssg,
       ss::sharded<ConsensusManager>& mngr,
       ShardLookup& tbl,
-      clock_type::duration heartbeat_interval)
+      clock_type::duration heartbeat_interval,
+      ss::smp_service_group foreign_reader_ssg
+      = ss::default_smp_service_group())
       : raftgen_service(sc, ssg)
       , _group_manager(mngr)
       , _shard_table(tbl)
-      , _heartbeat_interval(heartbeat_interval) {
+      , _heartbeat_interval(heartbeat_interval)
+      , _foreign_reader_ssg(foreign_reader_ssg) {
         finjector::shard_local_badger().register_probe(
           failure_probes::name(), &_probe);
     }
@@ -68,6 +72,22 @@ public:
 
     [[gnu::always_inline]] ss::future<heartbeat_reply>
     heartbeat(heartbeat_request&& r, rpc::streaming_context&) final {
+        auto liveness = mark_peer_alive(r.node_id);
+        if (r.heartbeats.empty()) {
+            // node level liveness heartbeat
+            return liveness.then([] { return heartbeat_reply{}; });
+        }
+        return do_heartbeat(std::move(r))
+          .then([liveness = std::move(liveness)](
+                  heartbeat_reply reply) mutable {
+              return liveness.then([reply = std::move(reply)]() mutable {
+                  return std::move(reply);
+              });
+          });
+    }
+
+    [[gnu::always_inline]] ss::future<heartbeat_reply>
+    do_heartbeat(heartbeat_request&& r) {
         using ret_t = std::vector<append_entries_reply>;
         std::vector<append_entries_request> reqs;
         reqs.reserve(r.heartbeats.size());
@@ -136,7 +156,8 @@ public:
         return _probe.append_entries().then([this, r = std::move(r)]() mutable {
             auto gr = r.target_group();
             return dispatch_request(
-              append_entries_request::make_foreign(std::move(r)),
+              append_entries_request::make_foreign(
+                std::move(r), _foreign_reader_ssg),
               [gr]() { return make_missing_group_reply(gr); },
               [](append_entries_request&& r, consensus_ptr c) {
                   return c->append_entries(std::move(r));
@@ -293,6 +314,22 @@ private:
         return ret;
     }
 
+    /// node liveness is tracked per shard as followers of idle groups led by
+    /// the node may live on any of them. Other shards are only updated every
+    /// half heartbeat interval, that is way below the election timeout.
+    ss::future<> mark_peer_alive(model::node_id id) {
+        auto now = clock_type::now();
+        auto& liveness = shard_local_peer_liveness();
+        auto last_seen = liveness.last_seen(id);
+        liveness.mark_alive(id, now);
+        if (last_seen + _heartbeat_interval / 2 > now) {
+            return ss::now();
+        }
+        return ss::smp::invoke_on_all([id, now] {
+            shard_local_peer_liveness().mark_alive(id, now);
+        });
+    }
+
     ss::future<append_entries_reply>
     dispatch_append_entries(ConsensusManager& m, append_entries_request&& r) {
         auto group = group_id(r.meta.group);
@@ -307,5 +344,8 @@ private:
     ss::sharded<ConsensusManager>& _group_manager;
     ShardLookup& _shard_table;
     clock_type::duration _heartbeat_interval;
+    // slices of foreign readers are loaded from the shard of the request
+    // while the raft group dispatch waits for them, so under another group
+    ss::smp_service_group _foreign_reader_ssg;
 };
 } // namespace raft
@@ -100,24 +100,60 @@ ss::future<result<replicate_result>> state_machine::quorum_write_empty_batch(
       });
 }
 
+ss::future<> state_machine::load_snapshot() {
+    return _raft->read_snapshot().then(
+      [this](std::optional<snapshot_payload> snapshot) {
+          if (!snapshot || snapshot->last_included_index < _next) {
+              return ss::now();
+          }
+          auto last_included = snapshot->last_included_index;
+          vlog(
+            _log.info,
+            "Applying snapshot with last included offset {} of size {}",
+            last_included,
+            snapshot->data.size_bytes());
+          return apply_snapshot(last_included, std::move(snapshot->data))
+            .then([this, last_included] {
+                _next = last_included + model::offset(1);
+                _waiters.notify(last_included);
+            });
+      });
+}
+
+bool state_machine::covered_by_snapshot() const {
+    return has_snapshot_state() && _next <= _raft->last_snapshot_index();
+}
+
 ss::future<> state_machine::apply() {
+    auto f = ss::now();
+    if (covered_by_snapshot()) {
+        f = load_snapshot();
+    }
     // wait until consensus commit index is >= _next
-    return _raft->events()
-      .wait(_next, model::no_timeout, _as)
+    return f
       .then([this] {
+          return _raft->events().wait(_next, model::no_timeout, _as);
+      })
+      .then([this] {
+          // a snapshot installed while waiting, i.e. by a leader bringing up
+          // this node, prefix truncates the log past _next. apply it instead
+          // of reading the log
+          if (covered_by_snapshot()) {
+              return load_snapshot();
+          }
           // build a reader for log range [_next, +inf).
           storage::log_reader_config config(
             _next, model::model_limits<model::offset>::max(), _io_prio);
-          return _raft->make_reader(config);
-      })
-      .then([this](model::record_batch_reader reader) {
-          // apply each batch to the state machine
-          return std::move(reader)
-            .consume(batch_applicator(this), model::no_timeout)
-            .then([this](model::offset last_applied) {
-                if (last_applied >= model::offset(0)) {
-                    _next = last_applied + model::offset(1);
-                }
+          return _raft->make_reader(config).then(
+            [this](model::record_batch_reader reader) {
+                // apply each batch to the state machine
+                return std::move(reader)
+                  .consume(batch_applicator(this), model::no_timeout)
+                  .then([this](model::offset last_applied) {
+                      if (last_applied >= model::offset(0)) {
+                          _next = last_applied + model::offset(1);
+                      }
+                  });
             });
       })
       .handle_exception([this](const std::exception_ptr& e) {
@@ -129,6 +165,14 @@ ss::future<> state_machine::write_last_applied(model::offset o) {
     return _raft->write_last_applied(o);
 }
 
+ss::future<> state_machine::write_snapshot(model::offset o, iobuf&& data) {
+    return _raft->write_snapshot(write_snapshot_cfg(o, std::move(data)));
+}
+
+model::offset state_machine::last_snapshot_index() const {
+    return _raft->last_snapshot_index();
+}
+
 ss::future<result<model::offset>> state_machine::instert_linerizable_barrier(
   model::timeout_clock::time_point timeout) {
     return ss::with_timeout(timeout, _raft->linearizable_barrier())
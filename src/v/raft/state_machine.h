@@ -102,6 +102,30 @@ public:
 
 protected:
     void set_next(model::offset offset);
+
+    /**
+     * State machines keeping their state in raft snapshots override this pair.
+     * When the next offset to apply is already included in a raft snapshot
+     * (the log prefix was truncated after a snapshot was taken or the leader
+     * installed its snapshot on this node) the state machine is rebuilt with
+     * `apply_snapshot` instead of replaying the log, and the apply loop
+     * continues right after the last offset included in the snapshot.
+     */
+    virtual bool has_snapshot_state() const { return false; }
+    virtual ss::future<> apply_snapshot(model::offset, iobuf&&) {
+        return ss::now();
+    }
+    /**
+     * Persist snapshot of the state at the given applied offset and prefix
+     * truncate the log up to it.
+     */
+    ss::future<> write_snapshot(model::offset, iobuf&&);
+    /// Last offset included in the latest raft snapshot
+    model::offset last_snapshot_index() const;
+    /// Next offset that is going to be applied
+    model::offset next() const { return _next; }
+    ss::logger& logger() { return _log; }
+
     ss::gate _gate;
 
 private:
@@ -119,6 +143,9 @@ private:
     friend batch_applicator;
 
     ss::future<> apply();
+    ss::future<> load_snapshot();
+    /// whether the next offset to apply is only available in the snapshot
+    bool covered_by_snapshot() const;
     bool stop_batch_applicator();
 
     consensus* _raft;
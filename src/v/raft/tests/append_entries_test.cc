@@ -23,6 +23,9 @@
 #include "storage/tests/utils/random_batch.h"
 #include "test_utils/async.h"
 
+#include <seastar/util/defer.hh>
+
+#include <algorithm>
 #include <system_error>
 
 FIXTURE_TEST(test_entries_are_replicated_to_all_nodes, raft_test_fixture) {
@@ -191,6 +194,98 @@ FIXTURE_TEST(test_single_node_recovery, raft_test_fixture) {
     validate_logs_replication(gr);
 };
 
+struct lagging_node_recovery {
+    std::chrono::milliseconds elapsed;
+    // most append entries requests a node had in flight to the recovered one
+    size_t max_inflight;
+};
+
+static lagging_node_recovery
+recover_lagging_node(std::chrono::milliseconds latency) {
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    auto leader_id = wait_for_group_leader(gr);
+    model::node_id disabled_id;
+    for (auto& [id, _] : gr.get_members()) {
+        // disable one of the non leader nodes
+        if (leader_id != id) {
+            disabled_id = id;
+            gr.disable_node(id);
+            break;
+        }
+    }
+    for (int i = 0; i < 20; ++i) {
+        bool success = replicate_random_batches(gr, 50).get0();
+        BOOST_REQUIRE(success);
+    }
+    for (auto& [_, m] : gr.get_members()) {
+        m.append_entries_latency = latency;
+    }
+    // only count the requests sent to recover the node
+    for (auto& [_, m] : gr.get_members()) {
+        auto& stats = m.append_entries_inflight[disabled_id];
+        wait_for(
+          10s,
+          [&stats] { return stats.current == 0; },
+          "Requests to the disabled node failed");
+        stats.max = 0;
+    }
+
+    auto start = ss::lowres_clock::now();
+    gr.enable_node(disabled_id);
+    gr.get_member(disabled_id).append_entries_latency = latency;
+
+    wait_for(
+      30s,
+      [&gr] { return are_all_commit_indexes_the_same(gr); },
+      "After recovery state is consistent");
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      ss::lowres_clock::now() - start);
+
+    // the recovered follower holds the same log as the leader
+    BOOST_REQUIRE(are_all_commit_indexes_the_same(gr));
+    validate_logs_replication(gr);
+    size_t max_inflight = 0;
+    for (auto& [_, m] : gr.get_members()) {
+        max_inflight = std::max(
+          max_inflight, m.append_entries_inflight[disabled_id].max);
+    }
+    return lagging_node_recovery{
+      .elapsed = elapsed, .max_inflight = max_inflight};
+}
+
+FIXTURE_TEST(test_lagging_node_recovery_with_latency, raft_test_fixture) {
+    constexpr auto latency = 10ms;
+    auto& inflight
+      = config::shard_local_cfg().raft_recovery_max_inflight_requests;
+    auto deferred = ss::defer(
+      [&inflight, original = inflight()] { inflight.set_value(original); });
+
+    config::shard_local_cfg()
+      .get("raft_recovery_max_inflight_requests")
+      .set_value(size_t(1));
+    auto serial = recover_lagging_node(latency);
+
+    config::shard_local_cfg()
+      .get("raft_recovery_max_inflight_requests")
+      .set_value(size_t(8));
+    auto pipelined = recover_lagging_node(latency);
+
+    // timings are only informative, the requests in flight are bounded by
+    // the configured limit
+    info(
+      "lagging node recovery with {}ms latency - serial: {}ms, {} in "
+      "flight, pipelined: {}ms, {} in flight",
+      latency.count(),
+      serial.elapsed.count(),
+      serial.max_inflight,
+      pipelined.elapsed.count(),
+      pipelined.max_inflight);
+    BOOST_REQUIRE_EQUAL(serial.max_inflight, size_t(1));
+    BOOST_REQUIRE_GE(pipelined.max_inflight, size_t(1));
+    BOOST_REQUIRE_LE(pipelined.max_inflight, size_t(8));
+};
+
 FIXTURE_TEST(test_empty_node_recovery, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 3);
     gr.enable_all();
@@ -743,6 +838,32 @@ FIXTURE_TEST(test_linarizable_barrier, raft_test_fixture) {
     }
 };
 
+FIXTURE_TEST(test_linarizable_barrier_under_leader_lease, raft_test_fixture) {
+    config::shard_local_cfg().get("raft_leader_lease_enabled").set_value(true);
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    auto leader_id = wait_for_group_leader(gr);
+
+    bool success = replicate_random_batches(gr, 5).get0();
+    BOOST_REQUIRE(success);
+
+    leader_id = wait_for_group_leader(gr);
+    auto leader_raft = gr.get_member(leader_id).consensus;
+    // heartbeats keep renewing the lease once an entry of the current term
+    // is committed
+    wait_for(
+      10s,
+      [leader_raft] { return leader_raft->lease_valid(); },
+      "leader holds a lease");
+
+    auto r = leader_raft->linearizable_barrier().get();
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(r.value(), leader_raft->committed_offset());
+
+    config::shard_local_cfg().get("raft_leader_lease_enabled").set_value(false);
+    BOOST_REQUIRE(!leader_raft->lease_valid());
+};
+
 FIXTURE_TEST(test_linarizable_barrier_single_node, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 1);
     gr.enable_all();
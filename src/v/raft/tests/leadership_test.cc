@@ -110,4 +110,39 @@ FIXTURE_TEST(
     // wait for next leader to be elected after recovery
     wait_for_group_leader(gr);
     assert_at_most_one_leader(gr);
-};
\ No newline at end of file
+};
+FIXTURE_TEST(test_idle_group_suppresses_heartbeats, raft_test_fixture) {
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg()
+          .get("raft_idle_heartbeat_suppression")
+          .set_value(true);
+    }).get();
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    auto leader_id = wait_for_group_leader(gr);
+    validate_logs_replication(gr);
+
+    // once quiescent, followers keep the leader through node level liveness
+    // instead of per group heartbeats
+    assert_stable_leadership(gr, 10);
+    auto last_expected_hbeat = raft::clock_type::now() - heartbeat_interval * 4;
+    for (auto& [id, m] : gr.get_members()) {
+        if (id == leader_id) {
+            continue;
+        }
+        BOOST_REQUIRE(m.consensus->last_heartbeat() < last_expected_hbeat);
+    }
+    BOOST_REQUIRE(gr.get_member(leader_id).consensus->is_leader());
+
+    // leader failure is still detected for an idle group
+    tstlog.info("Stopping current leader {}", leader_id);
+    gr.disable_node(leader_id);
+    auto new_leader_id = wait_for_group_leader(gr);
+    BOOST_REQUIRE_NE(leader_id, new_leader_id);
+
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg()
+          .get("raft_idle_heartbeat_suppression")
+          .set_value(false);
+    }).get();
+};
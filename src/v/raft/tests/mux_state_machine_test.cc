@@ -12,6 +12,7 @@
 #include "model/timeout_clock.h"
 #include "outcome.h"
 #include "raft/tests/mux_state_machine_fixture.h"
+#include "raft/tests/raft_group_fixture.h"
 #include "raft/types.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
@@ -163,6 +164,30 @@ struct simple_kv {
     bool is_batch_applicable(const model::record_batch& batch) const {
         return batch.header().type == model::record_batch_type(bt);
     }
+
+    ss::future<iobuf> take_snapshot(model::offset) {
+        std::vector<ss::sstring> keys;
+        std::vector<int> values;
+        for (auto& [k, v] : kv_map) {
+            keys.push_back(k);
+            values.push_back(v);
+        }
+        iobuf buf;
+        reflection::serialize(buf, std::move(keys), std::move(values));
+        return ss::make_ready_future<iobuf>(std::move(buf));
+    }
+
+    ss::future<>
+    apply_snapshot(model::offset, model::offset, iobuf&& snapshot) {
+        iobuf_parser parser(std::move(snapshot));
+        auto keys = reflection::adl<std::vector<ss::sstring>>{}.from(parser);
+        auto values = reflection::adl<std::vector<int>>{}.from(parser);
+        kv_map.clear();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            kv_map.emplace(keys[i], values[i]);
+        }
+        return ss::now();
+    }
 };
 
 ss::logger kvlog{"kv-test"};
@@ -448,3 +473,136 @@ FIXTURE_TEST(timeout_test, mux_state_machine_fixture) {
     state_1.as.request_abort();
     BOOST_REQUIRE_EQUAL(res, raft::errc::timeout);
 }
+
+FIXTURE_TEST(test_stm_snapshot, mux_state_machine_fixture) {
+    start_raft();
+    simple_kv<batch_type_1> state;
+    {
+        raft::mux_state_machine stm(
+          kvlog,
+          _raft.get(),
+          raft::persistent_last_applied::yes,
+          raft::snapshot_interval(10),
+          state);
+        stm.start().get0();
+        auto stop = ss::defer([&stm] { stm.stop().get0(); });
+        wait_for_leader();
+        ss::abort_source as;
+        for (int i = 0; i < 35; ++i) {
+            auto res = stm
+                         .replicate_and_wait(
+                           serialize_cmd(
+                             set_cmd{fmt::format("key-{}", i), i},
+                             batch_type_1),
+                           model::timeout_clock::now() + 2s,
+                           as)
+                         .get0();
+            BOOST_REQUIRE_EQUAL(res, errc::success);
+        }
+        // snapshots are persisted in background
+        tests::cooperative_spin_wait_with_timeout(5s, [this] {
+            return _raft->last_snapshot_index() >= model::offset(30)
+                   && _raft->start_offset() > model::offset(0);
+        }).get0();
+    }
+    BOOST_REQUIRE_EQUAL(state.kv_map.size(), 35);
+
+    // the log prefix is gone, state has to be recovered from the snapshot
+    // and the remaining log entries
+    simple_kv<batch_type_1> recovered;
+    raft::mux_state_machine stm(
+      kvlog, _raft.get(), raft::persistent_last_applied::yes, recovered);
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+    stm.wait(_raft->committed_offset(), model::timeout_clock::now() + 2s)
+      .get0();
+    BOOST_REQUIRE(recovered.kv_map == state.kv_map);
+}
+
+FIXTURE_TEST(test_stm_no_snapshot_before_interval, mux_state_machine_fixture) {
+    start_raft();
+    simple_kv<batch_type_1> state;
+    {
+        raft::mux_state_machine stm(
+          kvlog,
+          _raft.get(),
+          raft::persistent_last_applied::yes,
+          raft::snapshot_interval(10),
+          state);
+        stm.start().get0();
+        // stopping waits for snapshots persisted in background
+        auto stop = ss::defer([&stm] { stm.stop().get0(); });
+        wait_for_leader();
+        ss::abort_source as;
+        for (int i = 0; i < 5; ++i) {
+            auto res = stm
+                         .replicate_and_wait(
+                           serialize_cmd(
+                             set_cmd{fmt::format("key-{}", i), i},
+                             batch_type_1),
+                           model::timeout_clock::now() + 2s,
+                           as)
+                         .get0();
+            BOOST_REQUIRE_EQUAL(res, errc::success);
+        }
+    }
+    BOOST_REQUIRE_LT(_raft->committed_offset(), model::offset(9));
+    BOOST_REQUIRE_LT(_raft->last_snapshot_index(), model::offset(0));
+    BOOST_REQUIRE_EQUAL(_raft->start_offset(), model::offset(0));
+}
+
+FIXTURE_TEST(test_stm_snapshot_install_on_new_follower, raft_test_fixture) {
+    raft_group gr = raft_group(raft::group_id(0), 1);
+    gr.enable_all();
+    auto leader_raft = gr.get_member(wait_for_group_leader(gr)).consensus;
+
+    simple_kv<batch_type_1> leader_state;
+    raft::mux_state_machine leader_stm(
+      kvlog,
+      leader_raft.get(),
+      raft::persistent_last_applied::no,
+      raft::snapshot_interval(10),
+      leader_state);
+    leader_stm.start().get0();
+    auto stop_leader = ss::defer([&leader_stm] { leader_stm.stop().get0(); });
+    ss::abort_source as;
+    for (int i = 0; i < 25; ++i) {
+        auto res = leader_stm
+                     .replicate_and_wait(
+                       serialize_cmd(
+                         set_cmd{fmt::format("key-{}", i), i}, batch_type_1),
+                       model::timeout_clock::now() + 2s,
+                       as)
+                     .get0();
+        BOOST_REQUIRE_EQUAL(res, errc::success);
+    }
+    tests::cooperative_spin_wait_with_timeout(5s, [&leader_raft] {
+        return leader_raft->last_snapshot_index() >= model::offset(20)
+               && leader_raft->start_offset() > model::offset(0);
+    }).get0();
+
+    // the new node has an empty log and the leader no longer has the prefix
+    // of its log, the node can only catch up with install_snapshot
+    auto new_node = gr.create_new_node(model::node_id(1));
+    simple_kv<batch_type_1> follower_state;
+    raft::mux_state_machine follower_stm(
+      kvlog,
+      gr.get_member(new_node.id()).consensus.get(),
+      raft::persistent_last_applied::no,
+      follower_state);
+    follower_stm.start().get0();
+    auto stop_follower = ss::defer(
+      [&follower_stm] { follower_stm.stop().get0(); });
+
+    auto added = retry_with_leader(gr, 5, 1s, [new_node](raft_node& leader) {
+                     return leader.consensus
+                       ->add_group_members({new_node}, model::revision_id(0))
+                       .then([](std::error_code ec) { return !ec; });
+                 }).get0();
+    BOOST_REQUIRE(added);
+
+    follower_stm
+      .wait(leader_raft->committed_offset(), model::timeout_clock::now() + 10s)
+      .get0();
+    BOOST_REQUIRE(follower_state.kv_map == leader_state.kv_map);
+}
@@ -43,7 +43,9 @@
 #include <boost/range/iterator_range_core.hpp>
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <chrono>
+#include <unordered_map>
 
 inline ss::logger tstlog("raft_test");
 
@@ -73,6 +75,70 @@ struct consume_to_vector {
     std::vector<model::record_batch> batches;
 };
 
+/// Client protocol delaying append entries requests to simulate network
+/// latency between the nodes
+// append entries requests a node has in flight to one of its peers
+struct append_entries_inflight {
+    size_t current = 0;
+    size_t max = 0;
+};
+
+using append_entries_inflight_t
+  = std::unordered_map<model::node_id, append_entries_inflight>;
+
+struct delayed_client_protocol final
+  : raft::consensus_client_protocol::impl {
+    delayed_client_protocol(
+      raft::consensus_client_protocol p,
+      std::chrono::milliseconds& latency,
+      append_entries_inflight_t& inflight)
+      : protocol(std::move(p))
+      , latency(latency)
+      , inflight(inflight) {}
+
+    ss::future<result<raft::vote_reply>> vote(
+      model::node_id n, raft::vote_request&& r, rpc::client_opts o) final {
+        return protocol.vote(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::append_entries_reply>> append_entries(
+      model::node_id n,
+      raft::append_entries_request&& r,
+      rpc::client_opts o) final {
+        auto& stats = inflight[n];
+        stats.max = std::max(stats.max, ++stats.current);
+        auto f = protocol.append_entries(n, std::move(r), std::move(o));
+        if (latency != std::chrono::milliseconds(0)) {
+            f = ss::sleep(latency).then(
+              [f = std::move(f)]() mutable { return std::move(f); });
+        }
+        return std::move(f).finally([&stats] { --stats.current; });
+    }
+
+    ss::future<result<raft::heartbeat_reply>> heartbeat(
+      model::node_id n, raft::heartbeat_request&& r, rpc::client_opts o) final {
+        return protocol.heartbeat(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::install_snapshot_reply>> install_snapshot(
+      model::node_id n,
+      raft::install_snapshot_request&& r,
+      rpc::client_opts o) final {
+        return protocol.install_snapshot(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::timeout_now_reply>> timeout_now(
+      model::node_id n,
+      raft::timeout_now_request&& r,
+      rpc::client_opts o) final {
+        return protocol.timeout_now(n, std::move(r), std::move(o));
+    }
+
+    raft::consensus_client_protocol protocol;
+    std::chrono::milliseconds& latency;
+    append_entries_inflight_t& inflight;
+};
+
 struct raft_node {
     using log_t = std::vector<model::record_batch>;
     using leader_clb_t
@@ -129,7 +195,10 @@ struct raft_node {
           *log,
           seastar::default_priority_class(),
           std::chrono::seconds(10),
-          raft::make_rpc_client_protocol(self_id, cache),
+          raft::make_consensus_client_protocol<delayed_client_protocol>(
+            raft::make_rpc_client_protocol(self_id, cache),
+            append_entries_latency,
+            append_entries_inflight),
           [this](raft::leadership_status st) { leader_callback(st); },
           storage.local());
 
@@ -291,10 +360,14 @@ struct raft_node {
     ss::sharded<rpc::server> server;
     ss::sharded<test_raft_manager> raft_manager;
     std::unique_ptr<raft::heartbeat_manager> hbeats;
+    // append entries requests this node sent and did not get a reply for
+    append_entries_inflight_t append_entries_inflight;
     consensus_ptr consensus;
     std::unique_ptr<raft::log_eviction_stm> _nop_stm;
     leader_clb_t leader_callback;
     ss::abort_source _as;
+    // latency added to every append entries request sent by this node
+    std::chrono::milliseconds append_entries_latency{0};
 };
 
 static model::ntp node_ntp(raft::group_id gr_id, model::node_id n_id) {
@@ -202,6 +202,22 @@ SEASTAR_THREAD_TEST_CASE(heartbeat_request_roundtrip_with_negative) {
           raft::vnode(model::node_id(0), model::revision_id{}));
     }
 }
+SEASTAR_THREAD_TEST_CASE(node_liveness_heartbeat_roundtrip) {
+    raft::heartbeat_request req{
+      .node_id = model::node_id(1), .target_node_id = model::node_id(2)};
+    iobuf buf;
+    reflection::async_adl<raft::heartbeat_request>{}
+      .to(buf, std::move(req))
+      .get();
+    auto parser = iobuf_parser(std::move(buf));
+    auto res
+      = reflection::async_adl<raft::heartbeat_request>{}.from(parser).get0();
+    BOOST_REQUIRE(res.heartbeats.empty());
+    BOOST_REQUIRE_EQUAL(res.node_id, model::node_id(1));
+    BOOST_REQUIRE_EQUAL(res.target_node_id, model::node_id(2));
+    BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+}
+
 SEASTAR_THREAD_TEST_CASE(heartbeat_response_roundtrip) {
     static constexpr int64_t group_count = 10000;
     raft::heartbeat_reply reply;
@@ -20,7 +20,10 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <array>
 #include <type_traits>
+#include <vector>
 
 namespace raft {
 
@@ -210,15 +213,17 @@ async_adl<raft::append_entries_request>::from(iobuf_parser& in) {
 
 void adl<raft::protocol_metadata>::to(
   iobuf& out, raft::protocol_metadata request) {
+    const std::array<int64_t, 6> values{
+      request.group(),
+      request.commit_index(),
+      request.term(),
+      // varint the delta-encoded value
+      request.prev_log_index(),
+      request.prev_log_term(),
+      request.last_visible_index()};
     std::array<bytes::value_type, 6 * vint::max_length> staging{};
-    auto idx = vint::serialize(request.group(), staging.data());
-    idx += vint::serialize(request.commit_index(), staging.data() + idx);
-    idx += vint::serialize(request.term(), staging.data() + idx);
-
-    // varint the delta-encoded value
-    idx += vint::serialize(request.prev_log_index(), staging.data() + idx);
-    idx += vint::serialize(request.prev_log_term(), staging.data() + idx);
-    idx += vint::serialize(request.last_visible_index(), staging.data() + idx);
+    auto idx = vint::serialize_array(
+      values.data(), values.size(), staging.data());
 
     out.append(
       // NOLINTNEXTLINE
@@ -226,20 +231,16 @@ void adl<raft::protocol_metadata>::to(
       idx);
 }
 
-template<typename T>
-T varlong_reader(iobuf_parser& in) {
-    auto [val, len] = in.read_varlong();
-    return T(val);
-}
-
 raft::protocol_metadata adl<raft::protocol_metadata>::from(iobuf_parser& in) {
+    std::array<int64_t, 6> values; // NOLINT
+    in.read_varlongs(values.data(), values.size());
     raft::protocol_metadata ret;
-    ret.group = varlong_reader<raft::group_id>(in);
-    ret.commit_index = varlong_reader<model::offset>(in);
-    ret.term = varlong_reader<model::term_id>(in);
-    ret.prev_log_index = varlong_reader<model::offset>(in);
-    ret.prev_log_term = varlong_reader<model::term_id>(in);
-    ret.last_visible_index = varlong_reader<model::offset>(in);
+    ret.group = raft::group_id(values[0]);
+    ret.commit_index = model::offset(values[1]);
+    ret.term = model::term_id(values[2]);
+    ret.prev_log_index = model::offset(values[3]);
+    ret.prev_log_term = model::term_id(values[4]);
+    ret.last_visible_index = model::offset(values[5]);
     return ret;
 }
 namespace internal {
@@ -289,35 +290,32 @@ struct hbeat_response_array {
     std::vector<model::revision_id> target_revisions;
 };
 template<typename T>
-void encode_one_vint(iobuf& out, const T& t) {
-    auto b = vint::to_bytes(t);
-    // NOLINTNEXTLINE
-    out.append(reinterpret_cast<const char*>(b.data()), b.size());
-}
-
-template<typename T>
-void encode_varint_delta(iobuf& out, const T& prev, const T& current) {
+void encode_one_delta_array(iobuf& o, const std::vector<T>& v) {
     // TODO: use delta-delta:
     // https://github.com/facebookarchive/beringei/blob/92784ec6e2/beringei/lib/BitUtil.cpp
-    auto delta = current - prev;
-    encode_one_vint(out, delta);
-}
-
-template<typename T>
-void encode_one_delta_array(iobuf& o, const std::vector<T>& v) {
-    if (v.empty()) {
-        return;
-    }
+    static constexpr size_t chunk_size = 128;
+    std::array<int64_t, chunk_size> deltas; // NOLINT
+    std::array<uint8_t, chunk_size * vint::max_length> staging; // NOLINT
     const size_t max = v.size();
-    encode_one_vint(o, v[0]);
-    for (size_t i = 1; i < max; ++i) {
-        encode_varint_delta(o, v[i - 1], v[i]);
+    for (size_t i = 0; i < max; i += chunk_size) {
+        const size_t n = std::min(chunk_size, max - i);
+        for (size_t j = 0; j < n; ++j) {
+            const auto idx = i + j;
+            deltas[j] = idx == 0 ? v[0]() : v[idx]() - v[idx - 1]();
+        }
+        auto sz = vint::serialize_array(deltas.data(), n, staging.data());
+        o.append(staging.data(), sz);
     }
 }
-template<typename T>
-T read_one_varint_delta(iobuf_parser& in, const T& prev) {
-    auto dst = varlong_reader<T>(in);
-    return prev + dst;
+
+/// decodes a column written by encode_one_delta_array in place, `column`
+/// must be sized to the number of elements
+inline void
+read_one_delta_array(iobuf_parser& in, std::vector<int64_t>& column) {
+    in.read_varlongs(column.data(), column.size());
+    for (size_t i = 1; i < column.size(); ++i) {
+        column[i] += column[i - 1];
+    }
 }
 } // namespace internal
 
@@ -330,6 +328,13 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
             return lhs.meta.commit_index < rhs.meta.commit_index;
         }
     };
+    if (request.heartbeats.empty()) {
+        // node level liveness heartbeat
+        adl<model::node_id>{}.to(out, request.node_id);
+        adl<model::node_id>{}.to(out, request.target_node_id);
+        adl<uint32_t>{}.to(out, 0);
+        return ss::now();
+    }
     std::sort(
       request.heartbeats.begin(), request.heartbeats.end(), sorter_fn{});
     return ss::make_ready_future<>()
@@ -401,67 +406,45 @@ async_adl<raft::heartbeat_request>::from(iobuf_parser& in) {
     raft::heartbeat_request req;
     auto node_id = adl<model::node_id>{}.from(in);
     auto target_node = adl<model::node_id>{}.from(in);
+    req.node_id = node_id;
+    req.target_node_id = target_node;
     req.heartbeats = std::vector<raft::heartbeat_metadata>(
       adl<uint32_t>{}.from(in));
     if (req.heartbeats.empty()) {
         return ss::make_ready_future<raft::heartbeat_request>(std::move(req));
     }
     const size_t max = req.heartbeats.size();
-    req.heartbeats[0].meta.group = varlong_reader<raft::group_id>(in);
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].meta.group
-          = internal::read_one_varint_delta<raft::group_id>(
-            in, req.heartbeats[i - 1].meta.group);
-    }
-    req.heartbeats[0].meta.commit_index = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].meta.commit_index
-          = internal::read_one_varint_delta<model::offset>(
-            in, req.heartbeats[i - 1].meta.commit_index);
-    }
-    req.heartbeats[0].meta.term = varlong_reader<model::term_id>(in);
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].meta.term
-          = internal::read_one_varint_delta<model::term_id>(
-            in, req.heartbeats[i - 1].meta.term);
-    }
-    req.heartbeats[0].meta.prev_log_index = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].meta.prev_log_index
-          = internal::read_one_varint_delta<model::offset>(
-            in, req.heartbeats[i - 1].meta.prev_log_index);
-    }
-    req.heartbeats[0].meta.prev_log_term = varlong_reader<model::term_id>(in);
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].meta.prev_log_term
-          = internal::read_one_varint_delta<model::term_id>(
-            in, req.heartbeats[i - 1].meta.prev_log_term);
-    }
-    req.heartbeats[0].meta.last_visible_index = varlong_reader<model::offset>(
-      in);
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].meta.last_visible_index
-          = internal::read_one_varint_delta<model::offset>(
-            in, req.heartbeats[i - 1].meta.last_visible_index);
-    }
-
-    req.heartbeats[0].node_id = raft::vnode(
-      node_id, varlong_reader<model::revision_id>(in));
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].node_id = raft::vnode(
-          node_id,
-          internal::read_one_varint_delta<model::revision_id>(
-            in, req.heartbeats[i - 1].node_id.revision()));
-    }
-
-    req.heartbeats[0].target_node_id = raft::vnode(
-      target_node, varlong_reader<model::revision_id>(in));
-    for (size_t i = 1; i < max; ++i) {
-        req.heartbeats[i].target_node_id = raft::vnode(
-          target_node,
-          internal::read_one_varint_delta<model::revision_id>(
-            in, req.heartbeats[i - 1].target_node_id.revision()));
-    }
+    std::vector<int64_t> column(max);
+    auto read_column = [&in, &column, &req](auto&& assign) {
+        internal::read_one_delta_array(in, column);
+        for (size_t i = 0; i < column.size(); ++i) {
+            assign(req.heartbeats[i], column[i]);
+        }
+    };
+    read_column([](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.meta.group = raft::group_id(v);
+    });
+    read_column([](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.meta.commit_index = model::offset(v);
+    });
+    read_column([](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.meta.term = model::term_id(v);
+    });
+    read_column([](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.meta.prev_log_index = model::offset(v);
+    });
+    read_column([](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.meta.prev_log_term = model::term_id(v);
+    });
+    read_column([](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.meta.last_visible_index = model::offset(v);
+    });
+    read_column([node_id](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.node_id = raft::vnode(node_id, model::revision_id(v));
+    });
+    read_column([target_node](raft::heartbeat_metadata& hb, int64_t v) {
+        hb.target_node_id = raft::vnode(target_node, model::revision_id(v));
+    });
 
     for (auto& hb : req.heartbeats) {
         hb.meta.prev_log_index = decode_signed(hb.meta.prev_log_index);
@@ -547,55 +530,34 @@ async_adl<raft::heartbeat_reply>::from(iobuf_parser& in) {
     auto target_node_id = adl<model::node_id>{}.from(in);
 
     size_t size = reply.meta.size();
-    reply.meta[0].group = varlong_reader<raft::group_id>(in);
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].group = internal::read_one_varint_delta<raft::group_id>(
-          in, reply.meta[i - 1].group);
-    }
-    reply.meta[0].term = varlong_reader<model::term_id>(in);
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].term = internal::read_one_varint_delta<model::term_id>(
-          in, reply.meta[i - 1].term);
-    }
-
-    reply.meta[0].last_committed_log_index = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].last_committed_log_index
-          = internal::read_one_varint_delta<model::offset>(
-            in, reply.meta[i - 1].last_committed_log_index);
-    }
-
-    reply.meta[0].last_dirty_log_index = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].last_dirty_log_index
-          = internal::read_one_varint_delta<model::offset>(
-            in, reply.meta[i - 1].last_dirty_log_index);
-    }
-
-    reply.meta[0].last_term_base_offset = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].last_term_base_offset
-          = internal::read_one_varint_delta<model::offset>(
-            in, reply.meta[i - 1].last_term_base_offset);
-    }
-
-    reply.meta[0].node_id = raft::vnode(
-      node_id, varlong_reader<model::revision_id>(in));
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].node_id = raft::vnode(
-          node_id,
-          internal::read_one_varint_delta<model::revision_id>(
-            in, reply.meta[i - 1].node_id.revision()));
-    }
-
-    reply.meta[0].target_node_id = raft::vnode(
-      target_node_id, varlong_reader<model::revision_id>(in));
-    for (size_t i = 1; i < size; ++i) {
-        reply.meta[i].target_node_id = raft::vnode(
-          target_node_id,
-          internal::read_one_varint_delta<model::revision_id>(
-            in, reply.meta[i - 1].target_node_id.revision()));
-    }
+    std::vector<int64_t> column(size);
+    auto read_column = [&in, &column, &reply](auto&& assign) {
+        internal::read_one_delta_array(in, column);
+        for (size_t i = 0; i < column.size(); ++i) {
+            assign(reply.meta[i], column[i]);
+        }
+    };
+    read_column([](raft::append_entries_reply& r, int64_t v) {
+        r.group = raft::group_id(v);
+    });
+    read_column([](raft::append_entries_reply& r, int64_t v) {
+        r.term = model::term_id(v);
+    });
+    read_column([](raft::append_entries_reply& r, int64_t v) {
+        r.last_committed_log_index = model::offset(v);
+    });
+    read_column([](raft::append_entries_reply& r, int64_t v) {
+        r.last_dirty_log_index = model::offset(v);
+    });
+    read_column([](raft::append_entries_reply& r, int64_t v) {
+        r.last_term_base_offset = model::offset(v);
+    });
+    read_column([node_id](raft::append_entries_reply& r, int64_t v) {
+        r.node_id = raft::vnode(node_id, model::revision_id(v));
+    });
+    read_column([target_node_id](raft::append_entries_reply& r, int64_t v) {
+        r.target_node_id = raft::vnode(target_node_id, model::revision_id(v));
+    });
 
     for (size_t i = 0; i < size; ++i) {
         reply.meta[i].result = adl<raft::append_entries_reply::status>{}.from(
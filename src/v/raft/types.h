@@ -78,9 +78,18 @@ struct follower_index_metadata {
     }
     // next index to send to this follower
     model::offset next_index;
+    // last offset sent to the follower by recovery requests that are still in
+    // flight. Recovery pipelines requests starting right after this offset
+    // and resets it whenever follower replies invalidate the pipeline
+    model::offset last_sent_offset;
     // timestamp of last append_entries_rpc call
     clock_type::time_point last_append_timestamp;
     clock_type::time_point last_hbeat_timestamp;
+    // dirty offset of the last successful heartbeat that told the follower
+    // there is nothing left to commit. While it is equal to the leader dirty
+    // offset the group is idle for this follower and per group heartbeats can
+    // be replaced with node level liveness, see heartbeat_manager
+    model::offset idle_offset = model::offset::min();
     // The pair of sequences used to track append entries requests sent and
     // received by the follower. Every time append entries request is created
     // the `last_sent_seq` is incremented before accessing raft protocol state
@@ -129,6 +138,16 @@ struct follower_index_metadata {
 
     follower_req_seq last_sent_seq{0};
     follower_req_seq last_received_seq{0};
+    // leader lease bookkeeping. One in flight request at a time is tagged as a
+    // lease checkpoint together with its send time. When the follower accepts
+    // it in the current term it could not have voted for anybody else before
+    // `lease_ack + election timeout`, see consensus::lease_valid
+    follower_req_seq lease_checkpoint_seq{0};
+    clock_type::time_point lease_checkpoint_sent
+      = clock_type::time_point::min();
+    bool lease_checkpoint_pending = false;
+    clock_type::time_point lease_ack = clock_type::time_point::min();
+    model::term_id lease_term;
     bool is_learner = false;
     bool is_recovering = false;
 
@@ -208,12 +227,13 @@ struct append_entries_request {
     protocol_metadata meta;
     model::record_batch_reader batches;
     flush_after_append flush;
-    static append_entries_request make_foreign(append_entries_request&& req) {
+    static append_entries_request
+    make_foreign(append_entries_request&& req, ss::smp_service_group ssg) {
         return append_entries_request(
           req.node_id,
           req.target_node_id,
           std::move(req.meta),
-          model::make_foreign_record_batch_reader(std::move(req.batches)),
+          model::make_foreign_record_batch_reader(std::move(req.batches), ssg),
           req.flush);
     }
 };
@@ -258,6 +278,10 @@ struct heartbeat_metadata {
 /// log at some offset
 struct heartbeat_request {
     std::vector<heartbeat_metadata> heartbeats;
+    // physical source and target node, carried on the wire only for requests
+    // without heartbeats which act as node level liveness heartbeats
+    model::node_id node_id;
+    model::node_id target_node_id;
 };
 struct heartbeat_reply {
     std::vector<append_entries_reply> meta;
@@ -428,6 +452,16 @@ struct write_snapshot_cfg {
     should_prefix_truncate should_truncate;
 };
 
+/**
+ * State machine data stored in the latest persisted snapshot.
+ */
+struct snapshot_payload {
+    // last offset included in the snapshot
+    model::offset last_included_index;
+    // snapshot content
+    iobuf data;
+};
+
 struct timeout_now_request {
     // node id to validate on receiver
     vnode target_node_id;
@@ -14,6 +14,7 @@
 #include "cluster/cluster_utils.h"
 #include "cluster/controller.h"
 #include "cluster/fwd.h"
+#include "cluster/leader_balancer.h"
 #include "cluster/partition_manager.h"
 #include "cluster/security_frontend.h"
 #include "cluster/shard_table.h"
@@ -23,6 +24,7 @@
 #include "raft/types.h"
 #include "redpanda/admin/api-doc/config.json.h"
 #include "redpanda/admin/api-doc/kafka.json.h"
+#include "redpanda/admin/api-doc/leader_balancer.json.h"
 #include "redpanda/admin/api-doc/partition.json.h"
 #include "redpanda/admin/api-doc/raft.json.h"
 #include "redpanda/admin/api-doc/security.json.h"
@@ -100,6 +102,8 @@ void admin_server::configure_admin_routes() {
     rb->register_api_file(_server._routes, "security");
     rb->register_function(_server._routes, insert_comma);
     rb->register_api_file(_server._routes, "status");
+    rb->register_function(_server._routes, insert_comma);
+    rb->register_api_file(_server._routes, "leader_balancer");
     ss::httpd::config_json::get_config.set(
       _server._routes, []([[maybe_unused]] ss::const_req req) {
           rapidjson::StringBuffer buf;
@@ -111,6 +115,7 @@ void admin_server::configure_admin_routes() {
     register_kafka_routes();
     register_security_routes();
     register_status_routes();
+    register_leader_balancer_routes();
 }
 
 void admin_server::configure_dashboard() {
@@ -525,3 +530,75 @@ void admin_server::register_status_routes() {
           return ss::make_ready_future<ss::json::json_return_type>(status_map);
       });
 }
+
+static void write_broker_shard(
+  rapidjson::Writer<rapidjson::StringBuffer>& w,
+  const model::broker_shard& bs) {
+    w.StartObject();
+    w.Key("node_id");
+    w.Int(bs.node_id());
+    w.Key("shard");
+    w.Uint(bs.shard);
+    w.EndObject();
+}
+
+static ss::sstring
+leader_balancer_status_to_json(const cluster::leader_balancer::status& st) {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(buf);
+    w.StartObject();
+    w.Key("enabled");
+    w.Bool(st.enabled);
+    w.Key("dry_run");
+    w.Bool(st.dry_run);
+    w.Key("active");
+    w.Bool(st.active);
+    if (st.last_tick) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+          st.last_tick->time_since_epoch());
+        w.Key("last_tick_ms");
+        w.Int64(ms.count());
+    }
+    w.Key("transfers");
+    w.Uint64(st.transfers);
+    w.Key("failed_transfers");
+    w.Uint64(st.failed_transfers);
+    w.Key("spread_before");
+    w.Uint64(st.last_plan.spread_before);
+    w.Key("spread_after");
+    w.Uint64(st.last_plan.spread_after);
+    w.Key("moves");
+    w.StartArray();
+    for (const auto& m : st.last_plan.moves) {
+        w.StartObject();
+        w.Key("ns");
+        w.String(m.ntp.ns().c_str());
+        w.Key("topic");
+        w.String(m.ntp.tp.topic().c_str());
+        w.Key("partition");
+        w.Int(m.ntp.tp.partition());
+        w.Key("from");
+        write_broker_shard(w, m.from);
+        w.Key("to");
+        write_broker_shard(w, m.to);
+        w.EndObject();
+    }
+    w.EndArray();
+    w.EndObject();
+    return ss::sstring(buf.GetString(), buf.GetSize());
+}
+
+void admin_server::register_leader_balancer_routes() {
+    ss::httpd::leader_balancer_json::get_leader_balancer_plan.set(
+      _server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          return _controller->get_leader_balancer()
+            .invoke_on(
+              cluster::leader_balancer::shard,
+              [](cluster::leader_balancer& lb) {
+                  return leader_balancer_status_to_json(lb.get_status());
+              })
+            .then([](ss::sstring body) {
+                return ss::json::json_return_type(body.c_str());
+            });
+      });
+}
@@ -39,6 +39,7 @@
 #include "rpc/simple_protocol.h"
 #include "storage/chunk_cache.h"
 #include "storage/directories.h"
+#include "storage/disk_space_manager.h"
 #include "syschecks/syschecks.h"
 #include "test_utils/logs.h"
 #include "utils/file_io.h"
@@ -144,7 +145,17 @@ void application::initialize(
         syschecks::pidfile_create(config::shard_local_cfg().pidfile_path());
     }
 
-    smp_service_groups.create_groups().get();
+    smp_service_groups
+      .create_groups(smp_groups::config{
+        .fetch_max_nonlocal_requests = static_cast<uint32_t>(
+          config::shard_local_cfg().kafka_fetch_max_nonlocal_requests()),
+        .produce_max_nonlocal_requests = static_cast<uint32_t>(
+          config::shard_local_cfg().kafka_produce_max_nonlocal_requests()),
+        .foreign_reader_max_nonlocal_requests = static_cast<uint32_t>(
+          config::shard_local_cfg()
+            .raft_foreign_reader_max_nonlocal_requests()),
+      })
+      .get();
     _deferred.emplace_back(
       [this] { smp_service_groups.destroy_groups().get(); });
 
@@ -303,7 +314,7 @@ static storage::kvstore_config kvstore_config_from_global_config() {
 }
 
 static storage::log_config manager_config_from_global_config() {
-    return storage::log_config(
+    auto cfg = storage::log_config(
       storage::log_config::storage_type::disk,
       config::shard_local_cfg().data_directory().as_sstring(),
       config::shard_local_cfg().log_segment_size(),
@@ -321,6 +332,11 @@ static storage::log_config manager_config_from_global_config() {
         .min_size = config::shard_local_cfg().reclaim_min_size(),
         .max_size = config::shard_local_cfg().reclaim_max_size(),
       });
+    cfg.housekeeping_concurrency
+      = config::shard_local_cfg().log_housekeeping_concurrency();
+    cfg.housekeeping_budget_bytes
+      = config::shard_local_cfg().log_housekeeping_budget_bytes();
+    return cfg;
 }
 
 // add additional services in here
@@ -352,6 +368,7 @@ void application::wire_up_redpanda_services() {
       = _scheduling_groups.cache_background_reclaim_sg();
     construct_service(storage, kvstore_config_from_global_config(), log_cfg)
       .get();
+    construct_service(disk_space_manager, std::ref(storage)).get();
 
     if (coproc_enabled()) {
         syschecks::systemd_message("Building coproc pacemaker").get();
@@ -609,6 +626,8 @@ void application::start() {
 void application::start_redpanda() {
     syschecks::systemd_message("Staring storage services").get();
     storage.invoke_on_all(&storage::api::start).get();
+    disk_space_manager.invoke_on_all(&storage::disk_space_manager::start)
+      .get();
 
     syschecks::systemd_message("Starting the partition manager").get();
     partition_manager.invoke_on_all(&cluster::partition_manager::start).get();
@@ -652,14 +671,17 @@ void application::start_redpanda() {
             smp_service_groups.raft_smp_sg(),
             partition_manager,
             shard_table.local(),
-            config::shard_local_cfg().raft_heartbeat_interval_ms());
+            config::shard_local_cfg().raft_heartbeat_interval_ms(),
+            smp_service_groups.foreign_reader_smp_sg());
           proto->register_service<cluster::service>(
             _scheduling_groups.cluster_sg(),
             smp_service_groups.cluster_smp_sg(),
             std::ref(controller->get_topics_frontend()),
             std::ref(controller->get_members_manager()),
             std::ref(metadata_cache),
-            std::ref(controller->get_security_frontend()));
+            std::ref(controller->get_security_frontend()),
+            std::ref(partition_manager),
+            std::ref(shard_table));
           proto->register_service<cluster::metadata_dissemination_handler>(
             _scheduling_groups.cluster_sg(),
             smp_service_groups.cluster_smp_sg(),
@@ -686,6 +708,9 @@ void application::start_redpanda() {
       .invoke_on_all([this](rpc::server& s) {
           auto proto = std::make_unique<kafka::protocol>(
             smp_service_groups.kafka_smp_sg(),
+            smp_service_groups.fetch_smp_sg(),
+            smp_service_groups.produce_smp_sg(),
+            _scheduling_groups.compression_sg(),
             metadata_cache,
             controller->get_topics_frontend(),
             quota_mgr,
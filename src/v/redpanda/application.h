@@ -65,6 +65,7 @@ public:
     ss::sharded<kafka::group_router> group_router;
     ss::sharded<cluster::shard_table> shard_table;
     ss::sharded<storage::api> storage;
+    ss::sharded<storage::disk_space_manager> disk_space_manager;
     ss::sharded<coproc::pacemaker> pacemaker;
     ss::sharded<cluster::partition_manager> partition_manager;
     ss::sharded<raft::group_manager> raft_group_manager;
@@ -74,6 +74,9 @@ public:
         // used by request context builder
         proto = std::make_unique<kafka::protocol>(
           app.smp_service_groups.kafka_smp_sg(),
+          app.smp_service_groups.fetch_smp_sg(),
+          app.smp_service_groups.produce_smp_sg(),
+          ss::default_scheduling_group(),
           app.metadata_cache,
           app.controller->get_topics_frontend(),
           app.quota_mgr,
@@ -197,10 +200,13 @@ public:
           storage::debug_sanitize_files::yes);
     }
 
-    ss::future<>
-    add_topic(model::topic_namespace_view tp_ns, int partitions = 1) {
+    ss::future<> add_topic(
+      model::topic_namespace_view tp_ns,
+      int partitions = 1,
+      cluster::topic_properties props = {}) {
         std::vector<cluster::topic_configuration> cfgs{
           cluster::topic_configuration(tp_ns.ns, tp_ns.tp, partitions, 1)};
+        cfgs.front().properties = std::move(props);
         return app.controller->get_topics_frontend()
           .local()
           .create_topics(std::move(cfgs), model::no_timeout)
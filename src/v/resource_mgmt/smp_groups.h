@@ -19,12 +19,28 @@
 // instance of this class can be created at the top level and passed down into
 // any server and any shard that needs to schedule continuations into a given
 // group.
+//
+// the kafka fetch and produce data paths have groups of their own, so that
+// a burst of cross shard reads or writes is bounded independently and can not
+// use up the requests available to the other kafka handlers. foreign record
+// batch readers load their slices from the owner shard under a group of their
+// own too: the loads are awaited by raft requests dispatched under the raft
+// group, sharing it could deadlock once both directions run out of requests.
 class smp_groups {
 public:
+    struct config {
+        // max cross shard requests of a group a shard can have in flight
+        uint32_t default_max_nonlocal_requests{5000};
+        uint32_t fetch_max_nonlocal_requests{5000};
+        uint32_t produce_max_nonlocal_requests{5000};
+        uint32_t foreign_reader_max_nonlocal_requests{5000};
+    };
+
     smp_groups() = default;
-    ss::future<> create_groups() {
+    ss::future<> create_groups(config cfg = {}) {
         ss::smp_service_group_config smp_sg_config;
-        smp_sg_config.max_nonlocal_requests = 5000;
+        smp_sg_config.max_nonlocal_requests
+          = cfg.default_max_nonlocal_requests;
 
         return create_smp_service_group(smp_sg_config)
           .then([this](ss::smp_service_group sg) {
@@ -47,18 +63,50 @@ public:
           })
           .then([this](ss::smp_service_group sg) {
               _coproc = std::make_unique<ss::smp_service_group>(sg);
+          })
+          .then([cfg] {
+              ss::smp_service_group_config c;
+              c.max_nonlocal_requests = cfg.fetch_max_nonlocal_requests;
+              return ss::create_smp_service_group(c);
+          })
+          .then([this](ss::smp_service_group sg) {
+              _fetch = std::make_unique<ss::smp_service_group>(sg);
+          })
+          .then([cfg] {
+              ss::smp_service_group_config c;
+              c.max_nonlocal_requests = cfg.produce_max_nonlocal_requests;
+              return ss::create_smp_service_group(c);
+          })
+          .then([this](ss::smp_service_group sg) {
+              _produce = std::make_unique<ss::smp_service_group>(sg);
+          })
+          .then([cfg] {
+              ss::smp_service_group_config c;
+              c.max_nonlocal_requests
+                = cfg.foreign_reader_max_nonlocal_requests;
+              return ss::create_smp_service_group(c);
+          })
+          .then([this](ss::smp_service_group sg) {
+              _foreign_reader = std::make_unique<ss::smp_service_group>(sg);
           });
     }
     ss::smp_service_group raft_smp_sg() { return *_raft; }
     ss::smp_service_group kafka_smp_sg() { return *_kafka; }
     ss::smp_service_group cluster_smp_sg() { return *_cluster; }
     ss::smp_service_group coproc_smp_sg() { return *_coproc; }
+    ss::smp_service_group fetch_smp_sg() { return *_fetch; }
+    ss::smp_service_group produce_smp_sg() { return *_produce; }
+    ss::smp_service_group foreign_reader_smp_sg() { return *_foreign_reader; }
 
     ss::future<> destroy_groups() {
         return destroy_smp_service_group(*_kafka)
           .then([this] { return destroy_smp_service_group(*_raft); })
           .then([this] { return destroy_smp_service_group(*_cluster); })
-          .then([this] { return destroy_smp_service_group(*_coproc); });
+          .then([this] { return destroy_smp_service_group(*_coproc); })
+          .then([this] { return destroy_smp_service_group(*_fetch); })
+          .then([this] { return destroy_smp_service_group(*_produce); })
+          .then(
+            [this] { return destroy_smp_service_group(*_foreign_reader); });
     }
 
 private:
@@ -66,4 +114,7 @@ private:
     std::unique_ptr<ss::smp_service_group> _kafka;
     std::unique_ptr<ss::smp_service_group> _cluster;
     std::unique_ptr<ss::smp_service_group> _coproc;
+    std::unique_ptr<ss::smp_service_group> _fetch;
+    std::unique_ptr<ss::smp_service_group> _produce;
+    std::unique_ptr<ss::smp_service_group> _foreign_reader;
 };
@@ -11,6 +11,8 @@
 
 #pragma once
 #include "rpc/logger.h"
+#include "rpc/types.h"
+#include "utils/hdr_hist.h"
 #include "utils/unresolved_address.h"
 
 #include <seastar/core/metrics_registration.hh>
@@ -69,10 +71,16 @@ public:
 
     void waiting_for_available_memory() { ++_requests_blocked_memory; }
 
+    /// measures the time from queueing a request until its reply arrives
+    std::unique_ptr<hdr_hist::measurement> measure_request() {
+        return _request_latency.auto_measure();
+    }
+
     void setup_metrics(
       ss::metrics::metric_groups& mgs,
       const std::optional<ss::sstring>& service_name,
-      const unresolved_address& target_addr);
+      const unresolved_address& target_addr,
+      connection_lane lane);
 
 private:
     uint64_t _requests = 0;
@@ -90,6 +98,7 @@ private:
     uint32_t _server_correlation_errors = 0;
     uint32_t _client_correlation_errors = 0;
     uint32_t _requests_blocked_memory = 0;
+    hdr_hist _request_latency;
     ss::metrics::metric_groups _metrics;
 
     friend std::ostream& operator<<(std::ostream& o, const client_probe& p);
@@ -14,6 +14,7 @@
 #include <fmt/format.h>
 
 #include <chrono>
+#include <optional>
 
 namespace rpc {
 
@@ -30,28 +31,37 @@ ss::future<> connection_cache::emplace(
         if (_cache.find(n) != _cache.end()) {
             return;
         }
-        _cache.emplace(
-          n,
-          ss::make_lw_shared<rpc::reconnect_transport>(
-            std::move(c), std::move(backoff_policy)));
+        lanes_t lanes;
+        for (size_t i = 0; i < lanes.size(); ++i) {
+            auto cfg = c;
+            cfg.lane = connection_lane(i);
+            // the budget applies to the peer, not to each of its lanes
+            cfg.max_queued_bytes = c.max_queued_bytes / lanes.size();
+            lanes[i] = ss::make_lw_shared<rpc::reconnect_transport>(
+              std::move(cfg), backoff_policy.clone());
+        }
+        _cache.emplace(n, std::move(lanes));
     });
 }
 ss::future<> connection_cache::remove(model::node_id n) {
     return _mutex
-      .with([this, n]() -> transport_ptr {
+      .with([this, n]() -> std::optional<lanes_t> {
           auto it = _cache.find(n);
           if (it == _cache.end()) {
-              return nullptr;
+              return std::nullopt;
           }
-          auto ptr = it->second;
+          auto lanes = std::move(it->second);
           _cache.erase(it);
-          return ptr;
+          return lanes;
       })
-      .then([](transport_ptr ptr) {
-          if (!ptr) {
+      .then([](std::optional<lanes_t> lanes) {
+          if (!lanes) {
               return ss::now();
           }
-          return ptr->stop().finally([ptr] {});
+          return ss::do_with(std::move(*lanes), [](lanes_t& lanes) {
+              return ss::parallel_for_each(
+                lanes, [](transport_ptr& ptr) { return ptr->stop(); });
+          });
       });
 }
 
@@ -59,8 +69,9 @@ ss::future<> connection_cache::remove(model::node_id n) {
 ss::future<> connection_cache::stop() {
     return _mutex.with([this]() {
         return parallel_for_each(_cache, [](auto& it) {
-            auto& [_, cli] = it;
-            return cli->stop();
+            auto& [_, lanes] = it;
+            return parallel_for_each(
+              lanes, [](transport_ptr& cli) { return cli->stop(); });
         });
         _cache.clear();
         // mark mutex as broken to prevent new connections from being created
@@ -24,15 +24,21 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <array>
 #include <chrono>
 #include <unordered_map>
 
 namespace rpc {
+/// \brief keeps one connection per lane (see rpc::connection_lane) to every
+/// peer. Lanes have separate transports, so they neither share the output
+/// stream nor the memory budget for queued requests: the max_queued_bytes of
+/// the peer is split evenly between its lanes
 class connection_cache final
   : public ss::peering_sharded_service<connection_cache> {
 public:
     using transport_ptr = ss::lw_shared_ptr<rpc::reconnect_transport>;
-    using underlying = std::unordered_map<model::node_id, transport_ptr>;
+    using lanes_t = std::array<transport_ptr, connection_lanes_count>;
+    using underlying = std::unordered_map<model::node_id, lanes_t>;
     using iterator = typename underlying::iterator;
 
     static inline ss::shard_id shard_for(
@@ -45,7 +51,10 @@ public:
     bool contains(model::node_id n) const {
         return _cache.find(n) != _cache.end();
     }
-    transport_ptr get(model::node_id n) const { return _cache.find(n)->second; }
+    transport_ptr
+    get(model::node_id n, connection_lane lane = connection_lane::data) const {
+        return _cache.find(n)->second[static_cast<size_t>(lane)];
+    }
 
     /// \brief needs to be a future, because mutations may come from different
     /// fibers and they need to be synchronized
@@ -69,20 +78,21 @@ public:
         ss::shard_id src_shard,
         model::node_id node_id,
         clock_type::time_point connection_timeout,
+        connection_lane lane,
         Func&& f) {
         using ret_t = result_wrap_t<std::invoke_result_t<Func, Protocol>>;
         auto shard = rpc::connection_cache::shard_for(self, src_shard, node_id);
 
         return container().invoke_on(
           shard,
-          [node_id, f = std::forward<Func>(f), connection_timeout](
+          [node_id, f = std::forward<Func>(f), connection_timeout, lane](
             rpc::connection_cache& cache) mutable {
               if (!cache.contains(node_id)) {
                   // No client available
                   return ss::futurize<ret_t>::convert(
                     rpc::make_error_code(errc::missing_node_rpc_client));
               }
-              return cache.get(node_id)
+              return cache.get(node_id, lane)
                 ->get_connected(connection_timeout)
                 .then([f = std::forward<Func>(f)](
                         result<rpc::transport*> transport) mutable {
@@ -96,6 +106,49 @@ public:
           });
     }
 
+    template<typename Protocol, typename Func>
+    // clang-format off
+    CONCEPT(requires requires(Func&& f, Protocol proto) {
+        f(proto);
+    })
+      // clang-format on
+      auto with_node_client(
+        model::node_id self,
+        ss::shard_id src_shard,
+        model::node_id node_id,
+        clock_type::time_point connection_timeout,
+        Func&& f) {
+        return with_node_client<Protocol, Func>(
+          self,
+          src_shard,
+          node_id,
+          connection_timeout,
+          connection_lane::data,
+          std::forward<Func>(f));
+    }
+
+    template<typename Protocol, typename Func>
+    // clang-format off
+    CONCEPT(requires requires(Func&& f, Protocol proto) {
+        f(proto);
+    })
+      // clang-format on
+      auto with_node_client(
+        model::node_id self,
+        ss::shard_id src_shard,
+        model::node_id node_id,
+        clock_type::duration connection_timeout,
+        connection_lane lane,
+        Func&& f) {
+        return with_node_client<Protocol, Func>(
+          self,
+          src_shard,
+          node_id,
+          connection_timeout + clock_type::now(),
+          lane,
+          std::forward<Func>(f));
+    }
+
     template<typename Protocol, typename Func>
     // clang-format off
     CONCEPT(requires requires(Func&& f, Protocol proto) {
@@ -113,6 +166,7 @@ public:
           src_shard,
           node_id,
           connection_timeout + clock_type::now(),
+          connection_lane::data,
           std::forward<Func>(f));
     }
 
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/metrics_registration.hh>
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace rpc {
+
+/// \brief per method reply compression statistics. Also drives adaptive
+/// compression: a method whose replies keep compressing poorly stops being
+/// compressed for a while and is then probed again
+class method_probe {
+public:
+    void compression_skipped() { ++_compression_skipped; }
+
+    void compressed(size_t in, size_t out, std::chrono::nanoseconds t) {
+        ++_compressed;
+        _compression_in_bytes += in;
+        _compression_out_bytes += out;
+        _compression_time += t;
+        // saved less than 10%
+        if (out * 10 > in * 9) {
+            if (++_poor_ratio_streak >= poor_ratio_streak_limit) {
+                _poor_ratio_streak = 0;
+                _backoff_left = backoff_replies;
+            }
+        } else {
+            _poor_ratio_streak = 0;
+        }
+    }
+
+    /// true if compression of the next reply should be skipped
+    bool compression_backoff() {
+        if (_backoff_left == 0) {
+            return false;
+        }
+        --_backoff_left;
+        ++_compression_skipped;
+        return true;
+    }
+
+    void setup_metrics(
+      ss::metrics::metric_groups&,
+      const char* proto,
+      std::string_view service,
+      std::string_view method);
+
+private:
+    static constexpr uint32_t poor_ratio_streak_limit = 8;
+    static constexpr uint32_t backoff_replies = 64;
+
+    uint64_t _compressed = 0;
+    uint64_t _compression_skipped = 0;
+    uint64_t _compression_in_bytes = 0;
+    uint64_t _compression_out_bytes = 0;
+    std::chrono::nanoseconds _compression_time{0};
+    uint32_t _poor_ratio_streak = 0;
+    uint32_t _backoff_left = 0;
+};
+
+} // namespace rpc
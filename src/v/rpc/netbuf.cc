@@ -10,12 +10,15 @@
 #include "rpc/netbuf.h"
 
 #include "bytes/iobuf.h"
+#include "compression/compressibility.h"
 #include "compression/stream_zstd.h"
 #include "hashing/xx.h"
 #include "reflection/adl.h"
 #include "rpc/types.h"
 #include "vassert.h"
 
+#include <chrono>
+
 namespace rpc {
 iobuf header_as_iobuf(const header& h) {
     iobuf b;
@@ -26,6 +29,40 @@ iobuf header_as_iobuf(const header& h) {
       "Header size must be known and exact");
     return b;
 }
+void netbuf::maybe_compress() {
+    if (_policy == compression_policy::none) {
+        _hdr.compression = rpc::compression_type::none;
+        return;
+    }
+    if (_policy == compression_policy::adaptive) {
+        if (_probe && _probe->compression_backoff()) {
+            _hdr.compression = rpc::compression_type::none;
+            return;
+        }
+        if (!compression::is_compressible(_out)) {
+            if (_probe) {
+                _probe->compression_skipped();
+            }
+            _hdr.compression = rpc::compression_type::none;
+            return;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto compressed = compression::shard_local_zstd().compress(_out);
+    if (_probe) {
+        _probe->compressed(
+          _out.size_bytes(),
+          compressed.size_bytes(),
+          std::chrono::steady_clock::now() - start);
+    }
+    if (compressed.size_bytes() >= _out.size_bytes()) {
+        // saves the receiver from decompressing for nothing
+        _hdr.compression = rpc::compression_type::none;
+        return;
+    }
+    _out = std::move(compressed);
+}
+
 /// \brief used to send the bytes down the wire
 /// we re-compute the header-checksum on every call
 ss::scattered_message<char> netbuf::as_scattered() && {
@@ -37,8 +74,7 @@ ss::scattered_message<char> netbuf::as_scattered() && {
     if (
       _out.size_bytes() >= _min_compression_bytes
       && rpc::compression_type::zstd == _hdr.compression) {
-        compression::stream_zstd fn;
-        _out = fn.compress(std::move(_out));
+        maybe_compress();
     } else {
         // didn't meet min requirements
         _hdr.compression = rpc::compression_type::none;
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "bytes/iobuf.h"
+#include "rpc/method_probe.h"
 #include "rpc/types.h"
 #include "vassert.h"
 
@@ -29,10 +30,18 @@ public:
     void set_compression(rpc::compression_type c);
     void set_service_method_id(uint32_t);
     void set_min_compression_bytes(size_t);
+    /// \brief policy applied when compression is requested. Statistics of
+    /// the payloads compressed are recorded in the optional probe, which also
+    /// drives the adaptive policy
+    void set_compression_policy(compression_policy, method_probe* = nullptr);
     iobuf& buffer();
 
 private:
+    void maybe_compress();
+
     size_t _min_compression_bytes{1024};
+    compression_policy _policy{compression_policy::adaptive};
+    method_probe* _probe{nullptr};
     header _hdr;
     iobuf _out;
 };
@@ -53,5 +62,10 @@ inline void netbuf::set_service_method_id(uint32_t x) { _hdr.meta = x; }
 inline void netbuf::set_min_compression_bytes(size_t min) {
     _min_compression_bytes = min;
 }
+inline void
+netbuf::set_compression_policy(compression_policy p, method_probe* probe) {
+    _policy = p;
+    _probe = probe;
+}
 
 } // namespace rpc
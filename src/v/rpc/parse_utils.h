@@ -97,8 +97,7 @@ ss::future<T> parse_type(ss::input_stream<char>& in, const header& h) {
             return rpc::parse_type_wihout_compression<T>(std::move(io));
         }
         if (h.compression == compression_type::zstd) {
-            compression::stream_zstd fn;
-            io = fn.uncompress(std::move(io));
+            io = compression::shard_local_zstd().uncompress(std::move(io));
             return rpc::parse_type_wihout_compression<T>(std::move(io));
         }
         return ss::make_exception_future<T>(std::runtime_error(
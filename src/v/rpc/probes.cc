@@ -9,15 +9,80 @@
 
 #include "prometheus/prometheus_sanitize.h"
 #include "rpc/client_probe.h"
+#include "rpc/method_probe.h"
 #include "rpc/server_probe.h"
 #include "ssx/sformat.h"
 
 #include <seastar/core/metrics.hh>
 #include <seastar/net/inet_address.hh>
 
+#include <fmt/ostream.h>
+
 #include <ostream>
 
 namespace rpc {
+void method_probe::setup_metrics(
+  ss::metrics::metric_groups& mgs,
+  const char* proto,
+  std::string_view service,
+  std::string_view method) {
+    namespace sm = ss::metrics;
+    auto service_label = sm::label("service");
+    auto method_label = sm::label("method");
+    std::vector<sm::label_instance> labels{
+      service_label(ss::sstring(service)), method_label(ss::sstring(method))};
+    mgs.add_group(
+      prometheus_sanitize::metrics_name(proto),
+      {
+        sm::make_derive(
+          "compressed_replies",
+          [this] { return _compressed; },
+          sm::description(
+            ssx::sformat("{}: Number of compressed replies", proto)),
+          labels),
+        sm::make_derive(
+          "compression_skipped_replies",
+          [this] { return _compression_skipped; },
+          sm::description(ssx::sformat(
+            "{}: Number of replies left uncompressed by adaptive compression",
+            proto)),
+          labels),
+        sm::make_total_bytes(
+          "compression_in_bytes",
+          [this] { return _compression_in_bytes; },
+          sm::description(ssx::sformat(
+            "{}: Number of reply bytes passed to the compressor", proto)),
+          labels),
+        sm::make_total_bytes(
+          "compression_out_bytes",
+          [this] { return _compression_out_bytes; },
+          sm::description(ssx::sformat(
+            "{}: Number of reply bytes produced by the compressor", proto)),
+          labels),
+        sm::make_gauge(
+          "compression_ratio",
+          [this] {
+              return _compression_in_bytes == 0
+                       ? 1.0
+                       : double(_compression_out_bytes)
+                           / double(_compression_in_bytes);
+          },
+          sm::description(ssx::sformat(
+            "{}: Compressed to uncompressed size ratio of replies", proto)),
+          labels),
+        sm::make_derive(
+          "compression_time_us",
+          [this] {
+              return std::chrono::duration_cast<std::chrono::microseconds>(
+                       _compression_time)
+                .count();
+          },
+          sm::description(
+            ssx::sformat("{}: CPU time spent compressing replies", proto)),
+          labels),
+      });
+}
+
 void server_probe::setup_metrics(
   ss::metrics::metric_groups& mgs, const char* proto) {
     namespace sm = ss::metrics;
@@ -99,11 +164,14 @@ std::ostream& operator<<(std::ostream& o, const server_probe& p) {
 void client_probe::setup_metrics(
   ss::metrics::metric_groups& mgs,
   const std::optional<ss::sstring>& service_name,
-  const unresolved_address& target_addr) {
+  const unresolved_address& target_addr,
+  connection_lane lane) {
     namespace sm = ss::metrics;
     auto target = sm::label("target");
+    auto lane_label = sm::label("lane");
     std::vector<sm::label_instance> labels = {
-      target(ssx::sformat("{}:{}", target_addr.host(), target_addr.port()))};
+      target(ssx::sformat("{}:{}", target_addr.host(), target_addr.port())),
+      lane_label(ssx::sformat("{}", lane))};
     if (service_name) {
         labels.push_back(sm::label("service_name")(*service_name));
     }
@@ -181,6 +249,11 @@ void client_probe::setup_metrics(
           sm::description("Number of requests that are blocked beacause"
                           " of insufficient memory"),
           labels),
+        sm::make_histogram(
+          "request_latency",
+          [this] { return _request_latency.seastar_histogram_logform(); },
+          sm::description("Latency of requests sent on the connection"),
+          labels),
       });
 }
 
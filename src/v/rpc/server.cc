@@ -39,6 +39,7 @@ void server::start() {
     if (!cfg.disable_metrics) {
         setup_metrics();
         _probe.setup_metrics(_metrics, cfg.name.c_str());
+        _proto->setup_metrics(_metrics, cfg.name.c_str());
     }
     for (const auto& endpoint : cfg.addrs) {
         ss::server_socket ss;
@@ -62,6 +62,8 @@ public:
         // the lifetime of all references here are guaranteed to live
         // until the end of the server (container/parent)
         virtual ss::future<> apply(server::resources) = 0;
+        // protocol specific metrics, registered along with the server ones
+        virtual void setup_metrics(ss::metrics::metric_groups&, const char*) {}
     };
 
     explicit server(server_configuration);
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "reflection/async_adl.h"
+#include "rpc/method_probe.h"
 #include "rpc/netbuf.h"
 #include "rpc/parse_utils.h"
 #include "rpc/types.h"
@@ -22,9 +23,38 @@
 #include <seastar/core/scheduling.hh>
 
 #include <cstdint>
+#include <string_view>
+#include <vector>
 
 namespace rpc {
 
+/// \brief most method implementations will be codegenerated
+/// by $root/tools/rpcgen.py
+struct method {
+    using handler = ss::noncopyable_function<ss::future<netbuf>(
+      ss::input_stream<char>&, streaming_context&)>;
+
+    explicit method(
+      handler h,
+      std::string_view name = "",
+      compression_policy compression = compression_policy::adaptive)
+      : name(name)
+      , compression(compression)
+      , _handler(std::move(h)) {}
+
+    ss::future<netbuf>
+    operator()(ss::input_stream<char>& in, streaming_context& ctx) {
+        return _handler(in, ctx);
+    }
+
+    std::string_view name;
+    compression_policy compression;
+    method_probe probe;
+
+private:
+    handler _handler;
+};
+
 /// \brief most service implementations will be codegenerated
 struct service {
     template<typename Input, typename Output>
@@ -36,6 +66,9 @@ struct service {
     virtual ss::smp_service_group& get_smp_service_group() = 0;
     /// \brief return nullptr when method not found
     virtual method* method_from_id(uint32_t) = 0;
+    /// \brief used to label per method metrics
+    virtual std::string_view service_name() const { return ""; }
+    virtual std::vector<method*> methods() { return {}; }
 };
 
 class rpc_internal_body_parsing_exception : public std::exception {
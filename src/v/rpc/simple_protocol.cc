@@ -56,10 +56,24 @@ ss::future<> simple_protocol::apply(server::resources rs) {
       });
 }
 
-ss::future<>
-send_reply(ss::lw_shared_ptr<server_context_impl> ctx, netbuf buf) {
+void simple_protocol::setup_metrics(
+  ss::metrics::metric_groups& mgs, const char* name) {
+    for (auto& s : _services) {
+        for (method* m : s->methods()) {
+            m->probe.setup_metrics(mgs, name, s->service_name(), m->name);
+        }
+    }
+}
+
+ss::future<> send_reply(
+  ss::lw_shared_ptr<server_context_impl> ctx, netbuf buf, method* m) {
     buf.set_min_compression_bytes(1024);
-    buf.set_compression(rpc::compression_type::zstd);
+    if (m) {
+        buf.set_compression(rpc::compression_type::zstd);
+        buf.set_compression_policy(m->compression, &m->probe);
+    } else {
+        buf.set_compression(rpc::compression_type::none);
+    }
     buf.set_correlation_id(ctx->get_header().correlation_id);
 
     auto view = std::move(buf).as_scattered();
@@ -100,15 +114,14 @@ simple_protocol::dispatch_method_once(header h, server::resources rs) {
             rs.probe().method_not_found();
             netbuf reply_buf;
             reply_buf.set_status(rpc::status::method_not_found);
-            return send_reply(ctx, std::move(reply_buf)).then([ctx]() mutable {
-                ctx->signal_body_parse();
-            });
+            return send_reply(ctx, std::move(reply_buf), nullptr)
+              .then([ctx]() mutable { ctx->signal_body_parse(); });
         }
 
         method* m = it->get()->method_from_id(method_id);
 
         return (*m)(ctx->res.conn->input(), *ctx)
-          .then_wrapped([ctx, m = ctx->res.hist().auto_measure(), rs](
+          .then_wrapped([ctx, m, h = ctx->res.hist().auto_measure(), rs](
                           ss::future<netbuf> fut) mutable {
               netbuf reply_buf;
               try {
@@ -131,8 +144,8 @@ simple_protocol::dispatch_method_once(header h, server::resources rs) {
                   rs.probe().service_error();
                   reply_buf.set_status(rpc::status::server_error);
               }
-              return send_reply(ctx, std::move(reply_buf))
-                .finally([m = std::move(m)] {});
+              return send_reply(ctx, std::move(reply_buf), m)
+                .finally([h = std::move(h)] {});
           });
     });
     return fut;
@@ -26,6 +26,7 @@ public:
         return "vectorized internal rpc protocol";
     };
     ss::future<> apply(server::resources) final;
+    void setup_metrics(ss::metrics::metric_groups&, const char*) final;
 
 private:
     ss::future<> dispatch_method_once(header, server::resources);
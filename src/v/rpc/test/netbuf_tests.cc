@@ -7,8 +7,11 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "random/generators.h"
+#include "rpc/method_probe.h"
 #include "rpc/netbuf.h"
 #include "rpc/parse_utils.h"
+#include "units.h"
 
 #include <seastar/core/thread.hh>
 #include <seastar/testing/thread_test_case.hh>
@@ -45,3 +48,108 @@ SEASTAR_THREAD_TEST_CASE(netbuf_pod) {
     BOOST_REQUIRE_EQUAL(src.y, dst.y);
     BOOST_REQUIRE_EQUAL(src.z, dst.z);
 }
+
+static rpc::header send_with_policy(
+  iobuf payload, rpc::compression_policy p, rpc::method_probe* probe) {
+    auto n = rpc::netbuf();
+    n.set_correlation_id(42);
+    n.set_service_method_id(66);
+    n.set_compression(rpc::compression_type::zstd);
+    n.set_min_compression_bytes(1024);
+    n.set_compression_policy(p, probe);
+    n.buffer().append(std::move(payload));
+    auto bufs = std::move(n).as_scattered().release().release();
+    auto in = make_iobuf_input_stream(iobuf(std::move(bufs)));
+    return rpc::parse_header(in).get0().value();
+}
+
+static iobuf random_payload(size_t size) {
+    iobuf ret;
+    auto b = random_generators::get_bytes(size);
+    ret.append(b.data(), b.size());
+    return ret;
+}
+
+static iobuf text_payload(size_t size) {
+    iobuf ret;
+    auto s = random_generators::gen_alphanum_string(128);
+    while (ret.size_bytes() < size) {
+        ret.append(s.data(), s.size());
+    }
+    return ret;
+}
+
+SEASTAR_THREAD_TEST_CASE(netbuf_compression_policies) {
+    using rpc::compression_policy;
+    using rpc::compression_type;
+    rpc::method_probe probe;
+    BOOST_REQUIRE(
+      send_with_policy(text_payload(8_KiB), compression_policy::none, &probe)
+        .compression
+      == compression_type::none);
+    BOOST_REQUIRE(
+      send_with_policy(text_payload(8_KiB), compression_policy::zstd, &probe)
+        .compression
+      == compression_type::zstd);
+    BOOST_REQUIRE(
+      send_with_policy(
+        text_payload(8_KiB), compression_policy::adaptive, &probe)
+        .compression
+      == compression_type::zstd);
+    // below the threshold
+    BOOST_REQUIRE(
+      send_with_policy(text_payload(100), compression_policy::zstd, &probe)
+        .compression
+      == compression_type::none);
+    // entropy probe rejects random data
+    BOOST_REQUIRE(
+      send_with_policy(
+        random_payload(8_KiB), compression_policy::adaptive, &probe)
+        .compression
+      == compression_type::none);
+    // when forced and the output is not smaller the payload is sent as is
+    BOOST_REQUIRE(
+      send_with_policy(random_payload(8_KiB), compression_policy::zstd, &probe)
+        .compression
+      == compression_type::none);
+}
+
+SEASTAR_THREAD_TEST_CASE(netbuf_adaptive_compression_backoff) {
+    rpc::method_probe probe;
+    // a method whose payloads keep compressing poorly backs off
+    for (int i = 0; i < 8; ++i) {
+        probe.compressed(1000, 950, std::chrono::microseconds(10));
+    }
+    BOOST_REQUIRE(
+      send_with_policy(
+        text_payload(8_KiB), rpc::compression_policy::adaptive, &probe)
+        .compression
+      == rpc::compression_type::none);
+    // and gets probed again after a while
+    for (int i = 0; i < 64; ++i) {
+        probe.compression_backoff();
+    }
+    BOOST_REQUIRE(
+      send_with_policy(
+        text_payload(8_KiB), rpc::compression_policy::adaptive, &probe)
+        .compression
+      == rpc::compression_type::zstd);
+}
+
+SEASTAR_THREAD_TEST_CASE(netbuf_compressed_roundtrip) {
+    auto n = rpc::netbuf();
+    n.set_correlation_id(42);
+    n.set_service_method_id(66);
+    n.set_compression(rpc::compression_type::zstd);
+    n.set_min_compression_bytes(0);
+    auto payload = text_payload(8_KiB);
+    auto expected = payload.copy();
+    n.buffer().append(std::move(payload));
+    auto bufs = std::move(n).as_scattered().release().release();
+    auto in = make_iobuf_input_stream(iobuf(std::move(bufs)));
+    auto h = rpc::parse_header(in).get0().value();
+    BOOST_REQUIRE(h.compression == rpc::compression_type::zstd);
+    auto io = read_iobuf_exactly(in, h.payload_size).get0();
+    BOOST_REQUIRE_EQUAL(
+      compression::shard_local_zstd().uncompress(std::move(io)), expected);
+}
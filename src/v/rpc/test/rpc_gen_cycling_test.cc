@@ -9,6 +9,7 @@
 
 #include "model/timeout_clock.h"
 #include "random/generators.h"
+#include "rpc/connection_cache.h"
 #include "rpc/exceptions.h"
 #include "rpc/test/rpc_gen_types.h"
 #include "rpc/test/rpc_integration_fixture.h"
@@ -228,6 +229,53 @@ FIXTURE_TEST(client_muxing, rpc_integration_fixture) {
     BOOST_REQUIRE_EQUAL(echo_resp.value().data.str, "testing..._suffix");
 }
 
+FIXTURE_TEST(connection_cache_lanes, rpc_integration_fixture) {
+    configure_server();
+    register_services();
+    start_server();
+
+    const model::node_id self(0);
+    const model::node_id peer(1);
+    ss::sharded<rpc::connection_cache> cache;
+    cache.start().get();
+    auto stop = ss::defer([&cache] { cache.stop().get(); });
+    auto cfg = client_config();
+    cfg.max_queued_bytes = 1024 * 1024;
+    cache.local()
+      .emplace(
+        peer,
+        cfg,
+        rpc::make_exponential_backoff_policy<rpc::clock_type>(1s, 10s))
+      .get();
+
+    auto control = cache.local().get(peer, rpc::connection_lane::control);
+    auto data = cache.local().get(peer, rpc::connection_lane::data);
+    BOOST_REQUIRE(control.get() != data.get());
+    BOOST_REQUIRE(control->server_address() == data->server_address());
+    // lanes split the queued bytes budget of the peer
+    BOOST_REQUIRE_EQUAL(
+      control->get().available_memory() + data->get().available_memory(),
+      cfg.max_queued_bytes);
+
+    auto echo_resp = cache.local()
+                       .with_node_client<echo::echo_client_protocol>(
+                         self,
+                         ss::this_shard_id(),
+                         peer,
+                         1s,
+                         echo::echo_client_protocol::echo_lane,
+                         [](echo::echo_client_protocol proto) {
+                             return proto.echo(
+                               echo::echo_req{.str = "control"},
+                               rpc::client_opts(rpc::no_timeout));
+                         })
+                       .get0();
+    BOOST_REQUIRE_EQUAL(echo_resp.value().data.str, "control");
+    // only the lane that was used got connected
+    BOOST_REQUIRE(control->is_valid());
+    BOOST_REQUIRE(!data->is_valid());
+}
+
 FIXTURE_TEST(timeout_test, rpc_integration_fixture) {
     configure_server();
     register_services();
@@ -59,6 +59,7 @@ transport::transport(
     .server_addr = std::move(c.server_addr),
     .credentials = std::move(c.credentials),
   })
+  , _lane(c.lane)
   , _memory(c.max_queued_bytes) {
     if (!c.disable_metrics) {
         setup_metrics(service_name);
@@ -234,7 +235,8 @@ transport::do_send(sequence_t seq, netbuf b, rpc::client_opts opts) {
     return ss::with_gate(
       _dispatch_gate,
       [this, b = std::move(b), opts = std::move(opts), seq]() mutable {
-          auto f = make_response_handler(b, opts);
+          auto f = make_response_handler(b, opts).finally(
+            [m = _probe.measure_request()] {});
 
           // send
           auto sz = b.buffer().size_bytes();
@@ -327,7 +329,7 @@ ss::future<> transport::dispatch(header h) {
 }
 
 void transport::setup_metrics(const std::optional<ss::sstring>& service_name) {
-    _probe.setup_metrics(_metrics, service_name, server_address());
+    _probe.setup_metrics(_metrics, service_name, server_address(), _lane);
 }
 
 transport::~transport() {
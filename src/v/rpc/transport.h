@@ -102,9 +102,17 @@ public:
     ss::future<result<std::unique_ptr<streaming_context>>>
       send(netbuf, rpc::client_opts);
 
+    /// \brief bytes that can still be queued before sends wait for memory
+    size_t available_memory() const { return _memory.available_units(); }
+
+    /// \brief the compression policy of the method applies to the request
+    /// when `client_opts` asks for compression
     template<typename Input, typename Output>
-    ss::future<result<client_context<Output>>>
-      send_typed(Input, uint32_t, rpc::client_opts);
+    ss::future<result<client_context<Output>>> send_typed(
+      Input,
+      uint32_t,
+      rpc::client_opts,
+      compression_policy = compression_policy::adaptive);
 
 private:
     using sequence_t = named_type<uint64_t, struct sequence_tag>;
@@ -123,6 +131,7 @@ private:
     ss::future<result<std::unique_ptr<streaming_context>>>
     make_response_handler(netbuf&, const rpc::client_opts&);
 
+    connection_lane _lane;
     ss::semaphore _memory;
     absl::flat_hash_map<uint32_t, std::unique_ptr<internal::response_handler>>
       _correlations;
@@ -169,13 +178,18 @@ result<rpc::client_context<T>> map_result(const header& hdr, T data) {
 
 template<typename Input, typename Output>
 inline ss::future<result<client_context<Output>>>
-transport::send_typed(Input r, uint32_t method_id, rpc::client_opts opts) {
+transport::send_typed(
+  Input r,
+  uint32_t method_id,
+  rpc::client_opts opts,
+  compression_policy policy) {
     using ret_t = result<client_context<Output>>;
     _probe.request();
 
     auto b = std::make_unique<rpc::netbuf>();
     b->set_compression(opts.compression);
     b->set_min_compression_bytes(opts.min_compression_bytes);
+    b->set_compression_policy(policy);
     auto raw_b = b.get();
     raw_b->set_service_method_id(method_id);
 
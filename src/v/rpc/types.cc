@@ -49,6 +49,16 @@ std::ostream& operator<<(std::ostream& o, const header& h) {
              << ", payload_checksum:" << h.payload_checksum << "}";
 }
 
+std::ostream& operator<<(std::ostream& o, connection_lane l) {
+    switch (l) {
+    case connection_lane::data:
+        return o << "data";
+    case connection_lane::control:
+        return o << "control";
+    }
+    return o << "unknown";
+}
+
 std::ostream& operator<<(std::ostream& o, const server_configuration& c) {
     o << "{";
     for (auto& a : c.addrs) {
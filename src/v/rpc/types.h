@@ -50,6 +50,30 @@ enum class compression_type : uint8_t {
     max = zstd,
 };
 
+/// \brief how requests and replies of a method are compressed, set per method
+/// in the service definition, see $root/tools/rpcgen.py. Replies are
+/// compressed according to the policy; requests only when the client asked
+/// for compression in its client_opts.
+enum class compression_policy : uint8_t {
+    /// never compress, i.e. payloads that are already compressed
+    none = 0,
+    /// always compress payloads above the size threshold
+    zstd,
+    /// compress payloads above the size threshold unless sampling finds them
+    /// incompressible or recent payloads of the method did not shrink
+    adaptive,
+};
+
+/// \brief traffic to a peer is split into lanes with separate connections,
+/// so that small latency sensitive requests (heartbeats, votes) never queue
+/// behind bulk data written to the same stream. Selected per method in the
+/// service definition, see $root/tools/rpcgen.py
+enum class connection_lane : uint8_t {
+    data = 0,
+    control,
+};
+static constexpr size_t connection_lanes_count = 2;
+
 struct negotiation_frame {
     int8_t version = 0;
     /// \brief 0 - no compression
@@ -154,11 +178,6 @@ private:
     std::vector<ss::semaphore_units<>> _reservations;
 };
 
-/// \brief most method implementations will be codegenerated
-/// by $root/tools/rpcgen.py
-using method = ss::noncopyable_function<ss::future<netbuf>(
-  ss::input_stream<char>&, streaming_context&)>;
-
 /// \brief used in returned types for client::send_typed() calls
 template<typename T>
 struct client_context {
@@ -226,9 +245,11 @@ struct transport_configuration {
     uint32_t max_queued_bytes = std::numeric_limits<uint32_t>::max();
     ss::shared_ptr<ss::tls::certificate_credentials> credentials;
     metrics_disabled disable_metrics = metrics_disabled::no;
+    connection_lane lane = connection_lane::data;
 };
 
 std::ostream& operator<<(std::ostream&, const header&);
+std::ostream& operator<<(std::ostream&, connection_lane);
 std::ostream& operator<<(std::ostream&, const server_endpoint&);
 std::ostream& operator<<(std::ostream&, const server_configuration&);
 std::ostream& operator<<(std::ostream&, const status&);
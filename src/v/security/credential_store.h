@@ -65,6 +65,8 @@ public:
         return _credentials.contains(name);
     }
 
+    void clear() { _credentials.clear(); }
+
     const_iterator begin() const { return _credentials.cbegin(); }
     const_iterator end() const { return _credentials.cend(); }
 
@@ -82,6 +82,36 @@ Roaring compaction_key_reducer::end_of_stream() {
     return std::move(_inverted);
 }
 
+ss::future<ss::stop_iteration>
+compaction_fingerprint_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const model::offset o = e.offset + model::offset(e.delta);
+    const auto fp = fingerprint_key_map::make_fingerprint(e.key);
+
+    if (auto it = _map.find(fp); it != nullptr) {
+        if (o > it->offset) {
+            it->offset = o;
+            it->natural_index = _natural_index;
+        }
+    } else {
+        if (_map.full()) {
+            // write the entry again - we ran out of scratch space
+            _inverted.add(_map.evict().natural_index);
+        }
+        _map.insert(fp, o, _natural_index);
+    }
+
+    ++_natural_index;
+    return ss::make_ready_future<stop_t>(stop_t::no);
+}
+Roaring compaction_fingerprint_reducer::end_of_stream() {
+    _map.for_each([this](const fingerprint_key_map::entry& e) {
+        _inverted.add(e.natural_index);
+    });
+    _inverted.shrinkToFit();
+    return std::move(_inverted);
+}
+
 ss::future<ss::stop_iteration>
 index_copy_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
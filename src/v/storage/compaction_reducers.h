@@ -17,6 +17,7 @@
 #include "storage/compacted_index.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/compacted_offset_list.h"
+#include "storage/fingerprint_key_map.h"
 #include "storage/index_state.h"
 #include "storage/logger.h"
 #include "storage/segment_appender.h"
@@ -53,6 +54,8 @@ public:
     ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
     Roaring end_of_stream();
 
+    size_t memory_usage() { return idx_mem_usage() + _keys_mem_usage; }
+
 private:
     size_t idx_mem_usage() {
         using debug = absl::container_internal::hashtable_debug_internal::
@@ -66,6 +69,33 @@ private:
     uint32_t _natural_index{0};
 };
 
+/// Same as compaction_key_reducer but keeps fixed width fingerprints of the
+/// keys instead of the keys, which fits several times more keys into the
+/// same memory for topics with many distinct keys.
+///
+/// The index is read as a stream and the keys are not kept, so a fingerprint
+/// match can not be verified against the key: two distinct keys colliding on
+/// the fingerprint are compacted as one, which loses the older record. The
+/// reducer is opt-in through `compaction_key_fingerprints` for that reason.
+class compaction_fingerprint_reducer : public compaction_reducer {
+public:
+    static constexpr const size_t default_max_memory_usage = 5_MiB;
+
+    explicit compaction_fingerprint_reducer(
+      size_t max_mem = default_max_memory_usage)
+      : _map(max_mem) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    Roaring end_of_stream();
+
+    size_t memory_usage() const { return _map.memory_usage(); }
+
+private:
+    Roaring _inverted;
+    fingerprint_key_map _map;
+    uint32_t _natural_index{0};
+};
+
 /// This class copies the input reader into the writer consulting the bitmap of
 /// wether ot keep the entry or not
 class index_filtered_copy_reducer : public compaction_reducer {
@@ -267,7 +267,12 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
 
         return f.then([this, seg, cfg]() {
             return storage::internal::self_compact_segment(seg, cfg, _probe)
-              .finally([seg] { seg->mark_as_finished_self_compaction(); });
+              .finally([this, seg] {
+                  seg->mark_as_finished_self_compaction();
+                  // compaction may have removed the batches holding the
+                  // segment's max timestamp
+                  _segs.refresh_timestamps();
+              });
         });
     }
 
@@ -486,6 +491,66 @@ ss::future<> disk_log_impl::compact(compaction_config cfg) {
     return f;
 }
 
+bool disk_log_impl::is_evictable() const {
+    // mirrors the conditions under which compact() and gc() evict segments
+    return config().is_collectable()
+           && !(
+             config().has_overrides()
+             && config().get_overrides().cleanup_policy_bitflags
+                  == model::cleanup_policy_bitflags::none)
+           && config().ntp().ns() != model::redpanda_ns
+           && config().ntp().ns() != model::kafka_internal_namespace;
+}
+
+housekeeping_backlog disk_log_impl::backlog(const compaction_config& defaults) {
+    auto cfg = apply_overrides(defaults);
+    housekeeping_backlog ret{.size_bytes = _probe.partition_size()};
+    if (is_evictable() && cfg.max_bytes && ret.size_bytes > *cfg.max_bytes) {
+        ret.over_retention_bytes = ret.size_bytes - *cfg.max_bytes;
+    }
+    if (config().is_compacted()) {
+        for (const auto& s : _segs) {
+            if (
+              !s->has_appender() && s->is_compacted_segment()
+              && !s->finished_self_compaction()) {
+                ret.dirty_bytes += s->size_bytes();
+            }
+        }
+    }
+    _probe.set_housekeeping_backlog(
+      ret.over_retention_bytes, ret.dirty_bytes);
+    return ret;
+}
+
+std::vector<reclaimable_segment> disk_log_impl::reclaimable_segments() const {
+    std::vector<reclaimable_segment> ret;
+    if (_closed || !is_evictable() || _segs.size() < 2) {
+        return ret;
+    }
+    // the last segment is never evicted, same as with retention
+    for (size_t i = 0; i < _segs.size() - 1; ++i) {
+        const auto& s = _segs[i];
+        if (
+          s->has_appender()
+          || s->offsets().committed_offset > _max_collectible_offset) {
+            break;
+        }
+        ret.push_back(reclaimable_segment{
+          .committed_offset = s->offsets().committed_offset,
+          .max_timestamp = s->index().max_timestamp(),
+          .size_bytes = s->size_bytes(),
+        });
+    }
+    return ret;
+}
+
+ss::future<> disk_log_impl::reclaim(model::offset o, ss::abort_source& as) {
+    if (_closed || !is_evictable()) {
+        return ss::now();
+    }
+    return garbage_collect_segments(o, &as, "gc[disk_pressure]");
+}
+
 ss::future<> disk_log_impl::gc(compaction_config cfg) {
     vassert(!_closed, "gc on closed log - {}", *this);
 
@@ -77,6 +77,9 @@ public:
     size_t bytes_left_before_roll() const;
 
     size_t size_bytes() const override { return _probe.partition_size(); }
+    housekeeping_backlog backlog(const compaction_config&) final;
+    std::vector<reclaimable_segment> reclaimable_segments() const final;
+    ss::future<> reclaim(model::offset, ss::abort_source&) final;
     ss::future<> update_configuration(ntp_config::default_overrides) final;
 
 private:
@@ -126,6 +129,7 @@ private:
     bool is_front_segment(const segment_set::type&) const;
 
     compaction_config apply_overrides(compaction_config) const;
+    bool is_evictable() const;
 
 private:
     size_t max_segment_size() const;
@@ -0,0 +1,237 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/disk_space_manager.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "storage/api.h"
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/smp.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <queue>
+#include <sys/statvfs.h>
+
+namespace storage {
+
+disk_space_manager::disk_space_manager(ss::sharded<api>& storage)
+  : _storage(storage) {}
+
+ss::future<> disk_space_manager::start() {
+    if (ss::this_shard_id() != shard) {
+        return ss::now();
+    }
+    setup_metrics();
+    _timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] { return tick(); })
+          .handle_exception([](std::exception_ptr e) {
+              vlog(stlog.warn, "Disk space check failed: {}", e);
+          })
+          .finally([this] { arm_timer(); });
+    });
+    arm_timer();
+    return ss::now();
+}
+
+ss::future<> disk_space_manager::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void disk_space_manager::arm_timer() {
+    auto interval = config::shard_local_cfg().disk_pressure_check_interval_ms();
+    if (interval.count() > 0 && !_gate.is_closed()) {
+        _timer.arm(interval);
+    }
+}
+
+ss::future<> disk_space_manager::tick() {
+    const auto& cfg = config::shard_local_cfg();
+    auto st = co_await ss::engine().statvfs(
+      _storage.local().log_mgr().config().base_dir);
+    _total_bytes = st.f_blocks * st.f_frsize;
+    _free_bytes = st.f_bavail * st.f_frsize;
+    if (_total_bytes == 0) {
+        co_return;
+    }
+
+    const auto used = _total_bytes - _free_bytes;
+    const auto high = _total_bytes / 100
+                      * cfg.disk_pressure_high_watermark_percent();
+    if (used <= high) {
+        co_return;
+    }
+    const auto low = _total_bytes / 100
+                     * cfg.disk_pressure_low_watermark_percent();
+    const auto to_free = used - std::min(low, used);
+
+    auto plan = disk_space_manager::plan(
+      co_await collect(), to_free, model::timestamp::now());
+    size_t planned = 0;
+    for (const auto& e : plan) {
+        planned += e.size_bytes;
+    }
+    vlog(
+      stlog.warn,
+      "Disk usage of {} is {} of {} bytes, above the high watermark of {}%. "
+      "Evicting {} bytes from {} logs",
+      _storage.local().log_mgr().config().base_dir,
+      used,
+      _total_bytes,
+      cfg.disk_pressure_high_watermark_percent(),
+      planned,
+      plan.size());
+    co_await evict(std::move(plan));
+}
+
+ss::future<std::vector<disk_space_manager::log_segments>>
+disk_space_manager::collect() {
+    auto per_shard = co_await _storage.map([](api& a) {
+        return a.log_mgr().reclaimable_segments(
+          config::shard_local_cfg().cloud_storage_enabled());
+    });
+
+    std::vector<log_segments> ret;
+    for (ss::shard_id s = 0; s < per_shard.size(); ++s) {
+        for (auto& [ntp, segments] : per_shard[s]) {
+            ret.push_back(log_segments{
+              .ntp = ntp,
+              .shard = s,
+              .segments = std::move(segments),
+            });
+        }
+    }
+    co_return ret;
+}
+
+ss::future<> disk_space_manager::evict(std::vector<eviction> plan) {
+    std::vector<absl::flat_hash_map<model::ntp, model::offset>> per_shard(
+      ss::smp::count);
+    for (const auto& e : plan) {
+        per_shard[e.shard].emplace(e.ntp, e.offset);
+        _evicted_bytes += e.size_bytes;
+        _evicted_segments += e.segments;
+    }
+    co_await ss::parallel_for_each(
+      boost::irange<ss::shard_id>(0, ss::smp::count),
+      [this, &per_shard](ss::shard_id s) {
+          if (per_shard[s].empty()) {
+              return ss::now();
+          }
+          return _storage.invoke_on(
+            s, [offsets = std::move(per_shard[s])](api& a) mutable {
+                return a.log_mgr().reclaim(std::move(offsets));
+            });
+      });
+}
+
+std::vector<disk_space_manager::eviction> disk_space_manager::plan(
+  std::vector<log_segments> logs, size_t bytes, model::timestamp now) {
+    struct head {
+        model::timestamp timestamp;
+        size_t log;
+        size_t segment;
+    };
+    auto newer = [](const head& a, const head& b) {
+        return a.timestamp > b.timestamp;
+    };
+    auto make_head = [&logs, now](size_t log, size_t segment) {
+        return head{
+          .timestamp = std::min(
+            logs[log].segments[segment].max_timestamp, now),
+          .log = log,
+          .segment = segment,
+        };
+    };
+
+    // the oldest segment not evicted yet of every log, oldest on top
+    std::priority_queue<head, std::vector<head>, decltype(newer)> heads(
+      newer);
+    for (size_t i = 0; i < logs.size(); ++i) {
+        if (!logs[i].segments.empty()) {
+            heads.push(make_head(i, 0));
+        }
+    }
+
+    // index in the result of the eviction of every log
+    std::vector<std::optional<size_t>> evictions(logs.size());
+    std::vector<eviction> ret;
+    size_t freed = 0;
+    while (freed < bytes && !heads.empty()) {
+        auto h = heads.top();
+        heads.pop();
+        const auto& s = logs[h.log].segments[h.segment];
+        auto& idx = evictions[h.log];
+        if (!idx) {
+            idx = ret.size();
+            ret.push_back(eviction{
+              .ntp = logs[h.log].ntp,
+              .shard = logs[h.log].shard,
+              .segments = 0,
+              .size_bytes = 0,
+            });
+        }
+        auto& e = ret[*idx];
+        e.offset = s.committed_offset;
+        ++e.segments;
+        e.size_bytes += s.size_bytes;
+        freed += s.size_bytes;
+
+        if (h.segment + 1 < logs[h.log].segments.size()) {
+            heads.push(make_head(h.log, h.segment + 1));
+        }
+    }
+    return ret;
+}
+
+void disk_space_manager::setup_metrics() {
+    namespace sm = ss::metrics;
+
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:disk"),
+      {
+        sm::make_gauge(
+          "total_bytes",
+          [this] { return _total_bytes; },
+          sm::description("Size of the file system holding the data "
+                          "directory")),
+        sm::make_gauge(
+          "free_bytes",
+          [this] { return _free_bytes; },
+          sm::description("Free space of the file system holding the data "
+                          "directory")),
+        sm::make_total_bytes(
+          "pressure_evicted_bytes",
+          [this] { return _evicted_bytes; },
+          sm::description("Bytes of segments evicted because the disk was "
+                          "running out of space")),
+        sm::make_derive(
+          "pressure_evicted_segments",
+          [this] { return _evicted_segments; },
+          sm::description("Number of segments evicted because the disk was "
+                          "running out of space")),
+      });
+}
+
+} // namespace storage
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+#include "seastarx.h"
+#include "storage/fwd.h"
+#include "storage/types.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <vector>
+
+namespace storage {
+
+/**
+ * Disk space manager.
+ *
+ * Retention is enforced per log, so a single topic without retention limits,
+ * or with a segment whose timestamp is far in the future, can fill up the
+ * data directory and take down the broker.
+ *
+ * The manager periodically checks the free space of the file system holding
+ * the data directory. When the used space goes above
+ * `disk_pressure_high_watermark_percent` it evicts closed segments of all
+ * the logs of the node, oldest first, until the used space drops below
+ * `disk_pressure_low_watermark_percent`. Segments are evicted with the same
+ * mechanism as retention: the active segment, the segments above the raft
+ * collectible offset and the segments of archived logs that were not
+ * uploaded yet are never evicted. With cloud storage enabled a log whose
+ * uploaded offset is not known on this node, e.g. on a follower, is left
+ * alone entirely, as are internal and compacted only topics. Disabled
+ * unless `disk_pressure_check_interval_ms` is set.
+ *
+ * Single instance running on shard `disk_space_manager::shard`.
+ */
+class disk_space_manager {
+public:
+    static constexpr ss::shard_id shard = 0;
+
+    // reclaimable segments of a log
+    struct log_segments {
+        model::ntp ntp;
+        ss::shard_id shard;
+        std::vector<reclaimable_segment> segments;
+    };
+
+    // evict the segments of a log up to and including the offset
+    struct eviction {
+        model::ntp ntp;
+        ss::shard_id shard;
+        model::offset offset;
+        size_t segments;
+        size_t size_bytes;
+    };
+
+    explicit disk_space_manager(ss::sharded<api>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    /**
+     * Picks segments to evict, oldest first, until `bytes` are freed.
+     * Segments of a log are evicted in offset order, so a segment is only
+     * picked after all the preceding segments of its log. Timestamps after
+     * `now` are treated as `now`, segments with bogus timestamps are then
+     * evicted together with the most recent data rather than never.
+     */
+    static std::vector<eviction>
+    plan(std::vector<log_segments>, size_t bytes, model::timestamp now);
+
+private:
+    void arm_timer();
+    ss::future<> tick();
+    ss::future<std::vector<log_segments>> collect();
+    ss::future<> evict(std::vector<eviction>);
+    void setup_metrics();
+
+    ss::sharded<api>& _storage;
+
+    size_t _total_bytes{0};
+    size_t _free_bytes{0};
+    uint64_t _evicted_bytes{0};
+    uint64_t _evicted_segments{0};
+    ss::metrics::metric_groups _metrics;
+    ss::timer<ss::lowres_clock> _timer;
+    ss::gate _gate;
+};
+
+} // namespace storage
@@ -0,0 +1,126 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/fingerprint_key_map.h"
+
+#include "hashing/crc32c.h"
+#include "hashing/xx.h"
+#include "vassert.h"
+
+#include <algorithm>
+
+namespace storage::internal {
+
+fingerprint_key_map::fingerprint_key_map(size_t max_memory)
+  : _max_slots(std::max<size_t>(max_memory / sizeof(entry), 8)) {
+    _slots.resize(std::min(initial_capacity, _max_slots));
+}
+
+fingerprint_key_map::fingerprint
+fingerprint_key_map::make_fingerprint(bytes_view key) {
+    auto hash = xxhash_64(key.data(), key.size());
+    if (hash == empty_hash) {
+        hash = 1;
+    }
+    // a different hash function, so that it is independent of the first
+    crc32 check;
+    check.extend(key.data(), key.size());
+    check.extend(static_cast<uint32_t>(key.size()));
+    return fingerprint{.hash = hash, .check = check.value()};
+}
+
+size_t fingerprint_key_map::home(uint64_t hash) const {
+    // maps the hash onto [0, capacity) without a modulo
+    return static_cast<size_t>(
+      (static_cast<unsigned __int128>(hash) * _slots.size()) >> 64U);
+}
+
+fingerprint_key_map::entry*
+fingerprint_key_map::find(const fingerprint& fp) {
+    // the load factor is bounded, there is always a free slot ending the probe
+    for (auto i = home(fp.hash); _slots[i].hash != empty_hash; i = next(i)) {
+        if (_slots[i].hash == fp.hash && _slots[i].check == fp.check) {
+            return &_slots[i];
+        }
+    }
+    return nullptr;
+}
+
+bool fingerprint_key_map::full() const {
+    return _size >= max_size() && _slots.size() >= _max_slots;
+}
+
+void fingerprint_key_map::insert(
+  const fingerprint& fp, model::offset o, uint32_t natural_index) {
+    vassert(!full(), "Fingerprint map is full, size: {}", _size);
+    if (_size >= max_size()) {
+        grow();
+    }
+    auto i = home(fp.hash);
+    while (_slots[i].hash != empty_hash) {
+        i = next(i);
+    }
+    _slots[i] = entry{
+      .hash = fp.hash,
+      .offset = o,
+      .check = fp.check,
+      .natural_index = natural_index,
+    };
+    ++_size;
+}
+
+void fingerprint_key_map::grow() {
+    auto slots = std::exchange(
+      _slots,
+      std::vector<entry>(std::min(_slots.size() * 2, _max_slots)));
+    for (const auto& e : slots) {
+        if (e.hash == empty_hash) {
+            continue;
+        }
+        auto i = home(e.hash);
+        while (_slots[i].hash != empty_hash) {
+            i = next(i);
+        }
+        _slots[i] = e;
+    }
+}
+
+fingerprint_key_map::entry fingerprint_key_map::evict() {
+    vassert(_size > 0, "Cannot evict from an empty fingerprint map");
+    // entries are placed by hash, so taking them in slot order is evicting
+    // pseudo random keys
+    auto i = _evict_cursor < _slots.size() ? _evict_cursor : 0;
+    while (_slots[i].hash == empty_hash) {
+        i = next(i);
+    }
+    auto ret = _slots[i];
+    erase(i);
+    _evict_cursor = i;
+    return ret;
+}
+
+void fingerprint_key_map::erase(size_t i) {
+    // backward shift deletion, moves the following entries of the probe
+    // sequence into the hole so that lookups never stop early
+    auto hole = i;
+    for (auto j = next(i); _slots[j].hash != empty_hash; j = next(j)) {
+        const auto h = home(_slots[j].hash);
+        // whether the home of j lies cyclically in (hole, j]
+        const bool stays = hole <= j ? (hole < h && h <= j)
+                                     : (hole < h || h <= j);
+        if (!stays) {
+            _slots[hole] = _slots[j];
+            hole = j;
+        }
+    }
+    _slots[hole] = entry{};
+    --_size;
+}
+
+} // namespace storage::internal
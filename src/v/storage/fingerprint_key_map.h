@@ -0,0 +1,99 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/bytes.h"
+#include "model/fundamental.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace storage::internal {
+
+/**
+ * Key to value map of compaction that stores fixed width fingerprints of the
+ * keys instead of the keys themselves, so that memory usage per key does not
+ * depend on the size of the key and there is no allocation per key.
+ *
+ * Open addressing table with linear probing. A key is identified by a 64 bit
+ * hash, used to find its slot, and an independent 32 bit hash checked on
+ * every fingerprint match; two distinct keys are only mistaken for each other
+ * if they collide on both, i.e. on 96 bits.
+ *
+ * The table grows up to `max_memory`, after that new keys can only be
+ * inserted after evicting an existing one.
+ */
+class fingerprint_key_map {
+public:
+    struct fingerprint {
+        uint64_t hash;
+        uint32_t check;
+    };
+
+    static constexpr uint64_t empty_hash = 0;
+
+    struct entry {
+        // fingerprint hash, `empty_hash` for free slots
+        uint64_t hash{empty_hash};
+        model::offset offset;
+        uint32_t check{0};
+        uint32_t natural_index{0};
+    };
+
+    // maximum load factor of the table, in eighths
+    static constexpr size_t max_load = 7;
+    static constexpr size_t initial_capacity = 1024;
+
+    explicit fingerprint_key_map(size_t max_memory);
+
+    static fingerprint make_fingerprint(bytes_view);
+
+    /// entry of the key or nullptr when the key is not in the map, the offset
+    /// and natural index of the entry may be updated in place
+    entry* find(const fingerprint&);
+
+    /// inserts a key that is not in the map, the map must not be full
+    void insert(const fingerprint&, model::offset, uint32_t natural_index);
+
+    /// removes a pseudo random entry and returns it
+    entry evict();
+
+    /// no more keys can be inserted without evicting one
+    bool full() const;
+
+    template<typename Func>
+    void for_each(Func&& f) const {
+        for (const auto& e : _slots) {
+            if (e.hash != empty_hash) {
+                f(e);
+            }
+        }
+    }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+    size_t capacity() const { return _slots.size(); }
+    size_t memory_usage() const { return _slots.capacity() * sizeof(entry); }
+
+private:
+    size_t home(uint64_t hash) const;
+    size_t next(size_t i) const { return i + 1 == _slots.size() ? 0 : i + 1; }
+    size_t max_size() const { return _slots.size() * max_load / 8; }
+    void grow();
+    void erase(size_t);
+
+    std::vector<entry> _slots;
+    size_t _max_slots;
+    size_t _size{0};
+    size_t _evict_cursor{0};
+};
+
+} // namespace storage::internal
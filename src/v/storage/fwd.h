@@ -14,6 +14,7 @@
 namespace storage {
 
 class api;
+class disk_space_manager;
 class kvstore;
 class log_manager;
 class ntp_config;
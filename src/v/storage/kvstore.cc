@@ -20,11 +20,15 @@
 #include "storage/types.h"
 #include "vlog.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/defer.hh>
 #include <seastar/util/log.hh>
 
+#include <chrono>
+#include <iterator>
+
 static ss::logger lg("kvstore");
 
 namespace storage {
@@ -69,6 +73,33 @@ ss::future<> kvstore::start() {
               "key_count",
               [this] { return _db.size(); },
               ss::metrics::description("Number of keys in the database")),
+            ss::metrics::make_total_operations(
+              "segments_compacted",
+              [this] { return _probe.segments_compacted; },
+              ss::metrics::description("Number of segments compacted")),
+            ss::metrics::make_total_bytes(
+              "written_bytes",
+              [this] { return _probe.written_bytes; },
+              ss::metrics::description("Bytes of keys and values written")),
+            ss::metrics::make_total_bytes(
+              "compaction_written_bytes",
+              [this] { return _probe.compaction_written_bytes; },
+              ss::metrics::description(
+                "Bytes of live keys and values rewritten by compaction")),
+            ss::metrics::make_gauge(
+              "write_amplification",
+              [this] { return _probe.write_amplification(); },
+              ss::metrics::description(
+                "Bytes written to disk per byte of keys and values written")),
+            ss::metrics::make_gauge(
+              "recovery_time_ms",
+              [this] { return _probe.recovery_ms; },
+              ss::metrics::description(
+                "Time taken to replay the database on startup")),
+            ss::metrics::make_gauge(
+              "segments",
+              [this] { return _segments.size(); },
+              ss::metrics::description("Number of segments on disk")),
           });
     }
 
@@ -89,8 +120,9 @@ ss::future<> kvstore::start() {
                         if (_gate.is_closed()) {
                             return ss::now();
                         }
-                        return roll().then(
-                          [this] { return flush_and_apply_ops(); });
+                        return roll()
+                          .then([this] { return flush_and_apply_ops(); })
+                          .then([this] { return compact(); });
                     });
                 });
           });
@@ -150,7 +182,7 @@ std::optional<iobuf> kvstore::get(key_space ks, bytes_view key) {
     // do not re-assign to string_view -> temporary
     auto kkey = make_spaced_key(ks, key);
     if (auto it = _db.find(kkey); it != _db.end()) {
-        return it->second.copy();
+        return it->second.value.copy();
     }
     return std::nullopt;
 }
@@ -179,9 +211,17 @@ ss::future<> kvstore::put(key_space ks, bytes key, std::optional<iobuf> value) {
       });
 }
 
-void kvstore::apply_op(bytes key, std::optional<iobuf> value) {
+void kvstore::apply_op(
+  bytes key, std::optional<iobuf> value, model::offset segment) {
     auto it = _db.find(key);
     bool found = it != _db.end();
+    auto& usage = _segments.at(segment);
+    usage.written_bytes += key.size() + (value ? value->size_bytes() : 0);
+    if (found) {
+        // the previous write of the key is now garbage
+        _segments.at(it->second.segment).live_bytes
+          -= it->first.size() + it->second.value.size_bytes();
+    }
     if (value) {
         vlog(
           lg.trace,
@@ -189,20 +229,24 @@ void kvstore::apply_op(bytes key, std::optional<iobuf> value) {
           (found ? "update" : "insert"),
           key,
           value);
+        usage.live_bytes += key.size() + value->size_bytes();
         if (found) {
-            _probe.dec_cached_bytes(it->second.size_bytes());
+            _probe.dec_cached_bytes(it->second.value.size_bytes());
             _probe.add_cached_bytes(value->size_bytes());
-            it->second = std::move(*value);
+            it->second = entry{.value = std::move(*value), .segment = segment};
         } else {
             _probe.add_cached_bytes(key.size() + value->size_bytes());
-            _db.emplace(std::move(key), std::move(*value));
+            _db.emplace(
+              std::move(key),
+              entry{.value = std::move(*value), .segment = segment});
         }
     } else {
         if (!found) {
             vlog(lg.trace, "Apply op: delete: key={} not found", key);
         } else {
             vlog(lg.trace, "Apply op: delete: key={}", key);
-            _probe.dec_cached_bytes(it->first.size() + it->second.size_bytes());
+            _probe.dec_cached_bytes(
+              it->first.size() + it->second.value.size_bytes());
             _db.erase(it);
         }
     }
@@ -238,28 +282,41 @@ ss::future<> kvstore::flush_and_apply_ops() {
     return _segment->append(std::move(batch))
       .then([this](append_result) { return _segment->flush(); })
       .then([this, last_offset, ops = std::move(ops)]() mutable {
+          const auto segment = _segment->offsets().base_offset;
           for (auto& op : ops) {
-              apply_op(std::move(op.key), std::move(op.value));
+              _probe.add_written_bytes(
+                op.key.size() + (op.value ? op.value->size_bytes() : 0));
+              apply_op(std::move(op.key), std::move(op.value), segment);
               op.done.set_value();
           }
           _next_offset = last_offset + model::offset(1);
       });
 }
 
+ss::future<> kvstore::open_segment() {
+    return make_segment(
+             _ntpc,
+             model::offset(_next_offset),
+             model::term_id(0),
+             ss::default_priority_class(),
+             record_version_type::v1,
+             default_segment_readahead_size,
+             _conf.sanitize_fileops,
+             std::nullopt)
+      .then([this](ss::lw_shared_ptr<segment> seg) {
+          _segments.emplace(
+            seg->offsets().base_offset,
+            segment_usage{
+              .data_file = seg->reader().filename(),
+              .index_file = seg->index().filename(),
+            });
+          _segment = std::move(seg);
+      });
+}
+
 ss::future<> kvstore::roll() {
     if (!_segment) {
-        return make_segment(
-                 _ntpc,
-                 model::offset(_next_offset),
-                 model::term_id(0),
-                 ss::default_priority_class(),
-                 record_version_type::v1,
-                 default_segment_readahead_size,
-                 _conf.sanitize_fileops,
-                 std::nullopt)
-          .then([this](ss::lw_shared_ptr<segment> seg) {
-              _segment = std::move(seg);
-          });
+        return open_segment();
     }
 
     if (_segment->appender().file_byte_offset() > _conf.max_segment_size) {
@@ -274,97 +331,114 @@ ss::future<> kvstore::roll() {
         // segment. we clear _segment here before closing and finishing the roll
         // process so that if an issue occurs and the flush fiber terminates
         // that stop() doesn't try to flush and close a closed and partially
-        // cleaned-up segment.
+        // cleaned-up segment. the closed segment stays on disk until it is
+        // compacted.
         auto seg = std::exchange(_segment, nullptr);
-        return seg->close()
-          .then([this] { return save_snapshot(); })
-          .then([seg] {
-              vlog(
-                lg.debug,
-                "Removing old segment with base offset {}",
-                seg->offsets().base_offset);
-              return ss::remove_file(seg->reader().filename()).then([seg] {
-                  return ss::remove_file(seg->index().filename());
-              });
-          })
-          .then([this] {
-              return make_segment(
-                       _ntpc,
-                       model::offset(_next_offset),
-                       model::term_id(0),
-                       ss::default_priority_class(),
-                       record_version_type::v1,
-                       default_segment_readahead_size,
-                       _conf.sanitize_fileops,
-                       std::nullopt)
-                .then([this](ss::lw_shared_ptr<segment> seg) {
-                    _segment = std::move(seg);
-                });
-          });
+        return seg->close().then([this, seg] { return open_segment(); });
     }
 
     return ss::now();
 }
 
-ss::future<> kvstore::save_snapshot() {
-    vassert(
-      _next_offset >= model::offset(0),
-      "Unexpected next offset {}",
-      _next_offset);
+bool kvstore::needs_compaction() const {
+    // the last segment is the active one
+    if (_segments.size() < 2) {
+        return false;
+    }
+    const auto& [base_offset, oldest] = *_segments.begin();
+    if (
+      base_offset == snapshot_segment || oldest.live_bytes == 0
+      || oldest.written_bytes < _conf.max_segment_size / 2) {
+        // fold snapshots of older versions into the log, drop segments made
+        // of garbage and merge the small segments left behind by restarts
+        return true;
+    }
+    size_t written = 0;
+    size_t live = 0;
+    for (auto it = _segments.begin(); it != std::prev(_segments.end()); ++it) {
+        written += it->second.written_bytes;
+        live += it->second.live_bytes;
+    }
+    return written > max_space_amplification * live;
+}
 
-    // no operations have been applied to the db
-    if (_next_offset == model::offset(0)) {
-        return ss::now();
+ss::future<> kvstore::compact() {
+    return ss::do_until(
+      [this] { return _gate.is_closed() || !needs_compaction(); },
+      [this] { return compact_oldest_segment(); });
+}
+
+ss::future<> kvstore::compact_oldest_segment() {
+    const auto oldest = _segments.begin()->first;
+    const auto active = _segment->offsets().base_offset;
+
+    // rewrite the keys whose latest write is in the oldest segment
+    storage::record_batch_builder builder(kvstore_batch_type, _next_offset);
+    size_t bytes = 0;
+    size_t count = 0;
+    for (auto& [key, e] : _db) {
+        if (e.segment != oldest) {
+            continue;
+        }
+        bytes += key.size() + e.value.size_bytes();
+        ++count;
+        builder.add_raw_kv(
+          bytes_to_iobuf(key),
+          reflection::to_iobuf(
+            std::make_optional(e.value.share(0, e.value.size_bytes()))));
     }
 
     vlog(
       lg.debug,
-      "Creating snapshot at offset {}",
-      _next_offset - model::offset(1));
-
-    // package up the db into a batch
-    storage::record_batch_builder builder(kvstore_batch_type, model::offset(0));
-    for (auto& entry : _db) {
-        builder.add_raw_kv(
-          bytes_to_iobuf(entry.first),
-          entry.second.share(0, entry.second.size_bytes()));
+      "Compacting segment with base offset {}: rewriting {} keys, {} bytes",
+      oldest,
+      count,
+      bytes);
+
+    auto f = ss::now();
+    if (count > 0) {
+        auto batch = std::move(builder).build();
+        auto last_offset = batch.last_offset();
+        f = _segment->append(std::move(batch))
+              .then([this](append_result) { return _segment->flush(); })
+              .then([this, oldest, active, last_offset, bytes] {
+                  // no operation was applied while rewriting since ops are
+                  // applied by this same fiber
+                  for (auto& [key, e] : _db) {
+                      if (e.segment == oldest) {
+                          e.segment = active;
+                      }
+                  }
+                  auto& usage = _segments.at(active);
+                  usage.written_bytes += bytes;
+                  usage.live_bytes += bytes;
+                  _next_offset = last_offset + model::offset(1);
+              });
     }
-    auto batch = std::move(builder).build();
+    return f.then([this, oldest, bytes] {
+        _probe.segment_compacted(bytes);
+        auto usage = std::move(_segments.at(oldest));
+        _segments.erase(oldest);
+        return remove_segment(oldest, std::move(usage));
+    });
+}
 
-    // serialize batch: size_prefix + batch
-    iobuf data;
-    auto ph = data.reserve(sizeof(int32_t));
-    reflection::serialize(data, std::move(batch));
-    auto size = ss::cpu_to_le(int32_t(data.size_bytes() - sizeof(int32_t)));
-    ph.write((const char*)&size, sizeof(size));
-
-    return _snap.start_snapshot().then(
-      [this, data = std::move(data)](snapshot_writer writer) mutable {
-          return ss::do_with(
-            std::move(writer),
-            [this, data = std::move(data)](snapshot_writer& wr) mutable {
-                // the last log offset represented in the snapshot
-                auto last_offset = _next_offset - model::offset(1);
-
-                iobuf meta;
-                reflection::serialize(meta, last_offset);
-
-                return wr.write_metadata(std::move(meta))
-                  .then([&wr, data = std::move(data)]() mutable {
-                      auto& os = wr.output(); // kept alive by do_with above
-                      return write_iobuf_to_output_stream(std::move(data), os);
-                  })
-                  .then([&wr] { return wr.close(); })
-                  .then([this, &wr]() {
-                      vlog(lg.debug, "Finishing snapshot creation");
-                      return _snap.finish_snapshot(wr);
-                  });
-            });
+ss::future<>
+kvstore::remove_segment(model::offset base_offset, segment_usage usage) {
+    if (base_offset == snapshot_segment) {
+        vlog(lg.debug, "Removing snapshot");
+        return _snap.remove_snapshot();
+    }
+    vlog(lg.debug, "Removing old segment with base offset {}", base_offset);
+    return ss::remove_file(usage.data_file)
+      .then([usage = std::move(usage)] {
+          return ss::remove_file(usage.index_file);
       });
 }
 
 ss::future<> kvstore::recover() {
     return ss::async([this] {
+        const auto start = ss::lowres_clock::now();
         /*
          * after loading _next_offset will be set to either zero if no snapshot
          * is found, or the offset immediately following the snapshot offset.
@@ -381,6 +455,17 @@ ss::future<> kvstore::recover() {
                           .get0();
 
         replay_segments_in_thread(std::move(segments));
+
+        _probe.recovery_ms = std::chrono::duration_cast<
+                               std::chrono::milliseconds>(
+                               ss::lowres_clock::now() - start)
+                               .count();
+        vlog(
+          lg.info,
+          "Recovered {} keys from {} segments in {}ms",
+          _db.size(),
+          _segments.size(),
+          _probe.recovery_ms);
     });
 }
 
@@ -440,17 +525,25 @@ void kvstore::load_snapshot_in_thread() {
           batch.header().header_crc));
     }
 
-    batch.for_each_record([this](model::record r) {
+    // the live keys of the snapshot are rewritten to the log and the snapshot
+    // removed by the first compaction
+    auto& usage = _segments[snapshot_segment];
+    batch.for_each_record([this, &usage](model::record r) {
         auto key = iobuf_to_bytes(r.release_key());
-        _probe.add_cached_bytes(key.size() + r.value().size_bytes());
-        auto res = _db.emplace(std::move(key), r.release_value());
+        const auto bytes = key.size() + r.value().size_bytes();
+        _probe.add_cached_bytes(bytes);
+        usage.written_bytes += bytes;
+        usage.live_bytes += bytes;
+        auto res = _db.emplace(
+          std::move(key),
+          entry{.value = r.release_value(), .segment = snapshot_segment});
         vassert(
           res.second, "Snapshot contained duplicate key {}", res.first->first);
         vlog(
           lg.trace,
           "Load snapshot: restoring key={} value={}",
           res.first->first,
-          res.first->second);
+          res.first->second.value);
     });
 
     _next_offset = last_offset + model::offset(1);
@@ -467,6 +560,12 @@ void kvstore::replay_segments_in_thread(segment_set segs) {
         return;
     }
 
+    // without a snapshot the log starts at its oldest segment, the segments
+    // before it were removed by compaction
+    if (!_segments.contains(snapshot_segment)) {
+        _next_offset = segs.front()->offsets().base_offset;
+    }
+
     // find segment that starts at _next_offset
     const auto match = std::find_if(
       segs.begin(), segs.end(), [this](const ss::lw_shared_ptr<segment>& seg) {
@@ -498,9 +597,18 @@ void kvstore::replay_segments_in_thread(segment_set segs) {
           seg->offsets().base_offset,
           _next_offset);
 
+        const auto base_offset = seg->offsets().base_offset;
+        _segments.emplace(
+          base_offset,
+          segment_usage{
+            .data_file = seg->reader().filename(),
+            .index_file = seg->index().filename(),
+          });
+
         auto input = seg->reader().data_stream(0, ss::default_priority_class());
         auto parser = std::make_unique<continuous_batch_parser>(
-          std::make_unique<replay_consumer>(this), std::move(input));
+          std::make_unique<replay_consumer>(this, base_offset),
+          std::move(input));
         auto p = parser.get();
         p->consume()
           .discard_result()
@@ -524,16 +632,18 @@ void kvstore::replay_segments_in_thread(segment_set segs) {
         ss::remove_file(seg->index().filename()).get();
     }
 
-    // close the rest
+    // close the rest, they are compacted like any closed segment. a segment
+    // without batches would clash with the new active segment starting at the
+    // same offset and is removed right away.
     for (auto it = match; it != segs.end(); it++) {
-        (*it)->close().get();
+        auto seg = *it;
+        seg->close().get();
+        if (seg->offsets().base_offset == _next_offset) {
+            auto usage = std::move(_segments.at(_next_offset));
+            _segments.erase(_next_offset);
+            remove_segment(_next_offset, std::move(usage)).get();
+        }
     }
-
-    // saving a snapshot right after recovery during start-up prevents an
-    // accumulation of segments in cases where the system restarts many times
-    // without ever filling up a segment and snapshotting when rolling. they'll
-    // be removed on the next startup.
-    save_snapshot().get();
 }
 
 batch_consumer::consume_result kvstore::replay_consumer::consume_batch_start(
@@ -570,7 +680,7 @@ batch_consumer::stop_parser kvstore::replay_consumer::consume_batch_end() {
         auto key = iobuf_to_bytes(r.release_key());
         auto value = reflection::from_iobuf<std::optional<iobuf>>(
           r.release_value());
-        _store->apply_op(std::move(key), std::move(value));
+        _store->apply_op(std::move(key), std::move(value), _segment);
         _store->_next_offset += model::offset(1);
     });
 
@@ -25,6 +25,7 @@
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/timer.hh>
 
+#include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
 
 namespace storage {
@@ -49,6 +50,20 @@ namespace storage {
  * flushed to disk. Once the flush is complete the operations are applied to the
  * in-memory cache, and the associated promise is resolved.
  *
+ * Compaction
+ * ==========
+ *
+ * The write-ahead log is the only durable copy of the database. Segments are
+ * rolled once they reach the maximum segment size and closed segments are
+ * compacted incrementally, oldest first: the keys whose latest write lives in
+ * the oldest segment are appended to the active segment and the oldest segment
+ * is removed. Only live keys of one segment are rewritten at a time, instead
+ * of the whole database on every roll, and removing the oldest segment first
+ * guarantees that a deletion is never dropped while an older write of its key
+ * is still on disk. The oldest segment is compacted when it holds no live key,
+ * when it is small, or when closed segments hold more than
+ * `max_space_amplification` times the live data.
+ *
  * Concurrency
  * ===========
  *
@@ -63,8 +78,9 @@ namespace storage {
  * Limitations
  * ===========
  *
- * The entire database is cached in memory, so users should not allow the set of
- * uniuqe keys to grow unbounded.  No backpressure is applied, so use
+ * The entire database is cached in memory, values included since reads are
+ * synchronous, so users should not allow the set of uniuqe keys to grow
+ * unbounded. No backpressure is applied, so use
  * responsibly until this utility becomes more sophisticated. The initial set of
  * use cases--tracking raft voted-for and log's base offset--do not pose an
  * issue for either of these limitations since they exhibit a natural bound on
@@ -135,24 +151,56 @@ private:
           , value(std::move(value)) {}
     };
 
+    /*
+     * Value of a key and base offset of the segment holding its latest write.
+     */
+    struct entry {
+        iobuf value;
+        model::offset segment;
+    };
+
+    /*
+     * Key and value bytes written to a segment, and of those the bytes of
+     * keys whose latest write is in the segment.
+     */
+    struct segment_usage {
+        ss::sstring data_file;
+        ss::sstring index_file;
+        size_t written_bytes{0};
+        size_t live_bytes{0};
+    };
+
+    // compact while closed segments hold more than this times live data
+    static constexpr size_t max_space_amplification = 2;
+
+    // location of the keys loaded from a snapshot written by older versions,
+    // their live keys are rewritten to the log by the first compaction
+    static constexpr model::offset snapshot_segment = model::offset::min();
+
     /*
      * database operations are cached in `ops` and periodically flushed to the
      * current `segment` at position `next_offset` and then applied to `db`.
-     * when the segment reaches a threshold size a snapshot is saved a new
-     * segment is created.
+     * when the segment reaches a threshold size a new segment is created and
+     * the oldest segments are compacted.
      */
     std::vector<op> _ops;
     ss::timer<> _timer;
     ss::semaphore _sem{0};
     ss::lw_shared_ptr<segment> _segment;
     model::offset _next_offset;
-    absl::flat_hash_map<bytes, iobuf, bytes_type_hash, bytes_type_eq> _db;
+    absl::flat_hash_map<bytes, entry, bytes_type_hash, bytes_type_eq> _db;
+    // all segments by base offset, the active segment last
+    absl::btree_map<model::offset, segment_usage> _segments;
 
     ss::future<> put(key_space ks, bytes key, std::optional<iobuf> value);
-    void apply_op(bytes key, std::optional<iobuf> value);
+    void apply_op(bytes key, std::optional<iobuf> value, model::offset segment);
     ss::future<> flush_and_apply_ops();
     ss::future<> roll();
-    ss::future<> save_snapshot();
+    ss::future<> open_segment();
+    bool needs_compaction() const;
+    ss::future<> compact();
+    ss::future<> compact_oldest_segment();
+    ss::future<> remove_segment(model::offset, segment_usage);
 
     /*
      * Recovery
@@ -172,8 +220,9 @@ private:
      */
     class replay_consumer final : public batch_consumer {
     public:
-        explicit replay_consumer(kvstore* store)
-          : _store(store) {}
+        replay_consumer(kvstore* store, model::offset segment)
+          : _store(store)
+          , _segment(segment) {}
 
         consume_result consume_batch_start(
           model::record_batch_header header, size_t, size_t) override;
@@ -183,6 +232,7 @@ private:
 
     private:
         kvstore* _store;
+        model::offset _segment;
         model::offset _last_offset;
         model::record_batch_header _header;
         iobuf _records;
@@ -192,6 +242,18 @@ private:
 
     struct probe {
         void roll_segment() { ++segments_rolled; }
+        void segment_compacted(size_t bytes) {
+            ++segments_compacted;
+            compaction_written_bytes += bytes;
+        }
+        void add_written_bytes(size_t count) { written_bytes += count; }
+        double write_amplification() const {
+            if (written_bytes == 0) {
+                return 1;
+            }
+            return double(written_bytes + compaction_written_bytes)
+                   / double(written_bytes);
+        }
         void entry_fetched() { ++entries_fetched; }
         void entry_written() { ++entries_written; }
         void entry_removed() { ++entries_removed; }
@@ -199,6 +261,10 @@ private:
         void dec_cached_bytes(size_t count) { cached_bytes -= count; }
 
         uint64_t segments_rolled{0};
+        uint64_t segments_compacted{0};
+        uint64_t written_bytes{0};
+        uint64_t compaction_written_bytes{0};
+        uint64_t recovery_ms{0};
         uint64_t entries_fetched{0};
         uint64_t entries_written{0};
         uint64_t entries_removed{0};
@@ -24,6 +24,7 @@
 #include <seastar/core/shared_ptr.hh>
 
 #include <utility>
+#include <vector>
 
 namespace storage {
 
@@ -81,6 +82,15 @@ public:
         }
 
         virtual size_t size_bytes() const = 0;
+        // housekeeping work pending for the given node wide defaults, topic
+        // overrides are applied by the log
+        virtual housekeeping_backlog backlog(const compaction_config&) = 0;
+        // closed segments that may be evicted under disk pressure, in offset
+        // order
+        virtual std::vector<reclaimable_segment> reclaimable_segments() const
+          = 0;
+        // evicts the segments ending at or below the offset
+        virtual ss::future<> reclaim(model::offset, ss::abort_source&) = 0;
         virtual ss::future<>
           update_configuration(ntp_config::default_overrides) = 0;
 
@@ -181,6 +191,24 @@ public:
 
     size_t size_bytes() const { return _impl->size_bytes(); }
 
+    housekeeping_backlog backlog(const compaction_config& cfg) {
+        return _impl->backlog(cfg);
+    }
+
+    std::vector<reclaimable_segment> reclaimable_segments() const {
+        return _impl->reclaimable_segments();
+    }
+
+    /**
+     * \brief Evicts the segments ending at or below the offset
+     *
+     * Used to relieve disk pressure. Like retention it never evicts the
+     * active segment nor goes past the collectible offset.
+     */
+    ss::future<> reclaim(model::offset o, ss::abort_source& as) {
+        return _impl->reclaim(o, as);
+    }
+
     impl* get_impl() const { return _impl.get(); }
 
 private:
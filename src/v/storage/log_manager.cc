@@ -31,17 +31,20 @@
 #include "vlog.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/thread.hh>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <filesystem>
@@ -86,60 +89,116 @@ ss::future<> log_manager::stop() {
       .then([this] { return _batch_cache.stop(); });
 }
 
-static inline logs_type::iterator find_next_non_compacted_log(logs_type& logs) {
-    using bflags = log_housekeeping_meta::bitflags;
-    return std::find_if(
-      logs.begin(), logs.end(), [](const logs_type::value_type& l) {
-          return bflags::none == (l.second.flags & bflags::compacted);
+double log_manager::housekeeping_score(
+  const housekeeping_backlog& b,
+  ss::lowres_clock::duration since_last_run,
+  std::chrono::milliseconds interval) {
+    if (b.size_bytes == 0) {
+        return 0;
+    }
+    const auto dirty_ratio = std::min(
+      1.0, static_cast<double>(b.dirty_bytes) / b.size_bytes);
+    const auto backlog = static_cast<double>(b.over_retention_bytes)
+                         + b.dirty_bytes * dirty_ratio;
+
+    double age = max_housekeeping_age;
+    if (interval.count() > 0) {
+        std::chrono::duration<double> waited = since_last_run;
+        std::chrono::duration<double> ival = interval;
+        age = std::min(waited / ival, max_housekeeping_age);
+    }
+    return backlog * (1 + age);
+}
+
+std::vector<log_manager::housekeeping_candidate>
+log_manager::plan_housekeeping(
+  std::vector<housekeeping_candidate> candidates, size_t budget_bytes) {
+    std::stable_sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const housekeeping_candidate& a, const housekeeping_candidate& b) {
+          return a.score > b.score;
       });
+
+    std::vector<housekeeping_candidate> ret;
+    ret.reserve(candidates.size());
+    size_t used = 0;
+    for (auto& c : candidates) {
+        if (
+          c.dirty_bytes == 0 || used == 0
+          || used + c.dirty_bytes <= budget_bytes) {
+            used += c.dirty_bytes;
+            ret.push_back(std::move(c));
+        }
+    }
+    return ret;
 }
 
 ss::future<> log_manager::housekeeping() {
     auto collection_threshold = model::timestamp(
       model::timestamp::now().value() - _config.delete_retention.count());
+    auto cfg = compaction_config(
+      collection_threshold,
+      // TODO: [ch433] - this configuration needs to be updated
+      _config.retention_bytes,
+      _config.compaction_priority,
+      _abort_source);
+
+    auto now = ss::lowres_clock::now();
+    std::vector<housekeeping_candidate> candidates;
+    candidates.reserve(_logs.size());
+    for (auto& [ntp, meta] : _logs) {
+        auto backlog = meta.handle.backlog(cfg);
+        candidates.push_back(housekeeping_candidate{
+          .ntp = ntp,
+          .score = housekeeping_score(
+            backlog, now - meta.last_compaction, _config.compaction_interval),
+          .dirty_bytes = backlog.dirty_bytes,
+        });
+    }
+    const auto total = candidates.size();
+    auto plan = plan_housekeeping(
+      std::move(candidates), _config.housekeeping_budget_bytes);
+    if (plan.size() < total) {
+        vlog(
+          stlog.debug,
+          "Housekeeping {} of {} logs, the rest exceed the budget of {} bytes",
+          plan.size(),
+          total,
+          _config.housekeeping_budget_bytes);
+    }
+
     /**
-     * Note that this loop does a double find - which is not fast. This solution
-     * is the tradeoff to *not* lock the segment during log_manager::remove(ntp)
-     * and to *not* use an ordered container.
+     * Logs are looked up again right before they are compacted rather than
+     * holding on to the handles of the plan. This is the tradeoff to *not*
+     * lock the log during log_manager::remove(ntp): a log removed while the
+     * round is in progress is simply skipped.
      *
-     * The issue with keeping an iterator and effectively doing a iterator++
-     * is that during a concurrent log_manager::remove() we invalidate all the
-     * iterators for the absl::flat_hash_map; - an alternative here would be to
-     * use a lock
-     *
-     * Note that we also do not use an ordered container like an absl::tree-set
-     * because finds are frequent on this datastructure and we want to serve
-     * them as fast as we can since the majority of the time they will be in the
-     * hotpath / (request-response)
+     * The semaphore waiters are served in order, so logs start in plan order.
      */
-    using bflags = log_housekeeping_meta::bitflags;
-    return ss::do_until(
-             [this] {
-                 auto it = find_next_non_compacted_log(_logs);
-                 return it == _logs.end();
-             },
-             [this, collection_threshold] {
-                 auto it = find_next_non_compacted_log(_logs);
-                 if (it == _logs.end()) {
-                     // must check again because between the stop condition
-                     // and this continuation we might have removed the log
-                     return ss::now();
-                 }
-                 it->second.flags |= bflags::compacted;
-                 it->second.last_compaction = ss::lowres_clock::now();
-                 return it->second.handle.compact(compaction_config(
-                   collection_threshold,
-                   // TODO: [ch433] - this configuration needs to be updated
-                   _config.retention_bytes,
-                   _config.compaction_priority,
-                   _abort_source));
-             })
-      .finally([this] {
-          for (auto& h : _logs) {
-              h.second.flags &= ~bflags::compacted;
-          }
+    ss::semaphore sem(std::max<size_t>(_config.housekeeping_concurrency, 1));
+    co_await ss::parallel_for_each(
+      plan, [this, &sem, cfg](const housekeeping_candidate& c) {
+          return ss::with_semaphore(
+            sem, 1, [this, &c, cfg] { return housekeep(c.ntp, cfg); });
       });
 }
+
+ss::future<>
+log_manager::housekeep(const model::ntp& ntp, compaction_config cfg) {
+    if (_abort_source.abort_requested()) {
+        co_return;
+    }
+    auto it = _logs.find(ntp);
+    if (it == _logs.end()) {
+        co_return;
+    }
+    it->second.last_compaction = ss::lowres_clock::now();
+    // copy, the entry may be removed while compacting
+    auto lg = it->second.handle;
+    co_await lg.compact(cfg);
+}
+
 ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
   const ntp_config& ntp,
   model::offset base_offset,
@@ -307,6 +366,56 @@ absl::flat_hash_set<model::ntp> log_manager::get_all_ntps() const {
     return r;
 }
 
+void log_manager::set_uploaded_offset(const model::ntp& ntp, model::offset o) {
+    if (auto it = _logs.find(ntp); it != _logs.end()) {
+        it->second.uploaded_offset = o;
+    }
+}
+
+absl::flat_hash_map<model::ntp, std::vector<reclaimable_segment>>
+log_manager::reclaimable_segments(bool archival_enabled) const {
+    absl::flat_hash_map<model::ntp, std::vector<reclaimable_segment>> r;
+    for (const auto& [ntp, meta] : _logs) {
+        // only the leader archives a log and knows how much of it is
+        // uploaded, until then none of its segments may be evicted
+        if (archival_enabled && !meta.uploaded_offset) {
+            continue;
+        }
+        auto segments = meta.handle.reclaimable_segments();
+        if (meta.uploaded_offset) {
+            auto it = std::find_if(
+              segments.begin(),
+              segments.end(),
+              [o = *meta.uploaded_offset](const reclaimable_segment& s) {
+                  return s.committed_offset > o;
+              });
+            segments.erase(it, segments.end());
+        }
+        if (!segments.empty()) {
+            r.emplace(ntp, std::move(segments));
+        }
+    }
+    return r;
+}
+
+ss::future<>
+log_manager::reclaim(absl::flat_hash_map<model::ntp, model::offset> offsets) {
+    return ss::with_gate(
+      _open_gate, [this, offsets = std::move(offsets)]() mutable {
+          return ss::do_with(std::move(offsets), [this](auto& offsets) {
+              return ss::parallel_for_each(offsets, [this](const auto& e) {
+                  auto it = _logs.find(e.first);
+                  if (it == _logs.end()) {
+                      return ss::now();
+                  }
+                  // copy, the entry may be removed while evicting
+                  auto lg = it->second.handle;
+                  return lg.reclaim(e.second, _abort_source).finally([lg] {});
+              });
+          });
+      });
+}
+
 std::ostream& operator<<(std::ostream& o, log_config::storage_type t) {
     switch (t) {
     case log_config::storage_type::memory:
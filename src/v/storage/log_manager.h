@@ -37,6 +37,7 @@
 #include <array>
 #include <chrono>
 #include <optional>
+#include <vector>
 
 namespace storage {
 
@@ -115,6 +116,10 @@ struct log_config {
     // same as retention.bytes in kafka
     std::optional<size_t> retention_bytes = std::nullopt;
     std::chrono::milliseconds compaction_interval = std::chrono::minutes(10);
+    // number of logs compacted concurrently by a housekeeping round
+    size_t housekeeping_concurrency = 2;
+    // compaction backlog, in bytes, a housekeeping round takes on
+    size_t housekeeping_budget_bytes = 1_GiB;
     // same as delete.retention.ms in kafka - default 1 week
     std::chrono::milliseconds delete_retention = std::chrono::minutes(10080);
     with_cache cache = with_cache::yes;
@@ -160,9 +165,24 @@ struct log_config {
  * where each core manages a distinct set of logs. When the service is
  * shut down, calling `stop` on the log manager will close all of the
  * logs currently being managed.
+ *
+ * Retention and compaction run in periodic housekeeping rounds. Every round
+ * scores the logs by their pending work (see `housekeeping_score`) and
+ * compacts them most urgent first, `housekeeping_concurrency` at a time.
+ * Logs whose compaction backlog does not fit into the round budget are
+ * deferred to the next round, where they score higher.
  */
 class log_manager {
 public:
+    struct housekeeping_candidate {
+        model::ntp ntp;
+        double score;
+        size_t dirty_bytes;
+    };
+
+    // cap on the factor by which waiting raises the score of a log
+    static constexpr double max_housekeeping_age = 10;
+
     explicit log_manager(log_config, kvstore& kvstore) noexcept;
 
     ss::future<log> manage(ntp_config);
@@ -209,6 +229,42 @@ public:
     /// Returns all ntp's managed by this instance
     absl::flat_hash_set<model::ntp> get_all_ntps() const;
 
+    /// Records the last offset of the log uploaded to the archive, segments
+    /// above it are kept when the disk is running out of space.
+    void set_uploaded_offset(const model::ntp&, model::offset);
+
+    /// Returns the segments of every log that may be evicted when the disk is
+    /// running out of space, in offset order. With archival enabled only the
+    /// segments at or below the uploaded offset of a log are returned, none
+    /// when the uploaded offset of the log is unknown.
+    absl::flat_hash_map<model::ntp, std::vector<reclaimable_segment>>
+    reclaimable_segments(bool archival_enabled) const;
+
+    /// Evicts the segments of every log ending at or below the given offset.
+    ss::future<> reclaim(absl::flat_hash_map<model::ntp, model::offset>);
+
+    /**
+     * How urgently a log needs housekeeping. The score is the number of bytes
+     * over the retention limit plus the dirty bytes weighted by the dirty
+     * ratio of the log, so that mostly dirty logs go before large logs with a
+     * small dirty tail. It grows with the time since the log was last
+     * compacted, relative to the compaction interval, so that deferred logs
+     * are not starved.
+     */
+    static double housekeeping_score(
+      const housekeeping_backlog&,
+      ss::lowres_clock::duration since_last_run,
+      std::chrono::milliseconds interval);
+
+    /**
+     * Orders the candidates by decreasing score and drops the ones whose
+     * dirty bytes no longer fit into `budget_bytes`. Logs with no dirty bytes
+     * are cheap and always kept, as is the first log with dirty bytes even
+     * when it is larger than the budget.
+     */
+    static std::vector<housekeeping_candidate> plan_housekeeping(
+      std::vector<housekeeping_candidate>, size_t budget_bytes);
+
 private:
     using logs_type = absl::flat_hash_map<model::ntp, log_housekeeping_meta>;
 
@@ -221,6 +277,7 @@ private:
     void trigger_housekeeping();
     void arm_housekeeping();
     ss::future<> housekeeping();
+    ss::future<> housekeep(const model::ntp&, compaction_config);
 
     std::optional<batch_cache_index> create_cache(with_cache);
 
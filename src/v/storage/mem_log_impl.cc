@@ -381,6 +381,18 @@ struct mem_log_impl final : log::impl {
           });
     }
 
+    housekeeping_backlog backlog(const compaction_config&) final {
+        return housekeeping_backlog{.size_bytes = size_bytes()};
+    }
+
+    std::vector<reclaimable_segment> reclaimable_segments() const final {
+        return {};
+    }
+
+    ss::future<> reclaim(model::offset, ss::abort_source&) final {
+        return ss::now();
+    }
+
     struct eviction_monitor {
         ss::promise<model::offset> promise;
         ss::abort_source::subscription subscription;
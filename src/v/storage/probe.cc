@@ -105,6 +105,18 @@ void probe::setup_metrics(const model::ntp& ntp) {
           [this] { return _partition_bytes; },
           sm::description("Current size of partition in bytes"),
           labels),
+        sm::make_gauge(
+          "retention_backlog_bytes",
+          [this] { return _over_retention_bytes; },
+          sm::description("Bytes above the retention limit of the partition, "
+                          "as of the last housekeeping round"),
+          labels),
+        sm::make_gauge(
+          "compaction_backlog_bytes",
+          [this] { return _dirty_bytes; },
+          sm::description("Bytes of segments waiting to be compacted, as of "
+                          "the last housekeeping round"),
+          labels),
       });
 }
 
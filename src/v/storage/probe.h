@@ -68,11 +68,19 @@ public:
     void add_initial_segment(const segment&);
     void remove_partition_bytes(size_t remove) { _partition_bytes -= remove; }
 
+    void set_housekeeping_backlog(size_t over_retention, size_t dirty) {
+        _over_retention_bytes = over_retention;
+        _dirty_bytes = dirty;
+    }
+
 private:
     uint64_t _partition_bytes = 0;
     uint64_t _bytes_written = 0;
     uint64_t _bytes_read = 0;
     uint64_t _cached_bytes_read = 0;
+    // housekeeping backlog as of the last housekeeping round
+    uint64_t _over_retention_bytes = 0;
+    uint64_t _dirty_bytes = 0;
 
     uint64_t _batches_written = 0;
     uint64_t _batches_read = 0;
@@ -34,14 +34,27 @@ struct segment_ordering {
     bool operator()(const type& seg, model::offset value) const {
         return seg->offsets().dirty_offset < value;
     }
-    bool operator()(const type& seg, model::timestamp value) const {
-        return seg->index().max_timestamp() < value;
-    }
 };
 
+static segment_timestamp_index::entry timestamps(const segment& s) {
+    return segment_timestamp_index::entry{
+      .base_offset = s.offsets().base_offset,
+      .base_timestamp = s.index().base_timestamp(),
+      .max_timestamp = s.index().max_timestamp(),
+    };
+}
+
 segment_set::segment_set(segment_set::underlying_t segs)
   : _handles(std::move(segs)) {
     std::sort(_handles.begin(), _handles.end(), segment_ordering{});
+    refresh_timestamps();
+}
+
+void segment_set::refresh_timestamps() {
+    _timestamps.clear();
+    for (size_t i = 0; i + 1 < _handles.size(); ++i) {
+        _timestamps.push_back(timestamps(*_handles[i]));
+    }
 }
 
 void segment_set::add(ss::lw_shared_ptr<segment> h) {
@@ -54,14 +67,29 @@ void segment_set::add(ss::lw_shared_ptr<segment> h) {
           _handles.back()->offsets().dirty_offset,
           *h,
           *this);
+        // no more appends to the current last segment
+        _timestamps.push_back(timestamps(*_handles.back()));
     }
     _handles.emplace_back(std::move(h));
 }
 
-void segment_set::pop_back() { _handles.pop_back(); }
-void segment_set::pop_front() { _handles.pop_front(); }
+void segment_set::pop_back() {
+    _handles.pop_back();
+    if (!_timestamps.empty()) {
+        _timestamps.pop_back();
+    }
+}
+
+void segment_set::pop_front() {
+    _handles.pop_front();
+    if (!_timestamps.empty()) {
+        _timestamps.pop_front();
+    }
+}
+
 void segment_set::erase(iterator begin, iterator end) {
     _handles.erase(begin, end);
+    refresh_timestamps();
 }
 
 template<typename Iterator>
@@ -74,16 +102,6 @@ struct needle_in_range {
         // must use max_offset
         return o <= s.offsets().dirty_offset && o >= s.offsets().base_offset;
     }
-
-    bool operator()(Iterator ptr, model::timestamp t) {
-        auto& s = **ptr;
-        if (s.empty()) {
-            return false;
-        }
-        // must use max_offset
-        return t <= s.index().max_timestamp()
-               && t >= s.index().base_timestamp();
-    }
 };
 
 template<typename Iterator, typename Needle>
@@ -130,15 +148,30 @@ segment_set::lower_bound(model::offset offset) const {
 // entry is greater than the target timestamp, the broker will do binary search
 // on that time index to find the closest index entry and scan the log from
 // there. Otherwise it will move on to the next log segment.
+//
+// Rather than visiting the segments one at a time the first segment whose max
+// timestamp is at or after the target is found with a binary search of the
+// timestamp index.
+size_t segment_set::timestamp_lower_bound(model::timestamp needle) const {
+    auto i = _timestamps.lower_bound(needle);
+    if (i < _timestamps.size()) {
+        return i;
+    }
+    if (
+      !_handles.empty()
+      && _handles.back()->index().max_timestamp() >= needle) {
+        return _handles.size() - 1;
+    }
+    return _handles.size();
+}
+
 segment_set::iterator segment_set::lower_bound(model::timestamp needle) {
-    return std::lower_bound(
-      std::begin(_handles), std::end(_handles), needle, segment_ordering{});
+    return std::next(_handles.begin(), timestamp_lower_bound(needle));
 }
 
 segment_set::const_iterator
 segment_set::lower_bound(model::timestamp needle) const {
-    return segments_lower_bound(
-      std::cbegin(_handles), std::cend(_handles), needle);
+    return std::next(_handles.cbegin(), timestamp_lower_bound(needle));
 }
 
 std::ostream& operator<<(std::ostream& o, const segment_set& s) {
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "storage/segment.h"
+#include "storage/segment_timestamp_index.h"
 
 #include <seastar/core/circular_buffer.hh>
 
@@ -71,9 +72,15 @@ public:
 
     iterator lower_bound(model::offset o);
     const_iterator lower_bound(model::offset o) const;
+    /// first segment whose max timestamp is at or after `o`, timestamps need
+    /// not be monotonic across segments
     iterator lower_bound(model::timestamp o);
     const_iterator lower_bound(model::timestamp o) const;
 
+    /// rebuilds the timestamp index after the timestamps of segments other
+    /// than the last one changed, e.g. by compaction
+    void refresh_timestamps();
+
     const_iterator cbegin() const { return _handles.cbegin(); }
     const_iterator cend() const { return _handles.cend(); }
     iterator begin() { return _handles.begin(); }
@@ -82,7 +89,12 @@ public:
     const_iterator end() const { return _handles.end(); }
 
 private:
+    size_t timestamp_lower_bound(model::timestamp) const;
+
     underlying_t _handles;
+    // timestamps of all the segments but the last one, which may still be
+    // appended to and is looked up directly
+    segment_timestamp_index _timestamps;
 
     friend std::ostream& operator<<(std::ostream&, const segment_set&);
 };
@@ -0,0 +1,78 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/segment_timestamp_index.h"
+
+#include "vassert.h"
+
+#include <algorithm>
+
+namespace storage {
+
+void segment_timestamp_index::push_back(entry e) {
+    if (!_base_offsets.empty()) {
+        vassert(
+          _base_offsets.back() < e.base_offset,
+          "segments must be added in offset order, last: {}, added: {}",
+          _base_offsets.back(),
+          e.base_offset);
+    }
+    auto running_max = _running_max.empty()
+                         ? e.max_timestamp
+                         : std::max(_running_max.back(), e.max_timestamp);
+    _base_offsets.push_back(e.base_offset);
+    _base_timestamps.push_back(e.base_timestamp);
+    _max_timestamps.push_back(e.max_timestamp);
+    _running_max.push_back(running_max);
+}
+
+void segment_timestamp_index::pop_back() {
+    _base_offsets.pop_back();
+    _base_timestamps.pop_back();
+    _max_timestamps.pop_back();
+    _running_max.pop_back();
+}
+
+void segment_timestamp_index::pop_front() {
+    _base_offsets.pop_front();
+    _base_timestamps.pop_front();
+    _max_timestamps.pop_front();
+    rebuild_running_max();
+}
+
+void segment_timestamp_index::clear() {
+    _base_offsets.clear();
+    _base_timestamps.clear();
+    _max_timestamps.clear();
+    _running_max.clear();
+}
+
+size_t segment_timestamp_index::lower_bound(model::timestamp t) const {
+    auto it = std::lower_bound(_running_max.begin(), _running_max.end(), t);
+    return std::distance(_running_max.begin(), it);
+}
+
+segment_timestamp_index::entry
+segment_timestamp_index::operator[](size_t i) const {
+    return entry{
+      .base_offset = _base_offsets[i],
+      .base_timestamp = _base_timestamps[i],
+      .max_timestamp = _max_timestamps[i],
+    };
+}
+
+void segment_timestamp_index::rebuild_running_max() {
+    _running_max.clear();
+    for (auto t : _max_timestamps) {
+        _running_max.push_back(
+          _running_max.empty() ? t : std::max(_running_max.back(), t));
+    }
+}
+
+} // namespace storage
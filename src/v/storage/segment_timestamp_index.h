@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+
+#include <deque>
+
+namespace storage {
+
+/**
+ * Timestamps of the segments of a log, in offset order, used to find the
+ * segment a time query starts at without visiting every segment.
+ *
+ * Timestamps are set by the producers and need not grow with the offsets,
+ * so the max timestamps of the segments can not be binary searched. Their
+ * running maximum can: the first segment whose max timestamp is at or after
+ * `t` is also the first one whose running maximum is. Every column is kept
+ * in a container of its own, so a lookup only touches the running maxima.
+ *
+ * Appending and removing the last segment are O(1). Removing segments from
+ * the front changes the running maxima of all the remaining ones and
+ * rebuilds them, which is O(n) but only happens on retention and
+ * compaction.
+ */
+class segment_timestamp_index {
+public:
+    struct entry {
+        model::offset base_offset;
+        model::timestamp base_timestamp;
+        model::timestamp max_timestamp;
+    };
+
+    void push_back(entry);
+    void pop_back();
+    void pop_front();
+    void clear();
+
+    /// position of the first segment whose max timestamp is at or after `t`,
+    /// size() if there is none
+    size_t lower_bound(model::timestamp t) const;
+
+    entry operator[](size_t i) const;
+    size_t size() const { return _base_offsets.size(); }
+    bool empty() const { return _base_offsets.empty(); }
+
+private:
+    void rebuild_running_max();
+
+    std::deque<model::offset> _base_offsets;
+    std::deque<model::timestamp> _base_timestamps;
+    std::deque<model::timestamp> _max_timestamps;
+    // running maximum of _max_timestamps, non decreasing
+    std::deque<model::timestamp> _running_max;
+};
+
+} // namespace storage
@@ -10,6 +10,7 @@
 #include "storage/segment_utils.h"
 
 #include "bytes/iobuf_parser.h"
+#include "config/configuration.h"
 #include "likely.h"
 #include "model/adl_serde.h"
 #include "model/fundamental.h"
@@ -166,6 +167,10 @@ size_t number_of_chunks_from_config(const ntp_config& ntpc) {
 ss::future<Roaring>
 natural_index_of_entries_to_keep(compacted_index_reader reader) {
     reader.reset();
+    if (config::shard_local_cfg().compaction_key_fingerprints()) {
+        return reader.consume(
+          compaction_fingerprint_reducer(), model::no_timeout);
+    }
     return reader.consume(compaction_key_reducer(), model::no_timeout);
 }
 
@@ -11,15 +11,19 @@
 #include "random/generators.h"
 #include "storage/compacted_index.h"
 #include "storage/compaction_reducers.h"
+#include "units.h"
 
 #include <seastar/core/loop.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/testing/perf_tests.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <absl/container/node_hash_map.h>
+#include <fmt/core.h>
 
 #include <unordered_map>
+#include <vector>
 
 struct reducer_bench {
     storage::internal::compaction_key_reducer reducer;
@@ -37,3 +41,80 @@ PERF_TEST_F(reducer_bench, compaction_key_reducer_test) {
         perf_tests::stop_measuring_time();
     });
 }
+
+// self compaction of a segment of a topic with many distinct keys, every
+// key is written twice. Full keys compared to key fingerprints, once with
+// enough memory for all the keys and once with the default memory limit.
+struct high_cardinality {
+    static constexpr size_t distinct_keys = 200'000;
+    static constexpr size_t key_size = 32;
+
+    high_cardinality() {
+        keys.reserve(distinct_keys);
+        for (size_t i = 0; i < distinct_keys; ++i) {
+            keys.push_back(random_generators::get_bytes(key_size));
+        }
+    }
+
+    std::vector<storage::compacted_index::entry> entries() const {
+        std::vector<storage::compacted_index::entry> ret;
+        ret.reserve(2 * keys.size());
+        for (size_t i = 0; i < 2 * keys.size(); ++i) {
+            ret.emplace_back(
+              storage::compacted_index::entry_type::key,
+              bytes(keys[i % keys.size()]),
+              model::offset(i),
+              0);
+        }
+        return ret;
+    }
+
+    template<typename Reducer>
+    size_t reduce(Reducer reducer, const char* name) {
+        auto input = entries();
+        perf_tests::start_measuring_time();
+        for (auto& e : input) {
+            reducer(std::move(e)).get();
+        }
+        auto memory = reducer.memory_usage();
+        auto kept = reducer.end_of_stream();
+        perf_tests::stop_measuring_time();
+        if (!reported.contains(name)) {
+            // the memory of the reducer is the same on every run
+            reported.insert(name);
+            fmt::print(
+              "{}: {} bytes ({} per key), {} entries kept\n",
+              name,
+              memory,
+              memory / distinct_keys,
+              kept.cardinality());
+        }
+        return input.size();
+    }
+
+    std::vector<bytes> keys;
+    absl::flat_hash_set<ss::sstring> reported;
+};
+
+PERF_TEST_F(high_cardinality, key_reducer_unbounded) {
+    return reduce(
+      storage::internal::compaction_key_reducer(1_GiB),
+      "key_reducer_unbounded");
+}
+
+PERF_TEST_F(high_cardinality, fingerprint_reducer_unbounded) {
+    return reduce(
+      storage::internal::compaction_fingerprint_reducer(1_GiB),
+      "fingerprint_reducer_unbounded");
+}
+
+PERF_TEST_F(high_cardinality, key_reducer_default_memory) {
+    return reduce(
+      storage::internal::compaction_key_reducer(), "key_reducer_default");
+}
+
+PERF_TEST_F(high_cardinality, fingerprint_reducer_default_memory) {
+    return reduce(
+      storage::internal::compaction_fingerprint_reducer(),
+      "fingerprint_reducer_default");
+}
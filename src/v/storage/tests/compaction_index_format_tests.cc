@@ -15,6 +15,7 @@
 #include "storage/compacted_index_reader.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/compaction_reducers.h"
+#include "storage/fingerprint_key_map.h"
 #include "storage/segment_utils.h"
 #include "storage/spill_key_index.h"
 #include "test_utils/fixture.h"
@@ -22,6 +23,7 @@
 #include "utils/tmpbuf_file.h"
 #include "utils/vint.h"
 
+#include <absl/container/flat_hash_set.h>
 #include <boost/test/unit_test_suite.hpp>
 
 struct compacted_topic_fixture {};
@@ -262,6 +264,122 @@ FIXTURE_TEST(key_reducer_max_mem, compacted_topic_fixture) {
     BOOST_REQUIRE(exact_mem_bitmap.contains(98));
     BOOST_REQUIRE(exact_mem_bitmap.contains(99));
 }
+static Roaring reduce_with_keys(storage::compacted_index_reader rdr) {
+    rdr.reset();
+    return rdr
+      .consume(
+        storage::internal::compaction_key_reducer(1_GiB), model::no_timeout)
+      .get0();
+}
+
+static Roaring reduce_with_fingerprints(
+  storage::compacted_index_reader rdr, size_t max_mem = 1_GiB) {
+    rdr.reset();
+    return rdr
+      .consume(
+        storage::internal::compaction_fingerprint_reducer(max_mem),
+        model::no_timeout)
+      .get0();
+}
+
+FIXTURE_TEST(fingerprint_reducer_matches_key_reducer, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      // spill every key, so that the index has all the duplicates
+      1);
+
+    std::vector<bytes> keys;
+    for (auto i = 0; i < 500; ++i) {
+        keys.push_back(random_generators::get_bytes(
+          random_generators::get_int<size_t>(1, 100)));
+    }
+    for (auto i = 0; i < 5000; ++i) {
+        const auto& k = keys[random_generators::get_int<size_t>(
+          0, keys.size() - 1)];
+        idx.index(bytes_view(k), model::offset(i), 0).get();
+    }
+    idx.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    auto expected = reduce_with_keys(rdr);
+    auto result = reduce_with_fingerprints(rdr);
+    info("key bitmap cardinality: {}", expected.cardinality());
+    BOOST_REQUIRE(expected == result);
+}
+
+FIXTURE_TEST(fingerprint_reducer_max_mem, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      // spill every key, so that the index has all the duplicates
+      1);
+
+    // every key is written twice, 100 distinct keys
+    std::vector<bytes> keys;
+    for (auto i = 0; i < 100; ++i) {
+        keys.push_back(random_generators::get_bytes(16));
+    }
+    for (auto i = 0; i < 200; ++i) {
+        idx.index(bytes_view(keys[i % 100]), model::offset(i), 0).get();
+    }
+    idx.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    auto exact = reduce_with_keys(rdr);
+    // room for a handful of keys only
+    auto small = reduce_with_fingerprints(rdr, 0);
+
+    // evicted keys are kept, never dropped
+    BOOST_REQUIRE_LE(exact.cardinality(), small.cardinality());
+    BOOST_REQUIRE(exact.isSubset(small));
+}
+
+FIXTURE_TEST(fingerprint_map_eviction, compacted_topic_fixture) {
+    using map_t = storage::internal::fingerprint_key_map;
+    map_t map(1000 * sizeof(map_t::entry));
+    std::vector<map_t::fingerprint> fps;
+    for (uint32_t i = 0; !map.full(); ++i) {
+        auto k = random_generators::get_bytes(16);
+        auto fp = map_t::make_fingerprint(k);
+        BOOST_REQUIRE(map.find(fp) == nullptr);
+        map.insert(fp, model::offset(i), i);
+        fps.push_back(fp);
+    }
+    BOOST_REQUIRE_EQUAL(map.size(), fps.size());
+    BOOST_REQUIRE_LE(map.memory_usage(), 1000 * sizeof(map_t::entry));
+
+    absl::flat_hash_set<uint32_t> evicted;
+    for (auto i = 0; i < 300; ++i) {
+        evicted.insert(map.evict().natural_index);
+    }
+    BOOST_REQUIRE_EQUAL(evicted.size(), 300);
+    BOOST_REQUIRE_EQUAL(map.size(), fps.size() - 300);
+    // the entries left are still found after the backward shifts
+    for (uint32_t i = 0; i < fps.size(); ++i) {
+        auto e = map.find(fps[i]);
+        if (evicted.contains(i)) {
+            BOOST_REQUIRE(e == nullptr);
+        } else {
+            BOOST_REQUIRE(e != nullptr);
+            BOOST_REQUIRE_EQUAL(e->natural_index, i);
+            BOOST_REQUIRE_EQUAL(e->offset, model::offset(i));
+        }
+    }
+}
+
 FIXTURE_TEST(index_filtered_copy_tests, compacted_topic_fixture) {
     tmpbuf_file::store_t index_data;
 
@@ -0,0 +1,110 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE storage
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+#include "storage/disk_space_manager.h"
+#include "storage/types.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using dsm = storage::disk_space_manager;
+
+static const auto now = model::timestamp(1000);
+
+/*
+ * segments of 100 bytes, each spanning 10 offsets, with the given max
+ * timestamps
+ */
+static dsm::log_segments
+make_log(int p, ss::shard_id shard, std::vector<int64_t> timestamps) {
+    dsm::log_segments ret{
+      .ntp = model::ntp(
+        model::kafka_namespace, model::topic("t"), model::partition_id(p)),
+      .shard = shard,
+    };
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        ret.segments.push_back(storage::reclaimable_segment{
+          .committed_offset = model::offset(i * 10 + 9),
+          .max_timestamp = model::timestamp(timestamps[i]),
+          .size_bytes = 100,
+        });
+    }
+    return ret;
+}
+
+static const dsm::eviction*
+find(const std::vector<dsm::eviction>& plan, int p) {
+    for (const auto& e : plan) {
+        if (e.ntp.tp.partition() == p) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+BOOST_AUTO_TEST_CASE(nothing_to_free) {
+    std::vector<dsm::log_segments> logs;
+    logs.push_back(make_log(0, 0, {1, 2, 3}));
+    BOOST_REQUIRE(dsm::plan(std::move(logs), 0, now).empty());
+    BOOST_REQUIRE(dsm::plan({}, 1000, now).empty());
+}
+
+BOOST_AUTO_TEST_CASE(oldest_segments_across_logs_go_first) {
+    std::vector<dsm::log_segments> logs;
+    logs.push_back(make_log(0, 0, {10, 40, 50}));
+    logs.push_back(make_log(1, 1, {20, 30, 60}));
+    auto plan = dsm::plan(std::move(logs), 350, now);
+
+    // 10, 20, 30, 40 are evicted
+    auto p0 = find(plan, 0);
+    auto p1 = find(plan, 1);
+    BOOST_REQUIRE(p0 && p1);
+    BOOST_REQUIRE_EQUAL(p0->offset, model::offset(19));
+    BOOST_REQUIRE_EQUAL(p0->segments, 2);
+    BOOST_REQUIRE_EQUAL(p0->size_bytes, 200);
+    BOOST_REQUIRE_EQUAL(p1->offset, model::offset(19));
+    BOOST_REQUIRE_EQUAL(p1->shard, 1);
+    BOOST_REQUIRE_EQUAL(p1->segments, 2);
+}
+
+BOOST_AUTO_TEST_CASE(segments_of_a_log_are_evicted_in_offset_order) {
+    // the second segment of partition 0 is older than anything else but can
+    // not go before the first one
+    std::vector<dsm::log_segments> logs;
+    logs.push_back(make_log(0, 0, {50, 1}));
+    logs.push_back(make_log(1, 0, {20, 30}));
+    auto plan = dsm::plan(std::move(logs), 100, now);
+    BOOST_REQUIRE_EQUAL(plan.size(), 1);
+    BOOST_REQUIRE_EQUAL(plan[0].ntp.tp.partition(), 1);
+    BOOST_REQUIRE_EQUAL(plan[0].offset, model::offset(9));
+}
+
+BOOST_AUTO_TEST_CASE(future_timestamps_do_not_pin_segments) {
+    // a segment with a bogus timestamp is evicted like the most recent data
+    std::vector<dsm::log_segments> logs;
+    logs.push_back(make_log(0, 0, {now.value() * 1000}));
+    logs.push_back(make_log(1, 0, {now.value() - 1}));
+    auto plan = dsm::plan(std::move(logs), 200, now);
+    BOOST_REQUIRE_EQUAL(plan.size(), 2);
+    BOOST_REQUIRE_EQUAL(plan[0].ntp.tp.partition(), 1);
+    BOOST_REQUIRE_EQUAL(plan[1].ntp.tp.partition(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(plan_stops_when_out_of_segments) {
+    std::vector<dsm::log_segments> logs;
+    logs.push_back(make_log(0, 0, {1, 2}));
+    auto plan = dsm::plan(std::move(logs), 1000, now);
+    BOOST_REQUIRE_EQUAL(plan.size(), 1);
+    BOOST_REQUIRE_EQUAL(plan[0].segments, 2);
+    BOOST_REQUIRE_EQUAL(plan[0].offset, model::offset(19));
+}
@@ -0,0 +1,109 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE storage
+#include "model/fundamental.h"
+#include "storage/log_manager.h"
+#include "storage/types.h"
+#include "units.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <vector>
+
+using lm = storage::log_manager;
+using namespace std::chrono_literals;
+
+static constexpr auto interval = std::chrono::milliseconds(10min);
+
+static lm::housekeeping_candidate
+candidate(int p, double score, size_t dirty) {
+    return lm::housekeeping_candidate{
+      .ntp = model::ntp(
+        model::kafka_namespace, model::topic("t"), model::partition_id(p)),
+      .score = score,
+      .dirty_bytes = dirty,
+    };
+}
+
+static std::vector<int>
+partitions(const std::vector<lm::housekeeping_candidate>& plan) {
+    std::vector<int> ret;
+    for (const auto& c : plan) {
+        ret.push_back(c.ntp.tp.partition());
+    }
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE(logs_without_backlog_score_zero) {
+    auto b = storage::housekeeping_backlog{.size_bytes = 100_MiB};
+    BOOST_REQUIRE_EQUAL(lm::housekeeping_score(b, 1h, interval), 0);
+    BOOST_REQUIRE_EQUAL(
+      lm::housekeeping_score(storage::housekeeping_backlog{}, 1h, interval),
+      0);
+}
+
+BOOST_AUTO_TEST_CASE(mostly_dirty_logs_go_first) {
+    // same amount of dirty bytes, the small log is mostly dirty
+    auto small = storage::housekeeping_backlog{
+      .size_bytes = 20_MiB, .dirty_bytes = 10_MiB};
+    auto large = storage::housekeeping_backlog{
+      .size_bytes = 1_GiB, .dirty_bytes = 10_MiB};
+    BOOST_REQUIRE_GT(
+      lm::housekeeping_score(small, 0s, interval),
+      lm::housekeeping_score(large, 0s, interval));
+}
+
+BOOST_AUTO_TEST_CASE(bytes_over_retention_count_fully) {
+    auto over = storage::housekeeping_backlog{
+      .size_bytes = 1_GiB, .over_retention_bytes = 10_MiB};
+    auto dirty = storage::housekeeping_backlog{
+      .size_bytes = 1_GiB, .dirty_bytes = 10_MiB};
+    BOOST_REQUIRE_GT(
+      lm::housekeeping_score(over, 0s, interval),
+      lm::housekeeping_score(dirty, 0s, interval));
+}
+
+BOOST_AUTO_TEST_CASE(waiting_raises_the_score_up_to_a_cap) {
+    auto b = storage::housekeeping_backlog{
+      .size_bytes = 1_GiB, .over_retention_bytes = 10_MiB};
+    auto fresh = lm::housekeeping_score(b, 0s, interval);
+    auto waited = lm::housekeeping_score(b, interval, interval);
+    BOOST_REQUIRE_EQUAL(waited, 2 * fresh);
+
+    auto capped = lm::housekeeping_score(b, 1000 * interval, interval);
+    BOOST_REQUIRE_EQUAL(capped, fresh * (1 + lm::max_housekeeping_age));
+}
+
+BOOST_AUTO_TEST_CASE(plan_is_ordered_by_score) {
+    auto plan = lm::plan_housekeeping(
+      {candidate(0, 1, 0), candidate(1, 3, 0), candidate(2, 2, 0)}, 0);
+    BOOST_REQUIRE(partitions(plan) == std::vector<int>({1, 2, 0}));
+}
+
+BOOST_AUTO_TEST_CASE(plan_defers_logs_over_the_budget) {
+    auto plan = lm::plan_housekeeping(
+      {
+        candidate(0, 4, 60_MiB),
+        candidate(1, 3, 60_MiB),
+        candidate(2, 2, 40_MiB),
+        candidate(3, 1, 0),
+      },
+      100_MiB);
+    // partition 1 does not fit after partition 0, partition 2 still does and
+    // logs without compaction backlog always run
+    BOOST_REQUIRE(partitions(plan) == std::vector<int>({0, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(plan_always_takes_the_most_urgent_log) {
+    auto plan = lm::plan_housekeeping(
+      {candidate(0, 2, 0), candidate(1, 1, 1_GiB)}, 100_MiB);
+    BOOST_REQUIRE(partitions(plan) == std::vector<int>({0, 1}));
+}
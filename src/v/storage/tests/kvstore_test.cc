@@ -14,6 +14,8 @@
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <filesystem>
+
 template<typename T>
 static void set_configuration(ss::sstring p_name, T v) {
     ss::smp::invoke_on_all([p_name, v = std::move(v)] {
@@ -205,3 +207,68 @@ SEASTAR_THREAD_TEST_CASE(kvstore) {
     }
     kvs->stop().get();
 }
+
+static size_t count_segments(const ss::sstring& dir) {
+    size_t ret = 0;
+    for (const auto& e :
+         std::filesystem::recursive_directory_iterator(dir.c_str())) {
+        if (e.path().extension() == ".log") {
+            ++ret;
+        }
+    }
+    return ret;
+}
+
+SEASTAR_THREAD_TEST_CASE(kvstore_compaction) {
+    set_configuration("disable_metrics", true);
+
+    auto dir = ssx::sformat(
+      "kvstore_test_{}", random_generators::get_int(4000));
+
+    auto conf = get_conf(dir);
+
+    std::unordered_map<bytes, iobuf> truth;
+    std::vector<bytes> keys;
+    for (int i = 0; i < 20; i++) {
+        keys.push_back(random_generators::get_bytes(8));
+    }
+
+    // overwrite a few keys many times, rolling many segments
+    auto kvs = std::make_unique<storage::kvstore>(conf);
+    kvs->start().get();
+    for (int i = 0; i < 2000; i++) {
+        const auto& key = keys[i % keys.size()];
+        auto value = bytes_to_iobuf(random_generators::get_bytes(100));
+        truth[key] = value.copy();
+        kvs->put(storage::kvstore::key_space::testing, key, std::move(value))
+          .get();
+    }
+
+    // delete half of the keys, their older writes were compacted away or are
+    // in segments older than the deletion
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        truth.erase(keys[i]);
+        kvs->remove(storage::kvstore::key_space::testing, keys[i]).get();
+    }
+    kvs->stop().get();
+
+    // about 250KiB were written to 8KiB segments, compaction keeps only a few
+    // of them around
+    BOOST_REQUIRE_LE(count_segments(dir), 5);
+
+    // restart a few times, each restart leaves a small segment behind
+    for (int i = 0; i < 3; i++) {
+        kvs = std::make_unique<storage::kvstore>(conf);
+        kvs->start().get();
+        for (const auto& key : keys) {
+            auto value = kvs->get(storage::kvstore::key_space::testing, key);
+            if (auto it = truth.find(key); it != truth.end()) {
+                BOOST_REQUIRE(value == it->second);
+            } else {
+                BOOST_REQUIRE(!value);
+            }
+        }
+        kvs->stop().get();
+    }
+    BOOST_REQUIRE_LE(count_segments(dir), 5);
+}
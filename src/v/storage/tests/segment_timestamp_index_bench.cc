@@ -0,0 +1,81 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+#include "storage/segment_timestamp_index.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <random>
+#include <vector>
+
+// time queries on a log of 1000 segments whose timestamps mostly grow with
+// the offsets but jitter between segments, the timestamp index compared to
+// visiting the segments in order
+struct segment_timestamps {
+    static constexpr size_t segments = 1'000;
+    static constexpr size_t queries = 1'000;
+    // timestamps of a segment span about an hour
+    static constexpr int64_t span = 3'600'000;
+
+    segment_timestamps() {
+        std::uniform_int_distribution<int64_t> jitter(-span, span);
+        for (size_t i = 0; i < segments; ++i) {
+            auto max = int64_t(i + 1) * span + jitter(rng);
+            auto e = storage::segment_timestamp_index::entry{
+              .base_offset = model::offset(i * 100'000),
+              .base_timestamp = model::timestamp(max - span),
+              .max_timestamp = model::timestamp(max),
+            };
+            entries.push_back(e);
+            index.push_back(e);
+        }
+    }
+
+    std::vector<model::timestamp> query_timestamps() {
+        std::uniform_int_distribution<int64_t> dist(0, segments * span);
+        std::vector<model::timestamp> ret;
+        for (size_t i = 0; i < queries; ++i) {
+            ret.emplace_back(dist(rng));
+        }
+        return ret;
+    }
+
+    size_t scan() {
+        auto ts = query_timestamps();
+        perf_tests::start_measuring_time();
+        for (auto t : ts) {
+            size_t i = 0;
+            while (i < entries.size() && entries[i].max_timestamp < t) {
+                ++i;
+            }
+            perf_tests::do_not_optimize(i);
+        }
+        perf_tests::stop_measuring_time();
+        return queries;
+    }
+
+    size_t lookup() {
+        auto ts = query_timestamps();
+        perf_tests::start_measuring_time();
+        for (auto t : ts) {
+            perf_tests::do_not_optimize(index.lower_bound(t));
+        }
+        perf_tests::stop_measuring_time();
+        return queries;
+    }
+
+    std::mt19937 rng{7};
+    std::vector<storage::segment_timestamp_index::entry> entries;
+    storage::segment_timestamp_index index;
+};
+
+PERF_TEST_F(segment_timestamps, scan) { return scan(); }
+PERF_TEST_F(segment_timestamps, index) { return lookup(); }
@@ -0,0 +1,100 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE storage
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+#include "storage/segment_timestamp_index.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+using storage::segment_timestamp_index;
+
+static segment_timestamp_index::entry make_entry(int64_t base, int64_t max) {
+    return segment_timestamp_index::entry{
+      .base_offset = model::offset(base),
+      .base_timestamp = model::timestamp(max - 10),
+      .max_timestamp = model::timestamp(max),
+    };
+}
+
+// position of the first entry whose max timestamp is at or after `t`
+static size_t
+scan(const std::deque<segment_timestamp_index::entry>& entries, int64_t t) {
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].max_timestamp() >= t) {
+            return i;
+        }
+    }
+    return entries.size();
+}
+
+BOOST_AUTO_TEST_CASE(empty_index) {
+    segment_timestamp_index idx;
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(0)), 0);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_order_max_timestamps) {
+    segment_timestamp_index idx;
+    for (auto [base, max] : std::vector<std::pair<int64_t, int64_t>>{
+           {0, 100}, {10, 5000}, {20, 200}, {30, 300}, {40, 6000}}) {
+        idx.push_back(make_entry(base, max));
+    }
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(50)), 0);
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(150)), 1);
+    // later segments with lower timestamps never come first
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(250)), 1);
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(5001)), 4);
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(6001)), 5);
+
+    // dropping the segment with the high timestamp lowers the running max
+    idx.pop_front();
+    idx.pop_front();
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(250)), 1);
+    BOOST_REQUIRE_EQUAL(idx[0].base_offset, model::offset(20));
+
+    idx.pop_back();
+    BOOST_REQUIRE_EQUAL(idx.size(), 2);
+    BOOST_REQUIRE_EQUAL(idx.lower_bound(model::timestamp(5001)), 2);
+}
+
+BOOST_AUTO_TEST_CASE(matches_a_linear_scan) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> ts(0, 10'000);
+    std::uniform_int_distribution<int> op(0, 9);
+
+    segment_timestamp_index idx;
+    std::deque<segment_timestamp_index::entry> entries;
+    int64_t base = 0;
+    for (int i = 0; i < 5'000; ++i) {
+        auto o = op(rng);
+        if (o == 0 && !entries.empty()) {
+            idx.pop_front();
+            entries.pop_front();
+        } else if (o == 1 && !entries.empty()) {
+            idx.pop_back();
+            entries.pop_back();
+        } else {
+            auto e = make_entry(base, ts(rng));
+            base += 10;
+            idx.push_back(e);
+            entries.push_back(e);
+        }
+
+        BOOST_REQUIRE_EQUAL(idx.size(), entries.size());
+        auto t = ts(rng);
+        BOOST_REQUIRE_EQUAL(
+          idx.lower_bound(model::timestamp(t)), scan(entries, t));
+    }
+}
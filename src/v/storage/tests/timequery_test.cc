@@ -14,6 +14,8 @@
 
 #include <seastar/core/file.hh>
 
+#include <vector>
+
 FIXTURE_TEST(timequery, log_builder_fixture) {
     using namespace storage; // NOLINT
 
@@ -114,3 +116,56 @@ FIXTURE_TEST(timequery_single_value, log_builder_fixture) {
     BOOST_TEST(res->offset == model::offset(0));
     b | stop();
 }
+
+FIXTURE_TEST(timequery_out_of_order_segments, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start();
+
+    // 10 batches per segment, the timestamps of segment i start at base[i].
+    // the max timestamps of the segments are not monotonic
+    const std::vector<int64_t> bases = {100, 5000, 200, 300, 400};
+    for (size_t s = 0; s < bases.size(); ++s) {
+        b | add_segment(s * 10);
+        for (auto i = 0; i < 10; ++i) {
+            auto batch = test::make_random_batch(
+              model::offset(s * 10 + i), 1, false);
+            batch.header().first_timestamp = model::timestamp(bases[s] + i);
+            batch.header().max_timestamp = model::timestamp(bases[s] + i);
+            b | add_batch(std::move(batch));
+        }
+    }
+
+    auto query = [this](int64_t ts) {
+        auto log = b.get_log();
+        storage::timequery_config config(
+          model::timestamp(ts),
+          log.offsets().dirty_offset,
+          ss::default_priority_class());
+        return log.timequery(config).get0();
+    };
+
+    // first offset whose timestamp is at or after the query
+    auto res = query(105);
+    BOOST_TEST(res);
+    BOOST_TEST(res->offset == model::offset(5));
+    BOOST_TEST(res->time == model::timestamp(105));
+
+    // only the second segment has timestamps this high, the segments after
+    // it have lower ones
+    res = query(1000);
+    BOOST_TEST(res);
+    BOOST_TEST(res->offset == model::offset(10));
+    BOOST_TEST(res->time == model::timestamp(5000));
+
+    res = query(250);
+    BOOST_TEST(res);
+    BOOST_TEST(res->offset == model::offset(10));
+
+    res = query(5009);
+    BOOST_TEST(res);
+    BOOST_TEST(res->offset == model::offset(19));
+
+    BOOST_TEST(!query(5010));
+    b | stop();
+}
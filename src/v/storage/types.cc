@@ -110,4 +110,14 @@ std::ostream& operator<<(std::ostream& o, const compaction_config& c) {
     return o;
 }
 
+std::ostream& operator<<(std::ostream& o, const housekeeping_backlog& b) {
+    fmt::print(
+      o,
+      "{{size_bytes:{}, over_retention_bytes:{}, dirty_bytes:{}}}",
+      b.size_bytes,
+      b.over_retention_bytes,
+      b.dirty_bytes);
+    return o;
+}
+
 } // namespace storage
@@ -302,4 +302,30 @@ struct compaction_config {
 
     friend std::ostream& operator<<(std::ostream&, const compaction_config&);
 };
+
+/**
+ * Housekeeping work pending in a log, used by the log manager to decide which
+ * logs to compact first.
+ */
+struct housekeeping_backlog {
+    // bytes of the log
+    size_t size_bytes{0};
+    // bytes above the retention.bytes limit of the log
+    size_t over_retention_bytes{0};
+    // bytes of compacted topic segments that were not self compacted yet
+    size_t dirty_bytes{0};
+
+    friend std::ostream&
+    operator<<(std::ostream&, const housekeeping_backlog&);
+};
+
+/**
+ * Closed segment that may be removed, regardless of the retention policy of
+ * its log, when the node is running out of disk space.
+ */
+struct reclaimable_segment {
+    model::offset committed_offset;
+    model::timestamp max_timestamp;
+    size_t size_bytes{0};
+};
 } // namespace storage
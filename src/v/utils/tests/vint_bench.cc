@@ -0,0 +1,107 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "random/generators.h"
+#include "utils/vint.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <vector>
+
+// roughly the number of groups in a heartbeat for a busy node
+static constexpr size_t values_count = 1000;
+
+// offset and timestamp deltas, lengths, group ids: mostly 1 to 4 bytes
+static std::vector<int64_t> gen_values() {
+    std::vector<int64_t> values(values_count);
+    for (auto& v : values) {
+        v = random_generators::get_int<int64_t>(-1 << 20, 1 << 20);
+    }
+    return values;
+}
+
+static std::vector<uint8_t> encode(const std::vector<int64_t>& values) {
+    std::vector<uint8_t> buf(values.size() * vint::max_length);
+    buf.resize(vint::serialize_array(values.data(), values.size(), buf.data()));
+    return buf;
+}
+
+PERF_TEST(vint_encode, scalar) {
+    auto values = gen_values();
+    std::vector<uint8_t> buf(values.size() * vint::max_length);
+    perf_tests::start_measuring_time();
+    size_t sz = 0;
+    for (auto v : values) {
+        sz += vint::serialize(v, buf.data() + sz);
+    }
+    perf_tests::do_not_optimize(sz);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint_encode, bulk) {
+    auto values = gen_values();
+    std::vector<uint8_t> buf(values.size() * vint::max_length);
+    perf_tests::start_measuring_time();
+    auto sz = vint::serialize_array(values.data(), values.size(), buf.data());
+    perf_tests::do_not_optimize(sz);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint_decode, scalar) {
+    auto buf = encode(gen_values());
+    std::vector<int64_t> out(values_count);
+    perf_tests::start_measuring_time();
+    bytes_view view(buf.data(), buf.size());
+    for (auto& v : out) {
+        auto [value, sz] = vint::deserialize(view);
+        v = value;
+        view.remove_prefix(sz);
+    }
+    perf_tests::do_not_optimize(out);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint_decode, bulk) {
+    auto buf = encode(gen_values());
+    std::vector<int64_t> out(values_count);
+    perf_tests::start_measuring_time();
+    auto r = vint::deserialize_array(
+      buf.data(), buf.size(), out.data(), out.size());
+    perf_tests::do_not_optimize(r);
+    perf_tests::do_not_optimize(out);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint_decode, iobuf_parser_bulk) {
+    auto buf = encode(gen_values());
+    iobuf io;
+    io.append(buf.data(), buf.size());
+    std::vector<int64_t> out(values_count);
+    iobuf_parser parser(std::move(io));
+    perf_tests::start_measuring_time();
+    parser.read_varlongs(out.data(), out.size());
+    perf_tests::do_not_optimize(out);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint_decode, iobuf_parser_one_at_a_time) {
+    auto buf = encode(gen_values());
+    iobuf io;
+    io.append(buf.data(), buf.size());
+    std::vector<int64_t> out(values_count);
+    iobuf_parser parser(std::move(io));
+    perf_tests::start_measuring_time();
+    for (auto& v : out) {
+        v = parser.read_varlong().first;
+    }
+    perf_tests::do_not_optimize(out);
+    perf_tests::stop_measuring_time();
+}
@@ -8,6 +8,8 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
 #include "utils/vint.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -18,6 +20,7 @@
 #include <cstdint>
 #include <iostream>
 #include <random>
+#include <vector>
 
 namespace {
 
@@ -36,3 +39,79 @@ void check_roundtrip_sweep(int64_t count) {
 SEASTAR_THREAD_TEST_CASE(sanity_signed_sweep_64) {
     check_roundtrip_sweep(100000000);
 }
+
+namespace {
+
+std::vector<int64_t> random_values(size_t n) {
+    std::mt19937_64 rng(n);
+    std::vector<int64_t> values(n);
+    for (auto& v : values) {
+        // spread values over every encoded length, 1 to 10 bytes
+        const auto bits = rng() % 65;
+        v = bits == 64 ? static_cast<int64_t>(rng())
+                       : static_cast<int64_t>(rng() & ((1ULL << bits) - 1));
+        if (rng() & 1) {
+            v = -v;
+        }
+    }
+    return values;
+}
+
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(bulk_roundtrip) {
+    for (size_t n : {0, 1, 7, 8, 9, 100, 1000}) {
+        const auto values = random_values(n);
+        std::vector<uint8_t> buf(n * vint::max_length);
+        const auto sz = vint::serialize_array(values.data(), n, buf.data());
+
+        // identical to the scalar encoding
+        bytes expected;
+        for (auto v : values) {
+            expected += vint::to_bytes(v);
+        }
+        BOOST_REQUIRE_EQUAL(sz, expected.size());
+        BOOST_REQUIRE(bytes_view(buf.data(), sz) == bytes_view(expected));
+
+        std::vector<int64_t> decoded(n);
+        auto [count, consumed] = vint::deserialize_array(
+          buf.data(), sz, decoded.data(), n);
+        BOOST_REQUIRE_EQUAL(count, n);
+        BOOST_REQUIRE_EQUAL(consumed, sz);
+        BOOST_REQUIRE(decoded == values);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(bulk_decode_truncated) {
+    const auto values = random_values(100);
+    std::vector<uint8_t> buf(values.size() * vint::max_length);
+    const auto sz = vint::serialize_array(
+      values.data(), values.size(), buf.data());
+
+    std::vector<int64_t> decoded(values.size());
+    auto [count, consumed] = vint::deserialize_array(
+      buf.data(), sz - 1, decoded.data(), decoded.size());
+    BOOST_REQUIRE_EQUAL(count, values.size() - 1);
+    BOOST_REQUIRE_EQUAL(consumed, sz - vint::vint_size(values.back()));
+}
+
+SEASTAR_THREAD_TEST_CASE(parser_bulk_read_across_fragments) {
+    const auto values = random_values(1000);
+    std::vector<uint8_t> buf(values.size() * vint::max_length);
+    const auto sz = vint::serialize_array(
+      values.data(), values.size(), buf.data());
+
+    // small fragments so that varints straddle fragment boundaries
+    iobuf io;
+    for (size_t i = 0; i < sz; i += 13) {
+        iobuf frag;
+        frag.append(buf.data() + i, std::min<size_t>(13, sz - i));
+        io.append_fragments(std::move(frag));
+    }
+
+    iobuf_parser parser(std::move(io));
+    std::vector<int64_t> decoded(values.size());
+    parser.read_varlongs(decoded.data(), decoded.size());
+    BOOST_REQUIRE(decoded == values);
+    BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+}
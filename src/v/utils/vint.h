@@ -12,7 +12,14 @@
 #pragma once
 #include "bytes/bytes.h"
 
+#include <seastar/core/byteorder.hh>
+
+#include <bit>
 #include <cstdint>
+#include <cstring>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 // class is actually zigzag vint; always signed ints
 // matches exactly the kafka encoding which uses protobuf
@@ -37,9 +44,9 @@ inline constexpr uint64_t encode_zigzag(int64_t v) noexcept {
 inline constexpr int64_t decode_zigzag(uint64_t v) noexcept {
     return (int64_t)((v >> 1) ^ (~(v & 1) + 1));
 }
-inline size_t serialize(const int64_t x, uint8_t* out) noexcept {
-    // *must* be named differently from input
-    uint64_t value = encode_zigzag(x);
+/// \brief plain varint without zigzag encoding, used by kafka flexible
+/// versions for lengths and tags
+inline size_t serialize_unsigned(uint64_t value, uint8_t* out) noexcept {
     size_t bytes_used = 0;
     if (value < 0x80) {
         out[bytes_used++] = static_cast<uint8_t>(value);
@@ -58,14 +65,15 @@ inline size_t serialize(const int64_t x, uint8_t* out) noexcept {
     out[bytes_used++] = static_cast<uint8_t>(value);
     return bytes_used;
 }
+inline size_t serialize(const int64_t x, uint8_t* out) noexcept {
+    return serialize_unsigned(encode_zigzag(x), out);
+}
+inline constexpr size_t unsigned_vint_size(uint64_t v) noexcept {
+    // every byte holds 7 bits of payload; zero still needs one byte
+    return (std::bit_width(v | 1) + 6) / 7;
+}
 inline constexpr size_t vint_size(const int64_t value) noexcept {
-    uint64_t v = encode_zigzag(value);
-    size_t len = 1;
-    while (v >= 128) {
-        v >>= 7;
-        len++;
-    }
-    return len;
+    return unsigned_vint_size(encode_zigzag(value));
 }
 inline bytes to_bytes(int64_t value) noexcept {
     // our bytes uses a short-string optimization of 31 bytes
@@ -74,12 +82,18 @@ inline bytes to_bytes(int64_t value) noexcept {
     out.resize(sz);
     return out;
 }
+inline bytes to_bytes_unsigned(uint64_t value) noexcept {
+    auto out = ss::uninitialized_string<bytes>(max_length);
+    auto sz = serialize_unsigned(value, out.data());
+    out.resize(sz);
+    return out;
+}
 
 /// \brief almost identical impl to leveldb, made generic for c++
 /// friendliness
 /// https://github.com/google/leveldb/blob/201f52201f/util/coding.cc#L116
 template<typename Range>
-inline std::pair<int64_t, size_t> deserialize(Range&& r) noexcept {
+inline std::pair<uint64_t, size_t> deserialize_unsigned(Range&& r) noexcept {
     uint64_t result = 0;
     size_t bytes_read = 0;
     uint64_t shift = 0;
@@ -94,7 +108,132 @@ inline std::pair<int64_t, size_t> deserialize(Range&& r) noexcept {
         }
         shift += 7;
     }
+    return {result, bytes_read};
+}
+
+template<typename Range>
+inline std::pair<int64_t, size_t> deserialize(Range&& r) noexcept {
+    auto [result, bytes_read] = deserialize_unsigned(std::forward<Range>(r));
     return {decode_zigzag(result), bytes_read};
 }
 
+namespace details {
+/// Word-at-a-time helpers for varints of at most 8 bytes, i.e. values below
+/// 2^56. That covers every offset, delta, length and group id we encode, so
+/// the longer encodings are left to the byte-at-a-time code above. A varint
+/// is handled as a little endian 64 bit word with one 7 bit group per byte.
+inline constexpr size_t word_length = sizeof(uint64_t);
+inline constexpr uint64_t word_max_value = uint64_t(1) << 56;
+inline constexpr uint64_t continuation_bits = 0x8080808080808080;
+
+/// \brief gathers the 7 bit groups of `w` into a contiguous value
+inline uint64_t pack_groups(uint64_t w) noexcept {
+#if defined(__BMI2__)
+    return _pext_u64(w, ~continuation_bits);
+#else
+    w = ((w & 0x7f007f007f007f00) >> 1) | (w & 0x007f007f007f007f);
+    w = ((w & 0x3fff00003fff0000) >> 2) | (w & 0x00003fff00003fff);
+    return ((w & 0x0fffffff00000000) >> 4) | (w & 0x000000000fffffff);
+#endif
+}
+
+/// \brief inverse of pack_groups, `v` must be below word_max_value
+inline uint64_t spread_groups(uint64_t v) noexcept {
+#if defined(__BMI2__)
+    return _pdep_u64(v, ~continuation_bits);
+#else
+    v = ((v & 0x00fffffff0000000) << 4) | (v & 0x000000000fffffff);
+    v = ((v & 0x0fffc0000fffc000) << 2) | (v & 0x00003fff00003fff);
+    return ((v & 0x3f803f803f803f80) << 1) | (v & 0x007f007f007f007f);
+#endif
+}
+
+/// \brief decodes an unsigned varint from `src`, which must have at least
+/// word_length readable bytes. A length of 0 is returned when the varint does
+/// not terminate within the word.
+inline std::pair<uint64_t, size_t> decode_word(const uint8_t* src) noexcept {
+    uint64_t w;
+    std::memcpy(&w, src, sizeof(w));
+    w = ss::le_to_cpu(w);
+    const uint64_t stops = ~w & continuation_bits;
+    if (unlikely(stops == 0)) {
+        return {0, 0};
+    }
+    // keep the bits up to and including the first byte without continuation
+    const uint64_t mask = stops ^ (stops - 1);
+    const size_t len = (std::countr_zero(stops) / 8) + 1;
+    return {pack_groups(w & mask), len};
+}
+
+/// \brief encodes `v` below word_max_value into `out`. Always stores
+/// word_length bytes, so `out` must have that much room even if the encoded
+/// varint is shorter.
+inline size_t encode_word(uint64_t v, uint8_t* out) noexcept {
+    const size_t len = unsigned_vint_size(v);
+    const uint64_t cont = continuation_bits
+                          & ((uint64_t(1) << ((len - 1) * 8)) - 1);
+    const uint64_t w = ss::cpu_to_le(spread_groups(v) | cont);
+    std::memcpy(out, &w, sizeof(w));
+    return len;
+}
+} // namespace details
+
+/// \brief decodes a single varint from contiguous memory, taking the word
+/// fast path when at least details::word_length bytes are readable
+inline std::pair<int64_t, size_t>
+deserialize(const uint8_t* src, size_t len) noexcept {
+    if (likely(len >= details::word_length)) {
+        auto [v, n] = details::decode_word(src);
+        if (likely(n > 0)) {
+            return {decode_zigzag(v), n};
+        }
+    }
+    return deserialize(bytes_view(src, len));
+}
+
+/// \brief bulk zigzag encoding of `n` values. `out` must have room for
+/// `n * max_length` bytes. Returns the number of bytes written.
+inline size_t
+serialize_array(const int64_t* values, size_t n, uint8_t* out) noexcept {
+    size_t written = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t v = encode_zigzag(values[i]);
+        if (likely(v < details::word_max_value)) {
+            written += details::encode_word(v, out + written);
+        } else {
+            written += serialize_unsigned(v, out + written);
+        }
+    }
+    return written;
+}
+
+/// \brief bulk zigzag decoding of up to `n` values from `len` bytes of
+/// contiguous memory. Stops early at the first truncated varint. Returns the
+/// number of values decoded and the number of bytes consumed.
+inline std::pair<size_t, size_t> deserialize_array(
+  const uint8_t* src, size_t len, int64_t* values, size_t n) noexcept {
+    size_t decoded = 0;
+    size_t consumed = 0;
+    while (decoded < n && consumed < len) {
+        const uint8_t* p = src + consumed;
+        const size_t left = len - consumed;
+        if (likely(left >= details::word_length)) {
+            auto [v, sz] = details::decode_word(p);
+            if (likely(sz > 0)) {
+                values[decoded++] = decode_zigzag(v);
+                consumed += sz;
+                continue;
+            }
+        }
+        auto [v, sz] = deserialize(bytes_view(p, left));
+        if (unlikely(p[sz - 1] & 0x80)) {
+            // truncated varint
+            break;
+        }
+        values[decoded++] = v;
+        consumed += sz;
+    }
+    return {decoded, consumed};
+}
+
 } // namespace vint
@@ -80,6 +80,19 @@ public:
        return _ssg;
     }
 
+    std::string_view service_name() const final {
+       return "{{service_name}}";
+    }
+
+    std::vector<rpc::method*> methods() final {
+       std::vector<rpc::method*> ret;
+       ret.reserve(_methods.size());
+       for (auto& m : _methods) {
+          ret.push_back(&m);
+       }
+       return ret;
+    }
+
     rpc::method* method_from_id(uint32_t idx) final {
        switch(idx) {
        {%- for method in methods %}
@@ -111,7 +124,7 @@ private:
       {%- for method in methods %}
       rpc::method([this] (ss::input_stream<char>& in, rpc::streaming_context& ctx) {
          return raw_{{method.name}}(in, ctx);
-      }){{ "," if not loop.last }}
+      }, "{{method.name}}", rpc::compression_policy::{{method.compression}}){{ "," if not loop.last }}
       {%- endfor %}
     {% raw %}}}{% endraw %};
 };
@@ -123,10 +136,15 @@ public:
 
     virtual ~{{service_name}}_client_protocol() = default;
 
+    /// connection lane each method should be sent on, see rpc::connection_lane
+    {%- for method in methods %}
+    static constexpr rpc::connection_lane {{method.name}}_lane = rpc::connection_lane::{{method.lane}};
+    {%- endfor %}
+
     {%- for method in methods %}
     virtual inline ss::future<result<rpc::client_context<{{method.output_type}}>>>
     {{method.name}}({{method.input_type}}&& r, rpc::client_opts opts) {
-       return _transport.send_typed<{{method.input_type}}, {{method.output_type}}>(std::move(r), {{method.id}}, std::move(opts));
+       return _transport.send_typed<{{method.input_type}}, {{method.output_type}}>(std::move(r), {{method.id}}, std::move(opts), rpc::compression_policy::{{method.compression}});
     }
     {%- endfor %}
 
@@ -193,6 +211,10 @@ private:
 """
 
 
+COMPRESSION_POLICIES = ["none", "zstd", "adaptive"]
+CONNECTION_LANES = ["data", "control"]
+
+
 def _read_file(name):
     with open(name, 'r') as f:
         return json.load(f)
@@ -212,6 +234,17 @@ def _enrich_methods(service):
 
     for m in service["methods"]:
         m["id"] = _xor_id(m)
+        # compression policy of both requests and replies, see
+        # rpc::compression_policy
+        m.setdefault("compression", "adaptive")
+        if m["compression"] not in COMPRESSION_POLICIES:
+            raise ValueError("unknown compression policy '%s' of method %s" %
+                             (m["compression"], m["name"]))
+        # connection lane, see rpc::connection_lane
+        m.setdefault("lane", "data")
+        if m["lane"] not in CONNECTION_LANES:
+            raise ValueError("unknown connection lane '%s' of method %s" %
+                             (m["lane"], m["name"]))
 
     return service
 